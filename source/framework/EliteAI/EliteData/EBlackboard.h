@@ -36,6 +36,22 @@ namespace Elite
 		T m_Data;
 	};
 
+	//-----------------------------------------------------------------
+	// BLACKBOARD QUERIES (PER TICK CACHE)
+	//-----------------------------------------------------------------
+	//A query (sensor) declares what it computes: a unique id, the type of the result and how to compute it.
+	//The first caller in a tick computes the result, every later caller in the same tick gets the cached result.
+	/* USAGE INFORMATION
+	struct NearestFoodQuery
+	{
+		using ValueType = AgarioFood*;
+		static constexpr BlackboardQueryId Id{ CompileTimeLiteralStringHash("NearestFood") };
+		static ValueType Compute(Blackboard* pBlackboard);
+	};
+	AgarioFood* pFood = pBlackboard->Query<NearestFoodQuery>();
+	*/
+	using BlackboardQueryId = unsigned int;
+
 	//-----------------------------------------------------------------
 	// BLACKBOARD (BASE)
 	//-----------------------------------------------------------------
@@ -48,6 +64,10 @@ namespace Elite
 			for (auto el : m_BlackboardData)
 				SAFE_DELETE(el.second);
 			m_BlackboardData.clear();
+
+			for (auto el : m_QueryCache)
+				SAFE_DELETE(el.second.pField);
+			m_QueryCache.clear();
 		}
 
 		Blackboard(const Blackboard& other) = delete;
@@ -98,8 +118,49 @@ namespace Elite
 			return false;
 		}
 
+		//Get the result of a query, computed at most once per tick
+		template<typename T_Query> typename T_Query::ValueType Query()
+		{
+			using ValueType = typename T_Query::ValueType;
+			const BlackboardQueryId id{ T_Query::Id };
+
+			CachedQuery& cached = m_QueryCache[id];
+			if (cached.pField && cached.tick == m_QueryTick)
+			{
+				++m_QueryCacheHits;
+				//The id belongs to one query, so the field always has the type of that query
+				return static_cast<BlackboardField<ValueType>*>(cached.pField)->GetData();
+			}
+
+			++m_QueryCacheMisses;
+			const ValueType result{ T_Query::Compute(this) };
+			if (cached.pField)
+				static_cast<BlackboardField<ValueType>*>(cached.pField)->SetData(result);
+			else
+				cached.pField = new BlackboardField<ValueType>(result);
+			cached.tick = m_QueryTick;
+			return result;
+		}
+
+		//Invalidate all cached query results, call at the start of every agent update
+		void InvalidateQueries() { ++m_QueryTick; }
+
+		unsigned int GetQueryCacheHits() const { return m_QueryCacheHits; }
+		unsigned int GetQueryCacheMisses() const { return m_QueryCacheMisses; }
+		void ResetQueryCacheStats() { m_QueryCacheHits = 0; m_QueryCacheMisses = 0; }
+
 	private:
+		struct CachedQuery
+		{
+			IBlackBoardField* pField = nullptr;
+			unsigned int tick = 0;
+		};
+
 		std::unordered_map<std::string, IBlackBoardField*> m_BlackboardData;
+		std::unordered_map<BlackboardQueryId, CachedQuery> m_QueryCache;
+		unsigned int m_QueryTick = 1; //Starts past the tick of a new cache entry
+		unsigned int m_QueryCacheHits = 0;
+		unsigned int m_QueryCacheMisses = 0;
 	};
 }
 #endif
\ No newline at end of file
@@ -138,12 +138,16 @@ namespace Elite
 
 		virtual void Update(float deltaTime) override
 		{
+			ELITE_PROFILE_SCOPE("BehaviorTree::Update");
+
 			if (m_pRootBehavior == nullptr)
 			{
 				m_CurrentState = BehaviorState::Failure;
 				return;
 			}
-				
+
+			//New tick, cached queries of the previous tick are outdated
+			m_pBlackBoard->InvalidateQueries();
 			m_CurrentState = m_pRootBehavior->Execute(m_pBlackBoard);
 		}
 		Blackboard* GetBlackboard() const
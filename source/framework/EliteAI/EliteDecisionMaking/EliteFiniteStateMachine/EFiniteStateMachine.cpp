@@ -28,6 +28,9 @@ void FiniteStateMachine::AddTransition(FSMState* startState, FSMState* toState,
 
 void FiniteStateMachine::Update(float deltaTime)
 {
+    //New tick, cached queries of the previous tick are outdated
+    m_pBlackboard->InvalidateQueries();
+
     //Look if 1 or more condition exists for the current state that we are in
     auto& currentTransitions{ m_Transitions.find(m_pCurrentState) };
 
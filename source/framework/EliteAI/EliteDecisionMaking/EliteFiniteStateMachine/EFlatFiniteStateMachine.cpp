@@ -0,0 +1,112 @@
+//=== General Includes ===
+#include "stdafx.h"
+#include "EFlatFiniteStateMachine.h"
+using namespace Elite;
+
+//-----------------------------------------------------------------
+// FSM DEFINITION (SHARED)
+//-----------------------------------------------------------------
+FSMDefinition::FSMDefinition(const std::vector<FSMState*>& pStates, const std::vector<FSMCondition*>& pConditions,
+    const std::vector<FSMTransitionDesc>& transitions)
+    : m_pStates(pStates),
+    m_pConditions(pConditions),
+    m_Transitions(transitions.size()),
+    m_Offsets(pStates.size() + 1, 0)
+{
+    // Validate everything before the table is built
+    for (const FSMTransitionDesc& desc : transitions)
+    {
+        if (desc.from >= m_pStates.size() || desc.to >= m_pStates.size() || desc.condition >= m_pConditions.size())
+            Reject("FSMDefinition: transition uses an invalid state or condition id");
+    }
+
+    // Count the transitions of every state
+    for (const FSMTransitionDesc& desc : transitions)
+        ++m_Offsets[desc.from + 1];
+
+    // Prefix sum gives the start of every range
+    for (size_t s = 0; s < m_pStates.size(); ++s)
+        m_Offsets[s + 1] += m_Offsets[s];
+
+    // Stable scatter, so transitions keep their priority within a state
+    std::vector<unsigned int> cursor(m_Offsets.begin(), m_Offsets.end() - 1);
+    for (const FSMTransitionDesc& desc : transitions)
+    {
+        FSMTransition& transition = m_Transitions[cursor[desc.from]++];
+        transition.condition = desc.condition;
+        transition.to = desc.to;
+    }
+}
+
+FSMDefinition::~FSMDefinition()
+{
+    DeleteStatesAndConditions();
+}
+
+void FSMDefinition::DeleteStatesAndConditions()
+{
+    for (auto& pState : m_pStates)
+        SAFE_DELETE(pState);
+    m_pStates.clear();
+
+    for (auto& pCondition : m_pConditions)
+        SAFE_DELETE(pCondition);
+    m_pConditions.clear();
+}
+
+void FSMDefinition::Reject(const char* message)
+{
+    // The definition owns them from the moment it is constructed, so nobody else would delete them
+    DeleteStatesAndConditions();
+    throw Elite_Exception(message);
+}
+
+//-----------------------------------------------------------------
+// FLAT FINITE STATE MACHINE (PER AGENT)
+//-----------------------------------------------------------------
+FlatFiniteStateMachine::FlatFiniteStateMachine(const FSMDefinition* pDefinition, FSMStateId startState, Blackboard* pBlackboard)
+    : m_pDefinition(pDefinition),
+    m_CurrentState(startState),
+    m_pBlackboard(pBlackboard)
+{
+    if (!m_pDefinition || startState >= m_pDefinition->GetNrOfStates())
+    {
+        // The destructor doesn't run when the constructor throws, and the blackboard is ours already
+        SAFE_DELETE(m_pBlackboard);
+        throw Elite_Exception("FlatFiniteStateMachine: invalid definition or start state");
+    }
+
+    m_pDefinition->GetState(m_CurrentState)->OnEnter(m_pBlackboard);
+}
+
+FlatFiniteStateMachine::~FlatFiniteStateMachine()
+{
+    SAFE_DELETE(m_pBlackboard);
+}
+
+void FlatFiniteStateMachine::Update(float deltaTime)
+{
+    //New tick, cached queries of the previous tick are outdated
+    m_pBlackboard->InvalidateQueries();
+
+    // Only the transitions of the current state are stored in this range, in the order they were added
+    const FSMTransition* pEnd{ m_pDefinition->TransitionsEnd(m_CurrentState) };
+    for (const FSMTransition* pTransition{ m_pDefinition->TransitionsBegin(m_CurrentState) }; pTransition != pEnd; ++pTransition)
+    {
+        if (m_pDefinition->GetCondition(pTransition->condition)->Evaluate(m_pBlackboard))
+        {
+            ChangeState(pTransition->to);
+            break;
+        }
+    }
+
+    m_pDefinition->GetState(m_CurrentState)->Update(m_pBlackboard, deltaTime);
+}
+
+void FlatFiniteStateMachine::ChangeState(FSMStateId newState)
+{
+    // Ids are validated when the definition is built, so every state exists
+    m_pDefinition->GetState(m_CurrentState)->OnExit(m_pBlackboard);
+    m_CurrentState = newState;
+    m_pDefinition->GetState(m_CurrentState)->OnEnter(m_pBlackboard);
+}
@@ -0,0 +1,177 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EFlatFiniteStateMachine.h: Table driven FSM. States and conditions are addressed by dense ids,
+// the transitions of every state are stored in one contiguous range of a flat array.
+// A FSMDefinition is immutable after construction and can be shared by any number of agents,
+// a FlatFiniteStateMachine only stores the current state of one agent.
+/*=============================================================================*/
+#ifndef ELITE_FLAT_FINITE_STATE_MACHINE
+#define ELITE_FLAT_FINITE_STATE_MACHINE
+
+#include <stdexcept>
+
+namespace Elite
+{
+	//-----------------------------------------------------------------
+	// FLAT FSM TYPES
+	//-----------------------------------------------------------------
+	using FSMStateId = unsigned int;
+	using FSMConditionId = unsigned int;
+
+	//Description of one transition, as written by the user
+	struct FSMTransitionDesc
+	{
+		FSMStateId from;
+		FSMStateId to;
+		FSMConditionId condition;
+	};
+
+	//Transition as stored in the flat table, the start state is implied by the range it is stored in
+	struct FSMTransition
+	{
+		FSMConditionId condition = 0;
+		FSMStateId to = 0;
+	};
+
+	//-----------------------------------------------------------------
+	// COMPILE-TIME TRANSITION TABLE
+	//-----------------------------------------------------------------
+	//Sorts the transitions per start state (keeping the order they were described in) at compile time.
+	//Out of range ids make the constant evaluation fail, so an invalid graph does not compile.
+	/* USAGE INFORMATION
+	enum States : FSMStateId { Idle, Walk, StateCount };
+	enum Conditions : FSMConditionId { HasTarget, NoTarget, ConditionCount };
+	constexpr FSMTransitionDesc Transitions[]{ { Idle, Walk, HasTarget }, { Walk, Idle, NoTarget } };
+	constexpr auto Table{ MakeFSMTransitionTable<StateCount, ConditionCount>(Transitions) };
+	*/
+	template<FSMStateId NrOfStates, FSMConditionId NrOfConditions, unsigned int NrOfTransitions>
+	class FSMTransitionTable final
+	{
+	public:
+		constexpr explicit FSMTransitionTable(const FSMTransitionDesc(&descriptions)[NrOfTransitions])
+			: m_Transitions{}
+			, m_Offsets{}
+		{
+			//Count the transitions of every state
+			for (unsigned int i = 0; i < NrOfTransitions; ++i)
+			{
+				if (descriptions[i].from >= NrOfStates || descriptions[i].to >= NrOfStates)
+					throw std::out_of_range("FSMTransitionTable: state id out of range");
+				if (descriptions[i].condition >= NrOfConditions)
+					throw std::out_of_range("FSMTransitionTable: condition id out of range");
+
+				++m_Offsets[descriptions[i].from + 1];
+			}
+
+			//Prefix sum gives the start of every range
+			for (FSMStateId s = 0; s < NrOfStates; ++s)
+				m_Offsets[s + 1] += m_Offsets[s];
+
+			//Stable scatter into the ranges
+			unsigned int cursor[NrOfStates + 1]{};
+			for (FSMStateId s = 0; s < NrOfStates; ++s)
+				cursor[s] = m_Offsets[s];
+
+			for (unsigned int i = 0; i < NrOfTransitions; ++i)
+			{
+				FSMTransition& transition = m_Transitions[cursor[descriptions[i].from]++];
+				transition.condition = descriptions[i].condition;
+				transition.to = descriptions[i].to;
+			}
+		}
+
+		constexpr FSMStateId GetNrOfStates() const { return NrOfStates; }
+		constexpr FSMConditionId GetNrOfConditions() const { return NrOfConditions; }
+		constexpr unsigned int GetNrOfTransitions() const { return NrOfTransitions; }
+		constexpr const FSMTransition* GetTransitions() const { return m_Transitions; }
+		constexpr const unsigned int* GetOffsets() const { return m_Offsets; }
+
+	private:
+		FSMTransition m_Transitions[NrOfTransitions];
+		unsigned int m_Offsets[NrOfStates + 1]; //Transitions of state s are [m_Offsets[s], m_Offsets[s + 1])
+	};
+
+	template<FSMStateId NrOfStates, FSMConditionId NrOfConditions, unsigned int NrOfTransitions>
+	constexpr FSMTransitionTable<NrOfStates, NrOfConditions, NrOfTransitions> MakeFSMTransitionTable(const FSMTransitionDesc(&descriptions)[NrOfTransitions])
+	{
+		return FSMTransitionTable<NrOfStates, NrOfConditions, NrOfTransitions>{ descriptions };
+	}
+
+	//-----------------------------------------------------------------
+	// FSM DEFINITION (SHARED)
+	//-----------------------------------------------------------------
+	//Takes ownership of the states and conditions, the index in the vector is the id. They are deleted
+	//when the definition is, or right away when the constructor throws on an invalid graph.
+	//States and conditions only get data through the blackboard, so they can be shared between agents.
+	class FSMDefinition final
+	{
+	public:
+		//Runtime built transitions
+		FSMDefinition(const std::vector<FSMState*>& pStates, const std::vector<FSMCondition*>& pConditions,
+			const std::vector<FSMTransitionDesc>& transitions);
+		//Compile-time built transitions
+		template<FSMStateId NrOfStates, FSMConditionId NrOfConditions, unsigned int NrOfTransitions>
+		FSMDefinition(const std::vector<FSMState*>& pStates, const std::vector<FSMCondition*>& pConditions,
+			const FSMTransitionTable<NrOfStates, NrOfConditions, NrOfTransitions>& table);
+		~FSMDefinition();
+
+		FSMDefinition(const FSMDefinition& other) = delete;
+		FSMDefinition& operator=(const FSMDefinition& other) = delete;
+		FSMDefinition(FSMDefinition&& other) = delete;
+		FSMDefinition& operator=(FSMDefinition&& other) = delete;
+
+		FSMState* GetState(FSMStateId id) const { return m_pStates[id]; }
+		FSMCondition* GetCondition(FSMConditionId id) const { return m_pConditions[id]; }
+		FSMStateId GetNrOfStates() const { return static_cast<FSMStateId>(m_pStates.size()); }
+
+		//Contiguous range of transitions that start in the given state
+		const FSMTransition* TransitionsBegin(FSMStateId id) const { return m_Transitions.data() + m_Offsets[id]; }
+		const FSMTransition* TransitionsEnd(FSMStateId id) const { return m_Transitions.data() + m_Offsets[id + 1]; }
+
+	private:
+		std::vector<FSMState*> m_pStates;
+		std::vector<FSMCondition*> m_pConditions;
+		std::vector<FSMTransition> m_Transitions;
+		std::vector<unsigned int> m_Offsets;
+
+		void DeleteStatesAndConditions();
+		//Deletes what was adopted and throws, the destructor doesn't run for a constructor that throws
+		[[noreturn]] void Reject(const char* message);
+	};
+
+	template<FSMStateId NrOfStates, FSMConditionId NrOfConditions, unsigned int NrOfTransitions>
+	inline FSMDefinition::FSMDefinition(const std::vector<FSMState*>& pStates, const std::vector<FSMCondition*>& pConditions,
+		const FSMTransitionTable<NrOfStates, NrOfConditions, NrOfTransitions>& table)
+		: m_pStates(pStates)
+		, m_pConditions(pConditions)
+		, m_Transitions(table.GetTransitions(), table.GetTransitions() + NrOfTransitions)
+		, m_Offsets(table.GetOffsets(), table.GetOffsets() + NrOfStates + 1)
+	{
+		if (m_pStates.size() != NrOfStates || m_pConditions.size() != NrOfConditions)
+			Reject("FSMDefinition: amount of states or conditions does not match the transition table");
+	}
+
+	//-----------------------------------------------------------------
+	// FLAT FINITE STATE MACHINE (PER AGENT)
+	//-----------------------------------------------------------------
+	class FlatFiniteStateMachine final : public Elite::IDecisionMaking
+	{
+	public:
+		FlatFiniteStateMachine(const FSMDefinition* pDefinition, FSMStateId startState, Blackboard* pBlackboard);
+		virtual ~FlatFiniteStateMachine();
+
+		virtual void Update(float deltaTime) override;
+		Elite::Blackboard* GetBlackboard() const { return m_pBlackboard; }
+		FSMStateId GetCurrentState() const { return m_CurrentState; }
+
+	private:
+		void ChangeState(FSMStateId newState);
+
+	private:
+		const FSMDefinition* m_pDefinition = nullptr; //Shared, not owned
+		FSMStateId m_CurrentState = 0;
+		Blackboard* m_pBlackboard = nullptr; // takes ownership of the blackboard
+	};
+}
+#endif
@@ -0,0 +1,395 @@
+//=== General Includes ===
+#include "stdafx.h"
+#include "EGeneticAlgorithm.h"
+using namespace Elite;
+
+//=== Checkpoint Layout ===
+namespace
+{
+	const uint32_t GeneticFileMagic = MakeFourCC('E', 'G', 'E', 'N');
+	const uint32_t GeneticFileVersion = 1;
+
+	const uint32_t GeneticInfoSection = MakeFourCC('G', 'I', 'N', 'F');
+	const uint32_t GeneticTopologySection = MakeFourCC('G', 'T', 'O', 'P');
+	const uint32_t GeneticWeightsSection = MakeFourCC('G', 'W', 'G', 'T');
+	const uint32_t GeneticFitnessSection = MakeFourCC('G', 'F', 'I', 'T');
+
+	struct GeneticFileInfo
+	{
+		int generation;
+		int populationSize;
+		unsigned int seed;
+	};
+
+	//What a generator is used for, so two uses with the same seed never draw the same numbers
+	enum class RandomStream : unsigned int
+	{
+		Randomize = 1,
+		Evolve = 2,
+		World = 3
+	};
+
+	unsigned int GetSeed(unsigned int seed, RandomStream stream, int generation, int idx)
+	{
+		return MixSeed(MixSeed(MixSeed(seed, static_cast<unsigned int>(stream)), static_cast<unsigned int>(generation)), static_cast<unsigned int>(idx));
+	}
+
+	//Enough worlds per job to hide the cost of scheduling, few enough to keep every thread busy
+	const int WorldsPerJob = 64;
+}
+
+//=== GenomePool ===
+GenomePool::GenomePool(const std::vector<int>& topology, const GeneticSettings& settings) :
+	m_Topology{ topology },
+	m_Settings{ settings }
+{
+	ELITE_ASSERT(m_Topology.size() >= 2, "A genome needs at least an input and an output layer.");
+
+	const size_t nrOfLayers{ m_Topology.size() - 1 };
+	m_Weights.resize(nrOfLayers);
+	m_Biases.resize(nrOfLayers);
+	m_Outputs.resize(nrOfLayers);
+	m_NextWeights.resize(nrOfLayers);
+	m_NextBiases.resize(nrOfLayers);
+
+	Resize(m_Settings.populationSize);
+	Randomize();
+}
+
+void GenomePool::Resize(int populationSize)
+{
+	m_Settings.populationSize = populationSize;
+	for (size_t layer = 0; layer < m_Weights.size(); ++layer)
+	{
+		const int nrOfNeurons{ m_Topology[layer + 1] };
+		const int nrOfInputs{ m_Topology[layer] };
+		m_Weights[layer].Resize(nrOfNeurons, nrOfInputs, populationSize);
+		m_Biases[layer].Resize(nrOfNeurons, 1, populationSize);
+		m_NextWeights[layer].Resize(nrOfNeurons, nrOfInputs, populationSize);
+		m_NextBiases[layer].Resize(nrOfNeurons, 1, populationSize);
+	}
+	m_Fitnesses.assign(populationSize, 0.f);
+}
+
+void GenomePool::Randomize()
+{
+	const float range{ m_Settings.initialWeightRange };
+	for (int genome = 0; genome < GetNrOfGenomes(); ++genome)
+	{
+		//Not FMatrix::Randomize, rand() would make the population depend on everything else that uses it
+		std::mt19937 generator{ GetSeed(m_Settings.seed, RandomStream::Randomize, 0, genome) };
+		std::uniform_real_distribution<float> weightDistribution{ -range, range };
+		for (size_t layer = 0; layer < m_Weights.size(); ++layer)
+		{
+			for (int row = 0; row < m_Weights[layer].GetNrOfRows(); ++row)
+			{
+				for (int column = 0; column < m_Weights[layer].GetNrOfColumns(); ++column)
+					m_Weights[layer].Set(genome, row, column, weightDistribution(generator));
+				m_Biases[layer].Set(genome, row, 0, weightDistribution(generator));
+			}
+		}
+	}
+
+	std::fill(m_Fitnesses.begin(), m_Fitnesses.end(), 0.f);
+	m_Generation = 0;
+}
+
+const FMatrixBatch& GenomePool::FeedForward(const FMatrixBatch& inputs)
+{
+	ELITE_PROFILE_SCOPE("GenomePool::FeedForward");
+
+	const FMatrixBatch* pInputs{ &inputs };
+	for (size_t layer = 0; layer < m_Weights.size(); ++layer)
+	{
+		const bool isOutputLayer{ layer + 1 == m_Weights.size() };
+		Elite::FeedForward(m_Weights[layer], m_Biases[layer], *pInputs, m_Outputs[layer],
+			isOutputLayer ? m_Settings.outputActivation : m_Settings.hiddenActivation);
+		pInputs = &m_Outputs[layer];
+	}
+	return m_Outputs.back();
+}
+
+void GenomePool::GetLayer(int genome, int layer, FMatrix& weights, FMatrix& bias) const
+{
+	m_Weights[layer].GetMatrix(genome, weights);
+	m_Biases[layer].GetMatrix(genome, bias);
+}
+
+void GenomePool::SetLayer(int genome, int layer, const FMatrix& weights, const FMatrix& bias)
+{
+	m_Weights[layer].SetMatrix(genome, weights);
+	m_Biases[layer].SetMatrix(genome, bias);
+}
+
+int GenomePool::GetBestGenome() const
+{
+	return static_cast<int>(std::max_element(m_Fitnesses.begin(), m_Fitnesses.end()) - m_Fitnesses.begin());
+}
+
+float GenomePool::GetAverageFitness() const
+{
+	float sum{};
+	for (float fitness : m_Fitnesses)
+		sum += fitness;
+	return m_Fitnesses.empty() ? 0.f : sum / m_Fitnesses.size();
+}
+
+void GenomePool::Evolve()
+{
+	ELITE_PROFILE_SCOPE("GenomePool::Evolve");
+
+	//Best first, equal fitnesses on index so the ranking doesn't depend on the sort
+	const int populationSize{ GetNrOfGenomes() };
+	m_Ranking.resize(populationSize);
+	for (int genome = 0; genome < populationSize; ++genome)
+		m_Ranking[genome] = genome;
+	std::sort(m_Ranking.begin(), m_Ranking.end(), [this](int a, int b)
+		{
+			return m_Fitnesses[a] > m_Fitnesses[b] || (m_Fitnesses[a] == m_Fitnesses[b] && a < b);
+		});
+
+	//Every child has a generator of its own, which threads make which child doesn't change the result
+	const int nrOfElites{ Clamp(m_Settings.nrOfElites, 0, populationSize) };
+	const int generation{ m_Generation + 1 };
+	JOBSYSTEM->ParallelFor(populationSize, WorldsPerJob, [this, nrOfElites, generation](int begin, int end)
+		{
+			for (int child = begin; child < end; ++child)
+			{
+				if (child < nrOfElites)
+				{
+					CopyGenome(m_Ranking[child], child);
+					continue;
+				}
+
+				std::mt19937 generator{ GetSeed(m_Settings.seed, RandomStream::Evolve, generation, child) };
+				MakeChild(child, generator);
+			}
+		});
+
+	m_Weights.swap(m_NextWeights);
+	m_Biases.swap(m_NextBiases);
+	std::fill(m_Fitnesses.begin(), m_Fitnesses.end(), 0.f);
+	m_Generation = generation;
+}
+
+int GenomePool::SelectByTournament(std::mt19937& generator) const
+{
+	std::uniform_int_distribution<int> genomeDistribution{ 0, GetNrOfGenomes() - 1 };
+	int winner{ genomeDistribution(generator) };
+	for (int i = 1; i < m_Settings.tournamentSize; ++i)
+	{
+		const int contender{ genomeDistribution(generator) };
+		if (m_Fitnesses[contender] > m_Fitnesses[winner])
+			winner = contender;
+	}
+	return winner;
+}
+
+void GenomePool::MakeChild(int child, std::mt19937& generator)
+{
+	std::uniform_real_distribution<float> chanceDistribution{ 0.f, 1.f };
+	std::normal_distribution<float> mutationDistribution{ 0.f, m_Settings.mutationStrength };
+	const auto mutate = [&](float weight)
+	{
+		return chanceDistribution(generator) < m_Settings.mutationRate ? weight + mutationDistribution(generator) : weight;
+	};
+
+	const int parentA{ SelectByTournament(generator) };
+	const int parentB{ chanceDistribution(generator) < m_Settings.crossoverRate ? SelectByTournament(generator) : parentA };
+
+	//A neuron keeps its incoming weights and bias together, mixing them would break what it learned
+	for (size_t layer = 0; layer < m_Weights.size(); ++layer)
+	{
+		const FMatrixBatch& weights{ m_Weights[layer] };
+		const FMatrixBatch& biases{ m_Biases[layer] };
+		for (int row = 0; row < weights.GetNrOfRows(); ++row)
+		{
+			const int parent{ parentA == parentB || chanceDistribution(generator) < 0.5f ? parentA : parentB };
+			for (int column = 0; column < weights.GetNrOfColumns(); ++column)
+				m_NextWeights[layer].Set(child, row, column, mutate(weights.Get(parent, row, column)));
+			m_NextBiases[layer].Set(child, row, 0, mutate(biases.Get(parent, row, 0)));
+		}
+	}
+}
+
+void GenomePool::CopyGenome(int from, int to)
+{
+	for (size_t layer = 0; layer < m_Weights.size(); ++layer)
+	{
+		const FMatrixBatch& weights{ m_Weights[layer] };
+		for (int row = 0; row < weights.GetNrOfRows(); ++row)
+		{
+			for (int column = 0; column < weights.GetNrOfColumns(); ++column)
+				m_NextWeights[layer].Set(to, row, column, weights.Get(from, row, column));
+			m_NextBiases[layer].Set(to, row, 0, m_Biases[layer].Get(from, row, 0));
+		}
+	}
+}
+
+bool GenomePool::Save(const std::string& path) const
+{
+	//Genome after genome, every layer row by row with the bias at the end of the row.
+	//Doesn't depend on the block size, which changes with the population size.
+	std::vector<float> weights{};
+	for (int genome = 0; genome < GetNrOfGenomes(); ++genome)
+	{
+		for (size_t layer = 0; layer < m_Weights.size(); ++layer)
+		{
+			for (int row = 0; row < m_Weights[layer].GetNrOfRows(); ++row)
+			{
+				for (int column = 0; column < m_Weights[layer].GetNrOfColumns(); ++column)
+					weights.push_back(m_Weights[layer].Get(genome, row, column));
+				weights.push_back(m_Biases[layer].Get(genome, row, 0));
+			}
+		}
+	}
+
+	const GeneticFileInfo info{ m_Generation, GetNrOfGenomes(), m_Settings.seed };
+	BinaryFileWriter writer{ GeneticFileMagic, GeneticFileVersion };
+	writer.AddSection(GeneticInfoSection, &info, 1);
+	writer.AddSection(GeneticTopologySection, m_Topology);
+	writer.AddSection(GeneticWeightsSection, weights);
+	writer.AddSection(GeneticFitnessSection, m_Fitnesses);
+	return writer.Write(path);
+}
+
+bool GenomePool::Load(const std::string& path)
+{
+	BinaryFileReader reader{};
+	if (!reader.Open(path, GeneticFileMagic, GeneticFileVersion))
+		return false;
+
+	size_t nrOfInfos{}, nrOfLayers{}, nrOfWeights{}, nrOfFitnesses{};
+	const GeneticFileInfo* pInfo{ reader.GetSection<GeneticFileInfo>(GeneticInfoSection, nrOfInfos) };
+	const int* pTopology{ reader.GetSection<int>(GeneticTopologySection, nrOfLayers) };
+	const float* pWeights{ reader.GetSection<float>(GeneticWeightsSection, nrOfWeights) };
+	const float* pFitnesses{ reader.GetSection<float>(GeneticFitnessSection, nrOfFitnesses) };
+	if (nrOfInfos != 1 || pInfo->populationSize <= 0)
+		return false;
+	if (!std::equal(m_Topology.begin(), m_Topology.end(), pTopology, pTopology + nrOfLayers))
+		return false;
+
+	size_t nrOfWeightsPerGenome{};
+	for (size_t layer = 0; layer + 1 < m_Topology.size(); ++layer)
+		nrOfWeightsPerGenome += static_cast<size_t>(m_Topology[layer] + 1) * m_Topology[layer + 1];
+	const size_t populationSize{ static_cast<size_t>(pInfo->populationSize) };
+	if (nrOfWeights != nrOfWeightsPerGenome * populationSize || nrOfFitnesses != populationSize)
+		return false;
+
+	Resize(pInfo->populationSize);
+	for (int genome = 0; genome < GetNrOfGenomes(); ++genome)
+	{
+		for (size_t layer = 0; layer < m_Weights.size(); ++layer)
+		{
+			for (int row = 0; row < m_Weights[layer].GetNrOfRows(); ++row)
+			{
+				for (int column = 0; column < m_Weights[layer].GetNrOfColumns(); ++column)
+					m_Weights[layer].Set(genome, row, column, *pWeights++);
+				m_Biases[layer].Set(genome, row, 0, *pWeights++);
+			}
+		}
+	}
+	m_Fitnesses.assign(pFitnesses, pFitnesses + nrOfFitnesses);
+	m_Generation = pInfo->generation;
+	m_Settings.seed = pInfo->seed;
+	return true;
+}
+
+//=== GeneticTrainer ===
+GeneticTrainer::GeneticTrainer(GenomePool& pool, const std::function<IGeneticWorld*()>& createWorld, int maxNrOfSteps, float stepTime) :
+	m_Pool{ pool },
+	m_CreateWorld{ createWorld },
+	m_MaxNrOfSteps{ maxNrOfSteps },
+	m_StepTime{ stepTime }
+{
+}
+
+GeneticTrainer::~GeneticTrainer()
+{
+	for (IGeneticWorld* pWorld : m_pWorlds)
+		SAFE_DELETE(pWorld);
+}
+
+void GeneticTrainer::Evaluate()
+{
+	ELITE_PROFILE_SCOPE("GeneticTrainer::Evaluate");
+
+	//The population can have changed size by loading a checkpoint
+	const int nrOfGenomes{ m_Pool.GetNrOfGenomes() };
+	const int nrOfInputs{ m_Pool.GetNrOfInputs() };
+	const int nrOfOutputs{ m_Pool.GetNrOfOutputs() };
+	while (static_cast<int>(m_pWorlds.size()) < nrOfGenomes)
+		m_pWorlds.push_back(m_CreateWorld());
+	if (m_Inputs.GetNrOfMatrices() != nrOfGenomes || m_Inputs.GetNrOfRows() != nrOfInputs)
+		m_Inputs.Resize(nrOfInputs, 1, nrOfGenomes);
+	m_InputValues.resize(static_cast<size_t>(nrOfGenomes) * nrOfInputs);
+	m_OutputValues.resize(static_cast<size_t>(nrOfGenomes) * nrOfOutputs);
+	m_IsRunning.assign(nrOfGenomes, 1);
+
+	//A world writes the inputs of its next step right after it stepped, one pass over the worlds per step
+	const auto writeInputs = [this, nrOfInputs](int genome)
+	{
+		float* pInputs{ &m_InputValues[static_cast<size_t>(genome) * nrOfInputs] };
+		m_pWorlds[genome]->GetInputs(pInputs);
+		for (int input = 0; input < nrOfInputs; ++input)
+			m_Inputs.Set(genome, input, 0, pInputs[input]);
+	};
+
+	const unsigned int worldSeed{ GetSeed(m_Pool.GetSettings().seed, RandomStream::World, m_Pool.GetGeneration(), 0) };
+	JOBSYSTEM->ParallelFor(nrOfGenomes, WorldsPerJob, [this, worldSeed, &writeInputs](int begin, int end)
+		{
+			for (int genome = begin; genome < end; ++genome)
+			{
+				m_pWorlds[genome]->Reset(worldSeed);
+				writeInputs(genome);
+			}
+		});
+
+	//Worlds that are done keep their lane in the batch, their outputs are ignored
+	for (int step = 0; step < m_MaxNrOfSteps; ++step)
+	{
+		if (std::find(m_IsRunning.begin(), m_IsRunning.begin() + nrOfGenomes, 1) == m_IsRunning.begin() + nrOfGenomes)
+			break;
+
+		const FMatrixBatch& outputs{ m_Pool.FeedForward(m_Inputs) };
+
+		JOBSYSTEM->ParallelFor(nrOfGenomes, WorldsPerJob, [this, &outputs, &writeInputs, nrOfOutputs](int begin, int end)
+			{
+				for (int genome = begin; genome < end; ++genome)
+				{
+					if (!m_IsRunning[genome])
+						continue;
+
+					float* pOutputs{ &m_OutputValues[static_cast<size_t>(genome) * nrOfOutputs] };
+					for (int output = 0; output < nrOfOutputs; ++output)
+						pOutputs[output] = outputs.Get(genome, output, 0);
+					m_IsRunning[genome] = m_pWorlds[genome]->Step(pOutputs, m_StepTime);
+					if (m_IsRunning[genome])
+						writeInputs(genome);
+				}
+			});
+	}
+
+	for (int genome = 0; genome < nrOfGenomes; ++genome)
+		m_Pool.SetFitness(genome, m_pWorlds[genome]->GetFitness());
+}
+
+GeneticTrainer::GenerationStats GeneticTrainer::RunGeneration()
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	GenerationStats stats{};
+	stats.generation = m_Pool.GetGeneration();
+
+	const auto evaluationStart = Clock::now();
+	Evaluate();
+	const auto evolutionStart = Clock::now();
+	stats.bestFitness = m_Pool.GetFitness(m_Pool.GetBestGenome());
+	stats.averageFitness = m_Pool.GetAverageFitness();
+	m_Pool.Evolve();
+	const auto evolutionEnd = Clock::now();
+
+	stats.evaluationMs = std::chrono::duration<float, std::milli>(evolutionStart - evaluationStart).count();
+	stats.evolutionMs = std::chrono::duration<float, std::milli>(evolutionEnd - evolutionStart).count();
+	return stats;
+}
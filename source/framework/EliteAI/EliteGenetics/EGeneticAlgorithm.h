@@ -0,0 +1,154 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EGeneticAlgorithm.h: evolves a population of neural networks that all share one topology.
+// The weights of every genome live in one FMatrixBatch per layer, so the whole population is fed forward
+// at once. A GeneticTrainer scores the genomes in worlds of their own, stepped in parallel without drawing.
+// Every random number comes from generators seeded per genome and generation, so a run gives the same
+// population on any number of threads and can be picked up again from a checkpoint.
+/*=============================================================================*/
+#ifndef ELITE_GENETIC_ALGORITHM
+#define	ELITE_GENETIC_ALGORITHM
+
+namespace Elite
+{
+	struct GeneticSettings
+	{
+		int populationSize = 1000;
+		int nrOfElites = 2;					//best genomes that go to the next generation unchanged
+		int tournamentSize = 4;				//genomes that compete to become a parent
+		float crossoverRate = 0.7f;			//chance a child mixes two parents instead of copying one
+		float mutationRate = 0.05f;			//chance per weight to be mutated
+		float mutationStrength = 0.3f;		//standard deviation of the gaussian added to a mutated weight
+		float initialWeightRange = 1.f;		//weights start in [-range, range]
+		Activation hiddenActivation = Activation::Sigmoid;
+		Activation outputActivation = Activation::Sigmoid;
+		unsigned int seed = 0;
+	};
+
+	class GenomePool final
+	{
+	public:
+		//topology holds the size of every layer, the inputs first and the outputs last
+		GenomePool(const std::vector<int>& topology, const GeneticSettings& settings);
+		~GenomePool() = default;
+
+		//Random weights for every genome and back to generation 0
+		void Randomize();
+
+		//Feeds inputs[g] through the network of every genome g, in one batched pass per layer.
+		//inputs has GetNrOfInputs() rows. The outputs stay valid until the next call.
+		const FMatrixBatch& FeedForward(const FMatrixBatch& inputs);
+
+		//A single network, to drive an agent with the FMatrix FeedForward
+		void GetLayer(int genome, int layer, FMatrix& weights, FMatrix& bias) const;
+		void SetLayer(int genome, int layer, const FMatrix& weights, const FMatrix& bias);
+
+		void SetFitness(int genome, float fitness) { m_Fitnesses[genome] = fitness; }
+		float GetFitness(int genome) const { return m_Fitnesses[genome]; }
+		int GetBestGenome() const;
+		float GetAverageFitness() const;
+
+		//Replaces the population by the next generation. The elites stay, every other child has the winners
+		//of two tournaments as parents, takes each neuron from one of them and is mutated. Fitnesses go to 0.
+		//Children are made on the job system.
+		void Evolve();
+
+		//Checkpoint of the weights, fitnesses, generation and seed. Loading fails on another topology,
+		//the population takes the size and seed of the checkpoint so a resumed run goes on where it stopped.
+		bool Save(const std::string& path) const;
+		bool Load(const std::string& path);
+
+		//Get - Set
+		const std::vector<int>& GetTopology() const { return m_Topology; }
+		int GetNrOfInputs() const { return m_Topology.front(); }
+		int GetNrOfOutputs() const { return m_Topology.back(); }
+		int GetNrOfLayers() const { return static_cast<int>(m_Weights.size()); }
+		int GetNrOfGenomes() const { return m_Settings.populationSize; }
+		int GetGeneration() const { return m_Generation; }
+		const GeneticSettings& GetSettings() const { return m_Settings; }
+
+	private:
+		std::vector<int> m_Topology{};
+		GeneticSettings m_Settings{};
+		int m_Generation = 0;
+
+		//Per layer, matrix g is the layer of genome g
+		std::vector<FMatrixBatch> m_Weights{};
+		std::vector<FMatrixBatch> m_Biases{};
+		std::vector<FMatrixBatch> m_Outputs{};
+		std::vector<float> m_Fitnesses{};
+
+		//The next generation is made in here and swapped in
+		std::vector<FMatrixBatch> m_NextWeights{};
+		std::vector<FMatrixBatch> m_NextBiases{};
+		std::vector<int> m_Ranking{};
+
+		void Resize(int populationSize);
+		int SelectByTournament(std::mt19937& generator) const;
+		void MakeChild(int child, std::mt19937& generator);
+		void CopyGenome(int from, int to);
+	};
+
+	//A task that scores one genome, like an agent that has to reach a target in a world of its own.
+	//Worlds are stepped in parallel, so they can't touch anything shared: no PHYSICSWORLD, no rand().
+	class IGeneticWorld
+	{
+	public:
+		IGeneticWorld() = default;
+		virtual ~IGeneticWorld() = default;
+
+		//Every genome of a generation gets the same seed, so they are scored on the same task
+		virtual void Reset(unsigned int seed) = 0;
+		//Writes the GetNrOfInputs() inputs of the network
+		virtual void GetInputs(float* pInputs) const = 0;
+		//Applies the GetNrOfOutputs() outputs of the network and advances the world. False once it's done.
+		virtual bool Step(const float* pOutputs, float dt) = 0;
+		virtual float GetFitness() const = 0;
+	};
+
+	class GeneticTrainer final
+	{
+	public:
+		struct GenerationStats
+		{
+			int generation;
+			float bestFitness;
+			float averageFitness;
+			float evaluationMs;
+			float evolutionMs;
+		};
+
+		//createWorld is called once per genome, the trainer deletes the worlds
+		GeneticTrainer(GenomePool& pool, const std::function<IGeneticWorld*()>& createWorld, int maxNrOfSteps, float stepTime);
+		~GeneticTrainer();
+
+		//Runs every world until it's done or maxNrOfSteps is reached and sets the fitnesses in the pool.
+		//All worlds step together: they are split over the job system and share one feed forward per step.
+		void Evaluate();
+		//Evaluate followed by Evolve, returns the stats of the generation that was scored
+		GenerationStats RunGeneration();
+
+	private:
+		GenomePool& m_Pool;
+		std::function<IGeneticWorld*()> m_CreateWorld;
+		std::vector<IGeneticWorld*> m_pWorlds{};
+		int m_MaxNrOfSteps;
+		float m_StepTime;
+
+		//World g reads and writes its own part, so worlds never share a buffer
+		FMatrixBatch m_Inputs{};
+		std::vector<float> m_InputValues{};
+		std::vector<float> m_OutputValues{};
+		std::vector<char> m_IsRunning{};
+
+		GeneticTrainer(const GeneticTrainer&) = delete;
+		GeneticTrainer& operator=(const GeneticTrainer&) = delete;
+	};
+
+	//Trains steering controllers in headless worlds: checks that a run is the same on 1 and on all threads,
+	//that a checkpoint loads back, that fitness goes up and how generation throughput scales with threads.
+	//Writes the results to output and returns false when a check failed. Run with --genetic-benchmark.
+	bool RunGeneticAlgorithmBenchmark(std::ostream& output);
+}
+#endif
@@ -0,0 +1,243 @@
+//=== General Includes ===
+#include "stdafx.h"
+#include "EGeneticAlgorithm.h"
+using namespace Elite;
+
+namespace
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	double GetElapsedMs(const Clock::time_point& start)
+	{
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+	//An agent that has to get to a target and stay there, steered by the network through its acceleration.
+	//The target moves a few times per run, so a genome only scores well when it really seeks.
+	class SeekWorld final : public IGeneticWorld
+	{
+	public:
+		static const int NrOfInputs = 4;	//to the target, velocity
+		static const int NrOfOutputs = 2;	//acceleration
+
+		void Reset(unsigned int seed) override
+		{
+			m_Generator.seed(seed);
+			m_Position = ZeroVector2;
+			m_Velocity = ZeroVector2;
+			m_TotalDistance = 0.f;
+			m_NrOfSteps = 0;
+			PlaceTarget();
+		}
+
+		void GetInputs(float* pInputs) const override
+		{
+			const Vector2 toTarget{ (m_Target - m_Position) / (2.f * WorldSize) };
+			pInputs[0] = toTarget.x;
+			pInputs[1] = toTarget.y;
+			pInputs[2] = m_Velocity.x / MaxSpeed;
+			pInputs[3] = m_Velocity.y / MaxSpeed;
+		}
+
+		bool Step(const float* pOutputs, float dt) override
+		{
+			//Sigmoid outputs, 0.5 is no acceleration
+			const Vector2 acceleration{ (pOutputs[0] * 2.f - 1.f) * MaxAcceleration, (pOutputs[1] * 2.f - 1.f) * MaxAcceleration };
+			m_Velocity += acceleration * dt;
+			if (m_Velocity.MagnitudeSquared() > MaxSpeed * MaxSpeed)
+				m_Velocity = m_Velocity.GetNormalized() * MaxSpeed;
+			m_Position += m_Velocity * dt;
+
+			m_TotalDistance += m_Position.Distance(m_Target);
+			++m_NrOfSteps;
+			if (m_NrOfSteps % StepsPerTarget == 0)
+				PlaceTarget();
+			return true;
+		}
+
+		//Average distance to the target, as a fraction of the world
+		float GetFitness() const override
+		{
+			return m_NrOfSteps > 0 ? -m_TotalDistance / (m_NrOfSteps * WorldSize) : 0.f;
+		}
+
+	private:
+		static constexpr float WorldSize = 20.f;
+		static constexpr float MaxSpeed = 8.f;
+		static constexpr float MaxAcceleration = 16.f;
+		static const int StepsPerTarget = 90;
+
+		std::mt19937 m_Generator{};
+		Vector2 m_Position{};
+		Vector2 m_Velocity{};
+		Vector2 m_Target{};
+		float m_TotalDistance = 0.f;
+		int m_NrOfSteps = 0;
+
+		void PlaceTarget()
+		{
+			std::uniform_real_distribution<float> positionDistribution{ -WorldSize * 0.5f, WorldSize * 0.5f };
+			m_Target.x = positionDistribution(m_Generator);
+			m_Target.y = positionDistribution(m_Generator);
+		}
+	};
+
+	const int NrOfSteps = 270;
+	const float StepTime = 1.f / 30.f;
+
+	const std::vector<int>& GetSeekTopology()
+	{
+		static const std::vector<int> topology{ SeekWorld::NrOfInputs, 8, SeekWorld::NrOfOutputs };
+		return topology;
+	}
+
+	GeneticSettings GetSeekSettings(int populationSize)
+	{
+		GeneticSettings settings{};
+		settings.populationSize = populationSize;
+		settings.seed = 1234;
+		return settings;
+	}
+
+	IGeneticWorld* CreateSeekWorld()
+	{
+		return new SeekWorld();
+	}
+
+	bool IsSamePopulation(const GenomePool& a, const GenomePool& b)
+	{
+		if (a.GetNrOfGenomes() != b.GetNrOfGenomes() || a.GetGeneration() != b.GetGeneration())
+			return false;
+
+		FMatrix weightsA{}, biasA{}, weightsB{}, biasB{};
+		for (int genome = 0; genome < a.GetNrOfGenomes(); ++genome)
+		{
+			if (a.GetFitness(genome) != b.GetFitness(genome))
+				return false;
+
+			for (int layer = 0; layer < a.GetNrOfLayers(); ++layer)
+			{
+				a.GetLayer(genome, layer, weightsA, biasA);
+				b.GetLayer(genome, layer, weightsB, biasB);
+				for (int row = 0; row < weightsA.GetNrOfRows(); ++row)
+				{
+					if (biasA.Get(row, 0) != biasB.Get(row, 0))
+						return false;
+					for (int column = 0; column < weightsA.GetNrOfColumns(); ++column)
+					{
+						if (weightsA.Get(row, column) != weightsB.Get(row, column))
+							return false;
+					}
+				}
+			}
+		}
+		return true;
+	}
+
+	//Trains a fresh population, the fitnesses of the last generation are left in the pool
+	void Train(GenomePool& pool, int nrOfGenerations)
+	{
+		GeneticTrainer trainer{ pool, CreateSeekWorld, NrOfSteps, StepTime };
+		for (int generation = 0; generation < nrOfGenerations; ++generation)
+			trainer.RunGeneration();
+		trainer.Evaluate();
+	}
+
+	const char* CheckpointPath = "genetic_benchmark_checkpoint.bin";
+}
+
+bool Elite::RunGeneticAlgorithmBenchmark(std::ostream& output)
+{
+	bool hasPassed{ true };
+	const auto check = [&](bool isCorrect, const char* description)
+	{
+		output << (isCorrect ? "  ok   " : "  FAIL ") << description << std::endl;
+		hasPassed &= isCorrect;
+	};
+
+	//Oversubscribed on small machines on purpose, the split over threads has to differ from a serial run
+	const unsigned int nrOfWorkers{ JOBSYSTEM->GetNrOfThreads() - 1 };
+	const unsigned int nrOfCheckWorkers{ std::max(nrOfWorkers, 3u) };
+	output << "Genetic algorithm, " << nrOfWorkers + 1 << " threads" << std::endl;
+
+	//=== Checks ===
+	{
+		GenomePool serialPool{ GetSeekTopology(), GetSeekSettings(500) };
+		JOBSYSTEM->SetNrOfWorkers(0);
+		Train(serialPool, 3);
+
+		GenomePool parallelPool{ GetSeekTopology(), GetSeekSettings(500) };
+		JOBSYSTEM->SetNrOfWorkers(nrOfCheckWorkers);
+		Train(parallelPool, 3);
+		check(IsSamePopulation(serialPool, parallelPool), "same population on 1 and on 4+ threads");
+
+		GeneticSettings otherSettings{ GetSeekSettings(10) };
+		otherSettings.seed = 99;
+		GenomePool loadedPool{ GetSeekTopology(), otherSettings };
+		const bool isSaved{ parallelPool.Save(CheckpointPath) };
+		check(isSaved && loadedPool.Load(CheckpointPath) && IsSamePopulation(parallelPool, loadedPool), "checkpoint loads back");
+
+		GenomePool otherTopologyPool{ { SeekWorld::NrOfInputs, 6, SeekWorld::NrOfOutputs }, GetSeekSettings(10) };
+		check(!otherTopologyPool.Load(CheckpointPath) && otherTopologyPool.GetNrOfGenomes() == 10, "checkpoint of another topology is refused");
+		check(!loadedPool.Load("missing_genetic_checkpoint.bin"), "missing checkpoint is refused");
+
+		//A run that picks up a checkpoint goes on as if it never stopped
+		GeneticTrainer continuedTrainer{ parallelPool, CreateSeekWorld, NrOfSteps, StepTime };
+		parallelPool.Evolve();
+		continuedTrainer.Evaluate();
+		loadedPool.Evolve();
+		GeneticTrainer resumedTrainer{ loadedPool, CreateSeekWorld, NrOfSteps, StepTime };
+		resumedTrainer.Evaluate();
+		check(IsSamePopulation(parallelPool, loadedPool), "training resumes from a checkpoint");
+		std::remove(CheckpointPath);
+	}
+
+	//=== Training ===
+	JOBSYSTEM->SetNrOfWorkers(nrOfWorkers);
+	{
+		const int nrOfGenerations{ 30 };
+		GenomePool pool{ GetSeekTopology(), GetSeekSettings(1000) };
+		GeneticTrainer trainer{ pool, CreateSeekWorld, NrOfSteps, StepTime };
+
+		output << "Seek, " << pool.GetNrOfGenomes() << " genomes, " << NrOfSteps << " steps per generation" << std::endl;
+		GeneticTrainer::GenerationStats firstStats{}, lastStats{};
+		for (int generation = 0; generation < nrOfGenerations; ++generation)
+		{
+			lastStats = trainer.RunGeneration();
+			if (generation == 0)
+				firstStats = lastStats;
+			if (generation % 5 == 0 || generation + 1 == nrOfGenerations)
+			{
+				output << "  generation " << lastStats.generation << ": best " << lastStats.bestFitness << ", average " << lastStats.averageFitness
+					<< " (" << lastStats.evaluationMs << " ms evaluation, " << lastStats.evolutionMs << " ms evolution)" << std::endl;
+			}
+		}
+		//Every generation gets other targets, so the best genome is luck as much as skill. The average isn't.
+		check(lastStats.averageFitness > firstStats.averageFitness, "average fitness goes up");
+	}
+
+	//=== Throughput ===
+	{
+		const int nrOfGenerations{ 3 };
+		const auto timeGenerations = [&](unsigned int nrOfTimedWorkers)
+		{
+			JOBSYSTEM->SetNrOfWorkers(nrOfTimedWorkers);
+			GenomePool pool{ GetSeekTopology(), GetSeekSettings(4000) };
+			GeneticTrainer trainer{ pool, CreateSeekWorld, NrOfSteps, StepTime };
+			trainer.RunGeneration(); //warm up, creates the worlds
+
+			const auto start = Clock::now();
+			for (int generation = 0; generation < nrOfGenerations; ++generation)
+				trainer.RunGeneration();
+			return GetElapsedMs(start) / nrOfGenerations;
+		};
+
+		const double serialMs{ timeGenerations(0) };
+		const double parallelMs{ timeGenerations(nrOfWorkers) };
+		output << "4000 genomes: " << serialMs << " ms per generation on 1 thread, " << parallelMs << " ms on " << nrOfWorkers + 1
+			<< " threads (" << serialMs / parallelMs << "x)" << std::endl;
+	}
+
+	output << (hasPassed ? "All checks passed" : "Some checks FAILED") << std::endl;
+	return hasPassed;
+}
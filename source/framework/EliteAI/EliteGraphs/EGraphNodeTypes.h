@@ -97,6 +97,7 @@ namespace Elite
 			: GraphNode2D(index, pos), m_LineIdx(lineIdx){}
 		virtual ~NavGraphNode() = default;
 		int GetLineIndex() const { return m_LineIdx; };
+		void SetLineIndex(int lineIdx) { m_LineIdx = lineIdx; }
 	protected:
 		int m_LineIdx;
 	};
@@ -106,11 +107,24 @@ namespace Elite
 	public:
 		InfluenceNode(int index, Elite::Vector2 pos = { 0,0 }, float influence = 0.f)
 			: GraphNode2D(index, pos), m_Influence(influence) {}
+		//A copy (a cloned graph) doesn't belong to the map of the original
+		InfluenceNode(const InfluenceNode& other)
+			: GraphNode2D(other), m_Influence(other.m_Influence) {}
+		InfluenceNode& operator=(const InfluenceNode& other) { GraphNode2D::operator=(other); SetInfluence(other.m_Influence); return *this; }
 
 		float GetInfluence() const { return m_Influence; }
-		void SetInfluence(float influence) { m_Influence = influence; }
+		//Also tells the influence map that owns the node that its flat copy of the influences is outdated
+		void SetInfluence(float influence)
+		{
+			m_Influence = influence;
+			if (m_pIsMapBufferSynced)
+				*m_pIsMapBufferSynced = false;
+		}
 
 	private:
+		template<class T_GraphType> friend class InfluenceMap;
+
 		float m_Influence;
+		bool* m_pIsMapBufferSynced = nullptr; //set by the influence map, which writes m_Influence directly when it keeps its copy up to date
 	};
 }
\ No newline at end of file
@@ -0,0 +1,156 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EGraphObjectPool.h: slab storage for the nodes and connections owned by a graph.
+// Objects never move, so pointers handed out stay valid until they are destroyed.
+// Freed slots are reused through a free list that lives inside the slots themselves.
+/*=============================================================================*/
+#pragma once
+
+#include <type_traits>
+#include <new>
+
+namespace Elite
+{
+	template<class T>
+	class GraphObjectPool final
+	{
+	public:
+		explicit GraphObjectPool(size_t minSlabSize = 256) : m_MinSlabSize{ minSlabSize } {}
+		~GraphObjectPool() { ReleaseAll(); }
+
+		GraphObjectPool(const GraphObjectPool& other) = delete;
+		GraphObjectPool& operator=(const GraphObjectPool& other) = delete;
+		GraphObjectPool(GraphObjectPool&& other) = delete;
+		GraphObjectPool& operator=(GraphObjectPool&& other) = delete;
+
+		template<class... Args>
+		T* Create(Args&&... args);
+		void Destroy(T* pObject);
+
+		// True when pObject lives in one of the slabs of this pool
+		bool Owns(const T* pObject) const;
+
+		// Makes sure count more objects fit without allocating again
+		void Reserve(size_t count);
+
+		// Frees all slabs at once. Objects that are still alive are not destructed.
+		void ReleaseAll();
+
+		size_t GetNrOfObjects() const { return m_NrOfObjects; }
+		size_t GetCapacity() const { return m_Capacity; }
+
+	private:
+		using Slot = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+		static_assert(sizeof(Slot) >= sizeof(void*), "A free slot has to fit the free list pointer");
+
+		struct Slab
+		{
+			Slot* pBegin;
+			Slot* pEnd;
+		};
+
+		void AddSlab(size_t nrOfSlots);
+
+		std::vector<Slab> m_Slabs{};	// sorted on address, for Owns
+		Slot* m_pNext = nullptr;		// first unused slot of the newest slab
+		Slot* m_pEnd = nullptr;
+		void* m_pFreeList = nullptr;
+		size_t m_NrOfFreeSlots = 0;
+		size_t m_NrOfObjects = 0;
+		size_t m_Capacity = 0;
+		size_t m_MinSlabSize;
+	};
+
+	template<class T>
+	template<class... Args>
+	inline T* GraphObjectPool<T>::Create(Args&&... args)
+	{
+		void* pSlot{ nullptr };
+		if (m_pFreeList)
+		{
+			pSlot = m_pFreeList;
+			m_pFreeList = *static_cast<void**>(m_pFreeList);
+			--m_NrOfFreeSlots;
+		}
+		else
+		{
+			if (m_pNext == m_pEnd)
+				AddSlab(std::max(m_MinSlabSize, m_Capacity)); // grows geometrically, so Owns stays cheap
+			pSlot = m_pNext++;
+		}
+
+		T* pObject{ new (pSlot) T(std::forward<Args>(args)...) };
+		++m_NrOfObjects;
+		return pObject;
+	}
+
+	template<class T>
+	inline void GraphObjectPool<T>::Destroy(T* pObject)
+	{
+		assert(Owns(pObject) && "<GraphObjectPool::Destroy>: object is not part of this pool");
+
+		pObject->~T();
+		*reinterpret_cast<void**>(pObject) = m_pFreeList;
+		m_pFreeList = pObject;
+		++m_NrOfFreeSlots;
+		--m_NrOfObjects;
+	}
+
+	template<class T>
+	inline bool GraphObjectPool<T>::Owns(const T* pObject) const
+	{
+		const auto address = reinterpret_cast<uintptr_t>(pObject);
+		auto it = std::upper_bound(m_Slabs.begin(), m_Slabs.end(), address,
+			[](uintptr_t a, const Slab& slab) { return a < reinterpret_cast<uintptr_t>(slab.pBegin); });
+		if (it == m_Slabs.begin())
+			return false;
+
+		--it;
+		return address < reinterpret_cast<uintptr_t>(it->pEnd);
+	}
+
+	template<class T>
+	inline void GraphObjectPool<T>::Reserve(size_t count)
+	{
+		const size_t nrOfAvailableSlots{ static_cast<size_t>(m_pEnd - m_pNext) + m_NrOfFreeSlots };
+		if (nrOfAvailableSlots < count)
+			AddSlab(std::max(m_MinSlabSize, count - nrOfAvailableSlots));
+	}
+
+	template<class T>
+	inline void GraphObjectPool<T>::ReleaseAll()
+	{
+		for (const Slab& slab : m_Slabs)
+			delete[] slab.pBegin;
+		m_Slabs.clear();
+
+		m_pNext = nullptr;
+		m_pEnd = nullptr;
+		m_pFreeList = nullptr;
+		m_NrOfFreeSlots = 0;
+		m_NrOfObjects = 0;
+		m_Capacity = 0;
+	}
+
+	template<class T>
+	inline void GraphObjectPool<T>::AddSlab(size_t nrOfSlots)
+	{
+		// What is left of the current slab goes to the free list, so Reserve can hand out a fresh slab
+		for (; m_pNext != m_pEnd; ++m_pNext)
+		{
+			*reinterpret_cast<void**>(m_pNext) = m_pFreeList;
+			m_pFreeList = m_pNext;
+			++m_NrOfFreeSlots;
+		}
+
+		Slot* pSlots{ new Slot[nrOfSlots] };
+		const Slab newSlab{ pSlots, pSlots + nrOfSlots };
+		m_Slabs.insert(std::upper_bound(m_Slabs.begin(), m_Slabs.end(), newSlab,
+			[](const Slab& a, const Slab& b) { return reinterpret_cast<uintptr_t>(a.pBegin) < reinterpret_cast<uintptr_t>(b.pBegin); }), newSlab);
+
+		m_pNext = newSlab.pBegin;
+		m_pEnd = newSlab.pEnd;
+		m_Capacity += nrOfSlots;
+	}
+}
@@ -0,0 +1,134 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EGraphSerialization.h: binary layout of graph files (see EBinaryFile.h).
+// Connections are sorted on their from node and found through one offset per node,
+// so a mapped file can be searched in place without building a graph from it.
+/*=============================================================================*/
+#pragma once
+
+#include "EGraphNodeTypes.h"
+#include "EGraphConnectionTypes.h"
+
+namespace Elite
+{
+	const uint32_t GraphFileMagic = MakeFourCC('E', 'G', 'R', 'F');
+	const uint32_t GraphFileVersion = 1;
+
+	namespace GraphFileSection
+	{
+		// IGraph
+		const uint32_t Info = MakeFourCC('G', 'I', 'N', 'F');					// GraphFileInfo, 1
+		const uint32_t Nodes = MakeFourCC('G', 'N', 'O', 'D');					// GraphFileNode per node slot
+		const uint32_t ConnectionOffsets = MakeFourCC('G', 'C', 'O', 'F');		// int per connection list + 1
+		const uint32_t Connections = MakeFourCC('G', 'C', 'O', 'N');			// GraphFileConnection
+		// GridGraph
+		const uint32_t Grid = MakeFourCC('G', 'G', 'R', 'D');					// GridGraphFileInfo, 1
+		const uint32_t BlockedCells = MakeFourCC('G', 'B', 'L', 'K');			// bit per cell
+		const uint32_t CellCosts = MakeFourCC('G', 'C', 'C', 'S');				// float per cell
+		const uint32_t ExplicitLists = MakeFourCC('G', 'X', 'L', 'S');			// GridGraphFileList per edited node
+		const uint32_t ExplicitConnections = MakeFourCC('G', 'X', 'C', 'N');	// GraphFileConnection
+	}
+
+	struct GraphFileInfo
+	{
+		int nrOfNodes;
+		int nrOfConnectionLists;
+		int nextNodeIndex;
+		int isDirectional;
+		int nodeSize;			// sizeof the node and connection types, a file only loads into the graph type that saved it
+		int connectionSize;
+	};
+
+	// Union of what the node types store
+	struct GraphFileNode
+	{
+		int index;
+		int lineIndex;
+		int terrainType;
+		float influence;
+		Vector2 position;
+	};
+
+	struct GraphFileConnection
+	{
+		int from;
+		int to;
+		float cost;
+	};
+
+	struct GridGraphFileInfo
+	{
+		int columns;
+		int rows;
+		int cellSize;
+		int isConnectedDiagonally;
+		int isImplicit;
+		float costStraight;
+		float costDiagonal;
+	};
+
+	struct GridGraphFileList
+	{
+		int nodeIdx;
+		int firstConnection;
+		int nrOfConnections;
+	};
+
+	// Node data per node type, overload resolution picks the most derived one
+	inline void WriteGraphFileNode(const GraphNode& node, GraphFileNode& data)
+	{
+		data = GraphFileNode{ node.GetIndex(), 0, 0, 0.f, ZeroVector2 };
+	}
+
+	inline void WriteGraphFileNode(const GraphNode2D& node, GraphFileNode& data)
+	{
+		WriteGraphFileNode(static_cast<const GraphNode&>(node), data);
+		data.position = node.GetPosition();
+	}
+
+	inline void WriteGraphFileNode(const GridTerrainNode& node, GraphFileNode& data)
+	{
+		WriteGraphFileNode(static_cast<const GraphNode&>(node), data);
+		data.terrainType = int(node.GetTerrainType());
+	}
+
+	inline void WriteGraphFileNode(const NavGraphNode& node, GraphFileNode& data)
+	{
+		WriteGraphFileNode(static_cast<const GraphNode2D&>(node), data);
+		data.lineIndex = node.GetLineIndex();
+	}
+
+	inline void WriteGraphFileNode(const InfluenceNode& node, GraphFileNode& data)
+	{
+		WriteGraphFileNode(static_cast<const GraphNode2D&>(node), data);
+		data.influence = node.GetInfluence();
+	}
+
+	// The node is created with its index, these set the rest
+	inline void ReadGraphFileNode(const GraphFileNode& data, GraphNode& node)
+	{
+	}
+
+	inline void ReadGraphFileNode(const GraphFileNode& data, GraphNode2D& node)
+	{
+		node.SetPosition(data.position);
+	}
+
+	inline void ReadGraphFileNode(const GraphFileNode& data, GridTerrainNode& node)
+	{
+		node.SetTerrainType(TerrainType(data.terrainType));
+	}
+
+	inline void ReadGraphFileNode(const GraphFileNode& data, NavGraphNode& node)
+	{
+		ReadGraphFileNode(data, static_cast<GraphNode2D&>(node));
+		node.SetLineIndex(data.lineIndex);
+	}
+
+	inline void ReadGraphFileNode(const GraphFileNode& data, InfluenceNode& node)
+	{
+		ReadGraphFileNode(data, static_cast<GraphNode2D&>(node));
+		node.SetInfluence(data.influence);
+	}
+}
@@ -18,15 +18,61 @@ namespace Elite
 	public:
 		GridGraph(bool isDirectional);
 		GridGraph(int columns, int rows, int cellSize, bool isDirectionalGraph, bool isConnectedDiagonally, float costStraight = 1.f, float costDiagonal = 1.5);
+		GridGraph(const GridGraph& other);
+		virtual ~GridGraph();
 		void InitializeGrid(int columns, int rows, int cellSize, bool isDirectionalGraph, bool isConnectedDiagonally, float costStraight = 1.f, float costDiagonal = 1.5);
+		virtual std::shared_ptr<IGraph<T_NodeType, T_ConnectionType>> Clone() const override;
+
+		// Implicit connectivity: no connection objects are stored, the neighbors of a cell follow from the grid size,
+		// the blocked cells and the cell costs and are generated each time they are asked for.
+		// Only nodes whose connections are edited, or handed out as pointers through GetNodeConnections(idx)
+		// or GetConnection, get an explicit list. Searches use GetNodeConnections(idx, buffer), which stores nothing.
+		void InitializeImplicitGrid(int columns, int rows, int cellSize, bool isConnectedDiagonally, float costStraight = 1.f, float costDiagonal = 1.5);
+		bool IsImplicit() const { return m_IsImplicit; }
+		// Implicit grids only: nothing is blocked, every cell cost is 1 and no node has an explicit list,
+		// so every cell is connected to all of its neighbors with the default costs
+		bool IsUnmodifiedImplicitGrid() const;
+
+		// Implicit grids only. A blocked cell has no connections and can't be entered,
+		// unblocking it connects it to its neighbors again, also those with an explicit list.
+		void SetCellBlocked(int idx, bool isBlocked);
+		bool IsCellBlocked(int idx) const { return m_IsImplicit && ((m_BlockedCells[idx >> 6] >> (idx & 63)) & 1ull) != 0; }
+		// Scales the cost of the connections of a cell, a connection costs the average of both cells (like TerrainType).
+		// Explicit lists are updated too, an edited cost of a connection to or from the cell is replaced.
+		void SetCellCost(int idx, float cost);
+		float GetCellCost(int idx) const { return m_CellCosts[idx]; }
+		// The node follows the grid again
+		void ResetNodeConnections(int idx);
+
+		virtual void Clear() override;
 
 		using IGraph::GetNode;
 		T_NodeType* GetNode(int col, int row) const { return m_Nodes[GetIndex(col, row)]; }
-		const ConnectionList& GetConnections(const T_NodeType& node) const { return m_Connections[node.GetIndex()]; }
-		const ConnectionList& GetConnections(int idx) const { return m_Connections[idx]; }
+		const ConnectionList& GetConnections(const T_NodeType& node) const { return GetNodeConnections(node.GetIndex()); }
+		const ConnectionList& GetConnections(int idx) const { return GetNodeConnections(idx); }
+
+		// On an implicit grid this gives the node an explicit list, so the pointers stay valid. Not for concurrent use.
+		using IGraph::GetNodeConnections;
+		virtual const ConnectionList& GetNodeConnections(int idx) const override;
+		// On an implicit grid the list of a node without an explicit list is generated into the buffer
+		virtual const ConnectionList& GetNodeConnections(int idx, ConnectionBuffer& buffer) const override;
+		// Implicit grids store no lists per node, loop over the nodes with GetNodeConnections(idx, buffer) instead
+		virtual const ConnectionListVector& GetAllConnections() const override;
+
+		virtual void RemoveNode(int idx) override;
+		virtual void AddConnection(T_ConnectionType* pConnection) override;
+		using IGraph::RemoveConnection;
+		virtual void RemoveConnection(int from, int to) override;
+		virtual void RemoveConnectionsToAdjacentNodes(int idx) override;
+		virtual void SetConnectionCost(int from, int to, float cost) override;
 
 		int GetRows() const { return m_NrOfRows; }
 		int GetColumns() const { return m_NrOfColumns; }
+		int GetCellSize() const { return m_CellSize; }
+
+		bool IsConnectedDiagonally() const { return m_IsConnectedDiagonally; }
+		float GetDefaultCostStraight() const { return m_DefaultCostStraight; }
+		float GetDefaultCostDiagonal() const { return m_DefaultCostDiagonal; }
 
 		bool IsWithinBounds(int col, int row) const;
 		int GetIndex(int col, int row) const { return row * m_NrOfColumns + col; }
@@ -44,6 +90,11 @@ namespace Elite
 
 		void AddConnectionsToAdjacentCells(int col, int row);
 		void AddConnectionsToAdjacentCells(int idx);
+
+	protected:
+		virtual void WriteSections(BinaryFileWriter& writer) const override;
+		virtual bool ReadSections(const BinaryFileReader& reader) override;
+
 	private:
 		
 		int m_NrOfColumns;
@@ -57,10 +108,24 @@ namespace Elite
 		const std::vector<Vector2> m_StraightDirections = { { 1, 0 }, { 0, 1 }, { -1, 0 }, { 0, -1 } };
 		const std::vector<Vector2> m_DiagonalDirections = { { 1, 1 }, { -1, 1 }, { -1, -1 }, { 1, -1 } };
 
+		// implicit connectivity
+		bool m_IsImplicit = false;
+		std::vector<unsigned long long> m_BlockedCells{};	// one bit per cell
+		std::vector<float> m_CellCosts{};
+		std::unordered_map<int, ConnectionList> m_ExplicitConnections{};	// nodes with edited connections
+
 		// graph creation helper functions
-		void AddConnectionsInDirections(int idx, int col, int row, std::vector<Vector2> directions);
+		void AddConnectionsInDirections(int idx, int col, int row, const std::vector<Vector2>& directions);
 
 		float CalculateConnectionCost(int fromIdx, int toIdx) const;
+		float GetTerrainCost(int idx) const { return 1.f; }
+
+		float CalculateImplicitConnectionCost(int fromIdx, int toIdx) const;
+		// Writes the implicit connections of idx to pConnections (room for 8), returns how many there are
+		int GenerateConnections(int idx, T_ConnectionType* pConnections) const;
+		// The explicit list of idx, made from the implicit connections the first time
+		ConnectionList& GetExplicitConnections(int idx);
+		void ClearExplicitConnections();
 	
 		friend class GraphRenderer;
 	};
@@ -97,6 +162,34 @@ namespace Elite
 		InitializeGrid(columns, rows, cellSize, isDirectionalGraph, isConnectedDiagonally, costStraight, costDiagonal);
 	}
 
+	template<class T_NodeType, class T_ConnectionType>
+	inline GridGraph<T_NodeType, T_ConnectionType>::GridGraph(const GridGraph& other)
+		: IGraph(other)
+		, m_NrOfColumns(other.m_NrOfColumns)
+		, m_NrOfRows(other.m_NrOfRows)
+		, m_CellSize(other.m_CellSize)
+		, m_IsConnectedDiagonally(other.m_IsConnectedDiagonally)
+		, m_DefaultCostStraight(other.m_DefaultCostStraight)
+		, m_DefaultCostDiagonal(other.m_DefaultCostDiagonal)
+		, m_IsImplicit(other.m_IsImplicit)
+		, m_BlockedCells(other.m_BlockedCells)
+		, m_CellCosts(other.m_CellCosts)
+	{
+		for (const auto& explicitConnections : other.m_ExplicitConnections)
+		{
+			ConnectionList& connections{ m_ExplicitConnections[explicitConnections.first] };
+			connections.reserve(explicitConnections.second.size());
+			for (auto c : explicitConnections.second)
+				connections.push_back(CreateConnection(*c));
+		}
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline GridGraph<T_NodeType, T_ConnectionType>::~GridGraph()
+	{
+		ClearExplicitConnections();
+	}
+
 	template<class T_NodeType, class T_ConnectionType>
 	inline void GridGraph<T_NodeType, T_ConnectionType>::InitializeGrid(
 		int columns, 
@@ -115,13 +208,20 @@ namespace Elite
 		m_DefaultCostStraight = costStraight;
 		m_DefaultCostDiagonal = costDiagonal;
 
+		// Every node and connection of the grid goes into one slab per type
+		const int nrOfStraightConnections{ 2 * (m_NrOfColumns - 1) * m_NrOfRows + 2 * m_NrOfColumns * (m_NrOfRows - 1) };
+		const int nrOfDiagonalConnections{ m_IsConnectedDiagonally ? 4 * (m_NrOfColumns - 1) * (m_NrOfRows - 1) : 0 };
+		Reserve(m_NrOfColumns * m_NrOfRows, std::max(nrOfStraightConnections + nrOfDiagonalConnections, 0));
+		const size_t maxNrOfConnectionsPerNode{ m_IsConnectedDiagonally ? m_StraightDirections.size() + m_DiagonalDirections.size() : m_StraightDirections.size() };
+
 		// Create all nodes
 		for (auto r = 0; r < m_NrOfRows; ++r)
 		{
 			for (auto c = 0; c < m_NrOfColumns; ++c)
 			{
 				int idx = GetIndex(c, r);
-				AddNode(new T_NodeType(idx));
+				AddNode(CreateNode(idx));
+				m_Connections[idx].reserve(maxNrOfConnectionsPerNode);
 			}
 		}
 
@@ -135,6 +235,505 @@ namespace Elite
 		}
 	}
 
+	template<class T_NodeType, class T_ConnectionType>
+	inline void GridGraph<T_NodeType, T_ConnectionType>::InitializeImplicitGrid(
+		int columns,
+		int rows,
+		int cellSize,
+		bool isConnectedDiagonally,
+		float costStraight /* = 1.f*/,
+		float costDiagonal /* = 1.5f */)
+	{
+		Clear();
+
+		m_IsImplicit = true;
+		m_IsDirectionalGraph = false;
+		m_NrOfColumns = columns;
+		m_NrOfRows = rows;
+		m_CellSize = cellSize;
+		m_IsConnectedDiagonally = isConnectedDiagonally;
+		m_DefaultCostStraight = costStraight;
+		m_DefaultCostDiagonal = costDiagonal;
+
+		// Nodes only, in one slab. No connection lists at all.
+		const int nrOfCells{ columns * rows };
+		Reserve(nrOfCells, 0);
+		for (int idx = 0; idx < nrOfCells; ++idx)
+			m_Nodes.push_back(CreateNode(idx));
+		SetNextNodeIndex(nrOfCells);
+
+		m_BlockedCells.assign((nrOfCells + 63) / 64, 0);
+		m_CellCosts.assign(nrOfCells, 1.f);
+
+		OnGraphModified(true, true);
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline bool GridGraph<T_NodeType, T_ConnectionType>::IsUnmodifiedImplicitGrid() const
+	{
+		if (!m_IsImplicit || !m_ExplicitConnections.empty())
+			return false;
+
+		return std::all_of(m_BlockedCells.begin(), m_BlockedCells.end(), [](unsigned long long blockedCells) { return blockedCells == 0; })
+			&& std::all_of(m_CellCosts.begin(), m_CellCosts.end(), [](float cost) { return cost == 1.f; });
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline void GridGraph<T_NodeType, T_ConnectionType>::SetCellBlocked(int idx, bool isBlocked)
+	{
+		assert(m_IsImplicit && "<GridGraph::SetCellBlocked>: only implicit grids have blocked cells");
+
+		if (isBlocked)
+		{
+			m_BlockedCells[idx >> 6] |= 1ull << (idx & 63);
+
+			// Edited nodes keep their own list, take this cell out of those as well
+			ResetNodeConnections(idx);
+			for (auto& explicitConnections : m_ExplicitConnections)
+			{
+				ConnectionList& connections{ explicitConnections.second };
+				for (auto it = connections.begin(); it != connections.end();)
+				{
+					if ((*it)->GetTo() == idx)
+					{
+						DestroyConnection(*it);
+						it = connections.erase(it);
+					}
+					else
+						++it;
+				}
+			}
+		}
+		else if (IsCellBlocked(idx))
+		{
+			m_BlockedCells[idx >> 6] &= ~(1ull << (idx & 63));
+
+			// Neighbors without a list generate the connection to this cell again, the others get it back here
+			const int col{ idx % m_NrOfColumns };
+			const int row{ idx / m_NrOfColumns };
+			const auto restoreConnections = [&](const std::vector<Vector2>& directions)
+			{
+				for (const Vector2& d : directions)
+				{
+					const int neighborCol{ col + (int)d.x };
+					const int neighborRow{ row + (int)d.y };
+					if (!IsWithinBounds(neighborCol, neighborRow))
+						continue;
+
+					auto foundIt = m_ExplicitConnections.find(GetIndex(neighborCol, neighborRow));
+					if (foundIt == m_ExplicitConnections.end())
+						continue;
+
+					ConnectionList& connections{ foundIt->second };
+					if (std::any_of(connections.begin(), connections.end(), [idx](T_ConnectionType* c) { return c->GetTo() == idx; }))
+						continue;
+
+					T_ConnectionType generated[8];
+					const int nrOfConnections{ GenerateConnections(foundIt->first, generated) };
+					for (int i = 0; i < nrOfConnections; ++i)
+					{
+						if (generated[i].GetTo() == idx)
+							connections.push_back(CreateConnection(generated[i]));
+					}
+				}
+			};
+
+			restoreConnections(m_StraightDirections);
+			if (m_IsConnectedDiagonally)
+				restoreConnections(m_DiagonalDirections);
+		}
+
+		OnGraphModified(false, true);
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline void GridGraph<T_NodeType, T_ConnectionType>::SetCellCost(int idx, float cost)
+	{
+		m_CellCosts[idx] = cost;
+
+		// Generated connections pick the cost up by themselves, stored ones between grid neighbors are recalculated
+		const int col{ idx % m_NrOfColumns };
+		const int row{ idx / m_NrOfColumns };
+		const auto isNeighbor = [&](int otherIdx)
+		{
+			return std::abs(otherIdx % m_NrOfColumns - col) <= 1 && std::abs(otherIdx / m_NrOfColumns - row) <= 1;
+		};
+		for (int neighborRow = row - 1; neighborRow <= row + 1; ++neighborRow)
+		{
+			for (int neighborCol = col - 1; neighborCol <= col + 1; ++neighborCol)
+			{
+				if (!IsWithinBounds(neighborCol, neighborRow))
+					continue;
+
+				const int neighborIdx{ GetIndex(neighborCol, neighborRow) };
+				auto foundIt = m_ExplicitConnections.find(neighborIdx);
+				if (foundIt == m_ExplicitConnections.end())
+					continue;
+
+				for (auto c : foundIt->second)
+				{
+					if (neighborIdx == idx ? isNeighbor(c->GetTo()) : c->GetTo() == idx)
+						c->SetCost(CalculateImplicitConnectionCost(c->GetFrom(), c->GetTo()));
+				}
+			}
+		}
+
+		OnGraphModified(false, true);
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline void GridGraph<T_NodeType, T_ConnectionType>::ResetNodeConnections(int idx)
+	{
+		auto foundIt = m_ExplicitConnections.find(idx);
+		if (foundIt == m_ExplicitConnections.end())
+			return;
+
+		for (auto c : foundIt->second)
+			DestroyConnection(c);
+		m_ExplicitConnections.erase(foundIt);
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline void GridGraph<T_NodeType, T_ConnectionType>::Clear()
+	{
+		// The explicit lists point into the connection pool, they go before the pool is released
+		ClearExplicitConnections();
+		m_IsImplicit = false;
+		m_BlockedCells.clear();
+		m_CellCosts.clear();
+
+		IGraph::Clear();
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline void GridGraph<T_NodeType, T_ConnectionType>::ClearExplicitConnections()
+	{
+		for (auto& explicitConnections : m_ExplicitConnections)
+		{
+			for (auto c : explicitConnections.second)
+				DestroyConnection(c);
+		}
+		m_ExplicitConnections.clear();
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline const typename IGraph<T_NodeType, T_ConnectionType>::ConnectionList& GridGraph<T_NodeType, T_ConnectionType>::GetNodeConnections(int idx) const
+	{
+		if (!m_IsImplicit)
+			return IGraph::GetNodeConnections(idx);
+
+		// The caller may keep the pointers, so they have to live in the graph
+		return const_cast<GridGraph*>(this)->GetExplicitConnections(idx);
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline const typename IGraph<T_NodeType, T_ConnectionType>::ConnectionList& GridGraph<T_NodeType, T_ConnectionType>::GetNodeConnections(int idx, ConnectionBuffer& buffer) const
+	{
+		if (!m_IsImplicit)
+			return IGraph::GetNodeConnections(idx);
+
+		auto foundIt = m_ExplicitConnections.find(idx);
+		if (foundIt != m_ExplicitConnections.end())
+			return foundIt->second;
+
+		// Sized once, so the pointers below don't move while they are written
+		if (buffer.connections.size() < 8)
+			buffer.connections.resize(8);
+
+		const int nrOfConnections{ GenerateConnections(idx, buffer.connections.data()) };
+		buffer.pConnections.clear();
+		for (int i = 0; i < nrOfConnections; ++i)
+			buffer.pConnections.push_back(&buffer.connections[i]);
+
+		return buffer.pConnections;
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline const typename IGraph<T_NodeType, T_ConnectionType>::ConnectionListVector& GridGraph<T_NodeType, T_ConnectionType>::GetAllConnections() const
+	{
+		assert(!m_IsImplicit && "<GridGraph::GetAllConnections>: implicit grids store no lists, use GetNodeConnections(idx, buffer)");
+
+		// Empty on an implicit grid
+		return IGraph::GetAllConnections();
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline int GridGraph<T_NodeType, T_ConnectionType>::GenerateConnections(int idx, T_ConnectionType* pConnections) const
+	{
+		if (IsCellBlocked(idx))
+			return 0;
+
+		const int col{ idx % m_NrOfColumns };
+		const int row{ idx / m_NrOfColumns };
+		int nrOfConnections{ 0 };
+
+		const auto addConnections = [&](const std::vector<Vector2>& directions)
+		{
+			for (const Vector2& d : directions)
+			{
+				const int neighborCol{ col + (int)d.x };
+				const int neighborRow{ row + (int)d.y };
+				if (!IsWithinBounds(neighborCol, neighborRow))
+					continue;
+
+				const int neighborIdx{ GetIndex(neighborCol, neighborRow) };
+				if (IsCellBlocked(neighborIdx))
+					continue;
+
+				const float connectionCost{ CalculateImplicitConnectionCost(idx, neighborIdx) };
+				if (connectionCost >= 100000) //Same cut off as the explicit grid, for the different terrain types
+					continue;
+
+				T_ConnectionType& connection{ pConnections[nrOfConnections++] };
+				connection.SetFrom(idx);
+				connection.SetTo(neighborIdx);
+				connection.SetCost(connectionCost);
+			}
+		};
+
+		addConnections(m_StraightDirections);
+		if (m_IsConnectedDiagonally)
+			addConnections(m_DiagonalDirections);
+
+		return nrOfConnections;
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline float GridGraph<T_NodeType, T_ConnectionType>::CalculateImplicitConnectionCost(int fromIdx, int toIdx) const
+	{
+		const bool isDiagonal{ fromIdx % m_NrOfColumns != toIdx % m_NrOfColumns && fromIdx / m_NrOfColumns != toIdx / m_NrOfColumns };
+		const float cost{ isDiagonal ? m_DefaultCostDiagonal : m_DefaultCostStraight };
+		return cost * (m_CellCosts[fromIdx] + m_CellCosts[toIdx]) / 2.0f;
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline typename IGraph<T_NodeType, T_ConnectionType>::ConnectionList& GridGraph<T_NodeType, T_ConnectionType>::GetExplicitConnections(int idx)
+	{
+		auto foundIt = m_ExplicitConnections.find(idx);
+		if (foundIt != m_ExplicitConnections.end())
+			return foundIt->second;
+
+		T_ConnectionType generated[8];
+		const int nrOfConnections{ GenerateConnections(idx, generated) };
+
+		ConnectionList& connections{ m_ExplicitConnections[idx] };
+		connections.reserve(8);
+		for (int i = 0; i < nrOfConnections; ++i)
+			connections.push_back(CreateConnection(generated[i]));
+		return connections;
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline void GridGraph<T_NodeType, T_ConnectionType>::RemoveNode(int idx)
+	{
+		if (!m_IsImplicit)
+		{
+			IGraph::RemoveNode(idx);
+			return;
+		}
+
+		m_Nodes[idx]->SetIndex(invalid_node_index);
+		SetCellBlocked(idx, true);
+		OnGraphModified(true, true);
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline void GridGraph<T_NodeType, T_ConnectionType>::AddConnection(T_ConnectionType* pConnection)
+	{
+		if (!m_IsImplicit)
+		{
+			IGraph::AddConnection(pConnection);
+			return;
+		}
+
+		const int from{ pConnection->GetFrom() };
+		const int to{ pConnection->GetTo() };
+		ConnectionList& fromConnections{ GetExplicitConnections(from) };
+		assert(std::none_of(fromConnections.begin(), fromConnections.end(), [to](T_ConnectionType* c) { return c->GetTo() == to; })
+			&& "Connection already exists on this graph");
+		fromConnections.push_back(pConnection);
+
+		ConnectionList& toConnections{ GetExplicitConnections(to) };
+		if (std::none_of(toConnections.begin(), toConnections.end(), [from](T_ConnectionType* c) { return c->GetTo() == from; }))
+			toConnections.push_back(CreateConnection(to, from, pConnection->GetCost()));
+
+		OnGraphModified(false, true);
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline void GridGraph<T_NodeType, T_ConnectionType>::RemoveConnection(int from, int to)
+	{
+		if (!m_IsImplicit)
+		{
+			IGraph::RemoveConnection(from, to);
+			return;
+		}
+
+		const auto removeConnection = [this](int from, int to)
+		{
+			ConnectionList& connections{ GetExplicitConnections(from) };
+			auto foundIt = std::find_if(connections.begin(), connections.end(), [to](T_ConnectionType* c) { return c->GetTo() == to; });
+			if (foundIt != connections.end())
+			{
+				DestroyConnection(*foundIt);
+				connections.erase(foundIt);
+			}
+		};
+
+		removeConnection(from, to);
+		removeConnection(to, from);
+
+		OnGraphModified(false, true);
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline void GridGraph<T_NodeType, T_ConnectionType>::RemoveConnectionsToAdjacentNodes(int idx)
+	{
+		if (!m_IsImplicit)
+		{
+			IGraph::RemoveConnectionsToAdjacentNodes(idx);
+			return;
+		}
+
+		SetCellBlocked(idx, true);
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline void GridGraph<T_NodeType, T_ConnectionType>::SetConnectionCost(int from, int to, float cost)
+	{
+		if (!m_IsImplicit)
+		{
+			IGraph::SetConnectionCost(from, to, cost);
+			return;
+		}
+
+		for (auto pConnection : GetExplicitConnections(from))
+		{
+			if (pConnection->GetTo() == to)
+			{
+				pConnection->SetCost(cost);
+				break;
+			}
+		}
+
+		OnGraphModified(false, true);
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline void GridGraph<T_NodeType, T_ConnectionType>::WriteSections(BinaryFileWriter& writer) const
+	{
+		IGraph::WriteSections(writer);
+
+		const GridGraphFileInfo info{ m_NrOfColumns, m_NrOfRows, m_CellSize, m_IsConnectedDiagonally ? 1 : 0, m_IsImplicit ? 1 : 0,
+			m_DefaultCostStraight, m_DefaultCostDiagonal };
+		writer.AddSection(GraphFileSection::Grid, &info, 1);
+
+		if (!m_IsImplicit)
+			return;
+
+		writer.AddSection(GraphFileSection::BlockedCells, m_BlockedCells);
+		writer.AddSection(GraphFileSection::CellCosts, m_CellCosts);
+
+		// Sorted, so the same grid always gives the same file
+		std::vector<int> editedNodes{};
+		editedNodes.reserve(m_ExplicitConnections.size());
+		for (const auto& explicitConnections : m_ExplicitConnections)
+			editedNodes.push_back(explicitConnections.first);
+		std::sort(editedNodes.begin(), editedNodes.end());
+
+		std::vector<GridGraphFileList> lists{};
+		lists.reserve(editedNodes.size());
+		std::vector<GraphFileConnection> connections{};
+		for (int idx : editedNodes)
+		{
+			const ConnectionList& connectionList{ m_ExplicitConnections.at(idx) };
+			lists.push_back(GridGraphFileList{ idx, (int)connections.size(), (int)connectionList.size() });
+			for (auto c : connectionList)
+				connections.push_back(GraphFileConnection{ c->GetFrom(), c->GetTo(), c->GetCost() });
+		}
+		writer.AddSection(GraphFileSection::ExplicitLists, lists);
+		writer.AddSection(GraphFileSection::ExplicitConnections, connections);
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline bool GridGraph<T_NodeType, T_ConnectionType>::ReadSections(const BinaryFileReader& reader)
+	{
+		size_t nrOfInfos{}, nrOfNodes{};
+		const GridGraphFileInfo* pInfo{ reader.GetSection<GridGraphFileInfo>(GraphFileSection::Grid, nrOfInfos) };
+		reader.GetSection<GraphFileNode>(GraphFileSection::Nodes, nrOfNodes);
+		if (nrOfInfos != 1 || pInfo->columns < 0 || pInfo->rows < 0 || pInfo->cellSize <= 0 || nrOfNodes != size_t(pInfo->columns) * pInfo->rows)
+			return false;
+
+		const size_t nrOfCells{ nrOfNodes };
+		size_t nrOfBlockedWords{}, nrOfCellCosts{}, nrOfLists{}, nrOfExplicitConnections{};
+		const unsigned long long* pBlockedCells{ reader.GetSection<unsigned long long>(GraphFileSection::BlockedCells, nrOfBlockedWords) };
+		const float* pCellCosts{ reader.GetSection<float>(GraphFileSection::CellCosts, nrOfCellCosts) };
+		const GridGraphFileList* pLists{ reader.GetSection<GridGraphFileList>(GraphFileSection::ExplicitLists, nrOfLists) };
+		const GraphFileConnection* pExplicitConnections{ reader.GetSection<GraphFileConnection>(GraphFileSection::ExplicitConnections, nrOfExplicitConnections) };
+
+		if (pInfo->isImplicit)
+		{
+			if (nrOfBlockedWords != (nrOfCells + 63) / 64 || nrOfCellCosts != nrOfCells)
+				return false;
+
+			for (size_t i = 0; i < nrOfLists; ++i)
+			{
+				const GridGraphFileList& list{ pLists[i] };
+				if (list.nodeIdx < 0 || size_t(list.nodeIdx) >= nrOfCells || list.firstConnection < 0 || list.nrOfConnections < 0
+					|| size_t(list.firstConnection) + list.nrOfConnections > nrOfExplicitConnections)
+					return false;
+
+				for (int c = list.firstConnection; c < list.firstConnection + list.nrOfConnections; ++c)
+				{
+					const GraphFileConnection& connection{ pExplicitConnections[c] };
+					if (connection.from != list.nodeIdx || connection.to < 0 || size_t(connection.to) >= nrOfCells)
+						return false;
+				}
+			}
+		}
+
+		if (!ReadGraphSections(reader, !pInfo->isImplicit))
+			return false;
+
+		m_NrOfColumns = pInfo->columns;
+		m_NrOfRows = pInfo->rows;
+		m_CellSize = pInfo->cellSize;
+		m_IsConnectedDiagonally = pInfo->isConnectedDiagonally != 0;
+		m_DefaultCostStraight = pInfo->costStraight;
+		m_DefaultCostDiagonal = pInfo->costDiagonal;
+
+		if (pInfo->isImplicit)
+		{
+			m_IsImplicit = true;
+			m_BlockedCells.assign(pBlockedCells, pBlockedCells + nrOfBlockedWords);
+			m_CellCosts.assign(pCellCosts, pCellCosts + nrOfCellCosts);
+
+			Reserve(0, (int)nrOfExplicitConnections);
+			for (size_t i = 0; i < nrOfLists; ++i)
+			{
+				ConnectionList& connections{ m_ExplicitConnections[pLists[i].nodeIdx] };
+				connections.reserve(pLists[i].nrOfConnections);
+				for (int c = pLists[i].firstConnection; c < pLists[i].firstConnection + pLists[i].nrOfConnections; ++c)
+				{
+					T_ConnectionType* pConnection{ CreateConnection() };
+					pConnection->SetFrom(pExplicitConnections[c].from);
+					pConnection->SetTo(pExplicitConnections[c].to);
+					pConnection->SetCost(pExplicitConnections[c].cost);
+					connections.push_back(pConnection);
+				}
+			}
+		}
+
+		OnGraphModified(true, true);
+		return true;
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline std::shared_ptr<IGraph<T_NodeType, T_ConnectionType>> GridGraph<T_NodeType, T_ConnectionType>::Clone() const
+	{
+		return std::shared_ptr<GridGraph>(new GridGraph(*this));
+	}
+
 	template<class T_NodeType, class T_ConnectionType>
 	bool GridGraph<T_NodeType, T_ConnectionType>::IsWithinBounds(int col, int row) const
 	{
@@ -147,6 +746,15 @@ namespace Elite
 	{
 		int idx = GetIndex(col, row);
 
+		// Implicit grids only need to know the cell can be entered again, and what the terrain of the node costs now
+		if (m_IsImplicit)
+		{
+			ResetNodeConnections(idx);
+			SetCellCost(idx, GetTerrainCost(idx));
+			SetCellBlocked(idx, false);
+			return;
+		}
+
 		// Add connections in all directions, taking into account the dimensions of the grid
 		AddConnectionsInDirections(idx, col, row, m_StraightDirections);
 
@@ -166,7 +774,7 @@ namespace Elite
 	}
 
 	template<class T_NodeType, class T_ConnectionType>
-	void GridGraph<T_NodeType, T_ConnectionType>::AddConnectionsInDirections(int idx, int col, int row, std::vector<Elite::Vector2> directions)
+	void GridGraph<T_NodeType, T_ConnectionType>::AddConnectionsInDirections(int idx, int col, int row, const std::vector<Elite::Vector2>& directions)
 	{
 		for (auto d : directions)
 		{
@@ -180,7 +788,7 @@ namespace Elite
 
 				if (IsUniqueConnection(idx, neighborIdx) 
 					&& connectionCost < 100000) //Extra check for different terrain types
-					AddConnection(new GraphConnection(idx, neighborIdx, connectionCost));
+					AddConnection(CreateConnection(idx, neighborIdx, connectionCost));
 			}
 		}
 	}
@@ -199,26 +807,15 @@ namespace Elite
 			cost = m_DefaultCostDiagonal;
 		}
 
+		cost *= (GetTerrainCost(fromIdx) + GetTerrainCost(toIdx)) / 2.0f;
+
 		return cost;
 	}
 
 	template<>
-	inline float GridGraph<GridTerrainNode, GraphConnection>::CalculateConnectionCost(int fromIdx, int toIdx) const
+	inline float GridGraph<GridTerrainNode, GraphConnection>::GetTerrainCost(int idx) const
 	{
-		float cost = m_DefaultCostStraight;
-
-		Vector2 fromPos = GetNodePos(fromIdx);
-		Vector2 toPos = GetNodePos(toIdx);
-
-		if (int(fromPos.y) != int(toPos.y) &&
-			int(fromPos.x) != int(toPos.x))
-		{
-			cost = m_DefaultCostDiagonal;
-		}
-
-		cost *= (int(GetNode(fromIdx)->GetTerrainType()) + int(GetNode(toIdx)->GetTerrainType())) / 2.0f;
-
-		return cost;
+		return float(GetNode(idx)->GetTerrainType());
 	}
 
 	template<class T_NodeType, class T_ConnectionType>
@@ -9,6 +9,8 @@
 
 #include "EGraphNodeTypes.h"
 #include "EGraphConnectionTypes.h"
+#include "EGraphObjectPool.h"
+#include "EGraphSerialization.h"
 #include <memory>
 
 namespace Elite
@@ -19,9 +21,17 @@ namespace Elite
 	public:
 		// shorthand typedefs
 		using NodeVector = std::vector<T_NodeType*>;
-		using ConnectionList = std::list<T_ConnectionType*>; // TODO: function definition doesn't recognize this?
+		using ConnectionList = std::vector<T_ConnectionType*>;
 		using ConnectionListVector = std::vector<ConnectionList>;
 
+		// Caller owned room for the connections of one node, for graphs that generate them instead of storing them.
+		// Keep one per loop, a list returned with it is valid until the buffer is used again.
+		struct ConnectionBuffer
+		{
+			std::vector<T_ConnectionType> connections{};
+			ConnectionList pConnections{};
+		};
+
 	public:
 		IGraph(bool isDirectionalGraph);
 		IGraph(const IGraph& other);
@@ -32,24 +42,42 @@ namespace Elite
 		T_NodeType* GetNode(int idx) const;
 		bool IsNodeValid(int idx) const;
 		NodeVector GetAllNodes() const;
+		// Fills nodes with the active nodes, use a FrameVector for per frame queries
+		template<typename T_Allocator>
+		void GetAllNodes(std::vector<T_NodeType*, T_Allocator>& nodes) const;
 
 		T_ConnectionType* GetConnection(int from, int to) const;
-		const ConnectionListVector& GetAllConnections() const { return m_Connections; }
-		const ConnectionList& GetNodeConnections(int idx) const;
+		// Graphs that generate their connections have no stored lists to return
+		virtual const ConnectionListVector& GetAllConnections() const { return m_Connections; }
+		// The returned list and its connections stay valid until the graph is edited
+		virtual const ConnectionList& GetNodeConnections(int idx) const;
 		const ConnectionList& GetNodeConnections(T_NodeType* pNode) const { return GetNodeConnections(pNode->GetIndex()); }
+		// For searches and other read-only loops: graphs that generate their connections fill the buffer instead of storing them,
+		// stored lists are returned as they are
+		virtual const ConnectionList& GetNodeConnections(int idx, ConnectionBuffer& buffer) const { return GetNodeConnections(idx); }
+		const ConnectionList& GetNodeConnections(T_NodeType* pNode, ConnectionBuffer& buffer) const { return GetNodeConnections(pNode->GetIndex(), buffer); }
 
 		int GetNextFreeNodeIndex() const { return m_NextNodeIndex; }
+
+		// Nodes and connections made here live in the slabs of the graph, pass them to AddNode/AddConnection as usual.
+		// Objects created with new are still accepted, the graph deletes those one by one.
+		template<class... Args>
+		T_NodeType* CreateNode(Args&&... args) { return m_NodePool.Create(std::forward<Args>(args)...); }
+		template<class... Args>
+		T_ConnectionType* CreateConnection(Args&&... args) { return m_ConnectionPool.Create(std::forward<Args>(args)...); }
+		void Reserve(int nrOfNodes, int nrOfConnections);
+
 		int AddNode(T_NodeType* pNode);
-		void RemoveNode(int node);
+		virtual void RemoveNode(int node);
 
-		void AddConnection(T_ConnectionType* pConnection);
-		void RemoveConnection(int from, int to);
+		virtual void AddConnection(T_ConnectionType* pConnection);
+		virtual void RemoveConnection(int from, int to);
 		void RemoveConnection(T_ConnectionType* pConnection);
 
 		// Removes all connections to this pNode
-		void RemoveConnectionsToAdjacentNodes(int idx);
+		virtual void RemoveConnectionsToAdjacentNodes(int idx);
 
-		void SetConnectionCost(int from, int to, float cost);
+		virtual void SetConnectionCost(int from, int to, float cost);
 
 		int GetNrOfNodes() const { return m_Nodes.size(); }
 		int GetNrOfActiveNodes() const;
@@ -58,9 +86,13 @@ namespace Elite
 		bool IsEmpty() const { return m_Nodes.empty(); }
 		bool IsUniqueConnection(int from, int to) const;
 
-		void Clear();
+		virtual void Clear();
 		void RemoveConnections();
 
+		// Binary files, see EGraphSerialization.h. Loading replaces the whole graph.
+		bool SaveToFile(const std::string& path) const;
+		bool LoadFromFile(const std::string& path);
+
 		// Visualization
 		// -------------
 		float GetNodeRadius(T_NodeType* pNode) const;
@@ -93,9 +125,23 @@ namespace Elite
 		// Called whenever the graph is modified, to be overriden by derived classes
 		virtual void OnGraphModified(bool nrOfNodesChanged, bool nrOfConnectionsChanged) {}
 
+		// Derived graphs add their own sections after the ones of IGraph
+		virtual void WriteSections(BinaryFileWriter& writer) const;
+		virtual bool ReadSections(const BinaryFileReader& reader);
+		// Graphs that generate their connections store no lists, every other graph stores one per node
+		bool ReadGraphSections(const BinaryFileReader& reader, bool hasConnectionLists);
+
+		// For derived graphs that fill m_Nodes themselves
+		void SetNextNodeIndex(int idx) { m_NextNodeIndex = idx; }
+		void DestroyNode(T_NodeType* pNode);
+		void DestroyConnection(T_ConnectionType* pConnection);
+
 	private:
 		int m_NextNodeIndex;
 
+		GraphObjectPool<T_NodeType> m_NodePool{};
+		GraphObjectPool<T_ConnectionType> m_ConnectionPool{};
+
 		// private functions
 		void CullInvalidEdges();
 	};
@@ -110,24 +156,22 @@ namespace Elite
 	template<class T_NodeType, class T_ConnectionType>
 	inline IGraph<T_NodeType, T_ConnectionType>::IGraph(const IGraph& other)
 	{
-		for (auto& n : m_Nodes)
-			SAFE_DELETE(n);
-
-		for (auto& connectionList : m_Connections)
-		{
-			for (auto& connection : connectionList)
-				SAFE_DELETE(connection);
-		};
+		// Copies go into one slab per type
+		int nrOfConnections{ 0 };
+		for (const auto& connectionList : other.m_Connections)
+			nrOfConnections += static_cast<int>(connectionList.size());
+		Reserve(static_cast<int>(other.m_Nodes.size()), nrOfConnections);
 
+		m_Nodes.reserve(other.m_Nodes.size());
 		for (auto n : other.m_Nodes)
-			m_Nodes.push_back(new T_NodeType(*n));
+			m_Nodes.push_back(CreateNode(*n));
 
-		for (auto cList : other.m_Connections)
+		m_Connections.resize(other.m_Connections.size());
+		for (size_t i = 0; i < other.m_Connections.size(); ++i)
 		{
-			ConnectionList newList;
-			for (auto c : cList)
-				newList.push_back(new T_ConnectionType(*c));
-			m_Connections.push_back(newList);
+			m_Connections[i].reserve(other.m_Connections[i].size());
+			for (auto c : other.m_Connections[i])
+				m_Connections[i].push_back(CreateConnection(*c));
 		}
 
 		m_IsDirectionalGraph = other.m_IsDirectionalGraph;
@@ -167,7 +211,7 @@ namespace Elite
 			m_Nodes[to]->GetIndex() != invalid_node_index &&
 			"<Graph::GetConnection>: invalid 'to' index");
 
-		for (auto c : m_Connections[from])
+		for (auto c : GetNodeConnections(from))
 		{
 			if (c && c->GetTo() == to)
 				return c;
@@ -188,7 +232,18 @@ namespace Elite
 	}
 
 	template<class T_NodeType, class T_ConnectionType>
-	inline const std::list<T_ConnectionType*>& IGraph<T_NodeType, T_ConnectionType>::GetNodeConnections(int idx) const
+	template<typename T_Allocator>
+	inline void IGraph<T_NodeType, T_ConnectionType>::GetAllNodes(std::vector<T_NodeType*, T_Allocator>& nodes) const
+	{
+		nodes.clear();
+		nodes.reserve(m_Nodes.size());
+		for (auto n : m_Nodes)
+			if (n->GetIndex() != invalid_node_index)
+				nodes.push_back(n);
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline const std::vector<T_ConnectionType*>& IGraph<T_NodeType, T_ConnectionType>::GetNodeConnections(int idx) const
 	{
 		assert((idx < (int)m_Nodes.size()) && (idx >= 0) && "<Graph::GetNode>: invalid index");
 
@@ -205,6 +260,9 @@ namespace Elite
 			assert(m_Nodes[pNode->GetIndex()]->GetIndex() == invalid_node_index &&
 				"<Graph::AddNode>: Attempting to add a node with a duplicate ID");
 
+			// the removed node that held this index is replaced
+			if (m_Nodes[pNode->GetIndex()] != pNode)
+				DestroyNode(m_Nodes[pNode->GetIndex()]);
 			m_Nodes[pNode->GetIndex()] = pNode;
 
 			OnGraphModified(true, false);
@@ -256,7 +314,7 @@ namespace Elite
 
 						auto conPtr = *currentEdgeOnToNode;
 						currentEdgeOnToNode = m_Connections[(*currentConnection)->GetTo()].erase(currentEdgeOnToNode);
-						SAFE_DELETE(conPtr);
+						DestroyConnection(conPtr);
 
 						break;
 					}
@@ -268,7 +326,7 @@ namespace Elite
 		for (auto& connection : m_Connections[idx])
 		{
 			hadConnections = true;
-			SAFE_DELETE(connection);
+			DestroyConnection(connection);
 		}
 		m_Connections[idx].clear();
 
@@ -298,7 +356,7 @@ namespace Elite
 				//check to make sure the pConnection is unique before adding
 				if (IsUniqueConnection(pConnection->GetTo(), pConnection->GetFrom()))
 				{
-					T_ConnectionType* oppositeDirEdge = new T_ConnectionType();
+					T_ConnectionType* oppositeDirEdge = CreateConnection();
 
 					oppositeDirEdge->SetCost(pConnection->GetCost());
 					oppositeDirEdge->SetTo(pConnection->GetFrom());
@@ -346,8 +404,10 @@ namespace Elite
 			}
 		}
 
-		SAFE_DELETE(conFromTo);
-		SAFE_DELETE(conToFrom);
+		// In a directional graph the opposite connection is a separate one and stays
+		DestroyConnection(conFromTo);
+		if (!m_IsDirectionalGraph)
+			DestroyConnection(conToFrom);
 
 		OnGraphModified(false, true);
 	}
@@ -363,17 +423,17 @@ namespace Elite
 	{
 		// remove and delete connections from this pNode
 		for (auto c : m_Connections[idx])
-			delete c;
+			DestroyConnection(c);
 		m_Connections[idx].clear();
 
 		// remove and delete connections from other nodes to this pNode
 		auto isConnectionToThisNode = [idx](T_ConnectionType* pCon) { return pCon->GetTo() == idx; };
 		for (auto& c : m_Connections)
 		{
-			std::list<T_ConnectionType*>::iterator foundIt;
+			typename ConnectionList::iterator foundIt;
 			while ((foundIt = std::find_if(c.begin(), c.end(), isConnectionToThisNode))	!= c.end())
 			{
-				delete *foundIt;
+				DestroyConnection(*foundIt);
 				c.erase(foundIt);
 			}
 		}
@@ -388,14 +448,11 @@ namespace Elite
 		assert((from < (int)m_Nodes.size()) && (to < (int)m_Nodes.size()) &&
 			"<Graph::SetEdgeCost>: invalid index");
 
-		//visit each neighbour and erase any connections leading to this pNode
-		for (auto& curEdge = m_Connections[from].begin();
-			curEdge != m_Connections[from].end();
-			++curEdge)
+		for (auto pConnection : m_Connections[from])
 		{
-			if (curEdge->GetTo() == to)
+			if (pConnection->GetTo() == to)
 			{
-				curEdge->SetCost(cost);
+				pConnection->SetCost(cost);
 				break;
 			}
 		}
@@ -418,12 +475,9 @@ namespace Elite
 	{
 		int tot = 0;
 
-		for (auto curEdge = m_Connections.begin();
-			curEdge != m_Connections.end();
-			++curEdge)
-		{
-			tot += curEdge->size();
-		}
+		ConnectionBuffer buffer{};
+		for (int idx = 0; idx < (int)m_Nodes.size(); ++idx)
+			tot += (int)GetNodeConnections(idx, buffer).size();
 
 		return tot;
 	}
@@ -431,17 +485,21 @@ namespace Elite
 	template<class T_NodeType, class T_ConnectionType>
 	inline void IGraph<T_NodeType, T_ConnectionType>::Clear()
 	{
-		for (auto& n : m_Nodes)
-			SAFE_DELETE(n);
+		for (auto n : m_Nodes)
+			DestroyNode(n);
 		m_Nodes.clear();
 
 		for (auto& connectionList : m_Connections)
 		{
-			for (auto& connection : connectionList)
-				SAFE_DELETE(connection);
+			for (auto connection : connectionList)
+				DestroyConnection(connection);
 		}
 		m_Connections.clear();
 
+		// Slab memory goes back in one go
+		m_NodePool.ReleaseAll();
+		m_ConnectionPool.ReleaseAll();
+
 		m_NextNodeIndex = 0;
 	}
 
@@ -449,7 +507,167 @@ namespace Elite
 	inline void IGraph<T_NodeType, T_ConnectionType>::RemoveConnections()
 	{
 		for (auto& connectionList : m_Connections)
+		{
+			for (auto connection : connectionList)
+				DestroyConnection(connection);
 			connectionList.clear();
+		}
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline bool IGraph<T_NodeType, T_ConnectionType>::SaveToFile(const std::string& path) const
+	{
+		BinaryFileWriter writer{ GraphFileMagic, GraphFileVersion };
+		WriteSections(writer);
+		return writer.Write(path);
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline bool IGraph<T_NodeType, T_ConnectionType>::LoadFromFile(const std::string& path)
+	{
+		BinaryFileReader reader{};
+		if (!reader.Open(path, GraphFileMagic, GraphFileVersion))
+			return false;
+
+		return ReadSections(reader);
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline void IGraph<T_NodeType, T_ConnectionType>::WriteSections(BinaryFileWriter& writer) const
+	{
+		const GraphFileInfo info{ (int)m_Nodes.size(), (int)m_Connections.size(), m_NextNodeIndex, m_IsDirectionalGraph ? 1 : 0,
+			(int)sizeof(T_NodeType), (int)sizeof(T_ConnectionType) };
+		writer.AddSection(GraphFileSection::Info, &info, 1);
+
+		std::vector<GraphFileNode> nodes(m_Nodes.size());
+		for (size_t i = 0; i < m_Nodes.size(); ++i)
+			WriteGraphFileNode(*m_Nodes[i], nodes[i]);
+		writer.AddSection(GraphFileSection::Nodes, nodes);
+
+		std::vector<int> offsets{};
+		offsets.reserve(m_Connections.size() + 1);
+		std::vector<GraphFileConnection> connections{};
+		for (const auto& connectionList : m_Connections)
+		{
+			offsets.push_back((int)connections.size());
+			for (auto c : connectionList)
+				connections.push_back(GraphFileConnection{ c->GetFrom(), c->GetTo(), c->GetCost() });
+		}
+		offsets.push_back((int)connections.size());
+		writer.AddSection(GraphFileSection::ConnectionOffsets, offsets);
+		writer.AddSection(GraphFileSection::Connections, connections);
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline bool IGraph<T_NodeType, T_ConnectionType>::ReadSections(const BinaryFileReader& reader)
+	{
+		return ReadGraphSections(reader, true);
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline bool IGraph<T_NodeType, T_ConnectionType>::ReadGraphSections(const BinaryFileReader& reader, bool hasConnectionLists)
+	{
+		size_t nrOfInfos{}, nrOfNodes{}, nrOfOffsets{}, nrOfConnections{};
+		const GraphFileInfo* pInfo{ reader.GetSection<GraphFileInfo>(GraphFileSection::Info, nrOfInfos) };
+		const GraphFileNode* pNodes{ reader.GetSection<GraphFileNode>(GraphFileSection::Nodes, nrOfNodes) };
+		const int* pOffsets{ reader.GetSection<int>(GraphFileSection::ConnectionOffsets, nrOfOffsets) };
+		const GraphFileConnection* pConnections{ reader.GetSection<GraphFileConnection>(GraphFileSection::Connections, nrOfConnections) };
+
+		// Everything has to add up before the current graph is thrown away
+		if (nrOfInfos != 1 || pInfo->nodeSize != (int)sizeof(T_NodeType) || pInfo->connectionSize != (int)sizeof(T_ConnectionType)
+			|| pInfo->nrOfNodes < 0 || nrOfNodes != (size_t)pInfo->nrOfNodes
+			|| pInfo->nrOfConnectionLists != (hasConnectionLists ? pInfo->nrOfNodes : 0) || nrOfOffsets != (size_t)pInfo->nrOfConnectionLists + 1
+			|| pInfo->nextNodeIndex < 0 || pInfo->nextNodeIndex > pInfo->nrOfNodes)
+			return false;
+
+		// A node is in its own slot, or removed
+		for (size_t i = 0; i < nrOfNodes; ++i)
+		{
+			if (pNodes[i].index != (int)i && pNodes[i].index != invalid_node_index)
+				return false;
+		}
+
+		for (size_t i = 0; i + 1 < nrOfOffsets; ++i)
+		{
+			if (pOffsets[i] < 0 || pOffsets[i] > pOffsets[i + 1])
+				return false;
+		}
+		if (pOffsets[0] != 0 || (size_t)pOffsets[nrOfOffsets - 1] != nrOfConnections)
+			return false;
+
+		// Connections are indexed with their nodes without checks later on
+		for (size_t i = 0; i + 1 < nrOfOffsets; ++i)
+		{
+			for (int c = pOffsets[i]; c < pOffsets[i + 1]; ++c)
+			{
+				if (pConnections[c].from != (int)i || pConnections[c].to < 0 || pConnections[c].to >= pInfo->nrOfNodes)
+					return false;
+			}
+		}
+
+		Clear();
+		m_IsDirectionalGraph = pInfo->isDirectional != 0;
+		Reserve((int)nrOfNodes, (int)nrOfConnections);
+
+		for (size_t i = 0; i < nrOfNodes; ++i)
+		{
+			T_NodeType* pNode{ CreateNode(pNodes[i].index) };
+			ReadGraphFileNode(pNodes[i], *pNode);
+			m_Nodes.push_back(pNode);
+		}
+
+		m_Connections.resize(nrOfOffsets - 1);
+		for (size_t i = 0; i + 1 < nrOfOffsets; ++i)
+		{
+			ConnectionList& connectionList{ m_Connections[i] };
+			connectionList.reserve(pOffsets[i + 1] - pOffsets[i]);
+			for (int c = pOffsets[i]; c < pOffsets[i + 1]; ++c)
+			{
+				T_ConnectionType* pConnection{ CreateConnection() };
+				pConnection->SetFrom(pConnections[c].from);
+				pConnection->SetTo(pConnections[c].to);
+				pConnection->SetCost(pConnections[c].cost);
+				connectionList.push_back(pConnection);
+			}
+		}
+
+		m_NextNodeIndex = pInfo->nextNodeIndex;
+		OnGraphModified(true, true);
+		return true;
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline void IGraph<T_NodeType, T_ConnectionType>::Reserve(int nrOfNodes, int nrOfConnections)
+	{
+		m_NodePool.Reserve(nrOfNodes);
+		m_ConnectionPool.Reserve(nrOfConnections);
+		m_Nodes.reserve(nrOfNodes);
+		if (nrOfConnections > 0)
+			m_Connections.reserve(nrOfNodes);
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline void IGraph<T_NodeType, T_ConnectionType>::DestroyNode(T_NodeType* pNode)
+	{
+		if (!pNode)
+			return;
+
+		if (m_NodePool.Owns(pNode))
+			m_NodePool.Destroy(pNode);
+		else
+			delete pNode;
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline void IGraph<T_NodeType, T_ConnectionType>::DestroyConnection(T_ConnectionType* pConnection)
+	{
+		if (!pConnection)
+			return;
+
+		if (m_ConnectionPool.Owns(pConnection))
+			m_ConnectionPool.Destroy(pConnection);
+		else
+			delete pConnection;
 	}
 
 	template<class T_NodeType, class T_ConnectionType>
@@ -461,7 +679,8 @@ namespace Elite
 	template<class T_NodeType, class T_ConnectionType>
 	inline bool IGraph<T_NodeType, T_ConnectionType>::IsUniqueConnection(int from, int to) const
 	{
-		for(auto c : m_Connections[from])
+		ConnectionBuffer buffer{};
+		for(auto c : GetNodeConnections(from, buffer))
 		{
 			if (c->GetTo() == to)
 			{
@@ -2,6 +2,9 @@
 #include "EIGraph.h"
 #include "EGraphNodeTypes.h"
 #include "EGraphConnectionTypes.h"
+#include "EGridGraph.h"
+#include "EInfluenceMapKernels.h"
+#include <type_traits>
 
 namespace Elite
 {
@@ -10,9 +13,18 @@ namespace Elite
 	{
 	public:
 		InfluenceMap(bool isDirectional): T_GraphType(isDirectional) {}
-		void InitializeBuffer() { m_InfluenceDoubleBuffer = std::vector<float>(m_Nodes.size()); }
+		void InitializeBuffer() { m_InfluenceDoubleBuffer.resize(m_Nodes.size()); }
 		void PropagateInfluence(float deltaTime);
 
+		// Grid influence maps propagate through a flat array stencil kernel, as long as the grid connections are unmodified
+		bool GetUseGridKernel() const { return m_UseGridKernel; }
+		void SetUseGridKernel(bool useGridKernel) { m_UseGridKernel = useGridKernel; }
+
+		// The grid kernel splits the rows in one band per thread (including the calling thread) on the job system,
+		// capped by the number of threads the job system has
+		unsigned int GetNrOfPropagationThreads() const { return std::min(m_NrOfPropagationThreads, JOBSYSTEM->GetNrOfThreads()); }
+		void SetNrOfPropagationThreads(unsigned int nrOfThreads) { m_NrOfPropagationThreads = std::max(nrOfThreads, 1u); }
+
 		void SetInfluenceAtPosition(Elite::Vector2 pos, float influence);
 
 		void Render() const {}
@@ -31,6 +43,13 @@ namespace Elite
 		virtual void OnGraphModified(bool nrOfNodesChanged, bool nrOfConnectionsChanged) override;
 
 	private:
+		using IsGridGraph = std::is_base_of<GridGraph<InfluenceNode, GraphConnection>, T_GraphType>;
+
+		void PropagateInfluenceStep(std::false_type isGridGraph);
+		void PropagateInfluenceStep(std::true_type isGridGraph);
+		void PropagateInfluenceGeneric();
+		bool IsRegularGridStencil();
+
 		Elite::Color m_NegativeColor{ 1.f, 0.2f, 0.f};
 		Elite::Color m_NeutralColor{ 0.f, 0.f, 0.f };
 		Elite::Color m_PositiveColor{ 0.f, 0.2f, 1.f};
@@ -44,6 +63,14 @@ namespace Elite
 		float m_TimeSinceLastPropagation = 0.0f;
 
 		std::vector<float> m_InfluenceDoubleBuffer;
+
+		bool m_UseGridKernel = true;
+		bool m_IsStencilValidated = false;
+		bool m_IsRegularGridStencil = false;
+		bool m_IsGridBufferSynced = false; // false when the node influences changed outside of the grid kernel, the nodes point to it
+		std::vector<float> m_InfluenceGridBuffer; // flat copy of the node influences, row major
+
+		unsigned int m_NrOfPropagationThreads = 1;
 	};
 
 	template <class T_GraphType>
@@ -53,9 +80,74 @@ namespace Elite
 		if (m_TimeSinceLastPropagation < m_PropagationInterval) return;
 		m_TimeSinceLastPropagation -= m_PropagationInterval;
 
+		ELITE_PROFILE_SCOPE("InfluenceMap::PropagateInfluence");
+		PropagateInfluenceStep(IsGridGraph{});
+	}
+
+	template <class T_GraphType>
+	void InfluenceMap<T_GraphType>::PropagateInfluenceStep(std::false_type isGridGraph)
+	{
+		PropagateInfluenceGeneric();
+	}
+
+	template <class T_GraphType>
+	void InfluenceMap<T_GraphType>::PropagateInfluenceStep(std::true_type isGridGraph)
+	{
+		if (!m_UseGridKernel || !IsRegularGridStencil())
+		{
+			PropagateInfluenceGeneric();
+			return;
+		}
+
+		// Decay only depends on the connection cost, which is one of two values on a regular grid
+		InfluenceGridStencil stencil{};
+		stencil.columns = GetColumns();
+		stencil.rows = GetRows();
+		stencil.isConnectedDiagonally = IsConnectedDiagonally();
+		stencil.straightFactor = expf(-GetDefaultCostStraight() * m_Decay);
+		stencil.diagonalFactor = expf(-GetDefaultCostDiagonal() * m_Decay);
+		stencil.momentum = m_Momentum;
+
+		const size_t nrOfNodes{ m_Nodes.size() };
+		m_InfluenceDoubleBuffer.resize(nrOfNodes);
+
+		// The flat buffer stays the source of the propagation, it only has to be gathered again after the generic path ran
+		if (!m_IsGridBufferSynced)
+		{
+			m_InfluenceGridBuffer.resize(nrOfNodes);
+			for (size_t i = 0; i < nrOfNodes; ++i)
+				m_InfluenceGridBuffer[i] = m_Nodes[i]->GetInfluence();
+			m_IsGridBufferSynced = true;
+		}
+
+		const float* pSource{ m_InfluenceGridBuffer.data() };
+		float* pDestination{ m_InfluenceDoubleBuffer.data() };
+		auto propagateBand = [this, &stencil, pSource, pDestination](int rowBegin, int rowEnd)
+		{
+			PropagateInfluenceGridRows(stencil, pSource, pDestination, rowBegin, rowEnd);
+
+			// The nodes of a band are only touched by the thread that computed it. The buffer stays in sync,
+			// so the influence is written without SetInfluence marking it outdated.
+			for (int i = rowBegin * stencil.columns; i < rowEnd * stencil.columns; ++i)
+				m_Nodes[i]->m_Influence = pDestination[i];
+		};
+
+		JOBSYSTEM->ParallelForRanges(stencil.rows, static_cast<int>(GetNrOfPropagationThreads()), propagateBand);
+
+		// The new influence becomes the source of the next step
+		m_InfluenceGridBuffer.swap(m_InfluenceDoubleBuffer);
+	}
+
+	template <class T_GraphType>
+	void InfluenceMap<T_GraphType>::PropagateInfluenceGeneric()
+	{
+		m_IsGridBufferSynced = false;
+
+		// The buffer overload doesn't give the nodes of an implicit grid an explicit list
+		typename T_GraphType::ConnectionBuffer connectionBuffer{};
 		for (auto& node : m_Nodes)
 		{
-			auto& connections = GetNodeConnections(node);
+			auto& connections = GetNodeConnections(node->GetIndex(), connectionBuffer);
 
 			float maxInfluence{ 0 };
 
@@ -78,12 +170,89 @@ namespace Elite
 		}
 	}
 
+	template <class T_GraphType>
+	bool InfluenceMap<T_GraphType>::IsRegularGridStencil()
+	{
+		if (m_IsStencilValidated)
+			return m_IsRegularGridStencil;
+
+		// The kernel assumes every node has exactly the 4 (or 8) in bounds neighbors, with the default costs
+		m_IsStencilValidated = true;
+		m_IsRegularGridStencil = false;
+
+		const int columns{ GetColumns() };
+		const int rows{ GetRows() };
+		if ((int)m_Nodes.size() != columns * rows)
+			return false;
+
+		// Decided from the cells, visiting the nodes would generate the connections of every cell
+		if (IsImplicit())
+		{
+			m_IsRegularGridStencil = IsUnmodifiedImplicitGrid();
+			return m_IsRegularGridStencil;
+		}
+
+		typename T_GraphType::ConnectionBuffer connectionBuffer{};
+		for (int idx = 0; idx < (int)m_Nodes.size(); ++idx)
+		{
+			if (m_Nodes[idx]->GetIndex() != idx)
+				return false;
+
+			const int col{ idx % columns };
+			const int row{ idx / columns };
+
+			int expectedConnections{ 0 };
+			for (int dRow = -1; dRow <= 1; ++dRow)
+			{
+				for (int dCol = -1; dCol <= 1; ++dCol)
+				{
+					const bool isDiagonal{ dRow != 0 && dCol != 0 };
+					if ((dRow == 0 && dCol == 0) || (isDiagonal && !IsConnectedDiagonally()))
+						continue;
+					if (IsWithinBounds(col + dCol, row + dRow))
+						++expectedConnections;
+				}
+			}
+
+			const auto& connections = GetNodeConnections(idx, connectionBuffer);
+			if ((int)connections.size() != expectedConnections)
+				return false;
+
+			for (auto& connection : connections)
+			{
+				const int to{ connection->GetTo() };
+				const int dCol{ to % columns - col };
+				const int dRow{ to / columns - row };
+				if (abs(dCol) > 1 || abs(dRow) > 1)
+					return false;
+
+				const float expectedCost{ dCol != 0 && dRow != 0 ? GetDefaultCostDiagonal() : GetDefaultCostStraight() };
+				if (connection->GetCost() != expectedCost)
+					return false;
+			}
+		}
+
+		m_IsRegularGridStencil = true;
+		return true;
+	}
+
 	template <class T_GraphType>
 	inline void InfluenceMap<T_GraphType>::SetInfluenceAtPosition(Elite::Vector2 pos, float influence)
 	{
 		auto idx = GetNodeIdxAtWorldPos(pos);
-		if (IsNodeValid(idx))
+		if (!IsNodeValid(idx))
+			return;
+
+		// Writing both keeps the flat buffer in sync, so the next step doesn't have to gather it again
+		if (m_IsGridBufferSynced)
+		{
+			GetNode(idx)->m_Influence = influence;
+			m_InfluenceGridBuffer[idx] = influence;
+		}
+		else
+		{
 			GetNode(idx)->SetInfluence(influence);
+		}
 	}
 
 	template<class T_GraphType>
@@ -122,5 +291,11 @@ namespace Elite
 	inline void InfluenceMap<T_GraphType>::OnGraphModified(bool nrOfNodesChanged, bool nrOfConnectionsChanged)
 	{
 		InitializeBuffer();
+		m_IsStencilValidated = false;
+		m_IsGridBufferSynced = false;
+
+		// Influence written straight to a node (GetNode()->SetInfluence, loading a graph file) marks the buffer outdated
+		for (auto& pNode : m_Nodes)
+			pNode->m_pIsMapBufferSynced = &m_IsGridBufferSynced;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,181 @@
+#include "stdafx.h"
+#include "EInfluenceMapKernels.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define ELITE_INFLUENCE_SSE
+#include <emmintrin.h>
+#endif
+
+using namespace Elite;
+
+namespace
+{
+	// Same neighbor order as the GridGraph directions, so ties resolve the same way in the scalar and SSE path
+	inline void ConsiderNeighbor(float influence, float& best, float& bestAbs)
+	{
+		const float absInfluence{ fabsf(influence) };
+		if (absInfluence > bestAbs)
+		{
+			best = influence;
+			bestAbs = absInfluence;
+		}
+	}
+
+	inline void StampCell(float& destination, float influence)
+	{
+		if (fabsf(influence) >= fabsf(destination))
+			destination = influence;
+	}
+
+	inline float PropagateCell(const InfluenceGridStencil& stencil, const float* pSource, int col, int row)
+	{
+		const int columns{ stencil.columns };
+		const int rows{ stencil.rows };
+		const int idx{ row * columns + col };
+
+		const bool hasRight{ col + 1 < columns };
+		const bool hasLeft{ col > 0 };
+		const bool hasDown{ row + 1 < rows };
+		const bool hasUp{ row > 0 };
+
+		float best{ 0.f };
+		float bestAbs{ 0.f };
+
+		// Straight: { 1, 0 }, { 0, 1 }, { -1, 0 }, { 0, -1 }
+		if (hasRight) ConsiderNeighbor(pSource[idx + 1] * stencil.straightFactor, best, bestAbs);
+		if (hasDown) ConsiderNeighbor(pSource[idx + columns] * stencil.straightFactor, best, bestAbs);
+		if (hasLeft) ConsiderNeighbor(pSource[idx - 1] * stencil.straightFactor, best, bestAbs);
+		if (hasUp) ConsiderNeighbor(pSource[idx - columns] * stencil.straightFactor, best, bestAbs);
+
+		// Diagonal: { 1, 1 }, { -1, 1 }, { -1, -1 }, { 1, -1 }
+		if (stencil.isConnectedDiagonally)
+		{
+			if (hasRight && hasDown) ConsiderNeighbor(pSource[idx + columns + 1] * stencil.diagonalFactor, best, bestAbs);
+			if (hasLeft && hasDown) ConsiderNeighbor(pSource[idx + columns - 1] * stencil.diagonalFactor, best, bestAbs);
+			if (hasLeft && hasUp) ConsiderNeighbor(pSource[idx - columns - 1] * stencil.diagonalFactor, best, bestAbs);
+			if (hasRight && hasUp) ConsiderNeighbor(pSource[idx - columns + 1] * stencil.diagonalFactor, best, bestAbs);
+		}
+
+		return Lerp(best, pSource[idx], stencil.momentum);
+	}
+
+#ifdef ELITE_INFLUENCE_SSE
+	inline void ConsiderNeighbors(__m128 influence, __m128 absMask, __m128& best, __m128& bestAbs)
+	{
+		const __m128 absInfluence{ _mm_and_ps(influence, absMask) };
+		const __m128 isHigher{ _mm_cmpgt_ps(absInfluence, bestAbs) };
+		best = _mm_or_ps(_mm_and_ps(isHigher, influence), _mm_andnot_ps(isHigher, best));
+		bestAbs = _mm_max_ps(absInfluence, bestAbs);
+	}
+
+	// Processes 4 interior cells starting at pCenter, all 8 neighbors of these cells exist
+	inline __m128 PropagateInteriorCells(const InfluenceGridStencil& stencil, const float* pCenter,
+		__m128 straightFactor, __m128 diagonalFactor, __m128 momentum, __m128 oneMinusMomentum, __m128 absMask)
+	{
+		const int columns{ stencil.columns };
+
+		__m128 best{ _mm_setzero_ps() };
+		__m128 bestAbs{ _mm_setzero_ps() };
+
+		ConsiderNeighbors(_mm_mul_ps(_mm_loadu_ps(pCenter + 1), straightFactor), absMask, best, bestAbs);
+		ConsiderNeighbors(_mm_mul_ps(_mm_loadu_ps(pCenter + columns), straightFactor), absMask, best, bestAbs);
+		ConsiderNeighbors(_mm_mul_ps(_mm_loadu_ps(pCenter - 1), straightFactor), absMask, best, bestAbs);
+		ConsiderNeighbors(_mm_mul_ps(_mm_loadu_ps(pCenter - columns), straightFactor), absMask, best, bestAbs);
+
+		if (stencil.isConnectedDiagonally)
+		{
+			ConsiderNeighbors(_mm_mul_ps(_mm_loadu_ps(pCenter + columns + 1), diagonalFactor), absMask, best, bestAbs);
+			ConsiderNeighbors(_mm_mul_ps(_mm_loadu_ps(pCenter + columns - 1), diagonalFactor), absMask, best, bestAbs);
+			ConsiderNeighbors(_mm_mul_ps(_mm_loadu_ps(pCenter - columns - 1), diagonalFactor), absMask, best, bestAbs);
+			ConsiderNeighbors(_mm_mul_ps(_mm_loadu_ps(pCenter - columns + 1), diagonalFactor), absMask, best, bestAbs);
+		}
+
+		// Lerp(best, center, momentum), same operation order as the scalar Lerp
+		return _mm_add_ps(_mm_mul_ps(oneMinusMomentum, best), _mm_mul_ps(momentum, _mm_loadu_ps(pCenter)));
+	}
+#endif
+}
+
+void Elite::PropagateInfluenceGridRows(const InfluenceGridStencil& stencil, const float* pSource, float* pDestination, int rowBegin, int rowEnd)
+{
+	PropagateInfluenceGridRegion(stencil, pSource, pDestination, 0, stencil.columns, rowBegin, rowEnd);
+}
+
+float Elite::PropagateInfluenceGridRegion(const InfluenceGridStencil& stencil, const float* pSource, float* pDestination,
+	int colBegin, int colEnd, int rowBegin, int rowEnd)
+{
+	const int columns{ stencil.columns };
+	const int rows{ stencil.rows };
+	float maxAbsInfluence{ 0.f };
+
+#ifdef ELITE_INFLUENCE_SSE
+	const __m128 straightFactor{ _mm_set1_ps(stencil.straightFactor) };
+	const __m128 diagonalFactor{ _mm_set1_ps(stencil.diagonalFactor) };
+	const __m128 momentum{ _mm_set1_ps(stencil.momentum) };
+	const __m128 oneMinusMomentum{ _mm_set1_ps(1 - stencil.momentum) };
+	const __m128 absMask{ _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff)) };
+	__m128 maxAbs{ _mm_setzero_ps() };
+#endif
+
+	for (int row = rowBegin; row < rowEnd; ++row)
+	{
+		const int rowStart{ row * columns };
+		int col{ colBegin };
+
+#ifdef ELITE_INFLUENCE_SSE
+		// Border rows and columns miss neighbors, those go through the scalar path
+		if (row > 0 && row + 1 < rows)
+		{
+			if (col == 0 && col < colEnd)
+			{
+				pDestination[rowStart] = PropagateCell(stencil, pSource, 0, row);
+				maxAbsInfluence = std::max(maxAbsInfluence, fabsf(pDestination[rowStart]));
+				col = 1;
+			}
+
+			const int vectorEnd{ std::min(colEnd, columns - 1) };
+			for (; col + 4 <= vectorEnd; col += 4)
+			{
+				const __m128 result{ PropagateInteriorCells(stencil, pSource + rowStart + col,
+					straightFactor, diagonalFactor, momentum, oneMinusMomentum, absMask) };
+				_mm_storeu_ps(pDestination + rowStart + col, result);
+				maxAbs = _mm_max_ps(maxAbs, _mm_and_ps(result, absMask));
+			}
+		}
+#endif
+
+		for (; col < colEnd; ++col)
+		{
+			pDestination[rowStart + col] = PropagateCell(stencil, pSource, col, row);
+			maxAbsInfluence = std::max(maxAbsInfluence, fabsf(pDestination[rowStart + col]));
+		}
+	}
+
+#ifdef ELITE_INFLUENCE_SSE
+	float lanes[4];
+	_mm_storeu_ps(lanes, maxAbs);
+	maxAbsInfluence = std::max({ maxAbsInfluence, lanes[0], lanes[1], lanes[2], lanes[3] });
+#endif
+
+	return maxAbsInfluence;
+}
+
+void Elite::StampInfluenceSpan(float* pDestination, const float* pWeights, int count, float strength)
+{
+	int i{ 0 };
+
+#ifdef ELITE_INFLUENCE_SSE
+	const __m128 strengths{ _mm_set1_ps(strength) };
+	const __m128 absMask{ _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff)) };
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128 influence{ _mm_mul_ps(_mm_loadu_ps(pWeights + i), strengths) };
+		const __m128 current{ _mm_loadu_ps(pDestination + i) };
+		const __m128 isStronger{ _mm_cmpge_ps(_mm_and_ps(influence, absMask), _mm_and_ps(current, absMask)) };
+		_mm_storeu_ps(pDestination + i, _mm_or_ps(_mm_and_ps(isStronger, influence), _mm_andnot_ps(isStronger, current)));
+	}
+#endif
+
+	for (; i < count; ++i)
+		StampCell(pDestination[i], pWeights[i] * strength);
+}
@@ -0,0 +1,35 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EInfluenceMapKernels.h: Flat array kernels for influence maps on a regular grid.
+// Influence is stored row major (idx = row * columns + col), neighbors are the fixed 4 or 8 cell stencil.
+/*=============================================================================*/
+#pragma once
+
+namespace Elite
+{
+	struct InfluenceGridStencil
+	{
+		int columns = 0;
+		int rows = 0;
+		bool isConnectedDiagonally = true;
+
+		float straightFactor = 1.f;	// expf(-costStraight * decay)
+		float diagonalFactor = 1.f;	// expf(-costDiagonal * decay)
+		float momentum = 0.f;
+	};
+
+	// Propagates the rows [rowBegin, rowEnd) of pSource into pDestination:
+	// destination = Lerp(neighbor with the highest absolute decayed influence, source, momentum)
+	// Neighbors outside the grid are skipped. Uses SSE when available, rows can be processed independently.
+	void PropagateInfluenceGridRows(const InfluenceGridStencil& stencil, const float* pSource, float* pDestination, int rowBegin, int rowEnd);
+
+	// Same as above for the cells [colBegin, colEnd) x [rowBegin, rowEnd).
+	// Returns the highest absolute influence that was written, so callers can detect regions that became quiet.
+	float PropagateInfluenceGridRegion(const InfluenceGridStencil& stencil, const float* pSource, float* pDestination,
+		int colBegin, int colEnd, int rowBegin, int rowEnd);
+
+	// Stamps strength * pWeights[i] into pDestination[i] for count cells,
+	// a cell keeps its current influence when that one has a higher absolute value. Uses SSE when available.
+	void StampInfluenceSpan(float* pDestination, const float* pWeights, int count, float strength);
+}
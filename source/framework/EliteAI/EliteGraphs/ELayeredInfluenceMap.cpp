@@ -0,0 +1,379 @@
+//=== General Includes ===
+#include "stdafx.h"
+#include "ELayeredInfluenceMap.h"
+#include "EGraphEnums.h"
+using namespace Elite;
+
+LayeredInfluenceMap::LayeredInfluenceMap(int columns, int rows, float cellSize, bool isConnectedDiagonally, float costStraight, float costDiagonal)
+	: m_CellSize(cellSize)
+	, m_CostStraight(costStraight)
+	, m_CostDiagonal(costDiagonal)
+	, m_NrOfTileColumns((columns + m_TileSize - 1) / m_TileSize)
+	, m_NrOfTileRows((rows + m_TileSize - 1) / m_TileSize)
+{
+	if (columns <= 0 || rows <= 0 || cellSize <= 0.f)
+		throw Elite_Exception("LayeredInfluenceMap: the grid needs at least one cell and a positive cell size");
+
+	m_Stencil.columns = columns;
+	m_Stencil.rows = rows;
+	m_Stencil.isConnectedDiagonally = isConnectedDiagonally;
+
+	m_IsTileQueued.resize(m_NrOfTileColumns * m_NrOfTileRows);
+}
+
+int LayeredInfluenceMap::AddLayer(const std::string& name, float momentum, float decay)
+{
+	const size_t nrOfCells{ static_cast<size_t>(m_Stencil.columns) * m_Stencil.rows };
+
+	Layer layer{};
+	layer.name = name;
+	layer.momentum = momentum;
+	layer.decay = decay;
+	layer.influence.resize(nrOfCells);
+	layer.buffer.resize(nrOfCells);
+	layer.isTileAwake.resize(m_NrOfTileColumns * m_NrOfTileRows);
+
+	m_Layers.push_back(std::move(layer));
+	return static_cast<int>(m_Layers.size()) - 1;
+}
+
+int LayeredInfluenceMap::GetCellIdxAtWorldPos(const Elite::Vector2& pos) const
+{
+	if (pos.x < 0 || pos.y < 0)
+		return invalid_node_index;
+
+	const int col{ static_cast<int>(pos.x / m_CellSize) };
+	const int row{ static_cast<int>(pos.y / m_CellSize) };
+	if (col >= m_Stencil.columns || row >= m_Stencil.rows)
+		return invalid_node_index;
+
+	return row * m_Stencil.columns + col;
+}
+
+Elite::Vector2 LayeredInfluenceMap::GetCellWorldPos(int idx) const
+{
+	const int col{ idx % m_Stencil.columns };
+	const int row{ idx / m_Stencil.columns };
+	return Vector2{ (col + .5f) * m_CellSize, (row + .5f) * m_CellSize };
+}
+
+void LayeredInfluenceMap::SetInfluence(int layer, int idx, float influence)
+{
+	Layer& influenceLayer{ m_Layers[layer] };
+	influenceLayer.influence[idx] = influence;
+	WakeTile(influenceLayer, idx);
+}
+
+void LayeredInfluenceMap::SetInfluenceAtPosition(int layer, const Elite::Vector2& pos, float influence)
+{
+	const int idx{ GetCellIdxAtWorldPos(pos) };
+	if (idx != invalid_node_index)
+		SetInfluence(layer, idx, influence);
+}
+
+float LayeredInfluenceMap::GetWeightedInfluence(const std::vector<InfluenceLayerWeight>& weights, int idx) const
+{
+	float influence{ 0.f };
+	for (const InfluenceLayerWeight& layerWeight : weights)
+		influence += m_Layers[layerWeight.layer].influence[idx] * layerWeight.weight;
+	return influence;
+}
+
+bool LayeredInfluenceMap::FindBestCellInRadius(const Elite::Vector2& center, float radius, const std::vector<InfluenceLayerWeight>& weights,
+	Elite::Vector2& bestPos, float& bestInfluence, float distancePenalty) const
+{
+	const int colBegin{ std::max(static_cast<int>(floorf((center.x - radius) / m_CellSize)), 0) };
+	const int colEnd{ std::min(static_cast<int>(floorf((center.x + radius) / m_CellSize)) + 1, m_Stencil.columns) };
+	const int rowBegin{ std::max(static_cast<int>(floorf((center.y - radius) / m_CellSize)), 0) };
+	const int rowEnd{ std::min(static_cast<int>(floorf((center.y + radius) / m_CellSize)) + 1, m_Stencil.rows) };
+
+	const float radiusSquared{ radius * radius };
+	bool isFound{ false };
+
+	for (int row = rowBegin; row < rowEnd; ++row)
+	{
+		for (int col = colBegin; col < colEnd; ++col)
+		{
+			const int idx{ row * m_Stencil.columns + col };
+			const Vector2 cellPos{ GetCellWorldPos(idx) };
+			const float distanceSquared{ cellPos.DistanceSquared(center) };
+			if (distanceSquared > radiusSquared)
+				continue;
+
+			float influence{ GetWeightedInfluence(weights, idx) };
+			if (distancePenalty != 0.f)
+				influence -= distancePenalty * sqrtf(distanceSquared);
+
+			if (!isFound || influence > bestInfluence)
+			{
+				isFound = true;
+				bestInfluence = influence;
+				bestPos = cellPos;
+			}
+		}
+	}
+
+	return isFound;
+}
+
+void LayeredInfluenceMap::StampInfluence(int layer, const std::vector<InfluenceSource>& sources)
+{
+	if (sources.empty())
+		return;
+
+	Layer& influenceLayer{ m_Layers[layer] };
+
+	// Look up the kernels and wake the tiles up front, the stamping itself only writes influence
+	m_pSourceKernels.resize(sources.size());
+	for (size_t i = 0; i < sources.size(); ++i)
+	{
+		const InfluenceSource& source{ sources[i] };
+		const RadialKernel& kernel{ GetRadialKernel(source.radius, source.falloff) };
+		m_pSourceKernels[i] = &kernel;
+
+		// Clip to the grid first, a stamp that lies off an edge wakes nothing instead of the tiles along it
+		const int centerCol{ static_cast<int>(floorf(source.position.x / m_CellSize)) };
+		const int centerRow{ static_cast<int>(floorf(source.position.y / m_CellSize)) };
+		const int colBegin{ std::max(centerCol - kernel.halfSize, 0) };
+		const int colEnd{ std::min(centerCol + kernel.halfSize, m_Stencil.columns - 1) };
+		const int rowBegin{ std::max(centerRow - kernel.halfSize, 0) };
+		const int rowEnd{ std::min(centerRow + kernel.halfSize, m_Stencil.rows - 1) };
+		if (colBegin > colEnd || rowBegin > rowEnd)
+			continue;
+
+		const int tileColBegin{ colBegin / m_TileSize };
+		const int tileColEnd{ colEnd / m_TileSize };
+		const int tileRowBegin{ rowBegin / m_TileSize };
+		const int tileRowEnd{ rowEnd / m_TileSize };
+		for (int tileRow = tileRowBegin; tileRow <= tileRowEnd; ++tileRow)
+			for (int tileCol = tileColBegin; tileCol <= tileColEnd; ++tileCol)
+				influenceLayer.isTileAwake[tileRow * m_NrOfTileColumns + tileCol] = 1;
+	}
+
+	// Every thread stamps all sources into its own band of rows, so no cell is written by two threads
+	const int minNrOfSourcesPerThread{ 256 };
+	if (GetNrOfPropagationThreads() > 1 && static_cast<int>(sources.size()) >= minNrOfSourcesPerThread * 2)
+	{
+		JOBSYSTEM->ParallelForRanges(m_Stencil.rows, static_cast<int>(GetNrOfPropagationThreads()),
+			[this, &influenceLayer, &sources](int rowBegin, int rowEnd) { StampRows(influenceLayer, sources, rowBegin, rowEnd); });
+	}
+	else
+	{
+		StampRows(influenceLayer, sources, 0, m_Stencil.rows);
+	}
+}
+
+void LayeredInfluenceMap::PropagateInfluence(float deltaTime)
+{
+	m_TimeSinceLastPropagation += deltaTime;
+	if (m_TimeSinceLastPropagation < m_PropagationInterval) return;
+	m_TimeSinceLastPropagation -= m_PropagationInterval;
+
+	ELITE_PROFILE_SCOPE("LayeredInfluenceMap::PropagateInfluence");
+
+	m_NrOfPropagatedTiles = 0;
+	for (Layer& layer : m_Layers)
+		PropagateLayer(layer);
+}
+
+void LayeredInfluenceMap::Render(const std::vector<InfluenceLayerWeight>& weights, float maxAbsInfluence) const
+{
+	const float halfCellSize{ m_CellSize / 2.f };
+
+	for (int tileIdx = 0; tileIdx < m_NrOfTileColumns * m_NrOfTileRows; ++tileIdx)
+	{
+		// A tile that is asleep in every weighted layer only contains zeroes
+		bool isAwake{ false };
+		for (const InfluenceLayerWeight& layerWeight : weights)
+			isAwake |= m_Layers[layerWeight.layer].isTileAwake[tileIdx] != 0;
+		if (!isAwake)
+			continue;
+
+		const int colBegin{ (tileIdx % m_NrOfTileColumns) * m_TileSize };
+		const int rowBegin{ (tileIdx / m_NrOfTileColumns) * m_TileSize };
+		const int colEnd{ std::min(colBegin + m_TileSize, m_Stencil.columns) };
+		const int rowEnd{ std::min(rowBegin + m_TileSize, m_Stencil.rows) };
+
+		for (int row = rowBegin; row < rowEnd; ++row)
+		{
+			for (int col = colBegin; col < colEnd; ++col)
+			{
+				const int idx{ row * m_Stencil.columns + col };
+				const float influence{ GetWeightedInfluence(weights, idx) };
+				if (abs(influence) < m_NegligibleInfluence)
+					continue;
+
+				const float relativeInfluence{ std::min(abs(influence) / maxAbsInfluence, 1.f) };
+				const Color& color{ influence < 0 ? m_NegativeColor : m_PositiveColor };
+
+				const Vector2 cellPos{ GetCellWorldPos(idx) };
+				Vector2 verts[4]
+				{
+					Vector2(cellPos.x - halfCellSize, cellPos.y - halfCellSize),
+					Vector2(cellPos.x - halfCellSize, cellPos.y + halfCellSize),
+					Vector2(cellPos.x + halfCellSize, cellPos.y + halfCellSize),
+					Vector2(cellPos.x + halfCellSize, cellPos.y - halfCellSize)
+				};
+				DEBUGRENDERER2D->DrawSolidPolygon(&verts[0], 4,
+					Color{ color.r * relativeInfluence, color.g * relativeInfluence, color.b * relativeInfluence }, 0.1f);
+			}
+		}
+	}
+}
+
+const LayeredInfluenceMap::RadialKernel& LayeredInfluenceMap::GetRadialKernel(float radius, InfluenceFalloff falloff)
+{
+	// Radii are rounded to a quarter cell, so agents that slowly grow share kernels
+	const unsigned int quarterCells{ static_cast<unsigned int>(std::max(radius, 0.f) / m_CellSize * 4.f + .5f) };
+	const unsigned int key{ (quarterCells << 2) | static_cast<unsigned int>(falloff) };
+
+	auto kernelIt = m_RadialKernels.find(key);
+	if (kernelIt != m_RadialKernels.end())
+		return kernelIt->second;
+
+	const float radiusInCells{ quarterCells / 4.f };
+	RadialKernel kernel{};
+	kernel.halfSize = static_cast<int>(radiusInCells);
+
+	const int size{ kernel.halfSize * 2 + 1 };
+	kernel.weights.resize(size * size);
+	for (int y = -kernel.halfSize; y <= kernel.halfSize; ++y)
+	{
+		for (int x = -kernel.halfSize; x <= kernel.halfSize; ++x)
+		{
+			const float distance{ sqrtf(static_cast<float>(x * x + y * y)) };
+
+			float weight{ 0.f };
+			if (radiusInCells <= 0.f)
+			{
+				weight = 1.f;
+			}
+			else if (distance <= radiusInCells)
+			{
+				const float remaining{ 1.f - distance / radiusInCells };
+				switch (falloff)
+				{
+				case InfluenceFalloff::Constant: weight = 1.f; break;
+				case InfluenceFalloff::Linear: weight = remaining; break;
+				case InfluenceFalloff::Quadratic: weight = remaining * remaining; break;
+				}
+			}
+
+			kernel.weights[(y + kernel.halfSize) * size + x + kernel.halfSize] = weight;
+		}
+	}
+
+	return m_RadialKernels.emplace(key, std::move(kernel)).first->second;
+}
+
+void LayeredInfluenceMap::StampRows(Layer& layer, const std::vector<InfluenceSource>& sources, int rowBegin, int rowEnd) const
+{
+	for (size_t i = 0; i < sources.size(); ++i)
+	{
+		const InfluenceSource& source{ sources[i] };
+		const RadialKernel& kernel{ *m_pSourceKernels[i] };
+		const int size{ kernel.halfSize * 2 + 1 };
+
+		const int centerCol{ static_cast<int>(floorf(source.position.x / m_CellSize)) };
+		const int centerRow{ static_cast<int>(floorf(source.position.y / m_CellSize)) };
+
+		// Clip the kernel to the grid and to the rows of this band
+		const int colBegin{ std::max(centerCol - kernel.halfSize, 0) };
+		const int colEnd{ std::min(centerCol + kernel.halfSize + 1, m_Stencil.columns) };
+		const int stampRowBegin{ std::max(centerRow - kernel.halfSize, rowBegin) };
+		const int stampRowEnd{ std::min(centerRow + kernel.halfSize + 1, rowEnd) };
+		if (colBegin >= colEnd)
+			continue;
+
+		for (int row = stampRowBegin; row < stampRowEnd; ++row)
+		{
+			const float* pWeights{ kernel.weights.data() + (row - centerRow + kernel.halfSize) * size + (colBegin - centerCol + kernel.halfSize) };
+			StampInfluenceSpan(layer.influence.data() + row * m_Stencil.columns + colBegin, pWeights, colEnd - colBegin, source.strength);
+		}
+	}
+}
+
+void LayeredInfluenceMap::PropagateLayer(Layer& layer)
+{
+	// Influence only spreads one cell per step, so only awake tiles and their neighbors can change
+	m_TilesToPropagate.clear();
+	std::fill(m_IsTileQueued.begin(), m_IsTileQueued.end(), 0);
+	for (int tileRow = 0; tileRow < m_NrOfTileRows; ++tileRow)
+	{
+		for (int tileCol = 0; tileCol < m_NrOfTileColumns; ++tileCol)
+		{
+			if (!layer.isTileAwake[tileRow * m_NrOfTileColumns + tileCol])
+				continue;
+
+			for (int neighborRow = std::max(tileRow - 1, 0); neighborRow <= std::min(tileRow + 1, m_NrOfTileRows - 1); ++neighborRow)
+			{
+				for (int neighborCol = std::max(tileCol - 1, 0); neighborCol <= std::min(tileCol + 1, m_NrOfTileColumns - 1); ++neighborCol)
+				{
+					const int neighborIdx{ neighborRow * m_NrOfTileColumns + neighborCol };
+					if (m_IsTileQueued[neighborIdx])
+						continue;
+
+					m_IsTileQueued[neighborIdx] = 1;
+					m_TilesToPropagate.push_back(neighborIdx);
+				}
+			}
+		}
+	}
+
+	if (m_TilesToPropagate.empty())
+		return;
+	m_NrOfPropagatedTiles += static_cast<int>(m_TilesToPropagate.size());
+
+	InfluenceGridStencil stencil{ m_Stencil };
+	stencil.straightFactor = expf(-m_CostStraight * layer.decay);
+	stencil.diagonalFactor = expf(-m_CostDiagonal * layer.decay);
+	stencil.momentum = layer.momentum;
+
+	auto propagateTiles = [this, &layer, &stencil](int begin, int end)
+	{
+		for (int i = begin; i < end; ++i)
+		{
+			const int tileIdx{ m_TilesToPropagate[i] };
+			const int colBegin{ (tileIdx % m_NrOfTileColumns) * m_TileSize };
+			const int rowBegin{ (tileIdx / m_NrOfTileColumns) * m_TileSize };
+
+			const float maxAbsInfluence{ PropagateInfluenceGridRegion(stencil, layer.influence.data(), layer.buffer.data(),
+				colBegin, std::min(colBegin + m_TileSize, stencil.columns), rowBegin, std::min(rowBegin + m_TileSize, stencil.rows)) };
+			layer.isTileAwake[tileIdx] = maxAbsInfluence > m_NegligibleInfluence;
+		}
+	};
+
+	JOBSYSTEM->ParallelForRanges(static_cast<int>(m_TilesToPropagate.size()), static_cast<int>(GetNrOfPropagationThreads()), propagateTiles);
+
+	// Tiles that fell asleep are zeroed in both buffers, so skipping them in later steps gives the same result.
+	// This can only happen after the propagation, other tiles read their border cells.
+	for (int tileIdx : m_TilesToPropagate)
+	{
+		if (!layer.isTileAwake[tileIdx])
+			ClearTile(layer, tileIdx);
+	}
+
+	layer.influence.swap(layer.buffer);
+}
+
+void LayeredInfluenceMap::ClearTile(Layer& layer, int tileIdx)
+{
+	const int colBegin{ (tileIdx % m_NrOfTileColumns) * m_TileSize };
+	const int rowBegin{ (tileIdx / m_NrOfTileColumns) * m_TileSize };
+	const int colEnd{ std::min(colBegin + m_TileSize, m_Stencil.columns) };
+	const int rowEnd{ std::min(rowBegin + m_TileSize, m_Stencil.rows) };
+
+	for (int row = rowBegin; row < rowEnd; ++row)
+	{
+		const int rowStart{ row * m_Stencil.columns };
+		std::fill(layer.influence.begin() + rowStart + colBegin, layer.influence.begin() + rowStart + colEnd, 0.f);
+		std::fill(layer.buffer.begin() + rowStart + colBegin, layer.buffer.begin() + rowStart + colEnd, 0.f);
+	}
+}
+
+void LayeredInfluenceMap::WakeTile(Layer& layer, int idx)
+{
+	const int tileCol{ (idx % m_Stencil.columns) / m_TileSize };
+	const int tileRow{ (idx / m_Stencil.columns) / m_TileSize };
+	layer.isTileAwake[tileRow * m_NrOfTileColumns + tileCol] = 1;
+}
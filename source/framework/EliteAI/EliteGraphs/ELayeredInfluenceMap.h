@@ -0,0 +1,150 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// ELayeredInfluenceMap.h: Several influence layers (e.g. threat, food) on one regular grid.
+// Every layer has its own momentum and decay. The grid is split in tiles that fall asleep once their
+// influence is negligible, propagation only touches awake tiles and their direct neighbors.
+// Layers are combined at query time through a list of layer weights.
+/*=============================================================================*/
+#pragma once
+#include "EInfluenceMapKernels.h"
+
+namespace Elite
+{
+	struct InfluenceLayerWeight
+	{
+		int layer;
+		float weight;
+	};
+
+	enum class InfluenceFalloff
+	{
+		Constant,	// full strength up to the radius
+		Linear,		// 1 - distance / radius
+		Quadratic	// (1 - distance / radius)^2
+	};
+
+	struct InfluenceSource
+	{
+		Elite::Vector2 position;
+		float radius;	// 0 only stamps the cell at the position
+		float strength;
+		InfluenceFalloff falloff;
+	};
+
+	class LayeredInfluenceMap final
+	{
+	public:
+		LayeredInfluenceMap(int columns, int rows, float cellSize, bool isConnectedDiagonally = true, float costStraight = 1.f, float costDiagonal = 1.5f);
+		~LayeredInfluenceMap() = default;
+
+		LayeredInfluenceMap(const LayeredInfluenceMap& other) = delete;
+		LayeredInfluenceMap& operator=(const LayeredInfluenceMap& other) = delete;
+		LayeredInfluenceMap(LayeredInfluenceMap&& other) = delete;
+		LayeredInfluenceMap& operator=(LayeredInfluenceMap&& other) = delete;
+
+		//Layers, the returned id is used in all other functions
+		int AddLayer(const std::string& name, float momentum, float decay);
+		int GetNrOfLayers() const { return static_cast<int>(m_Layers.size()); }
+		const std::string& GetLayerName(int layer) const { return m_Layers[layer].name; }
+
+		float GetMomentum(int layer) const { return m_Layers[layer].momentum; }
+		void SetMomentum(int layer, float momentum) { m_Layers[layer].momentum = momentum; }
+		float GetDecay(int layer) const { return m_Layers[layer].decay; }
+		void SetDecay(int layer, float decay) { m_Layers[layer].decay = decay; }
+
+		//Grid
+		int GetColumns() const { return m_Stencil.columns; }
+		int GetRows() const { return m_Stencil.rows; }
+		float GetCellSize() const { return m_CellSize; }
+		int GetCellIdxAtWorldPos(const Elite::Vector2& pos) const;
+		Elite::Vector2 GetCellWorldPos(int idx) const;
+
+		//Influence
+		float GetInfluence(int layer, int idx) const { return m_Layers[layer].influence[idx]; }
+		void SetInfluence(int layer, int idx, float influence);
+		void SetInfluenceAtPosition(int layer, const Elite::Vector2& pos, float influence);
+		float GetWeightedInfluence(const std::vector<InfluenceLayerWeight>& weights, int idx) const;
+
+		//Stamps all sources in one pass. Where sources overlap, or a cell already has influence, the highest absolute value wins.
+		//The radial falloff of every (radius, falloff) pair is computed once and cached.
+		void StampInfluence(int layer, const std::vector<InfluenceSource>& sources);
+
+		//Finds the cell with the highest weighted influence within the radius, minus distancePenalty per unit of distance.
+		//Returns false when no cell of the grid lies within the radius.
+		bool FindBestCellInRadius(const Elite::Vector2& center, float radius, const std::vector<InfluenceLayerWeight>& weights,
+			Elite::Vector2& bestPos, float& bestInfluence, float distancePenalty = 0.f) const;
+
+		//Propagation
+		void PropagateInfluence(float deltaTime);
+
+		float GetPropagationInterval() const { return m_PropagationInterval; }
+		void SetPropagationInterval(float propagationInterval) { m_PropagationInterval = propagationInterval; }
+
+		//Tiles whose absolute influence stays below this value fall asleep and are cleared
+		float GetNegligibleInfluence() const { return m_NegligibleInfluence; }
+		void SetNegligibleInfluence(float negligibleInfluence) { m_NegligibleInfluence = negligibleInfluence; }
+
+		//Stamping and propagation run on the job system, on at most this many threads (including the calling thread)
+		unsigned int GetNrOfPropagationThreads() const { return std::min(m_NrOfPropagationThreads, JOBSYSTEM->GetNrOfThreads()); }
+		void SetNrOfPropagationThreads(unsigned int nrOfThreads) { m_NrOfPropagationThreads = std::max(nrOfThreads, 1u); }
+
+		//Stats of the last propagation step, summed over all layers
+		int GetNrOfTiles() const { return m_NrOfTileColumns * m_NrOfTileRows * GetNrOfLayers(); }
+		int GetNrOfPropagatedTiles() const { return m_NrOfPropagatedTiles; }
+
+		//Only draws the cells of awake tiles that have a non negligible weighted influence
+		void Render(const std::vector<InfluenceLayerWeight>& weights, float maxAbsInfluence) const;
+
+	private:
+		struct Layer
+		{
+			std::string name;
+			float momentum;
+			float decay;
+			std::vector<float> influence;	// row major, read by the propagation
+			std::vector<float> buffer;		// written by the propagation, swapped with influence afterwards
+			std::vector<char> isTileAwake;	// char instead of bool, tiles are written from different threads
+		};
+
+		//Falloff weights of a source in the center cell, (2 * halfSize + 1)^2 cells row major
+		struct RadialKernel
+		{
+			int halfSize;
+			std::vector<float> weights;
+		};
+		const RadialKernel& GetRadialKernel(float radius, InfluenceFalloff falloff);
+		void StampRows(Layer& layer, const std::vector<InfluenceSource>& sources, int rowBegin, int rowEnd) const;
+
+		void PropagateLayer(Layer& layer);
+		void ClearTile(Layer& layer, int tileIdx);
+		void WakeTile(Layer& layer, int idx);
+
+		static const int m_TileSize{ 16 };
+
+		InfluenceGridStencil m_Stencil{};
+		float m_CellSize;
+		float m_CostStraight;
+		float m_CostDiagonal;
+
+		int m_NrOfTileColumns;
+		int m_NrOfTileRows;
+
+		std::vector<Layer> m_Layers{};
+		std::vector<int> m_TilesToPropagate{};
+		std::vector<char> m_IsTileQueued{};
+		int m_NrOfPropagatedTiles{ 0 };
+
+		std::unordered_map<unsigned int, RadialKernel> m_RadialKernels{};
+		std::vector<const RadialKernel*> m_pSourceKernels{}; // kernel of every source of the current stamp
+
+		float m_NegligibleInfluence = 0.1f;
+		float m_PropagationInterval = .05f; //in Seconds
+		float m_TimeSinceLastPropagation = 0.0f;
+
+		unsigned int m_NrOfPropagationThreads = 1;
+
+		Elite::Color m_NegativeColor{ 1.f, 0.2f, 0.f };
+		Elite::Color m_PositiveColor{ 0.f, 0.2f, 1.f };
+	};
+}
@@ -28,12 +28,38 @@ Elite::NavGraph::NavGraph(const Polygon& contourMesh, float playerRadius = 1.0f)
 	CreateNavigationGraph();
 }
 
+Elite::NavGraph::NavGraph() :
+	Graph2D(false),
+	m_pNavMeshPolygon(new Polygon())
+{
+}
+
 Elite::NavGraph::~NavGraph()
 {
 	delete m_pNavMeshPolygon; 
 	m_pNavMeshPolygon = nullptr;
 }
 
+Elite::NavGraph* Elite::NavGraph::CreateFromFile(const std::string& path)
+{
+	NavGraph* pNavGraph = new NavGraph();
+	if (!pNavGraph->LoadFromFile(path))
+		SAFE_DELETE(pNavGraph);
+
+	return pNavGraph;
+}
+
+void Elite::NavGraph::WriteSections(BinaryFileWriter& writer) const
+{
+	Graph2D::WriteSections(writer);
+	m_pNavMeshPolygon->WriteSections(writer);
+}
+
+bool Elite::NavGraph::ReadSections(const BinaryFileReader& reader)
+{
+	return Graph2D::ReadSections(reader) && m_pNavMeshPolygon->ReadSections(reader);
+}
+
 int Elite::NavGraph::GetNodeIdxFromLineIdx(int lineIdx) const
 {
 	auto nodeIt = std::find_if(m_Nodes.begin(), m_Nodes.end(), [lineIdx](const NavGraphNode* n) { return n->GetLineIndex() == lineIdx; });
@@ -58,7 +84,7 @@ void Elite::NavGraph::CreateNavigationGraph()
 		// If the edge is shared by two triangles, add the center of the edge to the nodes list
 		if (m_pNavMeshPolygon->GetTrianglesFromLineIndex(edge->index).size() > 1)
 		{
-			AddNode(new NavGraphNode(GetNextFreeNodeIndex(), edge->index, (edge->p1 + edge->p2) / 2));
+			AddNode(CreateNode(GetNextFreeNodeIndex(), edge->index, (edge->p1 + edge->p2) / 2));
 		}
 	}
 	
@@ -78,13 +104,13 @@ void Elite::NavGraph::CreateNavigationGraph()
 		switch (validNodeIndexes.size())
 		{
 		case 2:
-			AddConnection(new GraphConnection2D(validNodeIndexes[0], validNodeIndexes[1]));
+			AddConnection(CreateConnection(validNodeIndexes[0], validNodeIndexes[1]));
 			break;
 		case 3:
 		{
-			AddConnection(new GraphConnection2D(validNodeIndexes[0], validNodeIndexes[1]));
-			AddConnection(new GraphConnection2D(validNodeIndexes[1], validNodeIndexes[2]));
-			AddConnection(new GraphConnection2D(validNodeIndexes[2], validNodeIndexes[0]));
+			AddConnection(CreateConnection(validNodeIndexes[0], validNodeIndexes[1]));
+			AddConnection(CreateConnection(validNodeIndexes[1], validNodeIndexes[2]));
+			AddConnection(CreateConnection(validNodeIndexes[2], validNodeIndexes[0]));
 		}
 			break;
 		}
@@ -12,13 +12,21 @@ namespace Elite
 		NavGraph(const Polygon& baseMesh, float playerRadius );
 		~NavGraph();
 
+		//Graph and triangulated navigation mesh in one file (SaveToFile), nullptr when it can't be loaded
+		static NavGraph* CreateFromFile(const std::string& path);
+
 		int GetNodeIdxFromLineIdx(int lineIdx) const;
 		Polygon* GetNavMeshPolygon() const;
 
+	protected:
+		virtual void WriteSections(BinaryFileWriter& writer) const override;
+		virtual bool ReadSections(const BinaryFileReader& reader) override;
+
 	private:
 		//--- Datamembers ---
 		Polygon* m_pNavMeshPolygon = nullptr; //Polygon that represents navigation mesh
 
+		NavGraph();
 		void CreateNavigationGraph();
 
 
@@ -13,14 +13,14 @@ namespace Elite
 		struct NodeRecord
 		{
 			T_NodeType* pNode = nullptr;
-			T_ConnectionType* pConnection = nullptr;
+			int fromNodeIdx = invalid_node_index; // the node the optimal connection comes from, connections of generated graphs don't outlive the search step
 			float costSoFar = 0.f; // accumulated g-costs of all the connections leading up to this one
 			float estimatedTotalCost = 0.f; // f-cost (= costSoFar + h-cost)
 
 			bool operator==(const NodeRecord& other) const
 			{
 				return pNode == other.pNode
-					&& pConnection == other.pConnection
+					&& fromNodeIdx == other.fromNodeIdx
 					&& costSoFar == other.costSoFar
 					&& estimatedTotalCost == other.estimatedTotalCost;
 			};
@@ -50,11 +50,15 @@ namespace Elite
 	template <class T_NodeType, class T_ConnectionType>
 	std::vector<T_NodeType*> AStar<T_NodeType, T_ConnectionType>::FindPath(T_NodeType* pStartNode, T_NodeType* pGoalNode)
 	{
+		ELITE_PROFILE_SCOPE("AStar::FindPath");
+
 		std::vector<T_NodeType*> path;
 		std::vector<NodeRecord> openList;
 		std::vector<NodeRecord> closedList;
 		
-		NodeRecord curRecord{ pStartNode, nullptr, 0.0f, GetHeuristicCost(pStartNode, pGoalNode) };
+		typename IGraph<T_NodeType, T_ConnectionType>::ConnectionBuffer connectionBuffer{};
+		
+		NodeRecord curRecord{ pStartNode, invalid_node_index, 0.0f, GetHeuristicCost(pStartNode, pGoalNode) };
 		openList.push_back(curRecord);
 
 		// Keep searching for a connection that leads to the end node
@@ -67,7 +71,7 @@ namespace Elite
 			if (curRecord.pNode == pGoalNode) break;
 
 			// For every neighbor
-			for (auto& connection : m_pGraph->GetNodeConnections(curRecord.pNode))
+			for (auto& connection : m_pGraph->GetNodeConnections(curRecord.pNode, connectionBuffer))
 			{
 				// Get the current node/neighbor
 				T_NodeType* pCurNode{ m_pGraph->GetNode(connection->GetTo()) };
@@ -124,7 +128,7 @@ namespace Elite
 
 				// At this point any expensive connection to the current node is removed (if it existed)
 				//		We create a new nodeRecord and add it to the openList
-				openList.push_back(NodeRecord{ pCurNode, connection, curGCost, curGCost + GetHeuristicCost(pCurNode, pGoalNode) });
+				openList.push_back(NodeRecord{ pCurNode, connection->GetFrom(), curGCost, curGCost + GetHeuristicCost(pCurNode, pGoalNode) });
 			}
 
 			// Remove the current record from the openList and add it to the closestList
@@ -155,7 +159,7 @@ namespace Elite
 			// Look in the closedList for the cheapest route to the previous node in the connection
 			for (const NodeRecord& existingRecord : closedList)
 			{
-				if (existingRecord.pNode->GetIndex() == curRecord.pConnection->GetFrom())
+				if (existingRecord.pNode->GetIndex() == curRecord.fromNodeIdx)
 				{
 					// Set the currentRecord to the found record
 					curRecord = existingRecord;
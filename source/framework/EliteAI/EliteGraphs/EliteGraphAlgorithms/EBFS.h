@@ -26,6 +26,8 @@ namespace Elite
 		std::queue<T_NodeType*> openList;
 		std::map<T_NodeType*, T_NodeType*> closedList;
 
+		typename IGraph<T_NodeType, T_ConnectionType>::ConnectionBuffer connectionBuffer{};
+
 		openList.push(pStartNode);
 
 		while (!openList.empty())
@@ -35,7 +37,7 @@ namespace Elite
 
 			if (pCurNode == pDestinationNode) break;
 
-			for (auto& connection : m_pGraph->GetNodeConnections(pCurNode))
+			for (auto& connection : m_pGraph->GetNodeConnections(pCurNode, connectionBuffer))
 			{
 				T_NodeType* pNextNode{ m_pGraph->GetNode(connection->GetTo()) };
 
@@ -6,6 +6,9 @@ namespace Elite
 	void GraphRenderer::RenderCircleNode(Vector2 pos, std::string text /*= ""*/, float radius /*= 3.0f*/, Elite::Color col /*= DEFAULT_NODE_COLOR*/, float depth /*= 0.0f*/) const
 	{
 		DEBUGRENDERER2D->DrawSolidCircle(pos, radius, { 0,0 }, col, depth);
+		if (text.empty())
+			return;
+
 		const auto stringOffset = Vector2{ -0.5f, 1.f };
 		DEBUGRENDERER2D->DrawString(pos + stringOffset, text.c_str());
 	}
@@ -21,6 +24,8 @@ namespace Elite
 		};
 
 		DEBUGRENDERER2D->DrawSolidPolygon(&verts[0], 4, col, depth);
+		if (text.empty())
+			return;
 
 		const auto stringOffset = Vector2{ -0.5f, 1.f };
 		DEBUGRENDERER2D->DrawString(pos + stringOffset, text.c_str());
@@ -33,6 +38,75 @@ namespace Elite
 		auto center = toPos + (fromPos - toPos) / 2;
 
 		DEBUGRENDERER2D->DrawSegment(toPos, fromPos, col, depth);
-		DEBUGRENDERER2D->DrawString(center, text.c_str());
+		if (!text.empty())
+			DEBUGRENDERER2D->DrawString(center, text.c_str());
+	}
+
+	void GraphRenderer::WriteRectNode(Vertex*& pTriangles, Vertex*& pLines, const Vector2& lower, const Vector2& upper, const Elite::Color& col, float depth) const
+	{
+		// Same output as DrawSolidPolygon with 4 points
+		const Vector2 verts[4]{ lower, Vector2(lower.x, upper.y), upper, Vector2(upper.x, lower.y) };
+		const Color fillColor(0.5f * col.r, 0.5f * col.g, 0.5f * col.b, 0.5f);
+
+		*pTriangles++ = Vertex(verts[0], depth, fillColor);
+		*pTriangles++ = Vertex(verts[1], depth, fillColor);
+		*pTriangles++ = Vertex(verts[2], depth, fillColor);
+		*pTriangles++ = Vertex(verts[0], depth, fillColor);
+		*pTriangles++ = Vertex(verts[2], depth, fillColor);
+		*pTriangles++ = Vertex(verts[3], depth, fillColor);
+
+		if (!pLines)
+			return;
+
+		depth -= DEPTH_SLICE_FINE_OFFSET;
+		for (int i = 0; i < 4; ++i)
+		{
+			*pLines++ = Vertex(verts[(i + 3) % 4], depth, col);
+			*pLines++ = Vertex(verts[i], depth, col);
+		}
+	}
+
+	void GraphRenderer::WriteCircleNode(Vertex*& pTriangles, Vertex*& pLines, const Vector2& center, float radius, const std::vector<Vector2>& unitCircle,
+		const Elite::Color& col, float depth) const
+	{
+		// Same output as DrawSolidCircle without the axis
+		const Color fillColor(0.5f * col.r, 0.5f * col.g, 0.5f * col.b, col.a);
+		const int nrOfSegments{ static_cast<int>(unitCircle.size()) };
+
+		for (int i = 0; i < nrOfSegments; ++i)
+		{
+			*pTriangles++ = Vertex(center, depth, fillColor);
+			*pTriangles++ = Vertex(center + radius * unitCircle[i], depth, fillColor);
+			*pTriangles++ = Vertex(center + radius * unitCircle[(i + 1) % nrOfSegments], depth, fillColor);
+		}
+
+		if (!pLines)
+			return;
+
+		depth -= DEPTH_SLICE_FINE_OFFSET;
+		for (int i = 0; i < nrOfSegments; ++i)
+		{
+			*pLines++ = Vertex(center + radius * unitCircle[i], depth, col);
+			*pLines++ = Vertex(center + radius * unitCircle[(i + 1) % nrOfSegments], depth, col);
+		}
+	}
+
+	void GraphRenderer::WriteConnection(Vertex*& pLines, const Vector2& fromPos, const Vector2& toPos, const Elite::Color& col, float depth) const
+	{
+		*pLines++ = Vertex(fromPos, depth, col);
+		*pLines++ = Vertex(toPos, depth, col);
+	}
+
+	bool GraphRenderer::IsPointVisible(const Vector2& pos, float radius, const Vector2& lower, const Vector2& upper)
+	{
+		return pos.x + radius >= lower.x && pos.x - radius <= upper.x
+			&& pos.y + radius >= lower.y && pos.y - radius <= upper.y;
+	}
+
+	bool GraphRenderer::IsSegmentVisible(const Vector2& p1, const Vector2& p2, const Vector2& lower, const Vector2& upper)
+	{
+		// Bounding box test, a segment that only passes near a corner is still drawn
+		return std::max(p1.x, p2.x) >= lower.x && std::min(p1.x, p2.x) <= upper.x
+			&& std::max(p1.y, p2.y) >= lower.y && std::min(p1.y, p2.y) <= upper.y;
 	}
 }
\ No newline at end of file
@@ -31,6 +31,16 @@ namespace Elite
 		void RenderRectNode(Vector2 pos, std::string text = "", float width = DEFAULT_NODE_RADIUS, Elite::Color col = DEFAULT_NODE_COLOR, float depth = 0.0f) const;
 		void RenderConnection(GraphConnection* con, Elite::Vector2 toPos, Elite::Vector2 fromPos, std::string text, Elite::Color col = DEFAULT_CONNECTION_COLOR, float depth = 0.0f) const;
 
+		// Batched rendering, writes straight into the debug renderer buffers. The pointers are moved past the written vertices.
+		// pLines can be nullptr to skip the outline.
+		void WriteRectNode(Vertex*& pTriangles, Vertex*& pLines, const Vector2& lower, const Vector2& upper, const Elite::Color& col, float depth) const;
+		void WriteCircleNode(Vertex*& pTriangles, Vertex*& pLines, const Vector2& center, float radius, const std::vector<Vector2>& unitCircle,
+			const Elite::Color& col, float depth) const;
+		void WriteConnection(Vertex*& pLines, const Vector2& fromPos, const Vector2& toPos, const Elite::Color& col, float depth) const;
+
+		static bool IsPointVisible(const Vector2& pos, float radius, const Vector2& lower, const Vector2& upper);
+		static bool IsSegmentVisible(const Vector2& p1, const Vector2& p2, const Vector2& lower, const Vector2& upper);
+
 		// Get correct color/text depending on the pNode/pConnection type
 		template<class T_NodeType, typename = typename enable_if<! is_base_of<GraphNode2D, T_NodeType>::value>::type>
 		Elite::Color GetNodeColor(T_NodeType* pNode) const;
@@ -54,6 +64,13 @@ namespace Elite
 
 		// variables
 		int m_FloatPrintPrecision = 1;
+
+		// Level of detail thresholds, in pixels on screen
+		const float m_MinCellPixelSize{ 3.f };			// smaller grid cells are merged into blocks
+		const float m_MinOutlinePixelSize{ 6.f };		// smaller nodes are drawn without outline
+		const float m_MinDetailedCirclePixelSize{ 8.f };	// smaller circle nodes get fewer segments
+		const float m_MinConnectionPixelLength{ 2.f };	// shorter connections are skipped
+		const float m_MinTextPixelSize{ 24.f };			// smaller nodes and connections get no labels
 	};
 
 
@@ -65,27 +82,80 @@ namespace Elite
 		bool renderNodeTxt /*= true*/, 
 		bool renderConnectionTxt /*= true*/) const
 	{
-		for (auto node : pGraph->GetAllNodes())
+		const Camera2D* pCamera{ DEBUGRENDERER2D->GetActiveCamera() };
+		Vector2 lower{}, upper{};
+		pCamera->GetVisibleWorldBounds(lower, upper);
+		const float pixelsPerUnit{ pCamera->GetPixelsPerWorldUnit() };
+
+		auto nodes = FrameArena::MakeVector<T_NodeType*>();
+		pGraph->GetAllNodes(nodes);
+
+		if (renderNodes)
 		{
-			if (renderNodes)
+			// Level of detail depends on the size of a node on screen
+			const float nodePixelSize{ DEFAULT_NODE_RADIUS * 2.f * pixelsPerUnit };
+			const std::vector<Vector2>& unitCircle{ DebugGeometry2D::GetUnitCircle(nodePixelSize >= m_MinDetailedCirclePixelSize ? DebugGeometry2D::CircleSegments : DebugGeometry2D::CoarseCircleSegments) };
+			const bool renderOutlines{ nodePixelSize >= m_MinOutlinePixelSize };
+			const bool renderText{ renderNodeTxt && nodePixelSize >= m_MinTextPixelSize };
+
+			int nrOfVisibleNodes{ 0 };
+			for (auto node : nodes)
+			{
+				if (IsPointVisible(pGraph->GetNodeWorldPos(node), DEFAULT_NODE_RADIUS, lower, upper))
+					++nrOfVisibleNodes;
+			}
+
+			const int nrOfSegments{ static_cast<int>(unitCircle.size()) };
+			Vertex* pTriangles{ DEBUGRENDERER2D->AllocateTriangleVertices(nrOfVisibleNodes * nrOfSegments * 3) };
+			Vertex* pLines{ renderOutlines ? DEBUGRENDERER2D->AllocateLineVertices(nrOfVisibleNodes * nrOfSegments * 2) : nullptr };
+
+			for (auto node : nodes)
 			{
-				std::string nodeTxt = "";
-				if (renderNodeTxt)
-					nodeTxt = GetNodeText(node);
+				const Vector2 nodePos{ pGraph->GetNodeWorldPos(node) };
+				if (!IsPointVisible(nodePos, DEFAULT_NODE_RADIUS, lower, upper))
+					continue;
 
-				RenderCircleNode(pGraph->GetNodeWorldPos(node),	nodeTxt, DEFAULT_NODE_RADIUS, GetNodeColor(node));
+				WriteCircleNode(pTriangles, pLines, nodePos, DEFAULT_NODE_RADIUS, unitCircle, GetNodeColor(node), 0.0f);
+
+				if (renderText)
+					DEBUGRENDERER2D->DrawString(nodePos + Vector2{ -0.5f, 1.f }, GetNodeText(node).c_str());
 			}
-		
-			if (renderConnections)
+		}
+
+		if (renderConnections)
+		{
+			// Connections shorter than a few pixels are skipped, labels only when they fit
+			const float minLengthSquared{ Square(m_MinConnectionPixelLength / pixelsPerUnit) };
+			const float minTextLengthSquared{ Square(m_MinTextPixelSize / pixelsPerUnit) };
+
+			typename IGraph<T_NodeType, T_ConnectionType>::ConnectionBuffer connectionBuffer{};
+			int nrOfVisibleConnections{ 0 };
+			for (auto node : nodes)
 			{
-				//Connections
-				for (auto con : pGraph->GetNodeConnections(node->GetIndex()))
+				for (auto con : pGraph->GetNodeConnections(node->GetIndex(), connectionBuffer))
 				{
-					std::string conTxt = "";
-					if (renderConnectionTxt)
-						conTxt = GetConnectionText(con);
+					const Vector2 fromPos{ pGraph->GetNodeWorldPos(con->GetFrom()) };
+					const Vector2 toPos{ pGraph->GetNodeWorldPos(con->GetTo()) };
+					if (fromPos.DistanceSquared(toPos) >= minLengthSquared && IsSegmentVisible(fromPos, toPos, lower, upper))
+						++nrOfVisibleConnections;
+				}
+			}
 
-					RenderConnection(con, pGraph->GetNodeWorldPos(con->GetTo()), pGraph->GetNodeWorldPos(con->GetFrom()), conTxt, GetConnectionColor(con));
+			Vertex* pLines{ DEBUGRENDERER2D->AllocateLineVertices(nrOfVisibleConnections * 2) };
+			for (auto node : nodes)
+			{
+				for (auto con : pGraph->GetNodeConnections(node->GetIndex(), connectionBuffer))
+				{
+					const Vector2 fromPos{ pGraph->GetNodeWorldPos(con->GetFrom()) };
+					const Vector2 toPos{ pGraph->GetNodeWorldPos(con->GetTo()) };
+					const float lengthSquared{ fromPos.DistanceSquared(toPos) };
+					if (lengthSquared < minLengthSquared || !IsSegmentVisible(fromPos, toPos, lower, upper))
+						continue;
+
+					WriteConnection(pLines, toPos, fromPos, GetConnectionColor(con), 0.0f);
+
+					if (renderConnectionTxt && lengthSquared >= minTextLengthSquared)
+						DEBUGRENDERER2D->DrawString(toPos + (fromPos - toPos) / 2, GetConnectionText(con).c_str());
 				}
 			}
 		}
@@ -99,39 +169,88 @@ namespace Elite
 		bool renderConnections, 
 		bool renderConnectionsCosts) const
 	{
+		const Camera2D* pCamera{ DEBUGRENDERER2D->GetActiveCamera() };
+		Vector2 lower{}, upper{};
+		pCamera->GetVisibleWorldBounds(lower, upper);
+
+		const int columns{ pGraph->m_NrOfColumns };
+		const int rows{ pGraph->m_NrOfRows };
+		const float cellSize{ float(pGraph->m_CellSize) };
+		const float cellPixelSize{ cellSize * pCamera->GetPixelsPerWorldUnit() };
+
+		// Only the cells within the camera view
+		const int colBegin{ std::max(int(floorf(lower.x / cellSize)), 0) };
+		const int colEnd{ std::min(int(floorf(upper.x / cellSize)) + 1, columns) };
+		const int rowBegin{ std::max(int(floorf(lower.y / cellSize)), 0) };
+		const int rowEnd{ std::min(int(floorf(upper.y / cellSize)) + 1, rows) };
+		if (colBegin >= colEnd || rowBegin >= rowEnd)
+			return;
+
 		if (renderNodes)
 		{
-			//Nodes/Grid
-			for (auto r = 0; r < pGraph->m_NrOfRows; ++r)
+			// Coarse level of detail: cells smaller than a few pixels are merged in blocks that take the color of their first cell
+			const int blockSize{ cellPixelSize >= m_MinCellPixelSize ? 1 : int(ceilf(m_MinCellPixelSize / cellPixelSize)) };
+			const bool renderOutlines{ blockSize == 1 && cellPixelSize >= m_MinOutlinePixelSize };
+			const int blockColBegin{ colBegin - colBegin % blockSize };
+			const int blockRowBegin{ rowBegin - rowBegin % blockSize };
+			const int nrOfBlocks{ ((colEnd - blockColBegin + blockSize - 1) / blockSize) * ((rowEnd - blockRowBegin + blockSize - 1) / blockSize) };
+
+			Vertex* pTriangles{ DEBUGRENDERER2D->AllocateTriangleVertices(nrOfBlocks * 6) };
+			Vertex* pLines{ renderOutlines ? DEBUGRENDERER2D->AllocateLineVertices(nrOfBlocks * 8) : nullptr };
+
+			for (int r = blockRowBegin; r < rowEnd; r += blockSize)
 			{
-				for (auto c = 0; c < pGraph->m_NrOfColumns; ++c)
+				for (int c = blockColBegin; c < colEnd; c += blockSize)
 				{
-					int idx = r * pGraph->m_NrOfColumns + c;
-					Vector2 cellPos{ pGraph->GetNodeWorldPos(idx) };
-					int cellSize = pGraph->m_CellSize;
-
-					//Node
-					std::string nodeTxt{};
-					if (renderNodeNumbers)
-						nodeTxt = GetNodeText(pGraph->GetNode(idx));
+					const Vector2 blockLower{ c * cellSize, r * cellSize };
+					const Vector2 blockUpper{ std::min(c + blockSize, columns) * cellSize, std::min(r + blockSize, rows) * cellSize };
+					WriteRectNode(pTriangles, pLines, blockLower, blockUpper, GetNodeColor(pGraph->GetNode(c, r)), 0.1f);
+				}
+			}
 
-					RenderRectNode(cellPos, nodeTxt, float(cellSize), GetNodeColor(pGraph->GetNode(idx)), 0.1f);
+			// Strings are only built when they are visible and readable
+			if (renderNodeNumbers && cellPixelSize >= m_MinTextPixelSize)
+			{
+				for (int r = rowBegin; r < rowEnd; ++r)
+				{
+					for (int c = colBegin; c < colEnd; ++c)
+						DEBUGRENDERER2D->DrawString(pGraph->GetNodeWorldPos(c, r) + Vector2{ -0.5f, 1.f }, GetNodeText(pGraph->GetNode(c, r)).c_str());
 				}
 			}
 		}
 
-		if (renderConnections)
+		if (renderConnections && cellPixelSize >= m_MinConnectionPixelLength)
 		{
-			for (auto node : pGraph->GetAllNodes())
+			const bool renderCosts{ renderConnectionsCosts && cellPixelSize >= m_MinTextPixelSize };
+
+			// Connections can leave the view by one cell
+			const int connectionColBegin{ std::max(colBegin - 1, 0) };
+			const int connectionColEnd{ std::min(colEnd + 1, columns) };
+			const int connectionRowBegin{ std::max(rowBegin - 1, 0) };
+			const int connectionRowEnd{ std::min(rowEnd + 1, rows) };
+
+			typename IGraph<T_NodeType, T_ConnectionType>::ConnectionBuffer connectionBuffer{};
+			int nrOfConnections{ 0 };
+			for (int r = connectionRowBegin; r < connectionRowEnd; ++r)
 			{
-				//Connections
-				for (auto con : pGraph->GetNodeConnections(node->GetIndex()))
-				{
-					std::string conTxt{ };
-					if (renderConnectionsCosts)
-						conTxt = GetConnectionText(con);
+				for (int c = connectionColBegin; c < connectionColEnd; ++c)
+					nrOfConnections += static_cast<int>(pGraph->GetNodeConnections(pGraph->GetIndex(c, r), connectionBuffer).size());
+			}
 
-					RenderConnection(con, pGraph->GetNodeWorldPos(con->GetTo()), pGraph->GetNodeWorldPos(con->GetFrom()), conTxt, GetConnectionColor(con));
+			Vertex* pLines{ DEBUGRENDERER2D->AllocateLineVertices(nrOfConnections * 2) };
+			for (int r = connectionRowBegin; r < connectionRowEnd; ++r)
+			{
+				for (int c = connectionColBegin; c < connectionColEnd; ++c)
+				{
+					for (auto con : pGraph->GetNodeConnections(pGraph->GetIndex(c, r), connectionBuffer))
+					{
+						const Vector2 toPos{ pGraph->GetNodeWorldPos(con->GetTo()) };
+						const Vector2 fromPos{ pGraph->GetNodeWorldPos(con->GetFrom()) };
+						WriteConnection(pLines, toPos, fromPos, GetConnectionColor(con), 0.0f);
+
+						if (renderCosts)
+							DEBUGRENDERER2D->DrawString(toPos + (fromPos - toPos) / 2, GetConnectionText(con).c_str());
+					}
 				}
 			}
 		}
@@ -38,25 +38,25 @@ namespace Elite
 			auto graphCopy{ pNavGraph->Clone() };
 			
 			//Create extra node for the Start Node (Agent's position)
-			NavGraphNode* startNode{ new NavGraphNode { graphCopy->GetNextFreeNodeIndex(), -1, startPos}};
+			NavGraphNode* startNode{ graphCopy->CreateNode(graphCopy->GetNextFreeNodeIndex(), -1, startPos) };
 			graphCopy->AddNode(startNode);
 			for (int edgeIdx : startTriangle->metaData.IndexLines)
 			{
 				const int targetNodeIdx{ pNavGraph->GetNodeIdxFromLineIdx(edgeIdx) };
 				if (targetNodeIdx == invalid_node_index) continue;
 
-				graphCopy->AddConnection(new GraphConnection2D{ startNode->GetIndex(), targetNodeIdx, startPos.Distance(graphCopy->GetNode(targetNodeIdx)->GetPosition()) });
+				graphCopy->AddConnection(graphCopy->CreateConnection(startNode->GetIndex(), targetNodeIdx, startPos.Distance(graphCopy->GetNode(targetNodeIdx)->GetPosition())));
 			}
 			
 			//Create extra node for the endNode
-			NavGraphNode* endNode{ new NavGraphNode { graphCopy->GetNextFreeNodeIndex(), endPos } };
+			NavGraphNode* endNode{ graphCopy->CreateNode(graphCopy->GetNextFreeNodeIndex(), endPos) };
 			graphCopy->AddNode(endNode);
 			for (int edgeIdx : endTriangle->metaData.IndexLines)
 			{
 				const int targetNodeIdx{ pNavGraph->GetNodeIdxFromLineIdx(edgeIdx) };
 				if (targetNodeIdx == invalid_node_index) continue;
 
-				graphCopy->AddConnection(new GraphConnection2D{ endNode->GetIndex(), targetNodeIdx, endPos.Distance(graphCopy->GetNode(targetNodeIdx)->GetPosition()) });
+				graphCopy->AddConnection(graphCopy->CreateConnection(endNode->GetIndex(), targetNodeIdx, endPos.Distance(graphCopy->GetNode(targetNodeIdx)->GetPosition())));
 			}
 			
 			//Run A star on new graph
@@ -647,6 +647,127 @@ void Elite::Polygon::Split()
 }
 #pragma endregion //PrivateTriangulationFunctions
 //----------------------------------------------------------
+#pragma region Serialization
+namespace
+{
+	const uint32_t PolygonFileMagic = Elite::MakeFourCC('E', 'P', 'O', 'L');
+	const uint32_t PolygonFileVersion = 1;
+
+	const uint32_t PolygonInfoSection = Elite::MakeFourCC('P', 'I', 'N', 'F');
+	const uint32_t PolygonPointsSection = Elite::MakeFourCC('P', 'P', 'T', 'S');		//own points, then those of each child
+	const uint32_t PolygonChildrenSection = Elite::MakeFourCC('P', 'C', 'H', 'D');	//number of points per child
+	const uint32_t PolygonLinesSection = Elite::MakeFourCC('P', 'L', 'I', 'N');
+	const uint32_t PolygonTrianglesSection = Elite::MakeFourCC('P', 'T', 'R', 'I');
+
+	struct PolygonFileInfo
+	{
+		int nrOfPoints;
+		int isTriangulated;
+	};
+}
+
+bool Elite::Polygon::SaveToFile(const std::string& path) const
+{
+	BinaryFileWriter writer{ PolygonFileMagic, PolygonFileVersion };
+	WriteSections(writer);
+	return writer.Write(path);
+}
+
+bool Elite::Polygon::LoadFromFile(const std::string& path)
+{
+	BinaryFileReader reader{};
+	if (!reader.Open(path, PolygonFileMagic, PolygonFileVersion))
+		return false;
+
+	return ReadSections(reader);
+}
+
+void Elite::Polygon::WriteSections(BinaryFileWriter& writer) const
+{
+	const PolygonFileInfo info{ static_cast<int>(m_vPoints.size()), m_isTriangulated ? 1 : 0 };
+	writer.AddSection(PolygonInfoSection, &info, 1);
+
+	std::vector<Vector2> points{ m_vPoints.begin(), m_vPoints.end() };
+	std::vector<int> childSizes{};
+	childSizes.reserve(m_vChildren.size());
+	for (const Polygon& child : m_vChildren)
+	{
+		points.insert(points.end(), child.m_vPoints.begin(), child.m_vPoints.end());
+		childSizes.push_back(static_cast<int>(child.m_vPoints.size()));
+	}
+	writer.AddSection(PolygonPointsSection, points);
+	writer.AddSection(PolygonChildrenSection, childSizes);
+
+	std::vector<Line> lines{};
+	lines.reserve(m_vpLines.size());
+	for (const Line* pLine : m_vpLines)
+		lines.push_back(*pLine);
+	writer.AddSection(PolygonLinesSection, lines);
+
+	std::vector<Triangle> triangles{};
+	triangles.reserve(m_vpTriangles.size());
+	for (const Triangle* pTriangle : m_vpTriangles)
+		triangles.push_back(*pTriangle);
+	writer.AddSection(PolygonTrianglesSection, triangles);
+}
+
+bool Elite::Polygon::ReadSections(const BinaryFileReader& reader)
+{
+	size_t nrOfInfos{}, nrOfPoints{}, nrOfChildren{}, nrOfLines{}, nrOfTriangles{};
+	const PolygonFileInfo* pInfo{ reader.GetSection<PolygonFileInfo>(PolygonInfoSection, nrOfInfos) };
+	const Vector2* pPoints{ reader.GetSection<Vector2>(PolygonPointsSection, nrOfPoints) };
+	const int* pChildSizes{ reader.GetSection<int>(PolygonChildrenSection, nrOfChildren) };
+	const Line* pLines{ reader.GetSection<Line>(PolygonLinesSection, nrOfLines) };
+	const Triangle* pTriangles{ reader.GetSection<Triangle>(PolygonTrianglesSection, nrOfTriangles) };
+
+	//A section that is there but can't be read was written with another Line or Triangle layout (USE_TRIANGLE_METADATA)
+	if (nrOfInfos != 1 || pInfo->nrOfPoints < 0
+		|| (!pLines && reader.HasSection(PolygonLinesSection)) || (!pTriangles && reader.HasSection(PolygonTrianglesSection)))
+		return false;
+
+	size_t nrOfChildPoints{ 0 };
+	for (size_t i = 0; i < nrOfChildren; ++i)
+	{
+		if (pChildSizes[i] < 0)
+			return false;
+		nrOfChildPoints += pChildSizes[i];
+	}
+	if (static_cast<size_t>(pInfo->nrOfPoints) + nrOfChildPoints != nrOfPoints)
+		return false;
+
+	//Replace everything
+	for (auto t : m_vpTriangles)
+		SAFE_DELETE(t);
+	m_vpTriangles.clear();
+	for (auto l : m_vpLines)
+		SAFE_DELETE(l);
+	m_vpLines.clear();
+	m_vChildren.clear();
+
+	const Vector2* pCurrent{ pPoints };
+	m_vPoints.assign(pCurrent, pCurrent + pInfo->nrOfPoints);
+	pCurrent += pInfo->nrOfPoints;
+
+	m_vChildren.resize(nrOfChildren);
+	for (size_t i = 0; i < nrOfChildren; ++i)
+	{
+		m_vChildren[i].m_vPoints.assign(pCurrent, pCurrent + pChildSizes[i]);
+		pCurrent += pChildSizes[i];
+	}
+
+	m_vpLines.reserve(nrOfLines);
+	for (size_t i = 0; i < nrOfLines; ++i)
+		m_vpLines.push_back(new Line(pLines[i]));
+
+	m_vpTriangles.reserve(nrOfTriangles);
+	for (size_t i = 0; i < nrOfTriangles; ++i)
+		m_vpTriangles.push_back(new Triangle(pTriangles[i]));
+
+	m_isTriangulated = pInfo->isTriangulated != 0;
+	return true;
+}
+#pragma endregion //Serialization
+//----------------------------------------------------------
 #pragma endregion //Polygon
 
 Elite::Rect::Rect()
@@ -13,6 +13,9 @@
 
 namespace Elite 
 {
+	class BinaryFileWriter;
+	class BinaryFileReader;
+
 	//=== Options ===
 	#define USE_TRIANGLE_METADATA
 
@@ -128,6 +131,13 @@ namespace Elite
 		void OrientateWithChildren(Winding winding);
 		void ExpandShape(float amount);
 
+		//Binary files (see EBinaryFile.h): points, one level of children, lines and triangles with their metadata.
+		//Loading replaces the polygon, a triangulated polygon comes back without triangulating again.
+		bool SaveToFile(const std::string& path) const;
+		bool LoadFromFile(const std::string& path);
+		void WriteSections(BinaryFileWriter& writer) const;
+		bool ReadSections(const BinaryFileReader& reader);
+
 		//=== Operators ===
 		bool operator ==(const Polygon& b) const
 		{ return this->m_vChildren == b.m_vChildren && this->m_vPoints == b.m_vPoints; }
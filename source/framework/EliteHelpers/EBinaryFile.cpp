@@ -0,0 +1,191 @@
+//=== General Includes ===
+#include "stdafx.h"
+#include "EBinaryFile.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+using namespace Elite;
+
+namespace
+{
+	const uint64_t SectionAlignment = 64;
+
+	uint64_t AlignOffset(uint64_t offset)
+	{
+		return (offset + SectionAlignment - 1) & ~(SectionAlignment - 1);
+	}
+}
+
+//=== MappedFile ===
+bool MappedFile::Open(const std::string& path)
+{
+	Close();
+
+#ifdef _WIN32
+	HANDLE hFile{ CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+	if (hFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER size{};
+	if (!GetFileSizeEx(hFile, &size) || size.QuadPart == 0)
+	{
+		CloseHandle(hFile);
+		return false;
+	}
+
+	HANDLE hMapping{ CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr) };
+	if (!hMapping)
+	{
+		CloseHandle(hFile);
+		return false;
+	}
+
+	m_pData = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+	if (!m_pData)
+	{
+		CloseHandle(hMapping);
+		CloseHandle(hFile);
+		return false;
+	}
+
+	m_hFile = hFile;
+	m_hMapping = hMapping;
+	m_Size = static_cast<size_t>(size.QuadPart);
+#else
+	const int fd{ open(path.c_str(), O_RDONLY) };
+	if (fd < 0)
+		return false;
+
+	struct stat info {};
+	if (fstat(fd, &info) != 0 || info.st_size == 0)
+	{
+		close(fd);
+		return false;
+	}
+
+	void* pData{ mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0) };
+	close(fd); //the mapping keeps the file alive
+	if (pData == MAP_FAILED)
+		return false;
+
+	m_pData = pData;
+	m_Size = static_cast<size_t>(info.st_size);
+#endif
+
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (!m_pData)
+		return;
+
+#ifdef _WIN32
+	UnmapViewOfFile(m_pData);
+	CloseHandle(m_hMapping);
+	CloseHandle(m_hFile);
+	m_hMapping = nullptr;
+	m_hFile = nullptr;
+#else
+	munmap(m_pData, m_Size);
+#endif
+
+	m_pData = nullptr;
+	m_Size = 0;
+}
+
+//=== BinaryFileWriter ===
+bool BinaryFileWriter::Write(const std::string& path) const
+{
+	std::ofstream file{ path, std::ios::binary | std::ios::trunc };
+	if (!file.is_open())
+		return false;
+
+	const BinaryFileHeader header{ m_Magic, m_Version, static_cast<uint32_t>(m_Sections.size()), 0 };
+
+	//Lay out the sections behind the header and the section table
+	std::vector<BinaryFileSection> table{};
+	table.reserve(m_Sections.size());
+	uint64_t offset{ sizeof(BinaryFileHeader) + m_Sections.size() * sizeof(BinaryFileSection) };
+	for (const Section& section : m_Sections)
+	{
+		offset = AlignOffset(offset);
+		table.push_back(BinaryFileSection{ section.id, section.stride, offset, section.count });
+		offset += section.data.size();
+	}
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(BinaryFileSection));
+
+	const char padding[SectionAlignment]{};
+	uint64_t position{ sizeof(BinaryFileHeader) + table.size() * sizeof(BinaryFileSection) };
+	for (size_t i = 0; i < m_Sections.size(); ++i)
+	{
+		file.write(padding, static_cast<std::streamsize>(table[i].offset - position));
+		file.write(m_Sections[i].data.data(), static_cast<std::streamsize>(m_Sections[i].data.size()));
+		position = table[i].offset + m_Sections[i].data.size();
+	}
+
+	return file.good();
+}
+
+//=== BinaryFileReader ===
+bool BinaryFileReader::Open(const std::string& path, uint32_t magic, uint32_t version)
+{
+	Close();
+	if (!m_File.Open(path))
+		return false;
+
+	const size_t fileSize{ m_File.GetSize() };
+	if (fileSize < sizeof(BinaryFileHeader))
+	{
+		Close();
+		return false;
+	}
+
+	const BinaryFileHeader& header{ *reinterpret_cast<const BinaryFileHeader*>(m_File.GetData()) };
+	if (header.magic != magic || header.version != version
+		|| fileSize < sizeof(BinaryFileHeader) + uint64_t(header.nrOfSections) * sizeof(BinaryFileSection))
+	{
+		Close();
+		return false;
+	}
+
+	const BinaryFileSection* pSections{ reinterpret_cast<const BinaryFileSection*>(m_File.GetData() + sizeof(BinaryFileHeader)) };
+	for (uint32_t i = 0; i < header.nrOfSections; ++i)
+	{
+		const BinaryFileSection& section{ pSections[i] };
+		if (section.offset % SectionAlignment != 0 || section.offset > fileSize
+			|| (section.stride != 0 && section.count > (fileSize - section.offset) / section.stride))
+		{
+			Close();
+			return false;
+		}
+	}
+
+	m_pSections = pSections;
+	m_NrOfSections = header.nrOfSections;
+	return true;
+}
+
+const BinaryFileSection* BinaryFileReader::FindSection(uint32_t id) const
+{
+	for (uint32_t i = 0; i < m_NrOfSections; ++i)
+	{
+		if (m_pSections[i].id == id)
+			return &m_pSections[i];
+	}
+	return nullptr;
+}
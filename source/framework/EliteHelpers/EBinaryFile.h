@@ -0,0 +1,142 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EBinaryFile.h: versioned binary files made of flat arrays ("sections").
+// A file is a header, a table of sections and the section data, every section 64 byte aligned.
+// Files are read through a memory mapping, so sections are used in place without copying.
+// Only trivially copyable types are stored, in the byte order of the machine that wrote them.
+/*=============================================================================*/
+#ifndef ELITE_BINARY_FILE
+#define	ELITE_BINARY_FILE
+
+#include <type_traits>
+#include <cstdint>
+
+namespace Elite
+{
+	//Makes a section or file id out of 4 characters, like 'NODE'
+	constexpr uint32_t MakeFourCC(char a, char b, char c, char d)
+	{
+		return uint32_t(uint8_t(a)) | (uint32_t(uint8_t(b)) << 8) | (uint32_t(uint8_t(c)) << 16) | (uint32_t(uint8_t(d)) << 24);
+	}
+
+	//Read-only mapping of a whole file
+	class MappedFile final
+	{
+	public:
+		MappedFile() = default;
+		~MappedFile() { Close(); }
+
+		MappedFile(const MappedFile& other) = delete;
+		MappedFile& operator=(const MappedFile& other) = delete;
+		MappedFile(MappedFile&& other) = delete;
+		MappedFile& operator=(MappedFile&& other) = delete;
+
+		bool Open(const std::string& path);
+		void Close();
+
+		bool IsOpen() const { return m_pData != nullptr; }
+		const char* GetData() const { return static_cast<const char*>(m_pData); }
+		size_t GetSize() const { return m_Size; }
+
+	private:
+		void* m_pData = nullptr;
+		size_t m_Size = 0;
+#ifdef _WIN32
+		void* m_hFile = nullptr;
+		void* m_hMapping = nullptr;
+#endif
+	};
+
+	//Layout on disk
+	struct BinaryFileHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t nrOfSections;
+		uint32_t reserved;
+	};
+
+	struct BinaryFileSection
+	{
+		uint32_t id;
+		uint32_t stride;	//sizeof the element type, to catch layout changes between builds
+		uint64_t offset;	//from the start of the file
+		uint64_t count;
+	};
+
+	class BinaryFileWriter final
+	{
+	public:
+		BinaryFileWriter(uint32_t magic, uint32_t version) : m_Magic{ magic }, m_Version{ version } {}
+
+		//The data is copied, the array doesn't have to outlive the writer
+		template<typename T>
+		void AddSection(uint32_t id, const T* pData, size_t count);
+		template<typename T>
+		void AddSection(uint32_t id, const std::vector<T>& data) { AddSection(id, data.data(), data.size()); }
+
+		bool Write(const std::string& path) const;
+
+	private:
+		struct Section
+		{
+			uint32_t id;
+			uint32_t stride;
+			uint64_t count;
+			std::vector<char> data;
+		};
+
+		uint32_t m_Magic;
+		uint32_t m_Version;
+		std::vector<Section> m_Sections{};
+	};
+
+	//Zero-copy view on a file written by BinaryFileWriter. Pointers it returns stay valid until it is closed.
+	class BinaryFileReader final
+	{
+	public:
+		//Fails when the file can't be mapped, has another magic or version, or sections don't fit in the file
+		bool Open(const std::string& path, uint32_t magic, uint32_t version);
+		void Close() { m_File.Close(); m_pSections = nullptr; m_NrOfSections = 0; }
+
+		bool HasSection(uint32_t id) const { return FindSection(id) != nullptr; }
+
+		//nullptr with count 0 when the section is missing or was written with another element size
+		template<typename T>
+		const T* GetSection(uint32_t id, size_t& count) const;
+
+	private:
+		const BinaryFileSection* FindSection(uint32_t id) const;
+
+		MappedFile m_File{};
+		const BinaryFileSection* m_pSections = nullptr;
+		uint32_t m_NrOfSections = 0;
+	};
+
+	template<typename T>
+	inline void BinaryFileWriter::AddSection(uint32_t id, const T* pData, size_t count)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Binary file sections can only hold trivially copyable types");
+
+		Section section{ id, static_cast<uint32_t>(sizeof(T)), count, {} };
+		const char* pBytes{ reinterpret_cast<const char*>(pData) };
+		section.data.assign(pBytes, pBytes + count * sizeof(T));
+		m_Sections.push_back(std::move(section));
+	}
+
+	template<typename T>
+	inline const T* BinaryFileReader::GetSection(uint32_t id, size_t& count) const
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Binary file sections can only hold trivially copyable types");
+
+		count = 0;
+		const BinaryFileSection* pSection{ FindSection(id) };
+		if (!pSection || pSection->stride != sizeof(T))
+			return nullptr;
+
+		count = static_cast<size_t>(pSection->count);
+		return reinterpret_cast<const T*>(m_File.GetData() + pSection->offset);
+	}
+}
+#endif
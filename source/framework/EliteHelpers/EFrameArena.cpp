@@ -0,0 +1,242 @@
+//=== General Includes ===
+#include "stdafx.h"
+#include "EFrameArena.h"
+#include <cstdlib>
+#include <memory>
+#include <new>
+using namespace Elite;
+
+//=== Heap Allocation Counter ===
+namespace
+{
+	std::atomic<unsigned long long> g_NrOfHeapAllocations{ 0 };
+}
+
+#ifdef USE_HEAP_COUNTER
+namespace
+{
+	void* AllocateAligned(size_t size, std::align_val_t alignment)
+	{
+		const size_t alignmentInBytes{ static_cast<size_t>(alignment) };
+		size = size ? size : 1;
+#ifdef _WIN32
+		return _aligned_malloc(size, alignmentInBytes);
+#else
+		return aligned_alloc(alignmentInBytes, (size + alignmentInBytes - 1) / alignmentInBytes * alignmentInBytes);
+#endif
+	}
+
+	void FreeAligned(void* p)
+	{
+#ifdef _WIN32
+		_aligned_free(p);
+#else
+		free(p);
+#endif
+	}
+}
+
+//Replaces the global operators of the whole executable, only to count calls
+void* operator new(size_t size)
+{
+	g_NrOfHeapAllocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* p = malloc(size ? size : 1))
+		return p;
+	throw std::bad_alloc();
+}
+void* operator new[](size_t size) { return operator new(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	g_NrOfHeapAllocations.fetch_add(1, std::memory_order_relaxed);
+	return malloc(size ? size : 1);
+}
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept { return operator new(size, tag); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { free(p); }
+
+//Over-aligned types don't go through malloc, they need their own pair
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	g_NrOfHeapAllocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* p = AllocateAligned(size, alignment))
+		return p;
+	throw std::bad_alloc();
+}
+void* operator new[](size_t size, std::align_val_t alignment) { return operator new(size, alignment); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	g_NrOfHeapAllocations.fetch_add(1, std::memory_order_relaxed);
+	return AllocateAligned(size, alignment);
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t& tag) noexcept { return operator new(size, alignment, tag); }
+void operator delete(void* p, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { FreeAligned(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { FreeAligned(p); }
+#endif
+
+//=== LinearArena ===
+LinearArena::LinearArena(size_t blockSize)
+	: m_BlockSize{ blockSize }
+{
+}
+
+LinearArena::~LinearArena()
+{
+	for (Block& block : m_Blocks)
+		delete[] block.pData;
+}
+
+void* LinearArena::Allocate(size_t size, size_t alignment)
+{
+	while (m_CurrentBlock < m_Blocks.size())
+	{
+		const Block& block{ m_Blocks[m_CurrentBlock] };
+		const uintptr_t address{ reinterpret_cast<uintptr_t>(block.pData + m_Offset) };
+		const size_t padding{ (alignment - address % alignment) % alignment };
+		if (m_Offset + padding + size <= block.size)
+		{
+			char* p{ block.pData + m_Offset + padding };
+			m_Offset += padding + size;
+			m_BytesUsed += padding + size;
+			return p;
+		}
+
+		//The rest of this block stays unused until the next reset
+		m_BytesUsed += block.size - m_Offset;
+		++m_CurrentBlock;
+		m_Offset = 0;
+	}
+
+	AddBlock(size + alignment);
+	return Allocate(size, alignment);
+}
+
+void LinearArena::AddBlock(size_t minSize)
+{
+	const size_t size{ std::max(m_BlockSize, minSize) };
+	m_Blocks.push_back(Block{ new char[size], size });
+	m_Capacity += size;
+}
+
+void LinearArena::Reset()
+{
+	if (m_Blocks.size() > 1)
+	{
+		for (Block& block : m_Blocks)
+			delete[] block.pData;
+		m_Blocks.clear();
+		m_Blocks.push_back(Block{ new char[m_Capacity], m_Capacity });
+	}
+
+	m_CurrentBlock = 0;
+	m_Offset = 0;
+	m_BytesUsed = 0;
+}
+
+//=== FrameArena ===
+namespace
+{
+	struct ArenaRegistry
+	{
+		std::mutex mutex;
+		std::vector<std::unique_ptr<LinearArena>> pArenas;
+		std::vector<LinearArena*> pFreeArenas; //of threads that ended, handed to the next new thread
+		size_t bytesUsedLastFrame = 0;
+		unsigned long long nrOfHeapAllocationsAtFrameStart = 0;
+		unsigned long long nrOfHeapAllocationsLastFrame = 0;
+	};
+
+	ArenaRegistry& GetRegistry()
+	{
+		static ArenaRegistry registry{};
+		return registry;
+	}
+
+	//Gives the arena back when its thread ends. Nothing is reset here, memory handed out
+	//this frame stays valid until FrameArena::EndFrame.
+	struct ThreadArena
+	{
+		LinearArena* pArena = nullptr;
+
+		~ThreadArena()
+		{
+			if (!pArena)
+				return;
+
+			ArenaRegistry& registry{ GetRegistry() };
+			std::lock_guard<std::mutex> lock{ registry.mutex };
+			registry.pFreeArenas.push_back(pArena);
+		}
+	};
+
+	thread_local ThreadArena tl_Arena{};
+}
+
+LinearArena& FrameArena::Get()
+{
+	if (!tl_Arena.pArena)
+	{
+		ArenaRegistry& registry{ GetRegistry() };
+		std::lock_guard<std::mutex> lock{ registry.mutex };
+		if (registry.pFreeArenas.empty())
+		{
+			registry.pArenas.push_back(std::make_unique<LinearArena>());
+			tl_Arena.pArena = registry.pArenas.back().get();
+		}
+		else
+		{
+			tl_Arena.pArena = registry.pFreeArenas.back();
+			registry.pFreeArenas.pop_back();
+		}
+	}
+	return *tl_Arena.pArena;
+}
+
+void FrameArena::EndFrame()
+{
+	ArenaRegistry& registry{ GetRegistry() };
+	std::lock_guard<std::mutex> lock{ registry.mutex };
+
+	registry.bytesUsedLastFrame = 0;
+	for (const auto& pArena : registry.pArenas)
+	{
+		registry.bytesUsedLastFrame += pArena->GetBytesUsed();
+		pArena->Reset();
+	}
+
+	const unsigned long long nrOfHeapAllocations{ g_NrOfHeapAllocations.load(std::memory_order_relaxed) };
+	registry.nrOfHeapAllocationsLastFrame = nrOfHeapAllocations - registry.nrOfHeapAllocationsAtFrameStart;
+	registry.nrOfHeapAllocationsAtFrameStart = nrOfHeapAllocations;
+}
+
+size_t FrameArena::GetBytesUsedLastFrame()
+{
+	ArenaRegistry& registry{ GetRegistry() };
+	std::lock_guard<std::mutex> lock{ registry.mutex };
+	return registry.bytesUsedLastFrame;
+}
+
+size_t FrameArena::GetCapacity()
+{
+	ArenaRegistry& registry{ GetRegistry() };
+	std::lock_guard<std::mutex> lock{ registry.mutex };
+
+	size_t capacity{ 0 };
+	for (const auto& pArena : registry.pArenas)
+		capacity += pArena->GetCapacity();
+	return capacity;
+}
+
+unsigned long long FrameArena::GetNrOfHeapAllocationsLastFrame()
+{
+	ArenaRegistry& registry{ GetRegistry() };
+	std::lock_guard<std::mutex> lock{ registry.mutex };
+	return registry.nrOfHeapAllocationsLastFrame;
+}
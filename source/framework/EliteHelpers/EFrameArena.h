@@ -0,0 +1,103 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EFrameArena.h: linear arena for transient allocations that only live for one frame.
+// Every thread gets its own arena, the main loop resets all of them in FrameArena::EndFrame.
+// Containers built on FrameVector must never be kept across frames.
+/*=============================================================================*/
+#ifndef ELITE_FRAME_ARENA
+#define	ELITE_FRAME_ARENA
+
+namespace Elite
+{
+	//Bump allocator over a list of blocks. Deallocation is a no-op, Reset frees everything at once.
+	class LinearArena final
+	{
+	public:
+		explicit LinearArena(size_t blockSize = 64 * 1024);
+		~LinearArena();
+
+		LinearArena(const LinearArena& other) = delete;
+		LinearArena& operator=(const LinearArena& other) = delete;
+		LinearArena(LinearArena&& other) = delete;
+		LinearArena& operator=(LinearArena&& other) = delete;
+
+		void* Allocate(size_t size, size_t alignment);
+		//Invalidates all allocations. When the last frame needed more than one block they are
+		//merged into one, so a steady workload ends up with a single block and no heap calls.
+		void Reset();
+
+		size_t GetBytesUsed() const { return m_BytesUsed; }
+		size_t GetCapacity() const { return m_Capacity; }
+		int GetNrOfBlocks() const { return static_cast<int>(m_Blocks.size()); }
+
+	private:
+		struct Block
+		{
+			char* pData;
+			size_t size;
+		};
+
+		void AddBlock(size_t minSize);
+
+		std::vector<Block> m_Blocks{};
+		size_t m_BlockSize;
+		size_t m_CurrentBlock = 0;
+		size_t m_Offset = 0;		//in the current block
+		size_t m_BytesUsed = 0;	//including alignment padding
+		size_t m_Capacity = 0;
+	};
+
+	//STL allocator on top of a LinearArena
+	template<typename T>
+	class ArenaAllocator
+	{
+	public:
+		using value_type = T;
+
+		explicit ArenaAllocator(LinearArena& arena) noexcept : m_pArena{ &arena } {}
+		template<typename U>
+		ArenaAllocator(const ArenaAllocator<U>& other) noexcept : m_pArena{ other.GetArena() } {}
+
+		T* allocate(size_t n) { return static_cast<T*>(m_pArena->Allocate(n * sizeof(T), alignof(T))); }
+		void deallocate(T*, size_t) noexcept {}
+
+		LinearArena* GetArena() const { return m_pArena; }
+
+	private:
+		LinearArena* m_pArena;
+	};
+
+	template<typename T, typename U>
+	bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) { return lhs.GetArena() == rhs.GetArena(); }
+	template<typename T, typename U>
+	bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) { return !(lhs == rhs); }
+
+	template<typename T>
+	using FrameVector = std::vector<T, ArenaAllocator<T>>;
+
+	class FrameArena final
+	{
+	public:
+		//Arena of the calling thread, created the first time a thread asks for it
+		static LinearArena& Get();
+
+		template<typename T>
+		static FrameVector<T> MakeVector(size_t capacity = 0)
+		{
+			FrameVector<T> v{ ArenaAllocator<T>(Get()) };
+			v.reserve(capacity);
+			return v;
+		}
+
+		//Call on the main thread at the end of the loop, while no other thread is using its arena
+		static void EndFrame();
+
+		//Stats of the last finished frame
+		static size_t GetBytesUsedLastFrame();
+		static size_t GetCapacity();
+		//Counted with a replaced global operator new, only available with USE_HEAP_COUNTER
+		static unsigned long long GetNrOfHeapAllocationsLastFrame();
+	};
+}
+#endif
@@ -0,0 +1,248 @@
+//=== General Includes ===
+#include "stdafx.h"
+#include "EJobSystem.h"
+using namespace Elite;
+
+namespace
+{
+	//Which queue the current thread pushes to, only valid for the job system that owns the thread
+	thread_local const JobSystem* tl_pQueueOwner = nullptr;
+	thread_local unsigned int tl_QueueIdx = 0;
+
+	//Times a worker looks for a job again before it goes to sleep
+	const int NrOfSpins = 64;
+}
+
+JobSystem::JobSystem(unsigned int nrOfWorkers)
+{
+	StartWorkers(nrOfWorkers);
+}
+
+JobSystem::~JobSystem()
+{
+	StopWorkers();
+}
+
+void JobSystem::Schedule(std::function<void()> job, JobCounter* pCounter, JobCounter* pDependency)
+{
+	if (pCounter)
+		pCounter->m_NrOfPendingJobs.fetch_add(1);
+	++m_NrOfJobs;
+
+	ScheduledJob scheduledJob{ std::move(job), pCounter };
+	if (pDependency)
+	{
+		//The last job of the dependency checks for waiting jobs under the same lock
+		std::lock_guard<std::mutex> lock{ pDependency->m_Mutex };
+		if (!pDependency->IsDone())
+		{
+			pDependency->m_WaitingJobs.push_back(std::move(scheduledJob));
+			return;
+		}
+	}
+	Push(std::move(scheduledJob));
+}
+
+void JobSystem::Wait(const JobCounter& counter)
+{
+	ELITE_PROFILE_SCOPE("JobSystem::Wait");
+
+	while (!counter.IsDone())
+	{
+		if (!TryRunJob())
+			std::this_thread::yield();
+	}
+
+	//The last job lowers the counter under this lock, it is done with the counter once it lets go
+	std::lock_guard<std::mutex> lock{ counter.m_Mutex };
+}
+
+void JobSystem::ParallelFor(int count, int grainSize, const std::function<void(int, int)>& task)
+{
+	if (count <= 0)
+		return;
+
+	grainSize = std::max(grainSize, 1);
+	if (m_Workers.empty() || count <= grainSize)
+	{
+		task(0, count);
+		return;
+	}
+
+	JobCounter counter{};
+	SplitRange(0, count, grainSize, task, counter);
+	Wait(counter);
+}
+
+void JobSystem::ParallelForRanges(int count, int nrOfRanges, const std::function<void(int, int)>& task)
+{
+	if (count <= 0)
+		return;
+
+	//SplitRange halves until a range fits the grain, which can give more ranges than asked, so every range is one index here
+	nrOfRanges = std::max(std::min(nrOfRanges, count), 1);
+	ParallelFor(nrOfRanges, 1, [count, nrOfRanges, &task](int rangeBegin, int rangeEnd)
+		{
+			for (int range = rangeBegin; range < rangeEnd; ++range)
+				task(static_cast<int>(static_cast<long long>(count) * range / nrOfRanges),
+					static_cast<int>(static_cast<long long>(count) * (range + 1) / nrOfRanges));
+		});
+}
+
+void JobSystem::SetNrOfWorkers(unsigned int nrOfWorkers)
+{
+	if (nrOfWorkers == m_Workers.size())
+		return;
+
+	StopWorkers();
+	StartWorkers(nrOfWorkers);
+}
+
+void JobSystem::StartWorkers(unsigned int nrOfWorkers)
+{
+	m_IsStopping = false;
+	for (unsigned int i = 0; i <= nrOfWorkers; ++i)
+		m_pQueues.push_back(new JobQueue());
+
+	m_Workers.reserve(nrOfWorkers);
+	for (unsigned int i = 0; i < nrOfWorkers; ++i)
+		m_Workers.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+}
+
+void JobSystem::StopWorkers()
+{
+	{
+		std::lock_guard<std::mutex> lock{ m_SleepMutex };
+		m_IsStopping = true;
+	}
+	m_JobAvailable.notify_all();
+
+	for (std::thread& worker : m_Workers)
+		worker.join();
+	m_Workers.clear();
+
+	for (JobQueue*& pQueue : m_pQueues)
+		SAFE_DELETE(pQueue);
+	m_pQueues.clear();
+	m_NrOfQueuedJobs = 0;
+}
+
+void JobSystem::WorkerLoop(unsigned int queueIdx)
+{
+	tl_pQueueOwner = this;
+	tl_QueueIdx = queueIdx;
+
+	while (true)
+	{
+		bool hasRunJob{ false };
+		for (int spin = 0; spin < NrOfSpins && !hasRunJob; ++spin)
+		{
+			hasRunJob = TryRunJob();
+			if (!hasRunJob)
+				std::this_thread::yield();
+		}
+		if (hasRunJob)
+			continue;
+
+		//Push only takes the lock when someone sleeps, the sleeper counts itself before it checks for jobs
+		std::unique_lock<std::mutex> lock{ m_SleepMutex };
+		++m_NrOfSleepingWorkers;
+		m_JobAvailable.wait(lock, [this]() { return m_NrOfQueuedJobs.load() > 0 || m_IsStopping; });
+		--m_NrOfSleepingWorkers;
+		if (m_IsStopping)
+			return;
+	}
+}
+
+unsigned int JobSystem::GetQueueIdx() const
+{
+	return tl_pQueueOwner == this ? tl_QueueIdx : 0;
+}
+
+void JobSystem::Push(ScheduledJob&& job)
+{
+	JobQueue& queue{ *m_pQueues[GetQueueIdx()] };
+	{
+		std::lock_guard<std::mutex> lock{ queue.mutex };
+		queue.jobs.push_back(std::move(job));
+	}
+	++m_NrOfQueuedJobs;
+
+	if (m_NrOfSleepingWorkers.load() > 0)
+	{
+		{
+			std::lock_guard<std::mutex> lock{ m_SleepMutex };
+		}
+		m_JobAvailable.notify_one();
+	}
+}
+
+bool JobSystem::TryRunJob()
+{
+	const unsigned int nrOfQueues{ static_cast<unsigned int>(m_pQueues.size()) };
+	const unsigned int ownQueueIdx{ GetQueueIdx() };
+
+	//Newest job of the own queue first, it is the smallest and its data is still in the cache
+	ScheduledJob job{};
+	bool hasJob{ false };
+	{
+		JobQueue& queue{ *m_pQueues[ownQueueIdx] };
+		std::lock_guard<std::mutex> lock{ queue.mutex };
+		if (!queue.jobs.empty())
+		{
+			job = std::move(queue.jobs.back());
+			queue.jobs.pop_back();
+			hasJob = true;
+		}
+	}
+
+	//Otherwise the oldest job of another queue
+	for (unsigned int i = 1; i < nrOfQueues && !hasJob; ++i)
+	{
+		JobQueue& queue{ *m_pQueues[(ownQueueIdx + i) % nrOfQueues] };
+		std::lock_guard<std::mutex> lock{ queue.mutex };
+		if (!queue.jobs.empty())
+		{
+			job = std::move(queue.jobs.front());
+			queue.jobs.pop_front();
+			hasJob = true;
+			++m_NrOfSteals;
+		}
+	}
+
+	if (!hasJob)
+		return false;
+
+	--m_NrOfQueuedJobs;
+	job.function();
+	FinishJob(job.pCounter);
+	return true;
+}
+
+void JobSystem::FinishJob(JobCounter* pCounter)
+{
+	if (!pCounter)
+		return;
+
+	std::vector<ScheduledJob> waitingJobs{};
+	{
+		std::lock_guard<std::mutex> lock{ pCounter->m_Mutex };
+		if (pCounter->m_NrOfPendingJobs.fetch_sub(1) == 1)
+			waitingJobs.swap(pCounter->m_WaitingJobs);
+	}
+
+	for (ScheduledJob& job : waitingJobs)
+		Push(std::move(job));
+}
+
+void JobSystem::SplitRange(int begin, int end, int grainSize, const std::function<void(int, int)>& task, JobCounter& counter)
+{
+	//The upper half goes to the queue, a thief takes the oldest and so the biggest half
+	while (end - begin > grainSize)
+	{
+		const int middle{ begin + (end - begin) / 2 };
+		Schedule([this, middle, end, grainSize, &task, &counter]() { SplitRange(middle, end, grainSize, task, counter); }, &counter);
+		end = middle;
+	}
+	task(begin, end);
+}
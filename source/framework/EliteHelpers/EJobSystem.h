@@ -0,0 +1,111 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EJobSystem.h: work-stealing job system shared by the whole framework.
+// Every worker has its own queue: it takes its newest job first and steals the oldest job of another
+// queue when its own is empty. Threads that aren't workers (the main thread) push to a shared queue and
+// run jobs themselves while they wait on a counter, so waiting inside a job or a nested ParallelFor is fine.
+/*=============================================================================*/
+#ifndef ELITE_JOB_SYSTEM
+#define	ELITE_JOB_SYSTEM
+
+namespace Elite
+{
+	class JobCounter;
+
+	//A job and the counter it lowers when it's done
+	struct ScheduledJob
+	{
+		std::function<void()> function;
+		JobCounter* pCounter;
+	};
+
+	//Number of scheduled jobs that didn't finish yet. Jobs scheduled with a counter as dependency
+	//only start once it reaches 0. A counter has to outlive the jobs that count on it.
+	class JobCounter final
+	{
+	public:
+		JobCounter() = default;
+		~JobCounter() = default;
+
+		bool IsDone() const { return m_NrOfPendingJobs.load(std::memory_order_acquire) == 0; }
+		int GetNrOfPendingJobs() const { return m_NrOfPendingJobs.load(std::memory_order_acquire); }
+
+	private:
+		friend class JobSystem;
+
+		std::atomic<int> m_NrOfPendingJobs{ 0 };
+		mutable std::mutex m_Mutex{};
+		std::vector<ScheduledJob> m_WaitingJobs{};
+
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+	};
+
+	class JobSystem final : public ESingleton<JobSystem>
+	{
+	public:
+		struct Stats
+		{
+			unsigned long long nrOfJobs;
+			unsigned long long nrOfSteals;
+		};
+
+		//One worker less than there are cores, the thread that waits does the rest of the work
+		explicit JobSystem(unsigned int nrOfWorkers = std::max(std::thread::hardware_concurrency(), 1u) - 1);
+		~JobSystem();
+
+		//pCounter goes up now and down when the job is done, the job waits until pDependency is done
+		void Schedule(std::function<void()> job, JobCounter* pCounter = nullptr, JobCounter* pDependency = nullptr);
+		//Runs jobs on the calling thread until the counter is done. Wait on a counter before destroying it.
+		void Wait(const JobCounter& counter);
+
+		//Splits [0, count) in ranges of grainSize and calls task(begin, end) for each of them.
+		//The calling thread takes part and returns when every range is done. Can be nested.
+		void ParallelFor(int count, int grainSize, const std::function<void(int, int)>& task);
+		//Splits [0, count) in nrOfRanges ranges of about the same size, so at most nrOfRanges threads work on it at once
+		void ParallelForRanges(int count, int nrOfRanges, const std::function<void(int, int)>& task);
+
+		//Workers + the calling thread
+		unsigned int GetNrOfThreads() const { return static_cast<unsigned int>(m_Workers.size()) + 1; }
+		//Stops and starts the workers, only call this when no jobs are scheduled
+		void SetNrOfWorkers(unsigned int nrOfWorkers);
+
+		Stats GetStats() const { return { m_NrOfJobs.load(), m_NrOfSteals.load() }; }
+
+	private:
+		struct JobQueue
+		{
+			std::mutex mutex{};
+			std::deque<ScheduledJob> jobs{};
+		};
+
+		//Queue 0 is shared by every thread that isn't a worker, worker i owns queue i + 1
+		std::vector<JobQueue*> m_pQueues{};
+		std::vector<std::thread> m_Workers{};
+
+		std::mutex m_SleepMutex{};
+		std::condition_variable m_JobAvailable{};
+		std::atomic<int> m_NrOfQueuedJobs{ 0 };
+		std::atomic<int> m_NrOfSleepingWorkers{ 0 };
+		bool m_IsStopping = false;
+
+		std::atomic<unsigned long long> m_NrOfJobs{ 0 };
+		std::atomic<unsigned long long> m_NrOfSteals{ 0 };
+
+		void StartWorkers(unsigned int nrOfWorkers);
+		void StopWorkers();
+		void WorkerLoop(unsigned int queueIdx);
+
+		unsigned int GetQueueIdx() const;
+		void Push(ScheduledJob&& job);
+		bool TryRunJob();
+		void FinishJob(JobCounter* pCounter);
+		void SplitRange(int begin, int end, int grainSize, const std::function<void(int, int)>& task, JobCounter& counter);
+	};
+
+	//Stress test of dependencies, nested parallel fors and jobs that schedule jobs, followed by the cost of scheduling.
+	//Writes the results to output and returns false when a check failed. Run with --job-benchmark.
+	bool RunJobSystemBenchmark(std::ostream& output);
+}
+#endif
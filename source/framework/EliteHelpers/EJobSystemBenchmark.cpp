@@ -0,0 +1,170 @@
+//=== General Includes ===
+#include "stdafx.h"
+#include "EJobSystem.h"
+using namespace Elite;
+
+namespace
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	double GetElapsedMs(const Clock::time_point& start)
+	{
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+	//Work that can't be optimized away, a few hundred cycles per index
+	double DoWork(int begin, int end)
+	{
+		double sum{};
+		for (int i = begin; i < end; ++i)
+			sum += sqrt(static_cast<double>(i % 1024));
+		return sum;
+	}
+
+	//Every job of the chain only starts when the one before it is done
+	bool CheckDependencies(JobSystem& jobSystem)
+	{
+		const int nrOfLinks{ 64 };
+		bool isInOrder{ true };
+		for (int round = 0; round < 50; ++round)
+		{
+			std::vector<JobCounter> counters(nrOfLinks);
+			std::atomic<int> nrOfDoneLinks{ 0 };
+			std::atomic<bool> hasFailed{ false };
+			for (int i = 0; i < nrOfLinks; ++i)
+			{
+				jobSystem.Schedule([&nrOfDoneLinks, &hasFailed, i]()
+					{
+						if (nrOfDoneLinks.fetch_add(1) != i)
+							hasFailed = true;
+					}, &counters[i], i > 0 ? &counters[i - 1] : nullptr);
+			}
+			jobSystem.Wait(counters.back());
+			isInOrder = isInOrder && !hasFailed && nrOfDoneLinks == nrOfLinks;
+		}
+		return isInOrder;
+	}
+
+	//Jobs that schedule more jobs on the same counter before they finish
+	bool CheckFanOut(JobSystem& jobSystem)
+	{
+		const int nrOfJobs{ 64 };
+		JobCounter counter{};
+		std::atomic<int> nrOfRuns{ 0 };
+		for (int i = 0; i < nrOfJobs; ++i)
+		{
+			jobSystem.Schedule([&]()
+				{
+					++nrOfRuns;
+					for (int j = 0; j < nrOfJobs; ++j)
+						jobSystem.Schedule([&nrOfRuns]() { ++nrOfRuns; }, &counter);
+				}, &counter);
+		}
+		jobSystem.Wait(counter);
+		return nrOfRuns == nrOfJobs + nrOfJobs * nrOfJobs;
+	}
+
+	//Parallel fors inside the ranges of a parallel for, every index has to be visited once
+	bool CheckNestedParallelFor(JobSystem& jobSystem)
+	{
+		const int nrOfOuter{ 64 };
+		const int nrOfInner{ 10000 };
+		std::atomic<long long> sum{ 0 };
+		jobSystem.ParallelFor(nrOfOuter, 1, [&](int outerBegin, int outerEnd)
+			{
+				for (int outer = outerBegin; outer < outerEnd; ++outer)
+				{
+					jobSystem.ParallelFor(nrOfInner, 100, [&](int begin, int end)
+						{
+							long long rangeSum{};
+							for (int i = begin; i < end; ++i)
+								rangeSum += i;
+							sum += rangeSum;
+						});
+				}
+			});
+		return sum == static_cast<long long>(nrOfOuter) * nrOfInner * (nrOfInner - 1) / 2;
+	}
+}
+
+bool Elite::RunJobSystemBenchmark(std::ostream& output)
+{
+	JobSystem& jobSystem{ *JOBSYSTEM };
+	const unsigned int nrOfWorkers{ jobSystem.GetNrOfThreads() - 1 };
+	bool hasPassed{ true };
+
+	//Stress test, also with no workers at all where the waiting thread runs everything
+	std::vector<unsigned int> workerCounts{ 0, 1 };
+	if (nrOfWorkers > 1)
+		workerCounts.push_back(nrOfWorkers);
+	for (unsigned int workerCount : workerCounts)
+	{
+		jobSystem.SetNrOfWorkers(workerCount);
+		for (int i = 0; i < 10; ++i)
+		{
+			const bool isDependencyOk{ CheckDependencies(jobSystem) };
+			const bool isFanOutOk{ CheckFanOut(jobSystem) };
+			const bool isNestedOk{ CheckNestedParallelFor(jobSystem) };
+			if (i == 0 || !isDependencyOk || !isFanOutOk || !isNestedOk)
+			{
+				output << "Job system, " << workerCount << " workers: dependencies " << (isDependencyOk ? "ok" : "FAILED")
+					<< ", fan out " << (isFanOutOk ? "ok" : "FAILED") << ", nested parallel for " << (isNestedOk ? "ok" : "FAILED") << std::endl;
+			}
+			hasPassed = hasPassed && isDependencyOk && isFanOutOk && isNestedOk;
+		}
+	}
+	jobSystem.SetNrOfWorkers(nrOfWorkers);
+
+	//Cost of an empty job, from Schedule until the counter is done
+	{
+		const int nrOfJobs{ 100000 };
+		JobCounter counter{};
+		const auto start = Clock::now();
+		for (int i = 0; i < nrOfJobs; ++i)
+			jobSystem.Schedule([]() {}, &counter);
+		jobSystem.Wait(counter);
+		output << "Empty job: " << GetElapsedMs(start) * 1000000.0 / nrOfJobs << " ns per job" << std::endl;
+	}
+
+	//Parallel for with cheap work, against a serial loop and a fixed number of ranges
+	const int count{ 1 << 22 };
+	double serialSum{}, sum{};
+	auto start = Clock::now();
+	serialSum = DoWork(0, count);
+	const double serialMs{ GetElapsedMs(start) };
+	output << "Serial loop: " << serialMs << " ms" << std::endl;
+
+	std::mutex sumMutex{};
+	const auto addRange = [&](int begin, int end)
+	{
+		const double rangeSum{ DoWork(begin, end) };
+		std::lock_guard<std::mutex> lock{ sumMutex };
+		sum += rangeSum;
+	};
+
+	const JobSystem::Stats statsBefore{ jobSystem.GetStats() };
+	for (int grainSize : { 64, 1024, 16384, 262144 })
+	{
+		start = Clock::now();
+		jobSystem.ParallelFor(count, grainSize, addRange);
+		const double ms{ GetElapsedMs(start) };
+		output << "Job system parallel for, grain " << grainSize << ": " << ms << " ms (" << serialMs / ms << "x)" << std::endl;
+	}
+	const JobSystem::Stats statsAfter{ jobSystem.GetStats() };
+	output << "  " << statsAfter.nrOfJobs - statsBefore.nrOfJobs << " jobs, " << statsAfter.nrOfSteals - statsBefore.nrOfSteals << " steals" << std::endl;
+
+	const int nrOfRanges{ static_cast<int>(jobSystem.GetNrOfThreads()) };
+	start = Clock::now();
+	jobSystem.ParallelForRanges(count, nrOfRanges, addRange);
+	const double rangesMs{ GetElapsedMs(start) };
+	output << "Job system parallel for, " << nrOfRanges << " ranges: " << rangesMs << " ms (" << serialMs / rangesMs << "x)" << std::endl;
+
+	//Different ranges add up in a different order, only close enough
+	const bool isSumOk{ fabs(sum - 5.0 * serialSum) <= 1e-6 * 5.0 * serialSum };
+	if (!isSumOk)
+		output << "Parallel for sums don't match the serial loop" << std::endl;
+	hasPassed = hasPassed && isSumOk;
+
+	output << "Job system benchmark " << (hasPassed ? "PASSED" : "FAILED") << " with " << jobSystem.GetNrOfThreads() << " threads" << std::endl;
+	return hasPassed;
+}
@@ -33,6 +33,8 @@ namespace Elite
 #if (PLATFORM_ID == PLATFORM_WINDOWS)
 		friend SDLWindow;
 #endif
+		//Replays swap the captured input for the recorded one
+		friend class Replay;
 
 		//=== Internal Functions
 		void Flush(){ m_InputContainer.clear();};
@@ -16,6 +16,8 @@
 #include "EVector3.h"
 #include "EMat22.h"
 #include "FMatrix.h"
+#include "FMatrixBatch.h"
+#include "EVector2Array.h"
 
 /* --- TYPE DEFINES --- */
 #endif
@@ -9,6 +9,7 @@
 //Standard C++ includes
 #include <cstdlib>
 #include <cfloat>
+#include <cmath>
 #include <type_traits>
 
 namespace Elite {
@@ -61,8 +62,9 @@ namespace Elite {
 	/*! Clamped angle between -pi, pi (in radians)  */
 	inline float ClampedAngle(const float radians)
 	{
-		float a = fmodf(radians + b2_pi, 2 * b2_pi);
-		a = a >= 0 ? (a - b2_pi) : (a + b2_pi);
+		const float pi = static_cast<float>(E_PI);
+		float a = fmodf(radians + pi, 2 * pi);
+		a = a >= 0 ? (a - pi) : (a + pi);
 		return a;
 	}
 	/*! Template function to clamp between a minimum and a maximum value -> in STD since c++17 */
@@ -110,6 +112,15 @@ namespace Elite {
 	inline float randomBinomial(float max = 1.f)
 	{ return randomFloat(max) - randomFloat(max); }
 
+	/*! Mixes a value into a seed (splitmix64 finalizer), close seeds give unrelated generators */
+	inline unsigned int MixSeed(unsigned int seed, unsigned int value)
+	{
+		uint64_t x{ ((static_cast<uint64_t>(seed) << 32) | value) + 0x9E3779B97F4A7C15ull };
+		x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+		x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+		return static_cast<unsigned int>(x ^ (x >> 31));
+	}
+
 	/*! Linear Interpolation */
 	/*inline float Lerp(float v0, float v1, float t)
 	{ return (1 - t) * v0 + t * v1;	}*/
@@ -0,0 +1,150 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// ESimd.h: thin wrapper around the widest float registers the build targets, so the batch math
+// kernels are written once. AVX (8 floats) when the compiler targets it, SSE2 (4 floats) on x64 and
+// x86 with SSE2, and a plain float otherwise. Only include this in the .cpp of a kernel.
+/*=============================================================================*/
+#ifndef ELITE_MATH_SIMD
+#define	ELITE_MATH_SIMD
+
+#if defined(__AVX__)
+	#define ELITE_SIMD_AVX
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define ELITE_SIMD_SSE
+#endif
+
+#if defined(ELITE_SIMD_AVX) || defined(ELITE_SIMD_SSE)
+	#define ELITE_SIMD
+	#include <immintrin.h>
+#endif
+
+namespace Elite
+{
+#if defined(ELITE_SIMD_AVX)
+	struct Simd
+	{
+		using Float = __m256;
+		static const int Width = 8;
+
+		static Float Load(const float* p) { return _mm256_loadu_ps(p); }
+		static void Store(float* p, Float v) { _mm256_storeu_ps(p, v); }
+		static Float Set(float f) { return _mm256_set1_ps(f); }
+		static Float Add(Float a, Float b) { return _mm256_add_ps(a, b); }
+		static Float Sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+		static Float Mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+		static Float Div(Float a, Float b) { return _mm256_div_ps(a, b); }
+		static Float Sqrt(Float a) { return _mm256_sqrt_ps(a); }
+		static Float Min(Float a, Float b) { return _mm256_min_ps(a, b); }
+		static Float Max(Float a, Float b) { return _mm256_max_ps(a, b); }
+		static Float Less(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+		static Float Greater(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+		//mask ? a : b
+		static Float Select(Float mask, Float a, Float b) { return _mm256_blendv_ps(b, a, mask); }
+		static int GetMask(Float mask) { return _mm256_movemask_ps(mask); }
+
+		//a * b + c, fused when the build targets AVX2. Rounds differently than Add(Mul(a, b), c).
+		static Float MulAdd(Float a, Float b, Float c)
+		{
+#if defined(__AVX2__) || defined(__FMA__)
+			return _mm256_fmadd_ps(a, b, c);
+#else
+			return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+		}
+
+		//2^n for whole numbers n in [-126, 127]
+		static Float Pow2(Float n)
+		{
+			const __m256i exponent{ _mm256_cvtps_epi32(n) };
+#if defined(__AVX2__)
+			return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(exponent, _mm256_set1_epi32(127)), 23));
+#else
+			//AVX has no 256 bit integer math, do both halves with SSE2
+			const __m128i bias{ _mm_set1_epi32(127) };
+			const __m128i low{ _mm_slli_epi32(_mm_add_epi32(_mm256_castsi256_si128(exponent), bias), 23) };
+			const __m128i high{ _mm_slli_epi32(_mm_add_epi32(_mm256_extractf128_si256(exponent, 1), bias), 23) };
+			return _mm256_castsi256_ps(_mm256_insertf128_si256(_mm256_castsi128_si256(low), high, 1));
+#endif
+		}
+		static Float Round(Float a) { return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+	};
+#elif defined(ELITE_SIMD_SSE)
+	struct Simd
+	{
+		using Float = __m128;
+		static const int Width = 4;
+
+		static Float Load(const float* p) { return _mm_loadu_ps(p); }
+		static void Store(float* p, Float v) { _mm_storeu_ps(p, v); }
+		static Float Set(float f) { return _mm_set1_ps(f); }
+		static Float Add(Float a, Float b) { return _mm_add_ps(a, b); }
+		static Float Sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+		static Float Mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+		static Float Div(Float a, Float b) { return _mm_div_ps(a, b); }
+		static Float Sqrt(Float a) { return _mm_sqrt_ps(a); }
+		static Float Min(Float a, Float b) { return _mm_min_ps(a, b); }
+		static Float Max(Float a, Float b) { return _mm_max_ps(a, b); }
+		static Float Less(Float a, Float b) { return _mm_cmplt_ps(a, b); }
+		static Float Greater(Float a, Float b) { return _mm_cmpgt_ps(a, b); }
+		//mask ? a : b
+		static Float Select(Float mask, Float a, Float b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+		static int GetMask(Float mask) { return _mm_movemask_ps(mask); }
+
+		static Float MulAdd(Float a, Float b, Float c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+
+		//2^n for whole numbers n in [-126, 127]
+		static Float Pow2(Float n)
+		{
+			const __m128i exponent{ _mm_cvtps_epi32(n) };
+			return _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(exponent, _mm_set1_epi32(127)), 23));
+		}
+		//SSE2 has no round instruction, converting rounds to nearest in the default rounding mode
+		static Float Round(Float a) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(a)); }
+	};
+#else
+	struct Simd
+	{
+		using Float = float;
+		static const int Width = 1;
+
+		static Float Load(const float* p) { return *p; }
+		static void Store(float* p, Float v) { *p = v; }
+		static Float Set(float f) { return f; }
+		static Float Add(Float a, Float b) { return a + b; }
+		static Float Sub(Float a, Float b) { return a - b; }
+		static Float Mul(Float a, Float b) { return a * b; }
+		static Float Div(Float a, Float b) { return a / b; }
+		static Float Sqrt(Float a) { return sqrtf(a); }
+		static Float Min(Float a, Float b) { return a < b ? a : b; }
+		static Float Max(Float a, Float b) { return a > b ? a : b; }
+		static Float MulAdd(Float a, Float b, Float c) { return a * b + c; }
+	};
+#endif
+
+	//e^x for every lane. Cephes expf: 2^n times a polynomial of what is left,
+	//relative error around 2e-7, inputs outside of [-87.3, 88.3] are clamped.
+	inline Simd::Float SimdExp(Simd::Float x)
+	{
+#ifdef ELITE_SIMD
+		x = Simd::Min(Simd::Max(x, Simd::Set(-87.3365447504019f)), Simd::Set(88.3762626647949f));
+
+		//x = n * ln(2) + r, with |r| <= ln(2) / 2, ln(2) in two parts to keep r exact
+		const Simd::Float n{ Simd::Round(Simd::Mul(x, Simd::Set(1.44269504088896341f))) };
+		Simd::Float r{ Simd::Sub(x, Simd::Mul(n, Simd::Set(0.693359375f))) };
+		r = Simd::Sub(r, Simd::Mul(n, Simd::Set(-2.12194440e-4f)));
+
+		Simd::Float y{ Simd::Set(1.9875691500E-4f) };
+		y = Simd::MulAdd(y, r, Simd::Set(1.3981999507E-3f));
+		y = Simd::MulAdd(y, r, Simd::Set(8.3334519073E-3f));
+		y = Simd::MulAdd(y, r, Simd::Set(4.1665795894E-2f));
+		y = Simd::MulAdd(y, r, Simd::Set(1.6666665459E-1f));
+		y = Simd::MulAdd(y, r, Simd::Set(5.0000001201E-1f));
+		y = Simd::MulAdd(y, Simd::Mul(r, r), Simd::Add(r, Simd::Set(1.f)));
+		return Simd::Mul(y, Simd::Pow2(n));
+#else
+		return expf(x);
+#endif
+	}
+}
+#endif
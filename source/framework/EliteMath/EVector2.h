@@ -6,6 +6,7 @@
 /*=============================================================================*/
 #ifndef ELITE_MATH_VECTOR2
 #define	ELITE_MATH_VECTOR2
+#include <ostream>
 namespace Elite
 {
 #define ZeroVector2 Vector2()
@@ -0,0 +1,252 @@
+//=== General Includes ===
+#include "stdafx.h"
+#include "EVector2Array.h"
+#include "ESimd.h"
+using namespace Elite;
+
+namespace
+{
+#ifdef ELITE_SIMD
+	//Only exact operations (no rsqrt, no MulAdd) in the same order as the Vector2 functions,
+	//so every lane rounds the same way the scalar code does
+	//Number of elements the SIMD loops handle, the rest goes through the Vector2 functions
+	size_t GetNrOfSimdElements(size_t count)
+	{
+		return count - count % Simd::Width;
+	}
+
+	Simd::Float GetDistancesSquared(const float* pXs, const float* pYs, size_t i, Simd::Float targetX, Simd::Float targetY)
+	{
+		const Simd::Float dx{ Simd::Sub(targetX, Simd::Load(pXs + i)) };
+		const Simd::Float dy{ Simd::Sub(targetY, Simd::Load(pYs + i)) };
+		return Simd::Add(Simd::Mul(dx, dx), Simd::Mul(dy, dy));
+	}
+#else
+	size_t GetNrOfSimdElements(size_t)
+	{
+		return 0;
+	}
+#endif
+}
+
+//=== Vector2Array ===
+Vector2Array::Vector2Array(const std::vector<Vector2>& vectors)
+{
+	Assign(vectors);
+}
+
+void Vector2Array::Assign(const std::vector<Vector2>& vectors)
+{
+	const size_t size{ vectors.size() };
+	Resize(size);
+	for (size_t i = 0; i < size; ++i)
+	{
+		m_Xs[i] = vectors[i].x;
+		m_Ys[i] = vectors[i].y;
+	}
+}
+
+void Vector2Array::CopyTo(std::vector<Vector2>& vectors) const
+{
+	const size_t size{ Size() };
+	vectors.resize(size);
+	for (size_t i = 0; i < size; ++i)
+		vectors[i] = { m_Xs[i], m_Ys[i] };
+}
+
+//=== Batch Functions ===
+void Elite::DistanceSquared(const Vector2Array& vectors, const Vector2& target, float* pResults)
+{
+	const float* pXs{ vectors.GetXs() };
+	const float* pYs{ vectors.GetYs() };
+	const size_t count{ vectors.Size() };
+	const size_t nrOfSimdElements{ GetNrOfSimdElements(count) };
+
+#ifdef ELITE_SIMD
+	const Simd::Float targetX{ Simd::Set(target.x) };
+	const Simd::Float targetY{ Simd::Set(target.y) };
+	for (size_t i = 0; i < nrOfSimdElements; i += Simd::Width)
+		Simd::Store(pResults + i, GetDistancesSquared(pXs, pYs, i, targetX, targetY));
+#endif
+
+	for (size_t i = nrOfSimdElements; i < count; ++i)
+		pResults[i] = Vector2{ pXs[i], pYs[i] }.DistanceSquared(target);
+}
+
+int Elite::FindNearestWithinRadius(const Vector2Array& vectors, const Vector2& target, float radius)
+{
+	const float* pXs{ vectors.GetXs() };
+	const float* pYs{ vectors.GetYs() };
+	const size_t count{ vectors.Size() };
+	const size_t nrOfSimdElements{ GetNrOfSimdElements(count) };
+
+	int nearestIdx{ -1 };
+	float nearestDistanceSquared{ radius * radius };
+	const auto checkElement = [&](size_t i, float distanceSquared)
+	{
+		//Strictly closer, so the first of equally close elements stays
+		if (distanceSquared < nearestDistanceSquared)
+		{
+			nearestDistanceSquared = distanceSquared;
+			nearestIdx = static_cast<int>(i);
+		}
+	};
+
+#ifdef ELITE_SIMD
+	const Simd::Float targetX{ Simd::Set(target.x) };
+	const Simd::Float targetY{ Simd::Set(target.y) };
+	float distancesSquared[Simd::Width];
+	for (size_t i = 0; i < nrOfSimdElements; i += Simd::Width)
+	{
+		//Most blocks have nothing closer than the best so far, only look at the lanes of the ones that do
+		const Simd::Float distanceSquared{ GetDistancesSquared(pXs, pYs, i, targetX, targetY) };
+		if (Simd::GetMask(Simd::Less(distanceSquared, Simd::Set(nearestDistanceSquared))) == 0)
+			continue;
+
+		Simd::Store(distancesSquared, distanceSquared);
+		for (int lane = 0; lane < Simd::Width; ++lane)
+			checkElement(i + lane, distancesSquared[lane]);
+	}
+#endif
+
+	for (size_t i = nrOfSimdElements; i < count; ++i)
+		checkElement(i, Vector2{ pXs[i], pYs[i] }.DistanceSquared(target));
+	return nearestIdx;
+}
+
+int Elite::GatherWithinRadius(const Vector2Array& vectors, const Vector2& target, float radius, std::vector<int>& indices)
+{
+	const float* pXs{ vectors.GetXs() };
+	const float* pYs{ vectors.GetYs() };
+	const size_t count{ vectors.Size() };
+	const size_t nrOfSimdElements{ GetNrOfSimdElements(count) };
+	const size_t nrOfIndices{ indices.size() };
+	const float radiusSquared{ radius * radius };
+
+#ifdef ELITE_SIMD
+	const Simd::Float targetX{ Simd::Set(target.x) };
+	const Simd::Float targetY{ Simd::Set(target.y) };
+	const Simd::Float simdRadiusSquared{ Simd::Set(radiusSquared) };
+	for (size_t i = 0; i < nrOfSimdElements; i += Simd::Width)
+	{
+		int mask{ Simd::GetMask(Simd::Less(GetDistancesSquared(pXs, pYs, i, targetX, targetY), simdRadiusSquared)) };
+		for (int lane = 0; mask != 0; ++lane, mask >>= 1)
+		{
+			if (mask & 1)
+				indices.push_back(static_cast<int>(i) + lane);
+		}
+	}
+#endif
+
+	for (size_t i = nrOfSimdElements; i < count; ++i)
+	{
+		if (Vector2{ pXs[i], pYs[i] }.DistanceSquared(target) < radiusSquared)
+			indices.push_back(static_cast<int>(i));
+	}
+	return static_cast<int>(indices.size() - nrOfIndices);
+}
+
+void Elite::Dot(const Vector2Array& a, const Vector2Array& b, float* pResults)
+{
+	const size_t count{ a.Size() };
+	const size_t nrOfSimdElements{ GetNrOfSimdElements(count) };
+
+#ifdef ELITE_SIMD
+	for (size_t i = 0; i < nrOfSimdElements; i += Simd::Width)
+	{
+		const Simd::Float xx{ Simd::Mul(Simd::Load(a.GetXs() + i), Simd::Load(b.GetXs() + i)) };
+		const Simd::Float yy{ Simd::Mul(Simd::Load(a.GetYs() + i), Simd::Load(b.GetYs() + i)) };
+		Simd::Store(pResults + i, Simd::Add(xx, yy));
+	}
+#endif
+
+	for (size_t i = nrOfSimdElements; i < count; ++i)
+		pResults[i] = a.Get(i).Dot(b.Get(i));
+}
+
+void Elite::Cross(const Vector2Array& a, const Vector2Array& b, float* pResults)
+{
+	const size_t count{ a.Size() };
+	const size_t nrOfSimdElements{ GetNrOfSimdElements(count) };
+
+#ifdef ELITE_SIMD
+	for (size_t i = 0; i < nrOfSimdElements; i += Simd::Width)
+	{
+		const Simd::Float xy{ Simd::Mul(Simd::Load(a.GetXs() + i), Simd::Load(b.GetYs() + i)) };
+		const Simd::Float yx{ Simd::Mul(Simd::Load(a.GetYs() + i), Simd::Load(b.GetXs() + i)) };
+		Simd::Store(pResults + i, Simd::Sub(xy, yx));
+	}
+#endif
+
+	for (size_t i = nrOfSimdElements; i < count; ++i)
+		pResults[i] = a.Get(i).Cross(b.Get(i));
+}
+
+void Elite::Normalize(Vector2Array& vectors)
+{
+	float* pXs{ vectors.GetXs() };
+	float* pYs{ vectors.GetYs() };
+	const size_t count{ vectors.Size() };
+	const size_t nrOfSimdElements{ GetNrOfSimdElements(count) };
+
+#ifdef ELITE_SIMD
+	//Vector2::Normalize sets the vector to zero when AreEqual(magnitude, 0.f)
+	const Simd::Float epsilon{ Simd::Set(FLT_EPSILON) };
+	const Simd::Float one{ Simd::Set(1.f) };
+	const Simd::Float zero{ Simd::Set(0.f) };
+	for (size_t i = 0; i < nrOfSimdElements; i += Simd::Width)
+	{
+		const Simd::Float x{ Simd::Load(pXs + i) };
+		const Simd::Float y{ Simd::Load(pYs + i) };
+		const Simd::Float magnitude{ Simd::Sqrt(Simd::Add(Simd::Mul(x, x), Simd::Mul(y, y))) };
+		const Simd::Float isNotZero{ Simd::Greater(magnitude, epsilon) };
+		const Simd::Float invMagnitude{ Simd::Div(one, magnitude) };
+		Simd::Store(pXs + i, Simd::Select(isNotZero, Simd::Mul(x, invMagnitude), zero));
+		Simd::Store(pYs + i, Simd::Select(isNotZero, Simd::Mul(y, invMagnitude), zero));
+	}
+#endif
+
+	for (size_t i = nrOfSimdElements; i < count; ++i)
+	{
+		Vector2 v{ pXs[i], pYs[i] };
+		v.Normalize();
+		vectors.Set(i, v);
+	}
+}
+
+void Elite::Clamp(Vector2Array& vectors, float max)
+{
+	float* pXs{ vectors.GetXs() };
+	float* pYs{ vectors.GetYs() };
+	const size_t count{ vectors.Size() };
+	const size_t nrOfSimdElements{ GetNrOfSimdElements(count) };
+
+#ifdef ELITE_SIMD
+	const Simd::Float simdMax{ Simd::Set(max) };
+	const Simd::Float one{ Simd::Set(1.f) };
+	for (size_t i = 0; i < nrOfSimdElements; i += Simd::Width)
+	{
+		const Simd::Float x{ Simd::Load(pXs + i) };
+		const Simd::Float y{ Simd::Load(pYs + i) };
+		const Simd::Float magnitude{ Simd::Sqrt(Simd::Add(Simd::Mul(x, x), Simd::Mul(y, y))) };
+		Simd::Float scale{ Simd::Div(simdMax, magnitude) };
+		scale = Simd::Select(Simd::Less(scale, one), scale, one);
+		Simd::Store(pXs + i, Simd::Mul(x, scale));
+		Simd::Store(pYs + i, Simd::Mul(y, scale));
+	}
+#endif
+
+	for (size_t i = nrOfSimdElements; i < count; ++i)
+		vectors.Set(i, Elite::Clamp(vectors.Get(i), max));
+}
+
+const char* Elite::GetBatchInstructionSet()
+{
+#if defined(ELITE_SIMD_AVX)
+	return "AVX";
+#elif defined(ELITE_SIMD_SSE)
+	return "SSE";
+#else
+	return "Scalar";
+#endif
+}
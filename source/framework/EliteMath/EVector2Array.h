@@ -0,0 +1,72 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EVector2Array.h: Vector2s stored as separate x and y arrays (SoA) and batch functions that work on
+// the whole array at once. The batch functions use AVX or SSE when the build targets it and plain
+// loops otherwise. Every result is bit for bit what the Vector2 function gives for that element,
+// as long as the compiler doesn't fuse the multiply-adds of the Vector2 functions (MSVC doesn't under /fp:precise).
+/*=============================================================================*/
+#ifndef ELITE_MATH_VECTOR2_ARRAY
+#define	ELITE_MATH_VECTOR2_ARRAY
+
+namespace Elite
+{
+	class Vector2Array final
+	{
+	public:
+		Vector2Array() = default;
+		explicit Vector2Array(const std::vector<Vector2>& vectors);
+		~Vector2Array() = default;
+
+		void Add(const Vector2& v) { m_Xs.push_back(v.x); m_Ys.push_back(v.y); }
+		void Set(size_t idx, const Vector2& v) { m_Xs[idx] = v.x; m_Ys[idx] = v.y; }
+		Vector2 Get(size_t idx) const { return { m_Xs[idx], m_Ys[idx] }; }
+
+		size_t Size() const { return m_Xs.size(); }
+		bool IsEmpty() const { return m_Xs.empty(); }
+		void Resize(size_t size) { m_Xs.resize(size); m_Ys.resize(size); }
+		void Reserve(size_t size) { m_Xs.reserve(size); m_Ys.reserve(size); }
+		void Clear() { m_Xs.clear(); m_Ys.clear(); }
+
+		void Assign(const std::vector<Vector2>& vectors);
+		void CopyTo(std::vector<Vector2>& vectors) const;
+
+		float* GetXs() { return m_Xs.data(); }
+		float* GetYs() { return m_Ys.data(); }
+		const float* GetXs() const { return m_Xs.data(); }
+		const float* GetYs() const { return m_Ys.data(); }
+
+	private:
+		std::vector<float> m_Xs{};
+		std::vector<float> m_Ys{};
+	};
+
+	//=== Batch Functions ===
+	//Results are written to pResults, which needs room for one float per element.
+	//Arrays that are combined need the same size.
+
+	//pResults[i] = vectors[i].DistanceSquared(target)
+	void DistanceSquared(const Vector2Array& vectors, const Vector2& target, float* pResults);
+	//Index of the closest element with a squared distance below radius², the lowest index on a tie. -1 when none is.
+	int FindNearestWithinRadius(const Vector2Array& vectors, const Vector2& target, float radius);
+	//Appends the index of every element with a squared distance below radius², in order. Returns how many were added.
+	int GatherWithinRadius(const Vector2Array& vectors, const Vector2& target, float radius, std::vector<int>& indices);
+
+	//pResults[i] = a[i].Dot(b[i])
+	void Dot(const Vector2Array& a, const Vector2Array& b, float* pResults);
+	//pResults[i] = a[i].Cross(b[i])
+	void Cross(const Vector2Array& a, const Vector2Array& b, float* pResults);
+
+	//vectors[i].Normalize()
+	void Normalize(Vector2Array& vectors);
+	//vectors[i] = Clamp(vectors[i], max)
+	void Clamp(Vector2Array& vectors, float max);
+
+	//Which instructions the batch functions were built with: "AVX", "SSE" or "Scalar"
+	const char* GetBatchInstructionSet();
+
+	//Compares every batch function with the Vector2 function per element and times both.
+	//Writes the results to output and returns false when a result differs. Run with --batch-benchmark.
+	bool RunVector2BatchBenchmark(std::ostream& output);
+}
+#endif
@@ -0,0 +1,229 @@
+//=== General Includes ===
+#include "stdafx.h"
+#include "EVector2Array.h"
+#include <cstring>
+using namespace Elite;
+
+namespace
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	const int NrOfRepeats = 100;
+
+	//Bit for bit, so signed zeros and NaNs have to match too
+	bool AreIdentical(float a, float b)
+	{
+		return std::memcmp(&a, &b, sizeof(float)) == 0;
+	}
+
+	bool AreIdentical(const Vector2& a, const Vector2& b)
+	{
+		return AreIdentical(a.x, b.x) && AreIdentical(a.y, b.y);
+	}
+
+	template<typename Function>
+	double GetNsPerElement(size_t count, Function function)
+	{
+		const auto start = Clock::now();
+		for (int i = 0; i < NrOfRepeats; ++i)
+			function();
+		return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / (static_cast<double>(count) * NrOfRepeats);
+	}
+
+	void WriteResult(std::ostream& output, const char* name, bool isIdentical, double scalarNs, double batchNs)
+	{
+		output << name << ": " << (isIdentical ? "identical" : "DIFFERENT") << ", Vector2 " << scalarNs << " ns, batch "
+			<< batchNs << " ns per element (" << scalarNs / batchNs << "x)" << std::endl;
+	}
+}
+
+bool Elite::RunVector2BatchBenchmark(std::ostream& output)
+{
+	//Not a multiple of any SIMD width, so the remainder runs through the Vector2 functions
+	const size_t count{ 100003 };
+	std::mt19937 generator{ 42 };
+	std::uniform_real_distribution<float> distribution{ -100.f, 100.f };
+
+	std::vector<Vector2> as(count), bs(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		as[i] = { distribution(generator), distribution(generator) };
+		bs[i] = { distribution(generator), distribution(generator) };
+	}
+
+	//Cases the comparisons and the zero check of Normalize have to agree on
+	const Vector2 target{ 12.5f, -7.25f };
+	as[0] = ZeroVector2;
+	as[1] = { FLT_EPSILON, 0.f };
+	as[2] = { FLT_EPSILON * 0.5f, 0.f };
+	as[3] = { -0.f, 1e-30f };
+	as[4] = { 1e30f, -1e30f };
+	//Outside of the random points, equally close to the nearest target
+	const Vector2 nearestTarget{ 150.5f, -120.25f };
+	as[5] = nearestTarget + Vector2{ 0.5f, 0.f };
+	as[6] = nearestTarget + Vector2{ -0.5f, 0.f };
+	as[count - 1] = nearestTarget + Vector2{ 0.f, 0.5f };
+
+	const Vector2Array aArray{ as };
+	const Vector2Array bArray{ bs };
+	std::vector<float> scalarResults(count), batchResults(count);
+	std::vector<Vector2> vectors{};
+	bool hasPassed{ true };
+
+	output << "Vector2 batch functions (" << GetBatchInstructionSet() << "), " << count << " elements" << std::endl;
+
+	//DistanceSquared
+	{
+		const auto runScalar = [&]()
+		{
+			for (size_t i = 0; i < count; ++i)
+				scalarResults[i] = as[i].DistanceSquared(target);
+		};
+		const auto runBatch = [&]() { DistanceSquared(aArray, target, batchResults.data()); };
+		runScalar();
+		runBatch();
+
+		bool isIdentical{ true };
+		for (size_t i = 0; i < count; ++i)
+			isIdentical = isIdentical && AreIdentical(scalarResults[i], batchResults[i]);
+		WriteResult(output, "DistanceSquared", isIdentical, GetNsPerElement(count, runScalar), GetNsPerElement(count, runBatch));
+		hasPassed = hasPassed && isIdentical;
+	}
+
+	//FindNearestWithinRadius, elements 5, 6 and the last one are equally close.
+	//Volatile, or the compiler only runs the last of the repeated loops.
+	{
+		volatile int scalarIdx{}, batchIdx{};
+		const float radius{ 2.f };
+		const auto runScalar = [&]()
+		{
+			int nearestIdx{ -1 };
+			float nearestDistanceSquared{ radius * radius };
+			for (size_t i = 0; i < count; ++i)
+			{
+				const float distanceSquared{ as[i].DistanceSquared(nearestTarget) };
+				if (distanceSquared < nearestDistanceSquared)
+				{
+					nearestDistanceSquared = distanceSquared;
+					nearestIdx = static_cast<int>(i);
+				}
+			}
+			scalarIdx = nearestIdx;
+		};
+		const auto runBatch = [&]() { batchIdx = FindNearestWithinRadius(aArray, nearestTarget, radius); };
+		runScalar();
+		runBatch();
+
+		const bool isIdentical{ scalarIdx == batchIdx && batchIdx == 5 };
+		WriteResult(output, "FindNearestWithinRadius", isIdentical, GetNsPerElement(count, runScalar), GetNsPerElement(count, runBatch));
+		hasPassed = hasPassed && isIdentical;
+	}
+
+	//GatherWithinRadius
+	{
+		std::vector<int> scalarIndices{}, batchIndices{};
+		const float radius{ 20.f };
+		const auto runScalar = [&]()
+		{
+			scalarIndices.clear();
+			for (size_t i = 0; i < count; ++i)
+			{
+				if (as[i].DistanceSquared(target) < radius * radius)
+					scalarIndices.push_back(static_cast<int>(i));
+			}
+		};
+		const auto runBatch = [&]()
+		{
+			batchIndices.clear();
+			GatherWithinRadius(aArray, target, radius, batchIndices);
+		};
+		runScalar();
+		runBatch();
+
+		const bool isIdentical{ scalarIndices == batchIndices };
+		WriteResult(output, "GatherWithinRadius", isIdentical, GetNsPerElement(count, runScalar), GetNsPerElement(count, runBatch));
+		hasPassed = hasPassed && isIdentical;
+	}
+
+	//Dot
+	{
+		const auto runScalar = [&]()
+		{
+			for (size_t i = 0; i < count; ++i)
+				scalarResults[i] = as[i].Dot(bs[i]);
+		};
+		const auto runBatch = [&]() { Dot(aArray, bArray, batchResults.data()); };
+		runScalar();
+		runBatch();
+
+		bool isIdentical{ true };
+		for (size_t i = 0; i < count; ++i)
+			isIdentical = isIdentical && AreIdentical(scalarResults[i], batchResults[i]);
+		WriteResult(output, "Dot", isIdentical, GetNsPerElement(count, runScalar), GetNsPerElement(count, runBatch));
+		hasPassed = hasPassed && isIdentical;
+	}
+
+	//Cross
+	{
+		const auto runScalar = [&]()
+		{
+			for (size_t i = 0; i < count; ++i)
+				scalarResults[i] = as[i].Cross(bs[i]);
+		};
+		const auto runBatch = [&]() { Cross(aArray, bArray, batchResults.data()); };
+		runScalar();
+		runBatch();
+
+		bool isIdentical{ true };
+		for (size_t i = 0; i < count; ++i)
+			isIdentical = isIdentical && AreIdentical(scalarResults[i], batchResults[i]);
+		WriteResult(output, "Cross", isIdentical, GetNsPerElement(count, runScalar), GetNsPerElement(count, runBatch));
+		hasPassed = hasPassed && isIdentical;
+	}
+
+	//Normalize, checked on the first pass and timed on the already normalized vectors
+	{
+		std::vector<Vector2> scalarVectors{ as };
+		Vector2Array batchVectors{ as };
+		const auto runScalar = [&]()
+		{
+			for (Vector2& v : scalarVectors)
+				v.Normalize();
+		};
+		const auto runBatch = [&]() { Normalize(batchVectors); };
+		runScalar();
+		runBatch();
+
+		batchVectors.CopyTo(vectors);
+		bool isIdentical{ true };
+		for (size_t i = 0; i < count; ++i)
+			isIdentical = isIdentical && AreIdentical(scalarVectors[i], vectors[i]);
+		WriteResult(output, "Normalize", isIdentical, GetNsPerElement(count, runScalar), GetNsPerElement(count, runBatch));
+		hasPassed = hasPassed && isIdentical;
+	}
+
+	//Clamp
+	{
+		const float max{ 50.f };
+		std::vector<Vector2> scalarVectors{ as };
+		Vector2Array batchVectors{ as };
+		const auto runScalar = [&]()
+		{
+			for (Vector2& v : scalarVectors)
+				v = Elite::Clamp(v, max);
+		};
+		const auto runBatch = [&]() { Clamp(batchVectors, max); };
+		runScalar();
+		runBatch();
+
+		batchVectors.CopyTo(vectors);
+		bool isIdentical{ true };
+		for (size_t i = 0; i < count; ++i)
+			isIdentical = isIdentical && AreIdentical(scalarVectors[i], vectors[i]);
+		WriteResult(output, "Clamp", isIdentical, GetNsPerElement(count, runScalar), GetNsPerElement(count, runBatch));
+		hasPassed = hasPassed && isIdentical;
+	}
+
+	output << "Vector2 batch benchmark " << (hasPassed ? "PASSED" : "FAILED") << std::endl;
+	return hasPassed;
+}
@@ -0,0 +1,244 @@
+//=== General Includes ===
+#include "stdafx.h"
+#include "FMatrix.h"
+#include "ESimd.h"
+using namespace Elite;
+
+namespace
+{
+	//Columns of pA that are summed before the results go back to memory, a block of pA stays in L2
+	const int InnerBlockSize = 256;
+	//Rows of pA per block, RowBlockSize x InnerBlockSize floats is 128 KB
+	const int RowBlockSize = 128;
+	//Columns of pC per strip, 2 registers of rows x 4 columns of sums stay in registers
+	const int MaxStripColumns = 4;
+
+	float Activate(float value, Activation activation)
+	{
+		switch (activation)
+		{
+		case Activation::Sigmoid:
+			return 1.f / (1.f + expf(-value));
+		case Activation::ReLU:
+			return value > 0.f ? value : 0.f;
+		default:
+			return value;
+		}
+	}
+
+	Simd::Float ActivateLanes(Simd::Float values, Activation activation)
+	{
+		switch (activation)
+		{
+		case Activation::Sigmoid:
+			return Simd::Div(Simd::Set(1.f), Simd::Add(Simd::Set(1.f), SimdExp(Simd::Sub(Simd::Set(0.f), values))));
+		case Activation::ReLU:
+			return Simd::Max(values, Simd::Set(0.f));
+		default:
+			return values;
+		}
+	}
+
+	struct Multiplication
+	{
+		const float* pA;
+		const float* pB;
+		float* pC;
+		int rows, inner, columns;
+		const float* pBias;
+		Activation activation;
+	};
+
+	//Rows [row, row + NrOfRegisters * Width) of NrOfColumns columns of pC, for inner [innerBegin, innerEnd)
+	template<int NrOfRegisters, int NrOfColumns>
+	void MultiplyStrip(const Multiplication& m, int row, int column, int innerBegin, int innerEnd)
+	{
+		const bool isFirstBlock{ innerBegin == 0 };
+		const bool isLastBlock{ innerEnd == m.inner };
+
+		Simd::Float sums[NrOfRegisters][NrOfColumns];
+		for (int c = 0; c < NrOfColumns; ++c)
+		{
+			for (int r = 0; r < NrOfRegisters; ++r)
+				sums[r][c] = isFirstBlock ? Simd::Set(0.f) : Simd::Load(m.pC + (column + c) * m.rows + row + r * Simd::Width);
+		}
+
+		for (int p = innerBegin; p < innerEnd; ++p)
+		{
+			Simd::Float a[NrOfRegisters];
+			for (int r = 0; r < NrOfRegisters; ++r)
+				a[r] = Simd::Load(m.pA + p * m.rows + row + r * Simd::Width);
+
+			for (int c = 0; c < NrOfColumns; ++c)
+			{
+				const Simd::Float b{ Simd::Set(m.pB[(column + c) * m.inner + p]) };
+				for (int r = 0; r < NrOfRegisters; ++r)
+					sums[r][c] = Simd::MulAdd(a[r], b, sums[r][c]);
+			}
+		}
+
+		for (int c = 0; c < NrOfColumns; ++c)
+		{
+			for (int r = 0; r < NrOfRegisters; ++r)
+			{
+				Simd::Float result{ sums[r][c] };
+				if (isLastBlock)
+				{
+					if (m.pBias)
+						result = Simd::Add(result, Simd::Load(m.pBias + row + r * Simd::Width));
+					result = ActivateLanes(result, m.activation);
+				}
+				Simd::Store(m.pC + (column + c) * m.rows + row + r * Simd::Width, result);
+			}
+		}
+	}
+
+	//Rows that don't fill a register
+	void MultiplyRemainingRows(const Multiplication& m, int rowBegin, int rowEnd, int column, int nrOfColumns, int innerBegin, int innerEnd)
+	{
+		for (int c = column; c < column + nrOfColumns; ++c)
+		{
+			for (int row = rowBegin; row < rowEnd; ++row)
+			{
+				float sum{ innerBegin == 0 ? 0.f : m.pC[c * m.rows + row] };
+				for (int p = innerBegin; p < innerEnd; ++p)
+					sum += m.pA[p * m.rows + row] * m.pB[c * m.inner + p];
+
+				if (innerEnd == m.inner)
+					sum = Activate(m.pBias ? sum + m.pBias[row] : sum, m.activation);
+				m.pC[c * m.rows + row] = sum;
+			}
+		}
+	}
+
+	template<int NrOfColumns>
+	void MultiplyColumns(const Multiplication& m, int rowBegin, int rowEnd, int column, int innerBegin, int innerEnd)
+	{
+		int row{ rowBegin };
+		for (; row + 2 * Simd::Width <= rowEnd; row += 2 * Simd::Width)
+			MultiplyStrip<2, NrOfColumns>(m, row, column, innerBegin, innerEnd);
+		for (; row + Simd::Width <= rowEnd; row += Simd::Width)
+			MultiplyStrip<1, NrOfColumns>(m, row, column, innerBegin, innerEnd);
+		MultiplyRemainingRows(m, row, rowEnd, column, NrOfColumns, innerBegin, innerEnd);
+	}
+
+	//One block of the batch. Every weight and input is a contiguous run of the matrices in the block,
+	//the sums of one element stay in L1 while the weights stream through.
+	void FeedForwardBlock(const FMatrixBatch& weights, const FMatrixBatch& bias, const FMatrixBatch& inputs, FMatrixBatch& result,
+		Activation activation, int block)
+	{
+		alignas(FMatrix::Alignment) float sums[FMatrixBatch::MaxBlockSize];
+		const int blockSize{ weights.GetBlockSize() };
+		for (int column = 0; column < inputs.GetNrOfColumns(); ++column)
+		{
+			for (int row = 0; row < weights.GetNrOfRows(); ++row)
+			{
+				const float* pBias{ bias.GetElement(block, row, 0) };
+				std::copy(pBias, pBias + blockSize, sums);
+				for (int input = 0; input < weights.GetNrOfColumns(); ++input)
+				{
+					const float* pWeights{ weights.GetElement(block, row, input) };
+					const float* pInputs{ inputs.GetElement(block, input, column) };
+					for (int i = 0; i < blockSize; i += Simd::Width)
+						Simd::Store(sums + i, Simd::MulAdd(Simd::Load(pWeights + i), Simd::Load(pInputs + i), Simd::Load(sums + i)));
+				}
+
+				float* pResults{ result.GetElement(block, row, column) };
+				for (int i = 0; i < blockSize; i += Simd::Width)
+					Simd::Store(pResults + i, ActivateLanes(Simd::Load(sums + i), activation));
+			}
+		}
+	}
+}
+
+void Elite::MultiplyMatrices(const float* pA, const float* pB, float* pC, int rows, int inner, int columns,
+	const float* pBias, Activation activation)
+{
+	ELITE_PROFILE_SCOPE("MultiplyMatrices");
+
+	const Multiplication m{ pA, pB, pC, rows, inner, columns, pBias, activation };
+	if (inner == 0)
+	{
+		//Nothing to sum, only the bias is left
+		for (int c = 0; c < columns; ++c)
+		{
+			for (int row = 0; row < rows; ++row)
+				pC[c * rows + row] = Activate(pBias ? pBias[row] : 0.f, activation);
+		}
+		return;
+	}
+
+	for (int innerBegin = 0; innerBegin < inner; innerBegin += InnerBlockSize)
+	{
+		const int innerEnd{ std::min(innerBegin + InnerBlockSize, inner) };
+		for (int rowBegin = 0; rowBegin < rows; rowBegin += RowBlockSize)
+		{
+			const int rowEnd{ std::min(rowBegin + RowBlockSize, rows) };
+			int column{ 0 };
+			for (; column + MaxStripColumns <= columns; column += MaxStripColumns)
+				MultiplyColumns<MaxStripColumns>(m, rowBegin, rowEnd, column, innerBegin, innerEnd);
+
+			switch (columns - column)
+			{
+			case 3: MultiplyColumns<3>(m, rowBegin, rowEnd, column, innerBegin, innerEnd); break;
+			case 2: MultiplyColumns<2>(m, rowBegin, rowEnd, column, innerBegin, innerEnd); break;
+			case 1: MultiplyColumns<1>(m, rowBegin, rowEnd, column, innerBegin, innerEnd); break;
+			default: break;
+			}
+		}
+	}
+}
+
+void Elite::ApplyActivation(float* pData, int size, Activation activation)
+{
+	if (activation == Activation::None)
+		return;
+
+	int i{ 0 };
+	for (; i + Simd::Width <= size; i += Simd::Width)
+		Simd::Store(pData + i, ActivateLanes(Simd::Load(pData + i), activation));
+	for (; i < size; ++i)
+		pData[i] = Activate(pData[i], activation);
+}
+
+bool Elite::FeedForward(const FMatrix& weights, const FMatrix& bias, const FMatrix& inputs, FMatrix& result, Activation activation)
+{
+	if (weights.GetNrOfColumns() != inputs.GetNrOfRows() || bias.GetNrOfRows() != weights.GetNrOfRows() || bias.GetNrOfColumns() != 1)
+	{
+		printf("Wrong sizes! [%d, %d] * [%d, %d] + [%d, %d]\n", weights.GetNrOfRows(), weights.GetNrOfColumns(),
+			inputs.GetNrOfRows(), inputs.GetNrOfColumns(), bias.GetNrOfRows(), bias.GetNrOfColumns());
+		return false;
+	}
+
+	if (result.GetNrOfRows() != weights.GetNrOfRows() || result.GetNrOfColumns() != inputs.GetNrOfColumns())
+		result.Resize(weights.GetNrOfRows(), inputs.GetNrOfColumns());
+
+	MultiplyMatrices(weights.GetData(), inputs.GetData(), result.GetData(), weights.GetNrOfRows(), weights.GetNrOfColumns(),
+		inputs.GetNrOfColumns(), bias.GetData(), activation);
+	return true;
+}
+
+bool Elite::FeedForward(const FMatrixBatch& weights, const FMatrixBatch& bias, const FMatrixBatch& inputs, FMatrixBatch& result, Activation activation)
+{
+	ELITE_PROFILE_SCOPE("FeedForward (batch)");
+
+	const int nrOfMatrices{ weights.GetNrOfMatrices() };
+	if (weights.GetNrOfColumns() != inputs.GetNrOfRows() || bias.GetNrOfRows() != weights.GetNrOfRows() || bias.GetNrOfColumns() != 1
+		|| bias.GetNrOfMatrices() != nrOfMatrices || inputs.GetNrOfMatrices() != nrOfMatrices)
+	{
+		printf("Wrong sizes! %d x [%d, %d] * %d x [%d, %d] + %d x [%d, %d]\n", nrOfMatrices, weights.GetNrOfRows(), weights.GetNrOfColumns(),
+			inputs.GetNrOfMatrices(), inputs.GetNrOfRows(), inputs.GetNrOfColumns(), bias.GetNrOfMatrices(), bias.GetNrOfRows(), bias.GetNrOfColumns());
+		return false;
+	}
+
+	if (result.GetNrOfRows() != weights.GetNrOfRows() || result.GetNrOfColumns() != inputs.GetNrOfColumns() || result.GetNrOfMatrices() != nrOfMatrices)
+		result.Resize(weights.GetNrOfRows(), inputs.GetNrOfColumns(), nrOfMatrices);
+
+	//The padding of the last block is computed along, a block is a multiple of the register width
+	JOBSYSTEM->ParallelFor(weights.GetNrOfBlocks(), 1, [&](int blockBegin, int blockEnd)
+		{
+			for (int block = blockBegin; block < blockEnd; ++block)
+				FeedForwardBlock(weights, bias, inputs, result, activation, block);
+		});
+	return true;
+}
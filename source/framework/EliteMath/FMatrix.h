@@ -2,28 +2,97 @@
 // Copyright 2021-2022 Elite Engine
 // Authors: Koen Samyn
 /*=============================================================================*/
-// FMatrix.cpp: FMatrix class
+// FMatrix.h: FMatrix class, column-major matrix of floats
 /*=============================================================================*/
 #ifndef ELITE_MATH_FMATRIX
 #define	ELITE_MATH_FMATRIX
 
 #include <random>
+#include <new>
 namespace Elite 
 {
+	//What a layer of a network does with its weighted sums
+	enum class Activation
+	{
+		None,
+		Sigmoid,
+		ReLU
+	};
+
+	//=== Kernels (FMatrix.cpp) ===
+	//pC = pA * pB for column-major data: pA is rows x inner, pB is inner x columns and pC rows x columns.
+	//Cache blocked and vectorized. pC = activation(pA * pB + pBias) when given, pBias has one value per row.
+	//The bias and activation are applied while the results are still in registers.
+	void MultiplyMatrices(const float* pA, const float* pB, float* pC, int rows, int inner, int columns,
+		const float* pBias = nullptr, Activation activation = Activation::None);
+	//pData[i] = activation(pData[i]), sigmoid with a vectorized exp
+	void ApplyActivation(float* pData, int size, Activation activation);
+
 	class FMatrix
 	{
 	public:
+		//The data starts at an address the widest SIMD registers can load from, columns are contiguous
+		static const size_t Alignment = 32;
+
 		FMatrix(): m_Data(nullptr), m_Rows(0), m_Columns(0), m_Size(0) {}
 		FMatrix(int rows, int columns): 
 			m_Rows(rows),
 			m_Columns(columns),
-			m_Data(new float[rows * columns]),
+			m_Data(Allocate(rows * columns)),
 			m_Size(rows * columns)
 		{}
+		FMatrix(const FMatrix& other) :
+			m_Rows(other.m_Rows),
+			m_Columns(other.m_Columns),
+			m_Data(Allocate(other.m_Size)),
+			m_Size(other.m_Size)
+		{
+			std::copy(other.m_Data, other.m_Data + m_Size, m_Data);
+		}
+		FMatrix(FMatrix&& other) noexcept :
+			m_Rows(other.m_Rows),
+			m_Columns(other.m_Columns),
+			m_Data(other.m_Data),
+			m_Size(other.m_Size)
+		{
+			other.m_Data = nullptr;
+			other.m_Rows = other.m_Columns = other.m_Size = 0;
+		}
+
+		FMatrix& operator=(const FMatrix& other)
+		{
+			if (this != &other)
+			{
+				if (m_Size != other.m_Size)
+				{
+					Free(m_Data);
+					m_Data = Allocate(other.m_Size);
+				}
+				m_Rows = other.m_Rows;
+				m_Columns = other.m_Columns;
+				m_Size = other.m_Size;
+				std::copy(other.m_Data, other.m_Data + m_Size, m_Data);
+			}
+			return *this;
+		}
+		FMatrix& operator=(FMatrix&& other) noexcept
+		{
+			if (this != &other)
+			{
+				Free(m_Data);
+				m_Data = other.m_Data;
+				m_Rows = other.m_Rows;
+				m_Columns = other.m_Columns;
+				m_Size = other.m_Size;
+				other.m_Data = nullptr;
+				other.m_Rows = other.m_Columns = other.m_Size = 0;
+			}
+			return *this;
+		}
 
 		virtual ~FMatrix()
 		{
-			delete[] m_Data;
+			Free(m_Data);
 			m_Data = nullptr;
 		}
 
@@ -32,8 +101,8 @@ namespace Elite
 			m_Rows = nrOfRows;
 			m_Columns = nrOfColumns;
 			m_Size = m_Rows * m_Columns;
-			delete[] m_Data; //ATTENTION: DELETES OLD DATA IN MATRIX
-			m_Data = new float[m_Size];
+			Free(m_Data); //ATTENTION: DELETES OLD DATA IN MATRIX
+			m_Data = Allocate(m_Size);
 		}
 
 		void Set(int row, int column, float value)
@@ -113,8 +182,25 @@ namespace Elite
 		{
 			return m_Columns;
 		}
+		//Element (r, c) is at c * rows + r, for the kernels in FMatrix.cpp
+		float* GetData()
+		{
+			return m_Data;
+		}
+		const float* GetData() const
+		{
+			return m_Data;
+		}
+
 		void MatrixMultiply(const FMatrix& op2, FMatrix& result)
 		{
+			//Matching sizes go through the blocked kernel, anything else multiplies the overlapping part
+			if (GetNrOfColumns() == op2.GetNrOfRows() && result.GetNrOfRows() == GetNrOfRows() && result.GetNrOfColumns() == op2.GetNrOfColumns())
+			{
+				MultiplyMatrices(m_Data, op2.m_Data, result.m_Data, m_Rows, m_Columns, op2.m_Columns);
+				return;
+			}
+
 			int maxRows = min(GetNrOfRows(), result.GetNrOfRows());
 			int maxColumns = min(op2.GetNrOfColumns(), result.GetNrOfColumns());
 
@@ -169,11 +255,7 @@ namespace Elite
 		}
 		void Sigmoid()
 		{
-			for (int i = 0; i < m_Size; ++i)
-			{
-				float val = m_Data[i];
-				m_Data[i] = 1 / (1 + exp(-val));
-			}
+			ApplyActivation(m_Data, m_Size, Activation::Sigmoid);
 		}
 
 		float Sum() const
@@ -261,7 +343,22 @@ namespace Elite
 			{
 				return c * m_Rows + r;
 			}
+
+			static float* Allocate(int size)
+			{
+				return static_cast<float*>(::operator new[](sizeof(float) * size, std::align_val_t{ Alignment }));
+			}
+			static void Free(float* pData)
+			{
+				if (pData)
+					::operator delete[](pData, std::align_val_t{ Alignment });
+			}
 	};
+
+	//result = activation(weights * inputs + bias): one layer of a network for every column of inputs at once.
+	//bias is a single column with a value per row of weights, result is resized when needed.
+	//Returns false when the sizes don't fit.
+	bool FeedForward(const FMatrix& weights, const FMatrix& bias, const FMatrix& inputs, FMatrix& result, Activation activation);
 }
 #endif
 
@@ -0,0 +1,39 @@
+//=== General Includes ===
+#include "stdafx.h"
+#include "FMatrixBatch.h"
+using namespace Elite;
+
+void FMatrixBatch::Resize(int rows, int columns, int nrOfMatrices)
+{
+	//Every element starts aligned, so the loads of a SIMD lane never straddle two elements
+	const int matricesPerAlignment{ static_cast<int>(FMatrix::Alignment / sizeof(float)) };
+	m_Rows = rows;
+	m_Columns = columns;
+	m_NrOfMatrices = nrOfMatrices;
+	m_BlockSize = std::min((nrOfMatrices + matricesPerAlignment - 1) / matricesPerAlignment * matricesPerAlignment, MaxBlockSize);
+	m_NrOfBlocks = m_BlockSize > 0 ? (nrOfMatrices + m_BlockSize - 1) / m_BlockSize : 0;
+
+	m_Data.Resize(m_BlockSize, m_NrOfBlocks * rows * columns);
+	m_Data.SetAll(0.f);
+}
+
+void FMatrixBatch::SetMatrix(int matrix, const FMatrix& values)
+{
+	for (int column = 0; column < m_Columns; ++column)
+	{
+		for (int row = 0; row < m_Rows; ++row)
+			Set(matrix, row, column, values.Get(row, column));
+	}
+}
+
+void FMatrixBatch::GetMatrix(int matrix, FMatrix& values) const
+{
+	if (values.GetNrOfRows() != m_Rows || values.GetNrOfColumns() != m_Columns)
+		values.Resize(m_Rows, m_Columns);
+
+	for (int column = 0; column < m_Columns; ++column)
+	{
+		for (int row = 0; row < m_Rows; ++row)
+			values.Set(row, column, Get(matrix, row, column));
+	}
+}
@@ -0,0 +1,70 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// FMatrixBatch.h: many matrices of the same size, stored interleaved in blocks.
+// Within a block, element (row, column) of every matrix is one contiguous run, so the networks of a
+// population, which all have the same layers, are evaluated together: every SIMD lane is another network.
+// Every block is contiguous too, one job of a feed forward streams through one block.
+/*=============================================================================*/
+#ifndef ELITE_MATH_FMATRIX_BATCH
+#define	ELITE_MATH_FMATRIX_BATCH
+
+namespace Elite
+{
+	class FMatrixBatch final
+	{
+	public:
+		FMatrixBatch() = default;
+		FMatrixBatch(int rows, int columns, int nrOfMatrices) { Resize(rows, columns, nrOfMatrices); }
+		~FMatrixBatch() = default;
+
+		//ATTENTION: DELETES OLD DATA, every element is 0 afterwards
+		void Resize(int rows, int columns, int nrOfMatrices);
+
+		int GetNrOfRows() const { return m_Rows; }
+		int GetNrOfColumns() const { return m_Columns; }
+		int GetNrOfMatrices() const { return m_NrOfMatrices; }
+		//Matrices per block, a multiple of the widest SIMD register. The last block is padded.
+		int GetBlockSize() const { return m_BlockSize; }
+		int GetNrOfBlocks() const { return m_NrOfBlocks; }
+
+		float Get(int matrix, int row, int column) const { return GetElement(matrix / m_BlockSize, row, column)[matrix % m_BlockSize]; }
+		void Set(int matrix, int row, int column, float value) { GetElement(matrix / m_BlockSize, row, column)[matrix % m_BlockSize] = value; }
+
+		void SetMatrix(int matrix, const FMatrix& values);
+		void GetMatrix(int matrix, FMatrix& values) const;
+
+		void SetAll(float value) { m_Data.SetAll(value); }
+		void Randomize(float min, float max) { m_Data.Randomize(min, max); }
+
+		//Element (row, column) of every matrix in the block, GetBlockSize() floats
+		float* GetElement(int block, int row, int column) { return m_Data.GetData() + GetElementIdx(block, row, column); }
+		const float* GetElement(int block, int row, int column) const { return m_Data.GetData() + GetElementIdx(block, row, column); }
+
+		//Most matrices per block, 256 floats of sums per element stay in L1
+		static const int MaxBlockSize = 256;
+
+	private:
+		//Column per element of every block, row per matrix in the block
+		FMatrix m_Data{};
+		int m_Rows = 0;
+		int m_Columns = 0;
+		int m_NrOfMatrices = 0;
+		int m_BlockSize = 0;
+		int m_NrOfBlocks = 0;
+
+		int GetElementIdx(int block, int row, int column) const
+		{
+			return ((block * m_Columns + column) * m_Rows + row) * m_BlockSize;
+		}
+	};
+
+	//result[m] = activation(weights[m] * inputs[m] + bias[m]) for every matrix m, split over the job system.
+	//bias has a single column, result is resized when needed. Returns false when the sizes don't fit.
+	bool FeedForward(const FMatrixBatch& weights, const FMatrixBatch& bias, const FMatrixBatch& inputs, FMatrixBatch& result, Activation activation);
+
+	//Blocked multiply, fused activation and batched feed forward against the straightforward loops.
+	//Writes the results to output and returns false when a result is off. Run with --fmatrix-benchmark.
+	bool RunFMatrixBenchmark(std::ostream& output);
+}
+#endif
@@ -0,0 +1,248 @@
+//=== General Includes ===
+#include "stdafx.h"
+#include "FMatrix.h"
+#include "FMatrixBatch.h"
+using namespace Elite;
+
+namespace
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	double GetElapsedMs(const Clock::time_point& start)
+	{
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+	//How FMatrix multiplied before the blocked kernel, through the bounds checked Get and Set
+	void MultiplyWithGetSet(const FMatrix& a, const FMatrix& b, FMatrix& result)
+	{
+		for (int row = 0; row < result.GetNrOfRows(); ++row)
+		{
+			for (int column = 0; column < result.GetNrOfColumns(); ++column)
+			{
+				float sum = 0;
+				for (int index = 0; index < a.GetNrOfColumns(); ++index)
+					sum += a.Get(row, index) * b.Get(index, column);
+				result.Set(row, column, sum);
+			}
+		}
+	}
+
+	//A layer of a network without FeedForward: multiply, add the bias and a sigmoid with exp per element
+	void FeedForwardWithGetSet(const FMatrix& weights, const FMatrix& bias, const FMatrix& inputs, FMatrix& result)
+	{
+		MultiplyWithGetSet(weights, inputs, result);
+		for (int row = 0; row < result.GetNrOfRows(); ++row)
+		{
+			for (int column = 0; column < result.GetNrOfColumns(); ++column)
+			{
+				const float value{ result.Get(row, column) + bias.Get(row, 0) };
+				result.Set(row, column, 1 / (1 + exp(-value)));
+			}
+		}
+	}
+
+	float GetMaxDifference(const FMatrix& a, const FMatrix& b)
+	{
+		float maxDifference{};
+		for (int row = 0; row < a.GetNrOfRows(); ++row)
+		{
+			for (int column = 0; column < a.GetNrOfColumns(); ++column)
+				maxDifference = std::max(maxDifference, fabsf(a.Get(row, column) - b.Get(row, column)));
+		}
+		return maxDifference;
+	}
+
+	//Population of networks with one hidden layer, the size the genetic algorithm experiments use
+	const int NrOfInputs = 8;
+	const int NrOfHidden = 16;
+	const int NrOfOutputs = 4;
+
+	struct Network
+	{
+		FMatrix hiddenWeights{ NrOfHidden, NrOfInputs };
+		FMatrix hiddenBias{ NrOfHidden, 1 };
+		FMatrix outputWeights{ NrOfOutputs, NrOfHidden };
+		FMatrix outputBias{ NrOfOutputs, 1 };
+		FMatrix inputs{ NrOfInputs, 1 };
+		FMatrix hidden{ NrOfHidden, 1 };
+		FMatrix outputs{ NrOfOutputs, 1 };
+	};
+
+	bool RunPopulationBenchmark(std::ostream& output, int nrOfNetworks)
+	{
+		std::vector<Network> networks(nrOfNetworks);
+		for (Network& network : networks)
+		{
+			network.hiddenWeights.Randomize(-1.f, 1.f);
+			network.hiddenBias.Randomize(-1.f, 1.f);
+			network.outputWeights.Randomize(-1.f, 1.f);
+			network.outputBias.Randomize(-1.f, 1.f);
+			network.inputs.Randomize(-1.f, 1.f);
+		}
+
+		FMatrixBatch hiddenWeights{ NrOfHidden, NrOfInputs, nrOfNetworks };
+		FMatrixBatch hiddenBias{ NrOfHidden, 1, nrOfNetworks };
+		FMatrixBatch outputWeights{ NrOfOutputs, NrOfHidden, nrOfNetworks };
+		FMatrixBatch outputBias{ NrOfOutputs, 1, nrOfNetworks };
+		FMatrixBatch inputs{ NrOfInputs, 1, nrOfNetworks };
+		FMatrixBatch hidden{}, outputs{};
+		for (int i = 0; i < nrOfNetworks; ++i)
+		{
+			hiddenWeights.SetMatrix(i, networks[i].hiddenWeights);
+			hiddenBias.SetMatrix(i, networks[i].hiddenBias);
+			outputWeights.SetMatrix(i, networks[i].outputWeights);
+			outputBias.SetMatrix(i, networks[i].outputBias);
+			inputs.SetMatrix(i, networks[i].inputs);
+		}
+
+		const int nrOfRepeats{ std::max(1, 20000 / nrOfNetworks) };
+
+		auto start = Clock::now();
+		for (int repeat = 0; repeat < nrOfRepeats; ++repeat)
+		{
+			for (Network& network : networks)
+			{
+				FeedForwardWithGetSet(network.hiddenWeights, network.hiddenBias, network.inputs, network.hidden);
+				FeedForwardWithGetSet(network.outputWeights, network.outputBias, network.hidden, network.outputs);
+			}
+		}
+		const double getSetMs{ GetElapsedMs(start) / nrOfRepeats };
+		std::vector<FMatrix> expectedOutputs{};
+		for (const Network& network : networks)
+			expectedOutputs.push_back(network.outputs);
+
+		start = Clock::now();
+		for (int repeat = 0; repeat < nrOfRepeats; ++repeat)
+		{
+			for (Network& network : networks)
+			{
+				FeedForward(network.hiddenWeights, network.hiddenBias, network.inputs, network.hidden, Activation::Sigmoid);
+				FeedForward(network.outputWeights, network.outputBias, network.hidden, network.outputs, Activation::Sigmoid);
+			}
+		}
+		const double perNetworkMs{ GetElapsedMs(start) / nrOfRepeats };
+
+		start = Clock::now();
+		for (int repeat = 0; repeat < nrOfRepeats; ++repeat)
+		{
+			FeedForward(hiddenWeights, hiddenBias, inputs, hidden, Activation::Sigmoid);
+			FeedForward(outputWeights, outputBias, hidden, outputs, Activation::Sigmoid);
+		}
+		const double batchMs{ GetElapsedMs(start) / nrOfRepeats };
+
+		float maxDifference{};
+		FMatrix batchOutputs{};
+		for (int i = 0; i < nrOfNetworks; ++i)
+		{
+			maxDifference = std::max(maxDifference, GetMaxDifference(expectedOutputs[i], networks[i].outputs));
+			outputs.GetMatrix(i, batchOutputs);
+			maxDifference = std::max(maxDifference, GetMaxDifference(expectedOutputs[i], batchOutputs));
+		}
+
+		const bool isOk{ maxDifference <= 1e-5f };
+		output << "Population of " << nrOfNetworks << " networks " << NrOfInputs << "-" << NrOfHidden << "-" << NrOfOutputs
+			<< ": Get/Set " << getSetMs << " ms, FeedForward per network " << perNetworkMs << " ms (" << getSetMs / perNetworkMs
+			<< "x), batch " << batchMs << " ms (" << getSetMs / batchMs << "x), max difference " << maxDifference
+			<< (isOk ? "" : " WRONG") << std::endl;
+		return isOk;
+	}
+}
+
+bool Elite::RunFMatrixBenchmark(std::ostream& output)
+{
+	bool hasPassed{ true };
+
+	//Sizes around the register width and the block sizes
+	const int sizes[][3]{ { 1, 1, 1 }, { 7, 5, 3 }, { 8, 8, 8 }, { 17, 33, 5 }, { 37, 53, 29 }, { 130, 300, 9 }, { 129, 257, 66 } };
+	for (const auto& size : sizes)
+	{
+		FMatrix a{ size[0], size[1] }, b{ size[1], size[2] };
+		FMatrix expected{ size[0], size[2] }, result{ size[0], size[2] };
+		a.Randomize(-1.f, 1.f);
+		b.Randomize(-1.f, 1.f);
+		MultiplyWithGetSet(a, b, expected);
+		a.MatrixMultiply(b, result);
+
+		const float maxDifference{ GetMaxDifference(expected, result) };
+		const bool isOk{ maxDifference <= 1e-5f * size[1] };
+		if (!isOk)
+			output << "Multiply [" << size[0] << ", " << size[1] << "] * [" << size[1] << ", " << size[2] << "] is off by " << maxDifference << std::endl;
+		hasPassed = hasPassed && isOk;
+	}
+
+	//Throughput of a big multiply
+	{
+		const int size{ 256 };
+		FMatrix a{ size, size }, b{ size, size }, result{ size, size };
+		a.Randomize(-1.f, 1.f);
+		b.Randomize(-1.f, 1.f);
+
+		auto start = Clock::now();
+		MultiplyWithGetSet(a, b, result);
+		const double getSetMs{ GetElapsedMs(start) };
+
+		const int nrOfRepeats{ 20 };
+		start = Clock::now();
+		for (int i = 0; i < nrOfRepeats; ++i)
+			a.MatrixMultiply(b, result);
+		const double blockedMs{ GetElapsedMs(start) / nrOfRepeats };
+
+		const double flops{ 2.0 * size * size * size };
+		output << "Multiply " << size << "x" << size << ": Get/Set " << getSetMs << " ms (" << flops / getSetMs / 1e6 << " GFLOP/s), blocked "
+			<< blockedMs << " ms (" << flops / blockedMs / 1e6 << " GFLOP/s, " << getSetMs / blockedMs << "x)" << std::endl;
+	}
+
+	//Vectorized sigmoid against exp, on the whole range where it isn't flat
+	{
+		const int count{ 100001 };
+		FMatrix values{ 1, count };
+		for (int i = 0; i < count; ++i)
+			values.Set(0, i, -100.f + 200.f * i / (count - 1));
+		FMatrix expected{ values };
+		values.Sigmoid();
+
+		float maxDifference{};
+		for (int i = 0; i < count; ++i)
+		{
+			const float expectedValue{ static_cast<float>(1.0 / (1.0 + exp(-static_cast<double>(expected.Get(0, i))))) };
+			maxDifference = std::max(maxDifference, fabsf(values.Get(0, i) - expectedValue));
+		}
+
+		const bool isOk{ maxDifference <= 1e-6f };
+		output << "Sigmoid: max difference with exp " << maxDifference << (isOk ? "" : " WRONG") << std::endl;
+		hasPassed = hasPassed && isOk;
+	}
+
+	//One network over many inputs, every column is an input
+	{
+		const int nrOfColumns{ 4096 };
+		FMatrix weights{ NrOfHidden, NrOfInputs }, bias{ NrOfHidden, 1 }, inputs{ NrOfInputs, nrOfColumns };
+		FMatrix expected{ NrOfHidden, nrOfColumns }, result{};
+		weights.Randomize(-1.f, 1.f);
+		bias.Randomize(-1.f, 1.f);
+		inputs.Randomize(-1.f, 1.f);
+
+		auto start = Clock::now();
+		FeedForwardWithGetSet(weights, bias, inputs, expected);
+		const double getSetMs{ GetElapsedMs(start) };
+
+		const int nrOfRepeats{ 20 };
+		start = Clock::now();
+		for (int i = 0; i < nrOfRepeats; ++i)
+			FeedForward(weights, bias, inputs, result, Activation::Sigmoid);
+		const double feedForwardMs{ GetElapsedMs(start) / nrOfRepeats };
+
+		const float maxDifference{ GetMaxDifference(expected, result) };
+		const bool isOk{ maxDifference <= 1e-5f };
+		output << "Layer " << NrOfInputs << "-" << NrOfHidden << " over " << nrOfColumns << " inputs: Get/Set " << getSetMs << " ms, FeedForward "
+			<< feedForwardMs << " ms (" << getSetMs / feedForwardMs << "x), max difference " << maxDifference << (isOk ? "" : " WRONG") << std::endl;
+		hasPassed = hasPassed && isOk;
+	}
+
+	for (int nrOfNetworks : { 1000, 10000 })
+		hasPassed = RunPopulationBenchmark(output, nrOfNetworks) && hasPassed;
+
+	output << "FMatrix benchmark " << (hasPassed ? "PASSED" : "FAILED") << " with " << JOBSYSTEM->GetNrOfThreads() << " threads" << std::endl;
+	return hasPassed;
+}
@@ -4,27 +4,37 @@
 
 #ifdef USE_BOX2D
 //=== Extra Information ===
-struct Box2DPhysicsSettings
+//Counts the pairs the broadphase hands to the contact manager. Box2D only asks the filter about pairs
+//that don't have a contact yet, so this is the number of new pairs per step.
+class PairCountingContactFilter final : public b2ContactFilter
 {
-	Box2DPhysicsSettings()
+public:
+	bool ShouldCollide(b2Fixture* fixtureA, b2Fixture* fixtureB) override
 	{
-		hz = 60.0f;
-		velocityIterations = 8;
-		positionIterations = 3;
+		++m_NrOfPairs;
+		return b2ContactFilter::ShouldCollide(fixtureA, fixtureB);
 	}
 
-	float32 hz;
-	int32 velocityIterations;
-	int32 positionIterations;
+	int m_NrOfPairs = 0;
 };
 
 //=== Constructors & Destructors ===
 template<>
 PhysicsWorld::~EPhysicsWorld()
 {
+	{
+		std::lock_guard<std::mutex> lock{ m_StepMutex };
+		m_IsStopping = true;
+	}
+	m_StepCondition.notify_all();
+	if (m_StepThread.joinable())
+		m_StepThread.join();
+
 	SAFE_DELETE(m_pPhysicsWorld);
 	auto pDebugRenderer = static_cast<Box2DRenderer*>(m_pDebugRenderer);
 	SAFE_DELETE(pDebugRenderer);
+	auto pContactFilter = static_cast<PairCountingContactFilter*>(m_pContactFilter);
+	SAFE_DELETE(pContactFilter);
 }
 
 //=== Functions ===
@@ -35,11 +45,15 @@ void PhysicsWorld::Initialize()
 	b2Vec2 gravity;
 	gravity.Set(0.0f, 0.0f);
 	m_pPhysicsWorld = new b2World(gravity);
-	m_pPhysicsWorld->SetAllowSleeping(true);
+	m_pPhysicsWorld->SetAllowSleeping(m_Settings.allowSleeping);
 	m_pPhysicsWorld->SetWarmStarting(true);
-	m_pPhysicsWorld->SetContinuousPhysics(true);
+	m_pPhysicsWorld->SetContinuousPhysics(m_Settings.continuousPhysics);
 	m_pPhysicsWorld->SetSubStepping(false);
 
+	auto pContactFilter = new PairCountingContactFilter();
+	m_pPhysicsWorld->SetContactFilter(pContactFilter);
+	m_pContactFilter = pContactFilter;
+
 	auto pDebugRenderer = new Box2DRenderer();
 	const auto flags = 1; //Render: shapes
 	pDebugRenderer->SetFlags(flags);
@@ -48,29 +62,192 @@ void PhysicsWorld::Initialize()
 }
 
 template<>
-void PhysicsWorld::Simulate(float elapsedTime)
+void PhysicsWorld::Sync() const
 {
-	if (!m_pPhysicsWorld)
+	if (!m_IsStepping)
 		return;
 
-	const Box2DPhysicsSettings physicsSettings;
-	const float frameTime = physicsSettings.hz > 0.0f ? 1.0f / physicsSettings.hz : float32(1.f / 60.f);
+	ELITE_PROFILE_SCOPE("PhysicsWorld::Sync");
+
+	std::unique_lock<std::mutex> lock{ m_StepMutex };
+	m_StepCondition.wait(lock, [this]() { return !m_HasStepWork; });
+	m_StepStats = m_ThreadStepStats;
+	m_IsStepping = false;
+}
+
+template<>
+void PhysicsWorld::SetSettings(const PhysicsSettings& settings)
+{
+	Sync();
+
+	m_Settings = settings;
+	m_pPhysicsWorld->SetAllowSleeping(m_Settings.allowSleeping);
+	m_pPhysicsWorld->SetContinuousPhysics(m_Settings.continuousPhysics);
+}
+
+template<>
+void PhysicsWorld::RunStep(float stepTime, PhysicsStepStats& stats)
+{
+	auto pContactFilter = static_cast<PairCountingContactFilter*>(m_pContactFilter);
+	pContactFilter->m_NrOfPairs = 0;
+
+	m_pPhysicsWorld->Step(stepTime, m_Settings.velocityIterations, m_Settings.positionIterations);
+
+	const b2Profile& profile = m_pPhysicsWorld->GetProfile();
+	++stats.nrOfSteps;
+	stats.nrOfBodies = m_pPhysicsWorld->GetBodyCount();
+	stats.nrOfProxies = m_pPhysicsWorld->GetProxyCount();
+	stats.nrOfNewPairs = pContactFilter->m_NrOfPairs;
+	stats.nrOfContacts = m_pPhysicsWorld->GetContactCount();
+	stats.stepMs = profile.step;
+	stats.broadphaseMs = profile.broadphase;
+	stats.collideMs = profile.collide;
+	stats.solveMs = profile.solve;
+
+	stats.nrOfAwakeBodies = 0;
+	for (const b2Body* pB = m_pPhysicsWorld->GetBodyList(); pB; pB = pB->GetNext())
+	{
+		if (pB->GetType() != b2_staticBody && pB->IsAwake())
+			++stats.nrOfAwakeBodies;
+	}
+
+	stats.nrOfTouchingContacts = 0;
+	for (const b2Contact* pC = m_pPhysicsWorld->GetContactList(); pC; pC = pC->GetNext())
+	{
+		if (pC->IsTouching())
+			++stats.nrOfTouchingContacts;
+	}
+}
+
+template<>
+void PhysicsWorld::RunSteps(float elapsedTime, PhysicsStepStats& stats)
+{
+	const float frameTime = m_Settings.stepRate > 0.0f ? 1.0f / m_Settings.stepRate : float32(1.f / 60.f);
 
 	if (elapsedTime > 0.25f)
 		elapsedTime = 0.25f;
 
 	m_FrameTimeAccumulator += elapsedTime;
 
+	stats.nrOfSteps = 0;
 	while (m_FrameTimeAccumulator >= frameTime)
 	{
-		m_pPhysicsWorld->Step(frameTime, physicsSettings.velocityIterations, physicsSettings.positionIterations);
+		RunStep(frameTime, stats);
 		m_FrameTimeAccumulator -= frameTime;
 	}
 }
 
+template<>
+void PhysicsWorld::StorePreviousTransforms()
+{
+	//Remember where the moving bodies were, bodies created after this are rendered at their current state
+	for (size_t slot = 0; slot < m_pSlotBodies.size(); ++slot)
+	{
+		const auto pB = static_cast<const b2Body*>(m_pSlotBodies[slot]);
+		PreviousTransform& previous = m_PreviousTransforms[slot];
+		previous.isValid = pB != nullptr && pB->GetType() != b2_staticBody;
+		if (!previous.isValid)
+			continue;
+
+		const b2Vec2& position = pB->GetPosition();
+		const b2Vec2& linearVelocity = pB->GetLinearVelocity();
+		previous.position = Vector2(position.x, position.y);
+		previous.angle = pB->GetAngle();
+		previous.linearVelocity = Vector2(linearVelocity.x, linearVelocity.y);
+		previous.angularVelocity = pB->GetAngularVelocity();
+	}
+	m_HasPreviousTransforms = true;
+}
+
+template<>
+void PhysicsWorld::StepThreadLoop()
+{
+	std::unique_lock<std::mutex> lock{ m_StepMutex };
+	while (true)
+	{
+		m_StepCondition.wait(lock, [this]() { return m_HasStepWork || m_IsStopping; });
+		if (m_IsStopping)
+			return;
+
+		//The main thread leaves the world alone until the work is marked done
+		lock.unlock();
+		{
+			ELITE_PROFILE_SCOPE("PhysicsWorld::Step (thread)");
+			RunSteps(m_StepElapsedTime, m_ThreadStepStats);
+		}
+		lock.lock();
+
+		m_HasStepWork = false;
+		m_StepCondition.notify_all();
+	}
+}
+
+template<>
+void PhysicsWorld::Simulate(float elapsedTime)
+{
+	if (!m_pPhysicsWorld)
+		return;
+
+	ELITE_PROFILE_SCOPE("PhysicsWorld::Simulate");
+
+	Sync();
+	RunSteps(elapsedTime, m_StepStats);
+}
+
+template<>
+void PhysicsWorld::SimulateAsync(float elapsedTime)
+{
+	if (!m_pPhysicsWorld)
+		return;
+
+	if (!m_Settings.stepOnThread)
+	{
+		Simulate(elapsedTime);
+		return;
+	}
+
+	ELITE_PROFILE_SCOPE("PhysicsWorld::SimulateAsync");
+
+	//Bodies are read from here while the step runs
+	Sync();
+	StorePreviousTransforms();
+
+	if (!m_StepThread.joinable())
+		m_StepThread = std::thread{ [this]() { StepThreadLoop(); } };
+
+	{
+		std::lock_guard<std::mutex> lock{ m_StepMutex };
+		m_StepElapsedTime = elapsedTime;
+		m_HasStepWork = true;
+	}
+	m_IsStepping = true;
+	m_StepCondition.notify_all();
+}
+
+template<>
+void PhysicsWorld::Step(float stepTime)
+{
+	if (!m_pPhysicsWorld)
+		return;
+
+	ELITE_PROFILE_SCOPE("PhysicsWorld::Step");
+
+	Sync();
+	//Only needed to draw in between steps
+	if (m_Settings.interpolateRendering)
+		StorePreviousTransforms();
+	else
+		m_HasPreviousTransforms = false;
+
+	m_StepStats.nrOfSteps = 0;
+	RunStep(stepTime, m_StepStats);
+}
+
 template<>
 void PhysicsWorld::RenderDebug() const
 {
+	Sync();
+
 	const auto pDebugRenderer = static_cast<Box2DRenderer*>(m_pDebugRenderer);
 	if (pDebugRenderer != nullptr)
 		m_pPhysicsWorld->DrawDebugData();
@@ -81,6 +258,7 @@ std::vector<Elite::Polygon> PhysicsWorld::GetAllStaticShapesInWorld(PhysicsFlags
 {
 	//Locals
 	std::vector<Elite::Polygon> vShapes = {};
+	Sync();
 
 	//Get all the shapes with certain flag, from static rigibodies
 	for (b2Body* pB = m_pPhysicsWorld->GetBodyList(); pB; pB = pB->GetNext())
@@ -5,6 +5,20 @@
 #include "Box2D/Collision/Shapes/b2CircleShape.h"
 #include "Box2D/Collision/Shapes/b2PolygonShape.h"
 
+namespace
+{
+	//While a threaded step runs, moving bodies are read from the state before the step (see PhysicsWorld::SimulateAsync)
+	bool GetSteppingTransform(int bodySlot, Elite::Vector2& position, float& angle)
+	{
+		return PHYSICSWORLD->IsStepping() && PHYSICSWORLD->GetPreviousTransform(bodySlot, position, angle);
+	}
+
+	bool GetSteppingVelocity(int bodySlot, Elite::Vector2& linearVelocity, float& angularVelocity)
+	{
+		return PHYSICSWORLD->IsStepping() && PHYSICSWORLD->GetPreviousVelocity(bodySlot, linearVelocity, angularVelocity);
+	}
+}
+
 //=== Constructors & Destructors ===
 template <>
 Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::RigidBodyBase(const RigidBodyDefine& define, 
@@ -31,7 +45,7 @@ Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::RigidBodyBase(const RigidB
 			bd.type = b2_staticBody; break;
 	}
 
-	//Create body
+	//Create body (GetWorld waits for a threaded step)
 	if(PHYSICSWORLD != nullptr && PHYSICSWORLD->GetWorld() != nullptr)
 		m_pBody = PHYSICSWORLD->GetWorld()->CreateBody(&bd);
 
@@ -42,6 +56,7 @@ Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::RigidBodyBase(const RigidB
 		m_UserDefinedFlags = userFlags;
 		auto pBody = static_cast<b2Body*>(m_pBody);
 		pBody->SetUserData(&m_UserDefinedFlags);
+		m_BodySlot = PHYSICSWORLD->AddBodySlot(m_pBody);
 	}
 }
 
@@ -51,6 +66,7 @@ Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::~RigidBodyBase()
 	{
 		auto pBody = static_cast<b2Body*>(m_pBody);
 		pBody->SetUserData(nullptr);
+		PHYSICSWORLD->RemoveBodySlot(m_BodySlot);
 		PHYSICSWORLD->GetWorld()->DestroyBody(pBody);
 	}
 }
@@ -58,6 +74,7 @@ Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::~RigidBodyBase()
 template<>
 void Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::AddShape(Elite::EPhysicsShape* pShape)
 {
+	PHYSICSWORLD->Sync();
 	auto pBody = static_cast<b2Body*>(m_pBody);
 
 	if(pShape->type == Elite::CircleShape)
@@ -116,6 +133,7 @@ void Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::AddShape(Elite::EPhys
 template<>
 void Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::RemoveAllShapes()
 {
+	PHYSICSWORLD->Sync();
 	auto pBody = static_cast<b2Body*>(m_pBody);
 	for (auto fix : m_vFixtures)
 	{
@@ -135,6 +153,11 @@ template<>
 Elite::ETransform<Elite::Vector2, Elite::Vector2> Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::GetTransform()
 {
 	const auto pBody = static_cast<b2Body*>(m_pBody);
+	Vector2 position{};
+	float angle{};
+	if (GetSteppingTransform(m_BodySlot, position, angle))
+		return ETransform<Vector2, Vector2>(position, Vector2(sinf(angle), cosf(angle)));
+
 	const auto trans = pBody->GetTransform();
 	return ETransform<Vector2, Vector2>(Vector2(trans.p.x, trans.p.y), Vector2(trans.q.s, trans.q.c));
 }
@@ -142,6 +165,7 @@ Elite::ETransform<Elite::Vector2, Elite::Vector2> Elite::RigidBodyBase<Elite::Ve
 template<>
 void Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::SetTransform(const internalTransformType& transform)
 {
+	PHYSICSWORLD->Sync();
 	auto pBody = static_cast<b2Body*>(m_pBody);
 	pBody->SetTransform(b2Vec2(transform.position.x, transform.position.y), transform.rotation.x);
 }
@@ -150,6 +174,11 @@ template<>
 Elite::Vector2 Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::GetPosition()
 {
 	const auto pBody = static_cast<b2Body*>(m_pBody);
+	Vector2 steppingPosition{};
+	float steppingAngle{};
+	if (GetSteppingTransform(m_BodySlot, steppingPosition, steppingAngle))
+		return steppingPosition;
+
 	const auto position = pBody->GetPosition();
 	return Vector2(position.x, position.y);
 }
@@ -157,6 +186,7 @@ Elite::Vector2 Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::GetPosition
 template<>
 void Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::SetPosition(const Vector2& pos)
 {
+	PHYSICSWORLD->Sync();
 	auto pBody = static_cast<b2Body*>(m_pBody);
 	pBody->SetTransform(b2Vec2(pos.x, pos.y), pBody->GetAngle());
 }
@@ -165,6 +195,11 @@ template<>
 Elite::Vector2 Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::GetRotation()
 {
 	const auto pBody = static_cast<b2Body*>(m_pBody);
+	Vector2 steppingPosition{};
+	float steppingAngle{};
+	if (GetSteppingTransform(m_BodySlot, steppingPosition, steppingAngle))
+		return Vector2(steppingAngle, steppingAngle);
+
 	const auto rotation = pBody->GetAngle();
 	return Vector2(rotation, rotation);
 }
@@ -172,13 +207,53 @@ Elite::Vector2 Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::GetRotation
 template<>
 void Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::SetRotation(const Vector2& rot)
 {
+	PHYSICSWORLD->Sync();
 	auto pBody = static_cast<b2Body*>(m_pBody);
 	pBody->SetTransform(pBody->GetPosition(), rot.x);
 }
 
+template<>
+Elite::Vector2 Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::GetRenderPosition()
+{
+	//The state from before the running step is the one to draw
+	if (PHYSICSWORLD->IsStepping())
+		return GetPosition();
+
+	const auto pBody = static_cast<b2Body*>(m_pBody);
+	const auto position = pBody->GetPosition();
+	const Vector2 currentPosition(position.x, position.y);
+
+	Vector2 previousPosition{};
+	float previousAngle{};
+	if (!PHYSICSWORLD->GetPreviousTransform(m_BodySlot, previousPosition, previousAngle))
+		return currentPosition;
+
+	return Lerp(previousPosition, currentPosition, PHYSICSWORLD->GetInterpolationAlpha());
+}
+
+template<>
+Elite::Vector2 Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::GetRenderRotation()
+{
+	if (PHYSICSWORLD->IsStepping())
+		return GetRotation();
+
+	const auto pBody = static_cast<b2Body*>(m_pBody);
+	const auto rotation = pBody->GetAngle();
+
+	Vector2 previousPosition{};
+	float previousAngle{};
+	if (!PHYSICSWORLD->GetPreviousTransform(m_BodySlot, previousPosition, previousAngle))
+		return Vector2(rotation, rotation);
+
+	//Shortest way around, in case the angle was reset in between
+	const float angle{ previousAngle + ClampedAngle(rotation - previousAngle) * PHYSICSWORLD->GetInterpolationAlpha() };
+	return Vector2(angle, angle);
+}
+
 template<>
 void Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::SetMass(float m)
 {
+	PHYSICSWORLD->Sync();
 	auto pBody = static_cast<b2Body*>(m_pBody);
 	b2MassData massData;
 	pBody->GetMassData(&massData);
@@ -198,6 +273,11 @@ template<>
 Elite::Vector2 Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::GetLinearVelocity()
 {
 	const auto pBody = static_cast<b2Body*>(m_pBody);
+	Vector2 steppingLinearVelocity{};
+	float steppingAngularVelocity{};
+	if (GetSteppingVelocity(m_BodySlot, steppingLinearVelocity, steppingAngularVelocity))
+		return steppingLinearVelocity;
+
 	const auto linearVelocity = pBody->GetLinearVelocity();
 	return Vector2(linearVelocity.x, linearVelocity.y);
 }
@@ -205,6 +285,7 @@ Elite::Vector2 Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::GetLinearVe
 template<>
 void Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::SetLinearVelocity(const Vector2& linearVelocity)
 {
+	PHYSICSWORLD->Sync();
 	auto pBody = static_cast<b2Body*>(m_pBody);
 	pBody->SetLinearVelocity(b2Vec2(linearVelocity.x, linearVelocity.y));
 }
@@ -213,6 +294,11 @@ template<>
 Elite::Vector2 Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::GetAngularVelocity()
 {
 	const auto pBody = static_cast<b2Body*>(m_pBody);
+	Vector2 steppingLinearVelocity{};
+	float steppingAngularVelocity{};
+	if (GetSteppingVelocity(m_BodySlot, steppingLinearVelocity, steppingAngularVelocity))
+		return Vector2(steppingAngularVelocity, steppingAngularVelocity);
+
 	const auto linearVelocity = pBody->GetAngularVelocity();
 	return Vector2(linearVelocity, linearVelocity);
 }
@@ -220,6 +306,7 @@ Elite::Vector2 Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::GetAngularV
 template<>
 void Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::SetAngularVelocity(const Vector2& angularVelocity)
 {
+	PHYSICSWORLD->Sync();
 	auto pBody = static_cast<b2Body*>(m_pBody);
 	pBody->SetAngularVelocity(angularVelocity.x);
 }
@@ -227,6 +314,7 @@ void Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::SetAngularVelocity(co
 template <>
 void Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::SetLinearDamping(float damping)
 {
+	PHYSICSWORLD->Sync();
 	auto pBody = static_cast<b2Body*>(m_pBody);
 	pBody->SetLinearDamping(damping);
 }
@@ -241,6 +329,7 @@ float Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::GetLinearDamping()
 template <>
 void Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::AddForce(const Vector2& force, EForceMode mode, bool autoWake)
 {
+	PHYSICSWORLD->Sync();
 	auto pBody = static_cast<b2Body*>(m_pBody);
 	switch (mode)
 	{
@@ -258,6 +347,7 @@ void Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::AddForce(const Vector
 template <>
 void Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::AddTorque(const Vector2& torque, EForceMode mode, bool autoWake)
 {
+	PHYSICSWORLD->Sync();
 	auto pBody = static_cast<b2Body*>(m_pBody);
 	switch (mode)
 	{
@@ -271,6 +361,21 @@ void Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::AddTorque(const Vecto
 	}
 }
 
+template <>
+void Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::SetActive(bool isActive)
+{
+	PHYSICSWORLD->Sync();
+	auto pBody = static_cast<b2Body*>(m_pBody);
+	pBody->SetActive(isActive);
+}
+
+template <>
+bool Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::IsActive()
+{
+	const auto pBody = static_cast<b2Body*>(m_pBody);
+	return pBody->IsActive();
+}
+
 template <>
 int Elite::RigidBodyBase<Elite::Vector2, Elite::Vector2>::GetUserDefinedFlags()
 {
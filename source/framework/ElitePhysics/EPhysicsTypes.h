@@ -52,6 +52,32 @@
 			:linearDamping(_linearDamping), angularDamping(_angularDamping), type(_type), allowSleep(_allowSleep)
 		{}
 	};
+	/*!Settings of the physics world, see PhysicsWorld::SetSettings*/
+	struct PhysicsSettings
+	{
+		float stepRate = 60.f;				//steps per second of Simulate, Step gets its step time from the caller
+		int velocityIterations = 8;
+		int positionIterations = 3;
+		bool allowSleeping = true;
+		bool continuousPhysics = true;
+		bool stepOnThread = false;			//SimulateAsync steps on the physics thread instead of inline
+		bool interpolateRendering = true;	//Step keeps the transforms from before it to draw in between, off when nothing is drawn
+	};
+	/*!Counts of the last physics step, to see where the time of a step goes*/
+	struct PhysicsStepStats
+	{
+		int nrOfSteps = 0;					//steps taken by the last Simulate or Step call
+		int nrOfBodies = 0;
+		int nrOfAwakeBodies = 0;
+		int nrOfProxies = 0;				//fixtures in the broadphase tree
+		int nrOfNewPairs = 0;				//overlapping proxy pairs the broadphase found that had no contact yet
+		int nrOfContacts = 0;				//pairs with overlapping bounding boxes, narrowphase runs on all of them
+		int nrOfTouchingContacts = 0;
+		float stepMs = 0.f;
+		float broadphaseMs = 0.f;
+		float collideMs = 0.f;
+		float solveMs = 0.f;
+	};
 	/*!Raycast data helper*/
 	template<typename rigidbodyType, typename positionType>
 	struct ERaycastHitPoint
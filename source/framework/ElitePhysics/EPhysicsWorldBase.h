@@ -24,21 +24,132 @@ namespace Elite
 		void Simulate(float elapsedTime = 0.f);
 		void RenderDebug() const;
 
-		physicsWorldType GetWorld() const { return m_pPhysicsWorld; }
+		//Simulate on the physics thread when the settings ask for it, inline otherwise. Returns right away,
+		//so the step overlaps with rendering the frame. Until Sync, bodies read the state from before the step
+		//and everything that changes the world waits for the step first.
+		//Contact listeners are called on the physics thread, they should only record what they get.
+		void SimulateAsync(float elapsedTime);
+		//Waits for the step started by SimulateAsync. Call before the app reads positions.
+		void Sync() const;
+		bool IsStepping() const { return m_IsStepping; }
+
+		void SetSettings(const PhysicsSettings& settings);
+		const PhysicsSettings& GetSettings() const { return m_Settings; }
+		//Of the last Simulate or Step, after Sync for a threaded step
+		const PhysicsStepStats& GetStepStats() const { return m_StepStats; }
+
+		//Fixed timestep: runs exactly one step of stepTime, the caller does the accumulating.
+		//The body transforms from before the step are kept to interpolate rendering.
+		void Step(float stepTime);
+
+		//0 renders bodies at their previous step, 1 at their current state. Stays 1 when only Simulate is used.
+		float GetInterpolationAlpha() const { return m_InterpolationAlpha; }
+		void SetInterpolationAlpha(float alpha) { m_InterpolationAlpha = alpha; }
+		bool GetPreviousTransform(int bodySlot, Elite::Vector2& position, float& angle) const
+		{
+			const PreviousTransform* pPrevious{ GetPrevious(bodySlot) };
+			if (!pPrevious)
+				return false;
+
+			position = pPrevious->position;
+			angle = pPrevious->angle;
+			return true;
+		}
+		//State of a moving body from before the running step, see SimulateAsync
+		bool GetPreviousVelocity(int bodySlot, Elite::Vector2& linearVelocity, float& angularVelocity) const
+		{
+			const PreviousTransform* pPrevious{ GetPrevious(bodySlot) };
+			if (!pPrevious)
+				return false;
+
+			linearVelocity = pPrevious->linearVelocity;
+			angularVelocity = pPrevious->angularVelocity;
+			return true;
+		}
+
+		//Every body gets a slot when it is created, its previous transform is kept at that index.
+		//Slots of removed bodies are handed out again.
+		int AddBodySlot(const void* pBody)
+		{
+			int slot{ static_cast<int>(m_pSlotBodies.size()) };
+			if (m_FreeBodySlots.empty())
+			{
+				m_pSlotBodies.push_back(pBody);
+				m_PreviousTransforms.emplace_back();
+			}
+			else
+			{
+				slot = m_FreeBodySlots.back();
+				m_FreeBodySlots.pop_back();
+				m_pSlotBodies[slot] = pBody;
+			}
+			//Created after the last store, so it is drawn at its current state
+			m_PreviousTransforms[slot].isValid = false;
+			return slot;
+		}
+		void RemoveBodySlot(int bodySlot)
+		{
+			m_pSlotBodies[bodySlot] = nullptr;
+			m_PreviousTransforms[bodySlot].isValid = false;
+			m_FreeBodySlots.push_back(bodySlot);
+		}
+
+		//Waits for a threaded step, the world can't be used while it runs
+		physicsWorldType GetWorld() const { Sync(); return m_pPhysicsWorld; }
 		std::vector<Elite::Polygon> GetAllStaticShapesInWorld(PhysicsFlags userFlags) const;
 
 		template<typename raycastbackType, typename positionType>
 		void Raycast(raycastbackType* callback, const positionType& point1, const positionType& point2)
-		{ m_pPhysicsWorld->RayCast(callback, point1, point2); }
+		{ Sync(); m_pPhysicsWorld->RayCast(callback, point1, point2); }
 
 	private:
 		//=== Datamembers ===
 		physicsWorldType m_pPhysicsWorld;
 		void* m_pDebugRenderer = nullptr;
+		void* m_pContactFilter = nullptr;
 		float m_FrameTimeAccumulator = 0.f;
+		PhysicsSettings m_Settings{};
+		mutable PhysicsStepStats m_StepStats{};	//filled in by Sync after a threaded step
+
+		struct PreviousTransform
+		{
+			Elite::Vector2 position{};
+			float angle = 0.f;
+			Elite::Vector2 linearVelocity{};
+			float angularVelocity = 0.f;
+			bool isValid = false;			//false for static bodies and bodies created after the store
+		};
+		//Indexed by body slot, filled in once per step without hashing or allocating
+		std::vector<const void*> m_pSlotBodies{};
+		std::vector<int> m_FreeBodySlots{};
+		std::vector<PreviousTransform> m_PreviousTransforms{};
+		bool m_HasPreviousTransforms = false;	//false when the last step didn't store them
+		float m_InterpolationAlpha = 1.f;
+
+		//Physics thread, only started when a step is first run on it
+		std::thread m_StepThread{};
+		mutable std::mutex m_StepMutex{};
+		mutable std::condition_variable m_StepCondition{};
+		float m_StepElapsedTime = 0.f;
+		bool m_HasStepWork = false;
+		bool m_IsStopping = false;
+		mutable std::atomic<bool> m_IsStepping{ false };	//set and cleared by the main thread, IsStepping may be asked from anywhere
+		PhysicsStepStats m_ThreadStepStats{};	//written by the physics thread, copied in Sync
 
 		//=== Internal Functions ===
 		void Initialize();
+		void StorePreviousTransforms();
+		const PreviousTransform* GetPrevious(int bodySlot) const
+		{
+			if (!m_HasPreviousTransforms || bodySlot < 0 || bodySlot >= static_cast<int>(m_PreviousTransforms.size())
+				|| !m_PreviousTransforms[bodySlot].isValid)
+				return nullptr;
+			return &m_PreviousTransforms[bodySlot];
+		}
+		//Runs the steps elapsedTime adds up to
+		void RunSteps(float elapsedTime, PhysicsStepStats& stats);
+		void RunStep(float stepTime, PhysicsStepStats& stats);
+		void StepThreadLoop();
 	};
 }
 #endif
\ No newline at end of file
@@ -36,6 +36,10 @@ namespace Elite
 		orientationType GetRotation();
 		void SetRotation(const orientationType& rot);
 
+		//Transform between the previous and current physics step, see PhysicsWorld::SetInterpolationAlpha
+		translationType GetRenderPosition();
+		orientationType GetRenderRotation();
+
 		void SetMass(float m);
 		float GetMass();
 
@@ -50,6 +54,10 @@ namespace Elite
 		void AddForce(const translationType& force, EForceMode mode, bool autoWake = true);
 		void AddTorque(const translationType& torque, EForceMode mode, bool autoWake = true);
 
+		//Inactive bodies are left out of the simulation and collide with nothing, but keep their shapes
+		void SetActive(bool isActive);
+		bool IsActive();
+
 		ERigidBodyType GetType() { return m_RigidBodyInformation.type; }
 		int GetUserDefinedFlags();
 		void SetUserDefinedFlags(PhysicsFlags flags);
@@ -66,6 +74,7 @@ namespace Elite
 		void* m_pBody = nullptr;
 		RigidBodyUserData m_pUserData = {};
 		PhysicsFlags m_UserDefinedFlags = PhysicsFlags::Default;
+		int m_BodySlot = -1; //see PhysicsWorld::AddBodySlot
 
 		//=== Internal Functions ===
 		void Initialize();
@@ -0,0 +1,315 @@
+//=== General Includes ===
+#include "stdafx.h"
+#include "EProfiler.h"
+using namespace Elite;
+
+//=== Per Thread State ===
+namespace
+{
+	//Gives the ring back when its thread ends
+	struct ThreadRing
+	{
+		ProfileZoneRing* pRing = nullptr;
+		unsigned short threadIdx = 0;
+
+		~ThreadRing()
+		{
+			if (pRing)
+				Profiler::ReleaseThread(threadIdx);
+		}
+	};
+
+	thread_local ThreadRing tl_Ring{};
+	thread_local unsigned short tl_Depth = 0;
+
+	void WriteJsonString(std::ofstream& file, const char* text)
+	{
+		file << '"';
+		for (const char* c = text; *c; ++c)
+		{
+			if (*c == '"' || *c == '\\')
+				file << '\\';
+			file << *c;
+		}
+		file << '"';
+	}
+}
+
+//=== ProfileZoneRing ===
+bool ProfileZoneRing::Push(const ProfileZone& zone)
+{
+	const unsigned int head{ m_Head.load(std::memory_order_relaxed) };
+	if (head - m_Tail.load(std::memory_order_acquire) >= m_Capacity)
+	{
+		m_NrOfDroppedZones.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	m_Zones[head & (m_Capacity - 1)] = zone;
+	m_Head.store(head + 1, std::memory_order_release);
+	return true;
+}
+
+void ProfileZoneRing::Drain(std::vector<ProfileZone>& zones)
+{
+	const unsigned int head{ m_Head.load(std::memory_order_acquire) };
+	unsigned int tail{ m_Tail.load(std::memory_order_relaxed) };
+
+	for (; tail != head; ++tail)
+		zones.push_back(m_Zones[tail & (m_Capacity - 1)]);
+
+	m_Tail.store(tail, std::memory_order_release);
+}
+
+//=== ProfileScope ===
+ProfileScope::ProfileScope(const char* name)
+	: m_Name{ name }
+{
+	++tl_Depth;
+	m_Begin = Profiler::GetTimestamp();
+}
+
+ProfileScope::~ProfileScope()
+{
+	const long long end{ Profiler::GetTimestamp() };
+	--tl_Depth;
+
+	if (!tl_Ring.pRing)
+		tl_Ring.pRing = Profiler::GetInstance()->RegisterThread(tl_Ring.threadIdx);
+
+	tl_Ring.pRing->Push({ m_Name, m_Begin, end, tl_Ring.threadIdx, tl_Depth });
+}
+
+//=== Profiler ===
+Profiler::~Profiler()
+{
+	for (ProfileZoneRing* pRing : m_pRings)
+		SAFE_DELETE(pRing);
+}
+
+long long Profiler::GetTimestamp()
+{
+	static const auto start = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+ProfileZoneRing* Profiler::RegisterThread(unsigned short& threadIdx)
+{
+	std::lock_guard<std::mutex> lock{ m_ThreadsMutex };
+	if (!m_FreeThreadIdxs.empty())
+	{
+		threadIdx = m_FreeThreadIdxs.back();
+		m_FreeThreadIdxs.pop_back();
+		return m_pRings[threadIdx];
+	}
+
+	threadIdx = static_cast<unsigned short>(m_pRings.size());
+	m_pRings.push_back(new ProfileZoneRing());
+	return m_pRings.back();
+}
+
+void Profiler::ReleaseThread(unsigned short threadIdx)
+{
+	//The main thread ends after the profiler is destroyed
+	if (!m_pInstance)
+		return;
+
+	std::lock_guard<std::mutex> lock{ m_pInstance->m_ThreadsMutex };
+	m_pInstance->m_FreeThreadIdxs.push_back(threadIdx);
+}
+
+void Profiler::BeginFrame()
+{
+	m_Frame.begin = GetTimestamp();
+}
+
+void Profiler::EndFrame()
+{
+	m_Frame.end = GetTimestamp();
+
+	m_FrameZones.clear();
+	{
+		std::lock_guard<std::mutex> lock{ m_ThreadsMutex };
+		for (ProfileZoneRing* pRing : m_pRings)
+			pRing->Drain(m_FrameZones);
+	}
+
+	if (m_IsCapturing)
+	{
+		if (m_CapturedZones.size() + m_FrameZones.size() <= m_MaxNrOfCapturedZones)
+		{
+			m_CapturedZones.insert(m_CapturedZones.end(), m_FrameZones.begin(), m_FrameZones.end());
+			m_CapturedFrames.push_back(m_Frame);
+		}
+		else
+			m_IsCapturing = false;
+	}
+
+	if (!m_IsPaused)
+	{
+		m_LastFrameZones.swap(m_FrameZones);
+		m_LastFrame = m_Frame;
+	}
+}
+
+void Profiler::StartCapture()
+{
+	m_CapturedZones.clear();
+	m_CapturedFrames.clear();
+	m_IsCapturing = true;
+}
+
+bool Profiler::WriteChromeTrace(const std::string& path) const
+{
+	std::ofstream file{ path };
+	if (!file.is_open())
+		return false;
+
+	//Timestamps in microseconds
+	file << "{\"traceEvents\":[\n";
+	bool isFirst{ true };
+	for (const Frame& frame : m_CapturedFrames)
+	{
+		file << (isFirst ? "" : ",\n") << "{\"name\":\"Frame\",\"ph\":\"X\",\"pid\":0,\"tid\":\"Frames\",\"ts\":"
+			<< frame.begin / 1000.0 << ",\"dur\":" << (frame.end - frame.begin) / 1000.0 << "}";
+		isFirst = false;
+	}
+	for (const ProfileZone& zone : m_CapturedZones)
+	{
+		file << (isFirst ? "" : ",\n") << "{\"name\":";
+		WriteJsonString(file, zone.name);
+		file << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << zone.threadIdx << ",\"ts\":"
+			<< zone.begin / 1000.0 << ",\"dur\":" << (zone.end - zone.begin) / 1000.0 << "}";
+		isFirst = false;
+	}
+	file << "\n]}\n";
+
+	return file.good();
+}
+
+bool Profiler::WriteCSV(const std::string& path) const
+{
+	std::ofstream file{ path };
+	if (!file.is_open())
+		return false;
+
+	file << "name,thread,depth,begin_us,duration_us\n";
+	for (const ProfileZone& zone : m_CapturedZones)
+	{
+		file << zone.name << ',' << zone.threadIdx << ',' << zone.depth << ','
+			<< zone.begin / 1000.0 << ',' << (zone.end - zone.begin) / 1000.0 << '\n';
+	}
+
+	return file.good();
+}
+
+void Profiler::RenderUI()
+{
+	ImGui::SetNextWindowSize(ImVec2(600, 300), ImGuiSetCond_FirstUseEver);
+	ImGui::SetNextWindowCollapsed(true, ImGuiSetCond_FirstUseEver);
+	if (!ImGui::Begin("Profiler"))
+	{
+		ImGui::End();
+		return;
+	}
+
+	unsigned int nrOfDroppedZones{ 0 };
+	int nrOfThreads{ 0 };
+	{
+		std::lock_guard<std::mutex> lock{ m_ThreadsMutex };
+		for (const ProfileZoneRing* pRing : m_pRings)
+			nrOfDroppedZones += pRing->GetNrOfDroppedZones();
+		nrOfThreads = static_cast<int>(m_pRings.size());
+	}
+
+	ImGui::Text("Frame: %.2f ms, %d zones, %d threads", (m_LastFrame.end - m_LastFrame.begin) / 1000000.f,
+		static_cast<int>(m_LastFrameZones.size()), nrOfThreads);
+	if (nrOfDroppedZones > 0)
+		ImGui::TextColored(ImVec4(1.f, 0.4f, 0.4f, 1.f), "Dropped zones: %u", nrOfDroppedZones);
+
+	ImGui::Checkbox("Pause", &m_IsPaused);
+	ImGui::SameLine();
+	if (ImGui::Button(m_IsCapturing ? "Stop capture" : "Start capture"))
+	{
+		if (m_IsCapturing)
+			StopCapture();
+		else
+			StartCapture();
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Save"))
+	{
+		WriteChromeTrace("profile_trace.json");
+		WriteCSV("profile.csv");
+	}
+	ImGui::SameLine();
+	ImGui::Text("%d frames captured", GetNrOfCapturedFrames());
+
+	ImGui::SliderFloat("Zoom", &m_FlameViewZoom, 1.f, 50.f, "%.1fx");
+
+	//Flame view
+	ImGui::BeginChild("FlameView", ImVec2(0, 0), true, ImGuiWindowFlags_HorizontalScrollbar);
+	RenderFlameView(ImGui::GetContentRegionAvailWidth() * m_FlameViewZoom);
+	ImGui::EndChild();
+
+	ImGui::End();
+}
+
+void Profiler::RenderFlameView(float width)
+{
+	const long long frameDuration{ m_LastFrame.end - m_LastFrame.begin };
+	if (frameDuration <= 0)
+		return;
+
+	//One band per thread, one row per depth
+	unsigned short nrOfThreads{ 0 };
+	std::vector<unsigned short> maxDepths{};
+	for (const ProfileZone& zone : m_LastFrameZones)
+	{
+		if (zone.threadIdx >= maxDepths.size())
+			maxDepths.resize(zone.threadIdx + 1, 0);
+		maxDepths[zone.threadIdx] = std::max(maxDepths[zone.threadIdx], zone.depth);
+		nrOfThreads = std::max(nrOfThreads, static_cast<unsigned short>(zone.threadIdx + 1));
+	}
+
+	const float rowHeight{ ImGui::GetTextLineHeight() + 4.f };
+	std::vector<float> threadOffsets(nrOfThreads + 1, 0.f);
+	for (unsigned short t = 0; t < nrOfThreads; ++t)
+		threadOffsets[t + 1] = threadOffsets[t] + (maxDepths[t] + 1) * rowHeight + 6.f;
+
+	const ImVec2 origin{ ImGui::GetCursorScreenPos() };
+	ImDrawList* pDrawList{ ImGui::GetWindowDrawList() };
+	const float nsToPixels{ width / frameDuration };
+
+	const ProfileZone* pHoveredZone{ nullptr };
+	for (const ProfileZone& zone : m_LastFrameZones)
+	{
+		//Zones of other threads can start before or end after the frame
+		const float x1{ origin.x + std::max(zone.begin - m_LastFrame.begin, 0LL) * nsToPixels };
+		const float x2{ origin.x + std::min(zone.end - m_LastFrame.begin, frameDuration) * nsToPixels };
+		if (x2 < x1)
+			continue;
+
+		const float y1{ origin.y + threadOffsets[zone.threadIdx] + zone.depth * rowHeight };
+		const ImVec2 rectMin{ x1, y1 };
+		const ImVec2 rectMax{ std::max(x2, x1 + 1.f), y1 + rowHeight - 1.f };
+
+		//Same name, same color
+		unsigned int hash{ 2166136261u };
+		for (const char* c = zone.name; *c; ++c)
+			hash = (hash ^ static_cast<unsigned char>(*c)) * 16777619u;
+		const ImColor color{ 0.35f + (hash & 0xFF) / 640.f, 0.35f + ((hash >> 8) & 0xFF) / 640.f, 0.35f + ((hash >> 16) & 0xFF) / 640.f, 1.f };
+		pDrawList->AddRectFilled(rectMin, rectMax, color);
+
+		if (ImGui::CalcTextSize(zone.name).x + 4.f < rectMax.x - rectMin.x)
+			pDrawList->AddText(ImVec2(rectMin.x + 2.f, rectMin.y + 2.f), ImColor(0.f, 0.f, 0.f, 1.f), zone.name);
+
+		if (ImGui::IsMouseHoveringRect(rectMin, rectMax))
+			pHoveredZone = &zone;
+	}
+
+	ImGui::Dummy(ImVec2(width, threadOffsets[nrOfThreads]));
+
+	if (pHoveredZone)
+		ImGui::SetTooltip("%s\n%.3f ms (thread %d)", pHoveredZone->name, (pHoveredZone->end - pHoveredZone->begin) / 1000000.f, pHoveredZone->threadIdx);
+}
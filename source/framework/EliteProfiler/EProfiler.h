@@ -0,0 +1,136 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EProfiler.h: per-frame hierarchical CPU profiler.
+// ELITE_PROFILE_SCOPE("name") times the enclosing scope. Every thread has its own zone stack and
+// a lock-free ring buffer, the main thread collects all of them once per frame in EndFrame.
+// Without USE_PROFILER the macros compile to nothing.
+/*=============================================================================*/
+#ifndef ELITE_PROFILER
+#define	ELITE_PROFILER
+
+#ifdef USE_PROFILER
+	#define ELITE_PROFILE_CONCAT_INNER(a, b) a##b
+	#define ELITE_PROFILE_CONCAT(a, b) ELITE_PROFILE_CONCAT_INNER(a, b)
+	//name has to be a string literal, only the pointer is stored
+	#define ELITE_PROFILE_SCOPE(name) const Elite::ProfileScope ELITE_PROFILE_CONCAT(profileScope, __LINE__){ name }
+	#define ELITE_PROFILE_BEGIN_FRAME() Elite::Profiler::GetInstance()->BeginFrame()
+	#define ELITE_PROFILE_END_FRAME() Elite::Profiler::GetInstance()->EndFrame()
+	#define ELITE_PROFILE_RENDER_UI() Elite::Profiler::GetInstance()->RenderUI()
+#else
+	#define ELITE_PROFILE_SCOPE(name) ((void)0)
+	#define ELITE_PROFILE_BEGIN_FRAME() ((void)0)
+	#define ELITE_PROFILE_END_FRAME() ((void)0)
+	#define ELITE_PROFILE_RENDER_UI() ((void)0)
+#endif
+
+namespace Elite
+{
+	struct ProfileZone
+	{
+		const char* name;
+		long long begin; //nanoseconds, see Profiler::GetTimestamp
+		long long end;
+		unsigned short threadIdx;
+		unsigned short depth;
+	};
+
+	//Fixed size ring of finished zones. Written by one thread, read by one other thread.
+	class ProfileZoneRing final
+	{
+	public:
+		ProfileZoneRing() : m_Zones(m_Capacity) {}
+
+		//Returns false when the ring is full, the zone is dropped then
+		bool Push(const ProfileZone& zone);
+		void Drain(std::vector<ProfileZone>& zones);
+		unsigned int GetNrOfDroppedZones() const { return m_NrOfDroppedZones.load(std::memory_order_relaxed); }
+
+	private:
+		static const unsigned int m_Capacity{ 1 << 16 }; //power of 2
+
+		std::vector<ProfileZone> m_Zones;
+		std::atomic<unsigned int> m_Head{ 0 }; //next write, only changed by the producer
+		std::atomic<unsigned int> m_Tail{ 0 }; //next read, only changed by the consumer
+		std::atomic<unsigned int> m_NrOfDroppedZones{ 0 };
+	};
+
+	class ProfileScope final
+	{
+	public:
+		explicit ProfileScope(const char* name);
+		~ProfileScope();
+
+		ProfileScope(const ProfileScope& other) = delete;
+		ProfileScope& operator=(const ProfileScope& other) = delete;
+		ProfileScope(ProfileScope&& other) = delete;
+		ProfileScope& operator=(ProfileScope&& other) = delete;
+
+	private:
+		const char* m_Name;
+		long long m_Begin;
+	};
+
+	class Profiler final : public ESingleton<Profiler>
+	{
+	public:
+		Profiler() = default;
+		~Profiler();
+
+		//Nanoseconds since the first call, high resolution clock
+		static long long GetTimestamp();
+
+		//Call on the main thread, the zones that ended in between make up the frame
+		void BeginFrame();
+		void EndFrame();
+
+		//The flame view keeps showing the last frame while paused
+		bool IsPaused() const { return m_IsPaused; }
+		void SetPaused(bool isPaused) { m_IsPaused = isPaused; }
+
+		//Captured frames are kept for the dumps below
+		void StartCapture();
+		void StopCapture() { m_IsCapturing = false; }
+		bool IsCapturing() const { return m_IsCapturing; }
+		int GetNrOfCapturedFrames() const { return static_cast<int>(m_CapturedFrames.size()); }
+
+		//Chrome trace event format, open with chrome://tracing or ui.perfetto.dev
+		bool WriteChromeTrace(const std::string& path) const;
+		bool WriteCSV(const std::string& path) const;
+
+		void RenderUI();
+
+		//Used by ProfileScope the first time a thread ends a zone. The ring of a thread that ended
+		//is handed to the next new thread together with its index, so short lived threads don't add rings.
+		ProfileZoneRing* RegisterThread(unsigned short& threadIdx);
+		//Called when a thread that registered ends, does nothing once the profiler is destroyed
+		static void ReleaseThread(unsigned short threadIdx);
+
+	private:
+		struct Frame
+		{
+			long long begin;
+			long long end;
+		};
+
+		void RenderFlameView(float width);
+
+		std::mutex m_ThreadsMutex;
+		std::vector<ProfileZoneRing*> m_pRings{};
+		std::vector<unsigned short> m_FreeThreadIdxs{}; //rings of threads that ended, zones left in them are still drained
+
+		std::vector<ProfileZone> m_FrameZones{};		//drained this frame
+		std::vector<ProfileZone> m_LastFrameZones{};	//shown in the UI
+		Frame m_Frame{};
+		Frame m_LastFrame{};
+
+		std::vector<ProfileZone> m_CapturedZones{};
+		std::vector<Frame> m_CapturedFrames{};
+		const size_t m_MaxNrOfCapturedZones{ 1 << 22 };
+
+		bool m_IsPaused = false;
+		bool m_IsCapturing = false;
+		float m_FlameViewZoom = 1.f;
+	};
+}
+#endif
@@ -20,6 +20,9 @@ public:
 	Elite::Vector2 ConvertScreenToWorld(const Elite::Vector2& screenPoint) const;
 	Elite::Vector2 ConvertWorldToScreen(const Elite::Vector2& worldPoint) const;
 	void BuildProjectionMatrix(float* m, float zBias) const;
+	void GetVisibleWorldBounds(Elite::Vector2& lower, Elite::Vector2& upper) const;
+	float GetPixelsPerWorldUnit() const { return m_height / (2.0f * m_zoom); }
+	float GetZoom() const { return m_zoom; }
 	void SetZoom(float z) { m_zoom = z; }
 	void SetCenter(Elite::Vector2 c) { m_center = c; }
 	void SetZoomLocked(bool state) { m_isZoomLocked = state; }
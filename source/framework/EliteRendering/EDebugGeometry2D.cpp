@@ -0,0 +1,181 @@
+//=== General Includes ===
+//No precompiled header, this file only needs the math types
+#include "EDebugGeometry2D.h"
+#include <algorithm>
+#include <cmath>
+using namespace Elite;
+
+//=== Culling ===
+bool DebugCullBounds2D::IsSegmentVisible(const Elite::Vector2& p1, const Elite::Vector2& p2) const
+{
+	//Bounding box test, a segment that only passes near a corner is still kept
+	return !isEnabled
+		|| (std::max(p1.x, p2.x) >= lower.x && std::min(p1.x, p2.x) <= upper.x
+		&& std::max(p1.y, p2.y) >= lower.y && std::min(p1.y, p2.y) <= upper.y);
+}
+
+bool DebugCullBounds2D::IsPolygonVisible(const Elite::Vector2* points, int count) const
+{
+	if (!isEnabled || count <= 0)
+		return true;
+
+	Elite::Vector2 polygonLower{ points[0] };
+	Elite::Vector2 polygonUpper{ points[0] };
+	for (int i = 1; i < count; ++i)
+	{
+		polygonLower.x = std::min(polygonLower.x, points[i].x);
+		polygonLower.y = std::min(polygonLower.y, points[i].y);
+		polygonUpper.x = std::max(polygonUpper.x, points[i].x);
+		polygonUpper.y = std::max(polygonUpper.y, points[i].y);
+	}
+
+	return IsRectVisible(polygonLower, polygonUpper);
+}
+
+bool DebugCullBounds2D::IsTextVisible(const Elite::Vector2& anchor, const Elite::Vector2& sizeInPixels) const
+{
+	//Screen y goes down, world y goes up
+	const Elite::Vector2 size{ sizeInPixels * worldUnitsPerPixel };
+	return IsRectVisible({ anchor.x, anchor.y - size.y }, { anchor.x + size.x, anchor.y });
+}
+
+//=== Vertex Generation ===
+namespace
+{
+	std::vector<Elite::Vector2> BuildUnitCircle(int nrOfSegments)
+	{
+		std::vector<Elite::Vector2> circle(nrOfSegments);
+		for (int i = 0; i < nrOfSegments; ++i)
+		{
+			const float angle{ 2.0f * static_cast<float>(E_PI) * i / nrOfSegments };
+			circle[i] = Elite::Vector2{ cosf(angle), sinf(angle) };
+		}
+		return circle;
+	}
+}
+
+const std::vector<Elite::Vector2>& DebugGeometry2D::GetUnitCircle(int nrOfSegments)
+{
+	static const std::vector<Elite::Vector2> circle{ BuildUnitCircle(CircleSegments) };
+	static const std::vector<Elite::Vector2> coarseCircle{ BuildUnitCircle(CoarseCircleSegments) };
+
+	return nrOfSegments == CoarseCircleSegments ? coarseCircle : circle;
+}
+
+bool DebugGeometry2D::AppendPolygon(std::vector<Vertex>& lines, const DebugCullBounds2D& bounds,
+	const Elite::Vector2* points, int count, const Color& color, float depth)
+{
+	if (count <= 0 || !bounds.IsPolygonVisible(points, count))
+		return false;
+
+	auto p1 = points[count - 1];
+	for (auto i = 0; i < count; ++i)
+	{
+		const auto p2 = points[i];
+		lines.emplace_back(p1, depth, color);
+		lines.emplace_back(p2, depth, color);
+		p1 = p2;
+	}
+	return true;
+}
+
+bool DebugGeometry2D::AppendSolidPolygon(std::vector<Vertex>& triangles, std::vector<Vertex>& lines, const DebugCullBounds2D& bounds,
+	const Elite::Vector2* points, int count, const Color& color, float depth)
+{
+	if (count <= 0 || !bounds.IsPolygonVisible(points, count))
+		return false;
+
+	//Triangle fan
+	const Color fillColor(0.5f * color.r, 0.5f * color.g, 0.5f * color.b, 0.5f);
+	for (auto i = 1; i < count - 1; ++i)
+	{
+		triangles.emplace_back(points[0], depth, fillColor);
+		triangles.emplace_back(points[i], depth, fillColor);
+		triangles.emplace_back(points[i + 1], depth, fillColor);
+	}
+
+	//Outline
+	depth -= DEPTH_SLICE_FINE_OFFSET;
+	auto p1 = points[count - 1];
+	for (auto i = 0; i < count; ++i)
+	{
+		const auto p2 = points[i];
+		lines.emplace_back(p1, depth, color);
+		lines.emplace_back(p2, depth, color);
+		p1 = p2;
+	}
+	return true;
+}
+
+bool DebugGeometry2D::AppendCircle(std::vector<Vertex>& lines, const DebugCullBounds2D& bounds,
+	const Elite::Vector2& center, float radius, const Color& color, float depth)
+{
+	if (!bounds.IsCircleVisible(center, radius))
+		return false;
+
+	const auto& unitCircle = GetUnitCircle();
+	const auto nrOfSegments = static_cast<int>(unitCircle.size());
+
+	auto v1 = center + radius * unitCircle[nrOfSegments - 1];
+	for (auto i = 0; i < nrOfSegments; ++i)
+	{
+		const auto v2 = center + radius * unitCircle[i];
+		lines.emplace_back(v1, depth, color);
+		lines.emplace_back(v2, depth, color);
+		v1 = v2;
+	}
+	return true;
+}
+
+bool DebugGeometry2D::AppendSolidCircle(std::vector<Vertex>& triangles, std::vector<Vertex>& lines, const DebugCullBounds2D& bounds,
+	const Elite::Vector2& center, float radius, const Elite::Vector2& axis, const Color& color, float depth)
+{
+	if (!bounds.IsCircleVisible(center, radius))
+		return false;
+
+	const auto& unitCircle = GetUnitCircle();
+	const auto nrOfSegments = static_cast<int>(unitCircle.size());
+	const Color fillColor(0.5f * color.r, 0.5f * color.g, 0.5f * color.b, color.a);
+	const float outlineDepth{ depth - DEPTH_SLICE_FINE_OFFSET };
+
+	auto v1 = center + radius * unitCircle[nrOfSegments - 1];
+	for (auto i = 0; i < nrOfSegments; ++i)
+	{
+		const auto v2 = center + radius * unitCircle[i];
+		triangles.emplace_back(center, depth, fillColor);
+		triangles.emplace_back(v1, depth, fillColor);
+		triangles.emplace_back(v2, depth, fillColor);
+
+		lines.emplace_back(v1, outlineDepth, color);
+		lines.emplace_back(v2, outlineDepth, color);
+		v1 = v2;
+	}
+
+	// Draw a line fixed in the circle to animate rotation.
+	const float axisDepth{ outlineDepth - DEPTH_SLICE_FINE_OFFSET };
+	lines.emplace_back(center, axisDepth, color);
+	lines.emplace_back(center + radius * axis, axisDepth, color);
+	return true;
+}
+
+bool DebugGeometry2D::AppendSegment(std::vector<Vertex>& lines, const DebugCullBounds2D& bounds,
+	const Elite::Vector2& p1, const Elite::Vector2& p2, const Color& color, float depth)
+{
+	if (!bounds.IsSegmentVisible(p1, p2))
+		return false;
+
+	lines.emplace_back(p1, depth, color);
+	lines.emplace_back(p2, depth, color);
+	return true;
+}
+
+bool DebugGeometry2D::AppendPoint(std::vector<Vertex>& points, const DebugCullBounds2D& bounds,
+	const Elite::Vector2& p, float size, const Color& color, float depth)
+{
+	//Size is in pixels
+	if (!bounds.IsCircleVisible(p, 0.5f * size * bounds.worldUnitsPerPixel))
+		return false;
+
+	points.emplace_back(p, depth, color, size);
+	return true;
+}
@@ -0,0 +1,77 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EDebugGeometry2D.h: CPU side of the 2D debug renderer: view culling and vertex generation.
+// Does not touch OpenGL and doesn't need the precompiled header, so it can be used and measured without a window.
+/*=============================================================================*/
+#ifndef ELITE_DEBUG_GEOMETRY_2D_H
+#define ELITE_DEBUG_GEOMETRY_2D_H
+
+//--- Includes ---
+#include <vector>
+#include <iosfwd>
+#include "ERenderingTypes.h"
+
+//Immediate Draw Auto Layering Settings
+#define DEPTH_SLICE_OFFSET 0.0005f
+#define DEPTH_SLICE_FINE_OFFSET 0.0000005f
+#define DEPTH_SLICE_MIN -0.5f//far
+#define DEPTH_SLICE_MAX 0.5f//close
+
+namespace Elite
+{
+	//World space rectangle that is visible, draw calls completely outside of it are dropped
+	struct DebugCullBounds2D
+	{
+		Elite::Vector2 lower{};
+		Elite::Vector2 upper{};
+		float worldUnitsPerPixel = 0.f; //margin for shapes sized in pixels (points)
+		bool isEnabled = false;
+
+		bool IsCircleVisible(const Elite::Vector2& center, float radius) const
+		{
+			return !isEnabled
+				|| (center.x + radius >= lower.x && center.x - radius <= upper.x
+				&& center.y + radius >= lower.y && center.y - radius <= upper.y);
+		}
+		bool IsRectVisible(const Elite::Vector2& rectLower, const Elite::Vector2& rectUpper) const
+		{
+			return !isEnabled
+				|| (rectUpper.x >= lower.x && rectLower.x <= upper.x
+				&& rectUpper.y >= lower.y && rectLower.y <= upper.y);
+		}
+		bool IsSegmentVisible(const Elite::Vector2& p1, const Elite::Vector2& p2) const;
+		bool IsPolygonVisible(const Elite::Vector2* points, int count) const;
+		//Text hangs down and to the right of its anchor on screen, its size is in pixels
+		bool IsTextVisible(const Elite::Vector2& anchor, const Elite::Vector2& sizeInPixels) const;
+	};
+
+	namespace DebugGeometry2D
+	{
+		const int CircleSegments = 16;
+		const int CoarseCircleSegments = 6;
+
+		//Unit circle points, built once. Only CircleSegments and CoarseCircleSegments are cached.
+		const std::vector<Elite::Vector2>& GetUnitCircle(int nrOfSegments = CircleSegments);
+
+		//All functions append to the given containers and return false when the shape was culled
+		bool AppendPolygon(std::vector<Vertex>& lines, const DebugCullBounds2D& bounds,
+			const Elite::Vector2* points, int count, const Color& color, float depth);
+		bool AppendSolidPolygon(std::vector<Vertex>& triangles, std::vector<Vertex>& lines, const DebugCullBounds2D& bounds,
+			const Elite::Vector2* points, int count, const Color& color, float depth);
+		bool AppendCircle(std::vector<Vertex>& lines, const DebugCullBounds2D& bounds,
+			const Elite::Vector2& center, float radius, const Color& color, float depth);
+		bool AppendSolidCircle(std::vector<Vertex>& triangles, std::vector<Vertex>& lines, const DebugCullBounds2D& bounds,
+			const Elite::Vector2& center, float radius, const Elite::Vector2& axis, const Color& color, float depth);
+		bool AppendSegment(std::vector<Vertex>& lines, const DebugCullBounds2D& bounds,
+			const Elite::Vector2& p1, const Elite::Vector2& p2, const Color& color, float depth);
+		bool AppendPoint(std::vector<Vertex>& points, const DebugCullBounds2D& bounds,
+			const Elite::Vector2& p, float size, const Color& color, float depth);
+	}
+
+	//Checks the culling and vertex counts of every shape and times the vertex generation of many circles,
+	//on and off screen, against the rotation the renderer used before. Needs no window.
+	//Writes the results to output and returns false when a check failed. Run with --debug-draw-benchmark.
+	bool RunDebugGeometryBenchmark(std::ostream& output);
+}
+#endif
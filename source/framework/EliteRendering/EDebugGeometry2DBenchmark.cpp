@@ -0,0 +1,198 @@
+//=== General Includes ===
+//No precompiled header, so this runs without a window and without OpenGL
+#include "EDebugGeometry2D.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ostream>
+#include <random>
+using namespace Elite;
+
+namespace
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	const int NrOfCircles = 20000;
+	const int NrOfRepeats = 20;
+
+	//The view of a 1280x720 window that shows [-16, 16] x [-9, 9]
+	DebugCullBounds2D GetView()
+	{
+		DebugCullBounds2D bounds{};
+		bounds.lower = { -16.f, -9.f };
+		bounds.upper = { 16.f, 9.f };
+		bounds.worldUnitsPerPixel = 32.f / 1280.f;
+		bounds.isEnabled = true;
+		return bounds;
+	}
+
+	//How the renderer built a solid circle before the unit circle was cached: rotating a vector per segment
+	void AppendSolidCircleByRotation(std::vector<Vertex>& triangles, std::vector<Vertex>& lines,
+		const Vector2& center, float radius, const Vector2& axis, const Color& color, float depth)
+	{
+		const auto k_segments = 16.0f;
+		const auto k_increment = 2.0f * static_cast<float>(E_PI) / k_segments;
+		const auto sinInc = sinf(k_increment);
+		const auto cosInc = cosf(k_increment);
+		const Color fillColor(0.5f * color.r, 0.5f * color.g, 0.5f * color.b, color.a);
+
+		Vector2 r1(cosInc, sinInc);
+		Vector2 v1 = center + radius * r1;
+		for (auto i = 0; i < k_segments; ++i)
+		{
+			Vector2 r2;
+			r2.x = cosInc * r1.x - sinInc * r1.y;
+			r2.y = sinInc * r1.x + cosInc * r1.y;
+			const Vector2 v2 = center + radius * r2;
+			triangles.emplace_back(center, depth, fillColor);
+			triangles.emplace_back(v1, depth, fillColor);
+			triangles.emplace_back(v2, depth, fillColor);
+			r1 = r2;
+			v1 = v2;
+		}
+
+		r1 = Vector2(1.0f, 0.0f);
+		v1 = center + radius * r1;
+		depth -= DEPTH_SLICE_FINE_OFFSET;
+		for (auto i = 0; i < k_segments; ++i)
+		{
+			Vector2 r2;
+			r2.x = cosInc * r1.x - sinInc * r1.y;
+			r2.y = sinInc * r1.x + cosInc * r1.y;
+			const Vector2 v2 = center + radius * r2;
+			lines.emplace_back(v1, depth, color);
+			lines.emplace_back(v2, depth, color);
+			r1 = r2;
+			v1 = v2;
+		}
+
+		lines.emplace_back(center, depth, color);
+		lines.emplace_back(center + radius * axis, depth, color);
+	}
+
+	template<typename Function>
+	double GetMsPerFrame(Function function)
+	{
+		const auto start = Clock::now();
+		for (int i = 0; i < NrOfRepeats; ++i)
+			function();
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / NrOfRepeats;
+	}
+}
+
+bool Elite::RunDebugGeometryBenchmark(std::ostream& output)
+{
+	bool hasPassed{ true };
+	const auto check = [&](bool isCorrect, const char* description)
+	{
+		output << (isCorrect ? "  ok   " : "  FAIL ") << description << std::endl;
+		hasPassed &= isCorrect;
+	};
+
+	const DebugCullBounds2D view{ GetView() };
+	const DebugCullBounds2D noCulling{};
+	const Color color{ 1.f, 0.f, 0.f };
+	std::vector<Vertex> triangles{}, lines{}, points{};
+
+	//=== Checks ===
+	output << "Debug geometry" << std::endl;
+	{
+		check(view.IsCircleVisible({ 0.f, 0.f }, 1.f) && view.IsCircleVisible({ 16.5f, 0.f }, 1.f)
+			&& !view.IsCircleVisible({ 18.f, 0.f }, 1.f), "circles are culled by their extent");
+		check(view.IsSegmentVisible({ -20.f, 0.f }, { 20.f, 0.f }) && !view.IsSegmentVisible({ -20.f, 10.f }, { 20.f, 12.f }),
+			"a segment crossing the view is kept although both ends are outside");
+		const Vector2 around[]{ { -30.f, -30.f }, { 30.f, -30.f }, { 30.f, 30.f }, { -30.f, 30.f } };
+		const Vector2 beside[]{ { 20.f, 0.f }, { 25.f, 0.f }, { 25.f, 5.f } };
+		check(view.IsPolygonVisible(around, 4) && !view.IsPolygonVisible(beside, 3), "polygons are culled by their bounding box");
+
+		//A 40 pixel point is half a world unit wide
+		check(view.IsCircleVisible({ 16.2f, 0.f }, 0.5f * 40.f * view.worldUnitsPerPixel)
+			&& !view.IsCircleVisible({ 16.5f, 0.f }, 0.5f * 10.f * view.worldUnitsPerPixel), "points are culled by their size in pixels");
+
+		//200 pixels is 5 world units
+		check(view.IsTextVisible({ -20.f, 0.f }, { 200.f, 20.f }) && !view.IsTextVisible({ -20.f, 0.f }, { 100.f, 20.f }),
+			"text that starts left of the view but runs into it is kept");
+		check(view.IsTextVisible({ 0.f, 9.5f }, { 100.f, 40.f }) && !view.IsTextVisible({ 0.f, -9.1f }, { 100.f, 40.f }),
+			"text hangs down from its anchor");
+		check(noCulling.IsCircleVisible({ 1000.f, 1000.f }, 0.f) && noCulling.IsTextVisible({ 1000.f, 1000.f }, {}),
+			"nothing is culled when culling is off");
+
+		const bool isSolidCircleDrawn{ DebugGeometry2D::AppendSolidCircle(triangles, lines, view, { 0.f, 0.f }, 1.f, { 1.f, 0.f }, color, 0.f) };
+		check(isSolidCircleDrawn && triangles.size() == 3 * DebugGeometry2D::CircleSegments
+			&& lines.size() == 2 * DebugGeometry2D::CircleSegments + 2, "a solid circle is a fan, an outline and an axis");
+		lines.clear();
+		const bool isCircleDrawn{ DebugGeometry2D::AppendCircle(lines, view, { 0.f, 0.f }, 1.f, color, 0.f) };
+		check(isCircleDrawn && lines.size() == 2 * DebugGeometry2D::CircleSegments, "a circle is an outline");
+		triangles.clear();
+		lines.clear();
+		const bool isCulledCircleDrawn{ DebugGeometry2D::AppendSolidCircle(triangles, lines, view, { 100.f, 0.f }, 1.f, { 1.f, 0.f }, color, 0.f) };
+		const bool isCulledPointDrawn{ DebugGeometry2D::AppendPoint(points, view, { 100.f, 0.f }, 5.f, color, 0.f) };
+		check(!isCulledCircleDrawn && !isCulledPointDrawn && triangles.empty() && lines.empty() && points.empty(),
+			"culled shapes add no vertices");
+
+		//The cached circle starts at angle 0, the rotation at one segment, so compare them as sets of points
+		std::vector<Vertex> rotatedTriangles{}, rotatedLines{};
+		AppendSolidCircleByRotation(rotatedTriangles, rotatedLines, { 3.f, -2.f }, 2.f, { 1.f, 0.f }, color, 0.f);
+		DebugGeometry2D::AppendSolidCircle(triangles, lines, view, { 3.f, -2.f }, 2.f, { 1.f, 0.f }, color, 0.f);
+		float maxError{ 0.f };
+		for (size_t i = 0; i < rotatedLines.size(); i += 2)
+		{
+			float nearest{ FLT_MAX };
+			for (size_t j = 0; j < lines.size(); j += 2)
+			{
+				const Vector3 difference{ rotatedLines[i].position - lines[j].position };
+				nearest = std::min(nearest, std::abs(difference.x) + std::abs(difference.y));
+			}
+			maxError = std::max(maxError, nearest);
+		}
+		check(maxError < 1e-4f, "the cached unit circle gives the same outline as the rotation");
+	}
+
+	//=== Throughput ===
+	{
+		//Spread over a world 10 times as wide and high as the view, so about 99% is off screen
+		std::mt19937 generator{ 42 };
+		std::uniform_real_distribution<float> xDistribution{ -160.f, 160.f };
+		std::uniform_real_distribution<float> yDistribution{ -90.f, 90.f };
+		std::vector<Vector2> centers(NrOfCircles);
+		for (Vector2& center : centers)
+			center = { xDistribution(generator), yDistribution(generator) };
+
+		triangles.reserve(3 * DebugGeometry2D::CircleSegments * NrOfCircles);
+		lines.reserve((2 * DebugGeometry2D::CircleSegments + 2) * NrOfCircles);
+
+		int nrOfDrawnCircles{ 0 };
+		const auto drawCircles = [&](const DebugCullBounds2D& bounds)
+		{
+			return [&, bounds]()
+			{
+				triangles.clear();
+				lines.clear();
+				nrOfDrawnCircles = 0;
+				for (const Vector2& center : centers)
+				{
+					if (DebugGeometry2D::AppendSolidCircle(triangles, lines, bounds, center, 0.5f, { 1.f, 0.f }, color, 0.f))
+						++nrOfDrawnCircles;
+				}
+			};
+		};
+		const auto drawCirclesByRotation = [&]()
+		{
+			triangles.clear();
+			lines.clear();
+			for (const Vector2& center : centers)
+				AppendSolidCircleByRotation(triangles, lines, center, 0.5f, { 1.f, 0.f }, color, 0.f);
+		};
+
+		const double rotationMs{ GetMsPerFrame(drawCirclesByRotation) };
+		const double unitCircleMs{ GetMsPerFrame(drawCircles(noCulling)) };
+		const double culledMs{ GetMsPerFrame(drawCircles(view)) };
+		output << NrOfCircles << " solid circles: " << rotationMs << " ms rotated, " << unitCircleMs << " ms from the unit circle ("
+			<< rotationMs / unitCircleMs << "x), " << culledMs << " ms culled to the view with " << nrOfDrawnCircles << " drawn ("
+			<< unitCircleMs / culledMs << "x)" << std::endl;
+		check(nrOfDrawnCircles > 0 && nrOfDrawnCircles < NrOfCircles / 50, "about 1% of the circles is in view");
+	}
+
+	output << (hasPassed ? "All checks passed" : "Some checks FAILED") << std::endl;
+	return hasPassed;
+}
@@ -9,7 +9,9 @@ DebugRenderer2D.h: OpenGL immediate 2D debug renderer, used for drawing 2D shape
 //--- Includes ---
 #include "2DCamera/ECamera2D.h"
 #include "ERenderingTypes.h"
+#include "EDebugGeometry2D.h"
 #include "../EliteGeometry/EGeometry2DTypes.h"
+
 namespace Elite
 {
 	template<typename Impl>
@@ -21,7 +23,7 @@ namespace Elite
 		~EDebugRenderer2D() = default;
 
 		//--- Functions ---
-		void Initialize(Camera2D* pActiveCamera);
+		void Initialize(Camera2D* pActiveCamera, bool isHeadless = false);
 		void Render();
 		unsigned int LoadShadersToProgram(const char* vertexShaderPath, const char* fragmentShaderPath);
 		unsigned int LoadShadersToProgramFromEmbeddedSource(const char* vertexShader, const char* fragmentShader);
@@ -45,6 +47,12 @@ namespace Elite
 		void DrawString(int x, int y, const char* string, ...) const;
 		void DrawString(const Elite::Vector2& pw, const char* string, ...) const;
 
+		//--- Batched Functions ---
+		//Appends vertices to a primitive container and returns the first one, to be filled in by the caller.
+		//The pointer is only valid until the next draw call.
+		Vertex* AllocateLineVertices(int nrOfVertices);
+		Vertex* AllocateTriangleVertices(int nrOfVertices);
+
 		inline float NextDepthSlice();
 
 	protected:
@@ -6,7 +6,9 @@
 /*=============================================================================*/
 #ifndef ELITE_RENDERING_TYPES
 #define ELITE_RENDERING_TYPES
-#include "../EliteMath/EMath.h"
+#include "../EliteMath/EMathUtilities.h"
+#include "../EliteMath/EVector2.h"
+#include "../EliteMath/EVector3.h"
 namespace Elite
 {
 	//Basic color
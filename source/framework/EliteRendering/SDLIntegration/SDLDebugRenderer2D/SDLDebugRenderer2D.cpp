@@ -3,17 +3,12 @@
 #include "SDLDebugRenderer2D.h"
 using namespace Elite;
 
-//Immediate Draw Auto Layering Settings
-#define DEPTH_SLICE_OFFSET 0.0005f
-#define DEPTH_SLICE_FINE_OFFSET 0.0000005f
-#define DEPTH_SLICE_MIN -0.5f//far
-#define DEPTH_SLICE_MAX 0.5f//close
-
 //Functions
-void SDLDebugRenderer2D::Initialize(Camera2D* pActiveCamera)
+void SDLDebugRenderer2D::Initialize(Camera2D* pActiveCamera, bool isHeadless)
 {
 	//Store variables
 	m_pActiveCamera = pActiveCamera;
+	m_IsHeadless = isHeadless;
 
 	//Initialize container sizes - reserve continious memory
 	int initialSize = 512;
@@ -21,6 +16,9 @@ void SDLDebugRenderer2D::Initialize(Camera2D* pActiveCamera)
 	m_vLines.reserve(initialSize);
 	m_vTriangles.reserve(initialSize);
 
+	if (m_IsHeadless)
+		return;
+
 	//Create the programs we use in our framework
 	m_programID = DEBUGRENDERER2D->LoadShadersToProgramFromEmbeddedSource(DefaultVertexShaderSource, DefaultFragmentShaderSource);
 	/*m_programID = LoadShadersToProgram("../data/shaders/DefaultVertexShader.vertexshader",
@@ -60,6 +58,22 @@ void SDLDebugRenderer2D::Initialize(Camera2D* pActiveCamera)
 
 void SDLDebugRenderer2D::Render()
 {
+	ELITE_PROFILE_SCOPE("SDLDebugRenderer2D::Render");
+
+	//Nothing to draw to, only start a new frame
+	if (m_IsHeadless)
+	{
+		m_NrOfDrawnVertices = 0;
+		m_NrOfCulledShapes = m_NrOfCulledShapesThisFrame;
+		m_NrOfCulledShapesThisFrame = 0;
+		m_IsCullBoundsValid = false;
+		m_vTriangles.clear();
+		m_vLines.clear();
+		m_vPoints.clear();
+		m_CurrDepthSlice = DEPTH_SLICE_MAX;
+		return;
+	}
+
 	//Clear color
 	glClear(GL_COLOR_BUFFER_BIT);
 	glClear(GL_DEPTH_BUFFER_BIT);
@@ -76,35 +90,53 @@ void SDLDebugRenderer2D::Render()
 	m_pActiveCamera->BuildProjectionMatrix(proj, 0.0f);
 	glUniformMatrix4fv(m_projectionUniform, 1, GL_FALSE, proj);
 
-	//Copy Data and Draw Lines
-	int size = m_vLines.size();
-	if (size > 0)
+	//Stream all primitives into one buffer. Orphaning it first lets the driver hand out fresh storage
+	//instead of waiting for the draws of the previous frame.
+	const int nrOfLines = static_cast<int>(m_vLines.size());
+	const int nrOfTriangles = static_cast<int>(m_vTriangles.size());
+	const int nrOfPoints = static_cast<int>(m_vPoints.size());
+	const int nrOfVertices = nrOfLines + nrOfTriangles + nrOfPoints;
+	if (nrOfVertices > m_BufferCapacity)
+		m_BufferCapacity = std::max(nrOfVertices, 2 * m_BufferCapacity);
+
+	if (nrOfVertices > 0)
 	{
-		glBufferData(GL_ARRAY_BUFFER, size * sizeof(Vertex), &m_vLines.front(), GL_DYNAMIC_DRAW);
-		glDrawArrays(GL_LINES, 0, size);
+		glBufferData(GL_ARRAY_BUFFER, m_BufferCapacity * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+		if (nrOfLines > 0)
+			glBufferSubData(GL_ARRAY_BUFFER, 0, nrOfLines * sizeof(Vertex), m_vLines.data());
+		if (nrOfTriangles > 0)
+			glBufferSubData(GL_ARRAY_BUFFER, nrOfLines * sizeof(Vertex), nrOfTriangles * sizeof(Vertex), m_vTriangles.data());
+		if (nrOfPoints > 0)
+			glBufferSubData(GL_ARRAY_BUFFER, (nrOfLines + nrOfTriangles) * sizeof(Vertex), nrOfPoints * sizeof(Vertex), m_vPoints.data());
 	}
 
-	//Copy Data and Draw Triangles
-	size = m_vTriangles.size();
-	if (size > 0)
+	//Draw Lines
+	if (nrOfLines > 0)
+		glDrawArrays(GL_LINES, 0, nrOfLines);
+
+	//Draw Triangles
+	if (nrOfTriangles > 0)
 	{
-		glBufferData(GL_ARRAY_BUFFER, size * sizeof(Vertex), &m_vTriangles.front(), GL_DYNAMIC_DRAW);
 		glEnable(GL_BLEND);
 		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-		glDrawArrays(GL_TRIANGLES, 0, size);
+		glDrawArrays(GL_TRIANGLES, nrOfLines, nrOfTriangles);
 		glDisable(GL_BLEND);
 	}
 	
-	//Copy Data and Draw Point
-	size = m_vPoints.size();
-	if (size > 0)
+	//Draw Points
+	if (nrOfPoints > 0)
 	{
-		glBufferData(GL_ARRAY_BUFFER, size * sizeof(Vertex), &m_vPoints.front(), GL_DYNAMIC_DRAW);
 		glEnable(GL_PROGRAM_POINT_SIZE);
-		glDrawArrays(GL_POINTS, 0, size);
+		glDrawArrays(GL_POINTS, nrOfLines + nrOfTriangles, nrOfPoints);
 		glDisable(GL_PROGRAM_POINT_SIZE);
 	}
 
+	//Stats
+	m_NrOfDrawnVertices = nrOfVertices;
+	m_NrOfCulledShapes = m_NrOfCulledShapesThisFrame;
+	m_NrOfCulledShapesThisFrame = 0;
+	m_IsCullBoundsValid = false;
+
 	//Cleanup containers
 	m_vTriangles.clear();
 	m_vLines.clear();
@@ -134,6 +166,9 @@ void SDLDebugRenderer2D::Shutdown()
 	m_vLines.clear();
 	m_vTriangles.clear();
 
+	if (m_IsHeadless)
+		return;
+
 	glDeleteBuffers(1, m_bufferIDs);
 	glDeleteVertexArrays(1, &m_vaoId);
 	glDeleteProgram(m_programID);
@@ -142,9 +177,16 @@ void SDLDebugRenderer2D::Shutdown()
 void SDLDebugRenderer2D::DrawPolygon(Elite::Polygon* polygon, const Color& color, float depth)
 {
 	//Copy data to vector
-	std::vector<Elite::Vector2> points;
+	auto points = Elite::FrameArena::MakeVector<Elite::Vector2>(polygon->GetPoints().size());
 	points.assign(polygon->GetPoints().begin(), polygon->GetPoints().end());
 
+	//Children are holes, so the outer points bound the whole polygon
+	if (!GetCullBounds().IsPolygonVisible(points.data(), static_cast<int>(points.size())))
+	{
+		++m_NrOfCulledShapesThisFrame;
+		return;
+	}
+
 	//Draw copied list as lines
 	depth -= DEPTH_SLICE_FINE_OFFSET;
 	auto p1 = points[points.size() - 1];
@@ -180,14 +222,8 @@ void SDLDebugRenderer2D::DrawPolygon(Elite::Polygon* polygon, const Color& color
 
 void SDLDebugRenderer2D::DrawPolygon(const Elite::Vector2* points, int count, const Color& color, float depth)
 {
-	auto p1 = points[count - 1];
-	for (auto i = 0; i < count; ++i)
-	{
-		const auto p2 = points[i];
-		m_vLines.push_back(Vertex(p1, depth, color));
-		m_vLines.push_back(Vertex(p2, depth, color));
-		p1 = p2;
-	}
+	if (!DebugGeometry2D::AppendPolygon(m_vLines, GetCullBounds(), points, count, color, depth))
+		++m_NrOfCulledShapesThisFrame;
 }
 
 void SDLDebugRenderer2D::DrawSolidPolygon(Elite::Polygon* polygon, const Color& color, float depth, bool triangulate)
@@ -196,7 +232,7 @@ void SDLDebugRenderer2D::DrawSolidPolygon(Elite::Polygon* polygon, const Color&
 	const Color fillColor(0.5f * color.r, 0.5f * color.g, 0.5f * color.b, 0.5f);
 
 	//Copy data to vector
-	std::vector<Elite::Vector2> points;
+	auto points = Elite::FrameArena::MakeVector<Elite::Vector2>(polygon->GetPoints().size());
 	points.assign(polygon->GetPoints().begin(), polygon->GetPoints().end());
 
 	//Triangulation
@@ -259,36 +295,32 @@ void SDLDebugRenderer2D::DrawSolidPolygon(const Elite::Polygon* polygon, const C
 
 void SDLDebugRenderer2D::DrawSolidPolygon(const Elite::Vector2* points, int count, const Color& color, float depth, bool triangluate)
 {
+	if (!triangluate)
+	{
+		if (!DebugGeometry2D::AppendSolidPolygon(m_vTriangles, m_vLines, GetCullBounds(), points, count, color, depth))
+			++m_NrOfCulledShapesThisFrame;
+		return;
+	}
+
+	if (!GetCullBounds().IsPolygonVisible(points, count))
+	{
+		++m_NrOfCulledShapesThisFrame;
+		return;
+	}
+
 	//Color
 	const Color fillColor(0.5f * color.r, 0.5f * color.g, 0.5f * color.b, 0.5f);
 
-	if (triangluate)
-	{
-		auto verts = std::vector<Elite::Triangle*>();
-		Elite::Polygon polygon(points, count);
-		verts = polygon.Triangulate();
+	auto verts = std::vector<Elite::Triangle*>();
+	Elite::Polygon polygon(points, count);
+	verts = polygon.Triangulate();
 
-		//Draw Triangles
-		for (auto i = 0; i < static_cast<int>(verts.size()); ++i)
-		{
-			m_vTriangles.push_back(Vertex(verts[i]->p1, depth, fillColor));
-			m_vTriangles.push_back(Vertex(verts[i]->p2, depth, fillColor));
-			m_vTriangles.push_back(Vertex(verts[i]->p3, depth, fillColor));
-		}
-	}
-	else
+	//Draw Triangles
+	for (auto i = 0; i < static_cast<int>(verts.size()); ++i)
 	{
-		auto verts = std::vector<Elite::Vector2>();
-		for (auto i = 0; i < count; ++i)
-			verts.push_back(points[i]);
-
-		//Draw Triangles
-		for (auto i = 1; i < static_cast<int>(verts.size() - 1); ++i)
-		{
-			m_vTriangles.push_back(Vertex(verts[0], depth, fillColor));
-			m_vTriangles.push_back(Vertex(verts[i], depth, fillColor));
-			m_vTriangles.push_back(Vertex(verts[i + 1], depth, fillColor));
-		}
+		m_vTriangles.push_back(Vertex(verts[i]->p1, depth, fillColor));
+		m_vTriangles.push_back(Vertex(verts[i]->p2, depth, fillColor));
+		m_vTriangles.push_back(Vertex(verts[i]->p3, depth, fillColor));
 	}
 
 	//Draw Lines
@@ -305,72 +337,14 @@ void SDLDebugRenderer2D::DrawSolidPolygon(const Elite::Vector2* points, int coun
 
 void SDLDebugRenderer2D::DrawCircle(const Elite::Vector2& center, float radius, const Color& color, float depth)
 {
-	const auto k_segments = 16.0f;
-	const auto k_increment = 2.0f * b2_pi / k_segments;
-	const auto sinInc = sinf(k_increment);
-	const auto cosInc = cosf(k_increment);
-	Elite::Vector2 r1(1.0f, 0.0f);
-	Elite::Vector2 v1 = center + radius * r1;
-	for (auto i = 0; i < k_segments; ++i)
-	{
-		// Perform rotation to avoid additional trigonometry.
-		Elite::Vector2 r2;
-		r2.x = cosInc * r1.x - sinInc * r1.y;
-		r2.y = sinInc * r1.x + cosInc * r1.y;
-		const Elite::Vector2 v2 = center + radius * r2;
-		m_vLines.push_back(Vertex(v1, depth, color));
-		m_vLines.push_back(Vertex(v2, depth, color));
-		r1 = r2;
-		v1 = v2;
-	}
+	if (!DebugGeometry2D::AppendCircle(m_vLines, GetCullBounds(), center, radius, color, depth))
+		++m_NrOfCulledShapesThisFrame;
 }
 
 void SDLDebugRenderer2D::DrawSolidCircle(const Elite::Vector2& center, float radius, const Elite::Vector2& axis, const Color& color, float depth)
 {
-	const auto k_segments = 16.0f;
-	const auto k_increment = 2.0f * b2_pi / k_segments;
-	const auto sinInc = sinf(k_increment);
-	const auto cosInc = cosf(k_increment);
-	const auto v0 = center;
-	Elite::Vector2 r1(cosInc, sinInc);
-	Elite::Vector2 v1 = center + radius * r1;
-	const Color fillColor(0.5f * color.r, 0.5f * color.g, 0.5f * color.b, color.a);
-	for (auto i = 0; i < k_segments; ++i)
-	{
-		// Perform rotation to avoid additional trigonometry.
-		Elite::Vector2 r2;
-		r2.x = cosInc * r1.x - sinInc * r1.y;
-		r2.y = sinInc * r1.x + cosInc * r1.y;
-		const Elite::Vector2 v2 = center + radius * r2;
-		m_vTriangles.push_back(Vertex(v0, depth, fillColor));
-		m_vTriangles.push_back(Vertex(v1, depth, fillColor));
-		m_vTriangles.push_back(Vertex(v2, depth, fillColor));
-		r1 = r2;
-		v1 = v2;
-	}
-
-	r1 = Elite::Vector2(1.0f, 0.0f);
-	v1 = center + radius * r1;
-	depth -= DEPTH_SLICE_FINE_OFFSET;
-
-	for (auto i = 0; i < k_segments; ++i)
-	{
-		Elite::Vector2 r2;
-		r2.x = cosInc * r1.x - sinInc * r1.y;
-		r2.y = sinInc * r1.x + cosInc * r1.y;
-		const Elite::Vector2 v2 = center + radius * r2;
-		m_vLines.push_back(Vertex(v1, depth, color));
-		m_vLines.push_back(Vertex(v2, depth, color));
-		r1 = r2;
-		v1 = v2;
-	}
-
-	// Draw a line fixed in the circle to animate rotation.
-	const Elite::Vector2 p = center + radius * axis;
-	depth -= DEPTH_SLICE_FINE_OFFSET;
-
-	m_vLines.push_back(Vertex(center, depth, color));
-	m_vLines.push_back(Vertex(p, depth, color));
+	if (!DebugGeometry2D::AppendSolidCircle(m_vTriangles, m_vLines, GetCullBounds(), center, radius, axis, color, depth))
+		++m_NrOfCulledShapesThisFrame;
 }
 
 void SDLDebugRenderer2D::DrawSolidCircle(const Elite::Vector2& center, float radius, const Elite::Vector2& axis, const Color& color)
@@ -380,8 +354,8 @@ void SDLDebugRenderer2D::DrawSolidCircle(const Elite::Vector2& center, float rad
 
 void SDLDebugRenderer2D::DrawSegment(const Elite::Vector2& p1, const Elite::Vector2& p2, const Color& color, float depth)
 {
-	m_vLines.push_back(Vertex(p1, depth, color));
-	m_vLines.push_back(Vertex(p2, depth, color));
+	if (!DebugGeometry2D::AppendSegment(m_vLines, GetCullBounds(), p1, p2, color, depth))
+		++m_NrOfCulledShapesThisFrame;
 }
 
 void SDLDebugRenderer2D::DrawSegment(const Elite::Vector2& p1, const Elite::Vector2& p2, const Color& color)
@@ -412,7 +386,8 @@ void SDLDebugRenderer2D::DrawTransform(const Elite::Vector2& p, const Elite::Vec
 
 void SDLDebugRenderer2D::DrawPoint(const Elite::Vector2& p, float size, const Color& color, float depth)
 {
-	m_vPoints.push_back(Vertex(p, depth, color, size));
+	if (!DebugGeometry2D::AppendPoint(m_vPoints, GetCullBounds(), p, size, color, depth))
+		++m_NrOfCulledShapesThisFrame;
 }
 
 void SDLDebugRenderer2D::DrawString(int x, int y, const char* string, ...) const
@@ -445,6 +420,18 @@ void SDLDebugRenderer2D::DrawString(const Elite::Vector2& pw, const char* string
 	if (!m_pActiveCamera)
 		return;
 
+	//Format first, the text has to be measured to know if any of it is on screen
+	char text[1024];
+	va_list arg;
+	va_start(arg, string);
+	vsnprintf(text, sizeof(text), string, arg);
+	va_end(arg);
+
+	//Skip the ImGui window entirely when the text is off screen
+	const ImVec2 textSize{ ImGui::CalcTextSize(text) };
+	if (!GetCullBounds().IsTextVisible(pw, Elite::Vector2{ textSize.x, textSize.y }))
+		return;
+
 	auto ps = m_pActiveCamera->ConvertWorldToScreen(pw);
 
 	auto& style = ImGui::GetStyle();
@@ -453,20 +440,47 @@ void SDLDebugRenderer2D::DrawString(const Elite::Vector2& pw, const char* string
 	colorWindowBg.w = 0.0f;
 	style.Colors[ImGuiCol_WindowBg] = colorWindowBg;
 
-	va_list arg;
-	va_start(arg, string);
 	ImGui::Begin("Overlay", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoInputs | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoScrollbar
 		| ImGuiWindowFlags_NoSavedSettings);
 	ImGui::SetCursorPos(ImVec2(float(ps.x), float(ps.y)));
-	ImGui::TextColoredV(ImColor(230, 153, 153, 255), string, arg);
+	ImGui::TextColored(ImColor(230, 153, 153, 255), "%s", text);
 	ImGui::End();
-	va_end(arg);
 
 	//Reset alpha
 	colorWindowBg.w = initialAlpha;
 	style.Colors[ImGuiCol_WindowBg] = colorWindowBg;
 }
 
+Vertex* SDLDebugRenderer2D::AllocateLineVertices(int nrOfVertices)
+{
+	const size_t first = m_vLines.size();
+	m_vLines.resize(first + nrOfVertices);
+	return m_vLines.data() + first;
+}
+
+Vertex* SDLDebugRenderer2D::AllocateTriangleVertices(int nrOfVertices)
+{
+	const size_t first = m_vTriangles.size();
+	m_vTriangles.resize(first + nrOfVertices);
+	return m_vTriangles.data() + first;
+}
+
+const DebugCullBounds2D& SDLDebugRenderer2D::GetCullBounds() const
+{
+	if (m_IsCullBoundsValid)
+		return m_CullBounds;
+
+	m_CullBounds = {};
+	m_IsCullBoundsValid = true;
+	if (!m_IsCullingEnabled || !m_pActiveCamera)
+		return m_CullBounds;
+
+	m_pActiveCamera->GetVisibleWorldBounds(m_CullBounds.lower, m_CullBounds.upper);
+	m_CullBounds.worldUnitsPerPixel = 1.f / m_pActiveCamera->GetPixelsPerWorldUnit();
+	m_CullBounds.isEnabled = true;
+	return m_CullBounds;
+}
+
 inline float SDLDebugRenderer2D::NextDepthSlice()
 {
 	m_CurrDepthSlice -= DEPTH_SLICE_OFFSET;
@@ -23,7 +23,8 @@ namespace Elite
 		~SDLDebugRenderer2D() { Shutdown(); };
 
 		//--- Functions ---
-		void Initialize(Camera2D* pActiveCamera);
+		//Headless only keeps the camera: draw calls are still accepted, Render drops them without touching OpenGL
+		void Initialize(Camera2D* pActiveCamera, bool isHeadless = false);
 		void Render();
 		unsigned int LoadShadersToProgram(const char* vertexShaderPath, const char* fragmentShaderPath);
 		unsigned int LoadShadersToProgramFromEmbeddedSource(const char* vertexShader, const char* fragmentShader);
@@ -46,8 +47,21 @@ namespace Elite
 		void DrawString(int x, int y, const char* string, ...) const;
 		void DrawString(const Elite::Vector2& pw, const char* string, ...) const;
 
+		//--- Batched Functions ---
+		Vertex* AllocateLineVertices(int nrOfVertices);
+		Vertex* AllocateTriangleVertices(int nrOfVertices);
+
 		inline float NextDepthSlice();
 
+		//--- Culling ---
+		//Draw calls completely outside of the active camera view are dropped
+		bool IsCullingEnabled() const { return m_IsCullingEnabled; }
+		void SetCullingEnabled(bool isEnabled) { m_IsCullingEnabled = isEnabled; m_IsCullBoundsValid = false; }
+
+		//Stats of the last rendered frame
+		int GetNrOfDrawnVertices() const { return m_NrOfDrawnVertices; }
+		int GetNrOfCulledShapes() const { return m_NrOfCulledShapes; }
+
 	private:
 		//--- Datamembers ---
 		//PROGRAM, VERTEX & ATTRIBUTE DATA
@@ -58,6 +72,20 @@ namespace Elite
 		int m_sizeAttribute = 2;
 		unsigned int m_vaoId = 0;
 		unsigned int m_bufferIDs[1] = {};
+		int m_BufferCapacity = 0; //in vertices
+
+		bool m_IsHeadless = false;
+
+		//Culling
+		bool m_IsCullingEnabled = true;
+		int m_NrOfCulledShapesThisFrame = 0;
+		int m_NrOfCulledShapes = 0;
+		int m_NrOfDrawnVertices = 0;
+		mutable DebugCullBounds2D m_CullBounds{};
+		mutable bool m_IsCullBoundsValid = false;
+
+		//Taken from the camera at the first draw call of a frame, the camera has been updated by then
+		const DebugCullBounds2D& GetCullBounds() const;
 
 		//Functions
 		void Shutdown();
@@ -0,0 +1,179 @@
+//=== General Includes ===
+#include "stdafx.h"
+#include "EReplay.h"
+using namespace Elite;
+
+//=== Log Layout ===
+namespace
+{
+	const uint32_t ReplayFileMagic = MakeFourCC('E', 'R', 'P', 'L');
+	const uint32_t ReplayFileVersion = 1;
+
+	const uint32_t ReplayInfoSection = MakeFourCC('R', 'I', 'N', 'F');
+	const uint32_t ReplayFramesSection = MakeFourCC('R', 'F', 'R', 'M');
+	const uint32_t ReplayInputSection = MakeFourCC('R', 'I', 'N', 'P');
+
+	struct ReplayFileInfo
+	{
+		unsigned int seed;
+		int loopMode;
+	};
+}
+
+//=== Replay ===
+Replay::State& Replay::GetState()
+{
+	static State state{};
+	return state;
+}
+
+unsigned int Replay::GetSeed()
+{
+	return GetState().seed;
+}
+
+void Replay::StartRecording(const std::string& path, int loopMode)
+{
+	State& state{ GetState() };
+	state.mode = Mode::Recording;
+	state.path = path;
+	state.loopMode = loopMode;
+	state.frames.clear();
+	state.inputActions.clear();
+}
+
+bool Replay::StartReplay(const std::string& path)
+{
+	BinaryFileReader reader{};
+	if (!reader.Open(path, ReplayFileMagic, ReplayFileVersion))
+		return false;
+
+	size_t nrOfInfos{}, nrOfFrames{}, nrOfInputActions{};
+	const ReplayFileInfo* pInfo{ reader.GetSection<ReplayFileInfo>(ReplayInfoSection, nrOfInfos) };
+	const Frame* pFrames{ reader.GetSection<Frame>(ReplayFramesSection, nrOfFrames) };
+	const InputAction* pInputActions{ reader.GetSection<InputAction>(ReplayInputSection, nrOfInputActions) };
+	if (nrOfInfos != 1 || !pFrames || !pInputActions)
+		return false;
+
+	for (size_t i = 0; i < nrOfFrames; ++i)
+	{
+		if (pFrames[i].firstInputAction < 0 || pFrames[i].nrOfInputActions < 0
+			|| size_t(pFrames[i].firstInputAction) + pFrames[i].nrOfInputActions > nrOfInputActions)
+			return false;
+	}
+
+	State& state{ GetState() };
+	state.mode = Mode::Replaying;
+	state.path = path;
+	state.seed = pInfo->seed;
+	state.loopMode = pInfo->loopMode;
+	state.frames.assign(pFrames, pFrames + nrOfFrames);
+	state.inputActions.assign(pInputActions, pInputActions + nrOfInputActions);
+	state.currentFrame = 0;
+	state.timings.clear();
+	state.timings.reserve(nrOfFrames);
+	return true;
+}
+
+bool Replay::BeginFrame(float& elapsed)
+{
+	State& state{ GetState() };
+	EInputManager* pInputManager{ EInputManager::GetInstance() };
+
+	switch (state.mode)
+	{
+	case Mode::Recording:
+	{
+		const int firstInputAction{ static_cast<int>(state.inputActions.size()) };
+		state.inputActions.insert(state.inputActions.end(), pInputManager->m_InputContainer.begin(), pInputManager->m_InputContainer.end());
+		state.frames.push_back(Frame{ elapsed, 0, firstInputAction, static_cast<int>(pInputManager->m_InputContainer.size()) });
+		break;
+	}
+	case Mode::Replaying:
+	{
+		if (state.currentFrame >= state.frames.size())
+			return false;
+
+		const Frame& frame{ state.frames[state.currentFrame] };
+		elapsed = frame.elapsed;
+		pInputManager->Flush();
+		for (int i = frame.firstInputAction; i < frame.firstInputAction + frame.nrOfInputActions; ++i)
+			pInputManager->AddInputAction(state.inputActions[i]);
+
+		state.frameStart = std::chrono::high_resolution_clock::now();
+		break;
+	}
+	default:
+		break;
+	}
+
+	return true;
+}
+
+void Replay::SetNrOfTicks(int nrOfTicks)
+{
+	State& state{ GetState() };
+	if (state.mode == Mode::Recording && !state.frames.empty())
+		state.frames.back().nrOfTicks = nrOfTicks;
+}
+
+int Replay::GetNrOfTicks()
+{
+	const State& state{ GetState() };
+	if (state.mode != Mode::Replaying || state.currentFrame >= state.frames.size())
+		return 0;
+
+	return state.frames[state.currentFrame].nrOfTicks;
+}
+
+void Replay::EndFrame()
+{
+	State& state{ GetState() };
+	if (state.mode != Mode::Replaying || state.currentFrame >= state.frames.size())
+		return;
+
+	const Frame& frame{ state.frames[state.currentFrame] };
+	const float durationMs{ std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - state.frameStart).count() };
+	state.timings.push_back(FrameTiming{ frame.elapsed, frame.nrOfTicks, durationMs });
+	++state.currentFrame;
+}
+
+void Replay::Finish()
+{
+	State& state{ GetState() };
+
+	if (state.mode == Mode::Recording)
+	{
+		const ReplayFileInfo info{ state.seed, state.loopMode };
+		BinaryFileWriter writer{ ReplayFileMagic, ReplayFileVersion };
+		writer.AddSection(ReplayInfoSection, &info, 1);
+		writer.AddSection(ReplayFramesSection, state.frames);
+		writer.AddSection(ReplayInputSection, state.inputActions);
+		if (writer.Write(state.path))
+			std::cout << "Recorded " << state.frames.size() << " frames to " << state.path << std::endl;
+		else
+			std::cout << "Could not write replay log " << state.path << std::endl;
+	}
+	else if (state.mode == Mode::Replaying)
+	{
+		const std::string timingsPath{ state.path + ".timings.csv" };
+		std::ofstream file{ timingsPath };
+		file << "frame,elapsed_ms,ticks,duration_ms\n";
+
+		float totalMs{ 0.f };
+		float maxMs{ 0.f };
+		for (size_t i = 0; i < state.timings.size(); ++i)
+		{
+			const FrameTiming& timing{ state.timings[i] };
+			file << i << ',' << timing.elapsed * 1000.f << ',' << timing.nrOfTicks << ',' << timing.durationMs << '\n';
+			totalMs += timing.durationMs;
+			maxMs = std::max(maxMs, timing.durationMs);
+		}
+
+		const size_t nrOfFrames{ state.timings.size() };
+		std::cout << "Replayed " << nrOfFrames << "/" << state.frames.size() << " frames in " << totalMs << " ms (avg "
+			<< (nrOfFrames > 0 ? totalMs / nrOfFrames : 0.f) << " ms, max " << maxMs << " ms), timings in " << timingsPath << std::endl;
+	}
+
+	state.mode = Mode::Off;
+}
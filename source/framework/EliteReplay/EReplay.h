@@ -0,0 +1,79 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EReplay.h: records everything a run depends on (RNG seed, input events and timesteps per frame)
+// to a binary log, and plays a log back so the exact same workload runs again.
+// A replay writes the duration of every frame to <log>.timings.csv, to compare builds with.
+// Not captured: ImGui interaction and rand() calls made from worker threads.
+/*=============================================================================*/
+#ifndef ELITE_REPLAY
+#define	ELITE_REPLAY
+
+namespace Elite
+{
+	class Replay final
+	{
+	public:
+		enum class Mode
+		{
+			Off,
+			Recording,
+			Replaying
+		};
+
+		//Seed for srand. Picked from the clock once per run, or the recorded one during a replay.
+		static unsigned int GetSeed();
+
+		//loopMode is stored as is, the main loop gets it back with GetLoopMode when replaying
+		static void StartRecording(const std::string& path, int loopMode);
+		//False when the log can't be loaded
+		static bool StartReplay(const std::string& path);
+
+		static Mode GetMode() { return GetState().mode; }
+		static bool IsReplaying() { return GetState().mode == Mode::Replaying; }
+		static int GetLoopMode() { return GetState().loopMode; }
+
+		//Call once per frame, after the window filled the input manager. Recording stores the input and the timestep,
+		//replaying puts the recorded ones in their place. Returns false when the replay is done.
+		static bool BeginFrame(float& elapsed);
+		//Number of fixed ticks, set by the loop while recording and given back while replaying
+		static void SetNrOfTicks(int nrOfTicks);
+		static int GetNrOfTicks();
+		static void EndFrame();
+
+		//Writes the log or the timings
+		static void Finish();
+
+	private:
+		struct Frame
+		{
+			float elapsed;
+			int nrOfTicks;
+			int firstInputAction;
+			int nrOfInputActions;
+		};
+
+		struct FrameTiming
+		{
+			float elapsed;
+			int nrOfTicks;
+			float durationMs;
+		};
+
+		struct State
+		{
+			Mode mode = Mode::Off;
+			std::string path{};
+			unsigned int seed = static_cast<unsigned int>(time(nullptr));
+			int loopMode = 0;
+			std::vector<Frame> frames{};
+			std::vector<InputAction> inputActions{};
+			size_t currentFrame = 0;
+			std::vector<FrameTiming> timings{};
+			std::chrono::high_resolution_clock::time_point frameStart{};
+		};
+
+		static State& GetState();
+	};
+}
+#endif
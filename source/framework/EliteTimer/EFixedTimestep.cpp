@@ -0,0 +1,38 @@
+//=== General Includes ===
+#include "stdafx.h"
+#include "EFixedTimestep.h"
+using namespace Elite;
+
+FixedTimestep::FixedTimestep(float stepTime, int maxStepsPerFrame)
+	: m_StepTime{ stepTime }
+	, m_MaxStepsPerFrame{ maxStepsPerFrame }
+{
+}
+
+int FixedTimestep::Advance(float elapsedTime)
+{
+	m_Accumulator += std::max(elapsedTime, 0.f);
+
+	int nrOfSteps{ static_cast<int>(m_Accumulator / m_StepTime) };
+	if (nrOfSteps > m_MaxStepsPerFrame)
+	{
+		//Can't keep up, drop the whole steps we have no time for but keep the fraction for interpolation
+		m_DroppedTime += (nrOfSteps - m_MaxStepsPerFrame) * m_StepTime;
+		m_Accumulator -= (nrOfSteps - m_MaxStepsPerFrame) * m_StepTime;
+		nrOfSteps = m_MaxStepsPerFrame;
+	}
+
+	m_Accumulator -= nrOfSteps * m_StepTime;
+	if (m_Accumulator < 0.f) //float rounding
+		m_Accumulator = 0.f;
+
+	m_NrOfSteps += nrOfSteps;
+	return nrOfSteps;
+}
+
+void FixedTimestep::Reset()
+{
+	m_Accumulator = 0.f;
+	m_DroppedTime = 0.f;
+	m_NrOfSteps = 0;
+}
@@ -0,0 +1,43 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EFixedTimestep.h: accumulator that turns variable frame times into a number of fixed simulation steps.
+// The leftover time is exposed as an interpolation factor for rendering. The number of steps per frame
+// is capped, time that could not be caught up on is dropped instead of piling up (spiral of death).
+/*=============================================================================*/
+#ifndef ELITE_FIXED_TIMESTEP
+#define	ELITE_FIXED_TIMESTEP
+namespace Elite
+{
+	class FixedTimestep final
+	{
+	public:
+		explicit FixedTimestep(float stepTime = 1.f / 60.f, int maxStepsPerFrame = 5);
+
+		//Adds the real time of a frame, returns how many fixed steps have to be run for it
+		int Advance(float elapsedTime);
+		void Reset();
+
+		//How far the simulation is between the last and the next step, in [0, 1)
+		float GetAlpha() const { return m_Accumulator / m_StepTime; }
+
+		float GetStepTime() const { return m_StepTime; }
+		void SetStepTime(float stepTime) { m_StepTime = stepTime; }
+		int GetMaxStepsPerFrame() const { return m_MaxStepsPerFrame; }
+		void SetMaxStepsPerFrame(int maxStepsPerFrame) { m_MaxStepsPerFrame = maxStepsPerFrame; }
+
+		//Stats since the last reset
+		unsigned long long GetNrOfSteps() const { return m_NrOfSteps; }
+		double GetSimulatedTime() const { return m_NrOfSteps * static_cast<double>(m_StepTime); }
+		float GetDroppedTime() const { return m_DroppedTime; }
+
+	private:
+		float m_StepTime;
+		int m_MaxStepsPerFrame;
+
+		float m_Accumulator = 0.f;
+		float m_DroppedTime = 0.f;
+		unsigned long long m_NrOfSteps = 0;
+	};
+}
+#endif
@@ -12,12 +12,15 @@ GLint Elite::EImmediateUI::m_positionAttribute = 0, Elite::EImmediateUI::m_uvAtt
 
 Elite::EImmediateUI::~EImmediateUI()
 {
-	//Shutdown
-	glDeleteVertexArrays(1, &m_vaoID);
-	glDeleteBuffers(1, &m_vboID);
-	glDeleteBuffers(1, &m_elementsID);
-	glDeleteProgram(m_programID);
-	glDeleteTextures(1, &m_atlasTextureID);
+	//Shutdown, there is no OpenGL to clean up without a window
+	if (!m_IsHeadless)
+	{
+		glDeleteVertexArrays(1, &m_vaoID);
+		glDeleteBuffers(1, &m_vboID);
+		glDeleteBuffers(1, &m_elementsID);
+		glDeleteProgram(m_programID);
+		glDeleteTextures(1, &m_atlasTextureID);
+	}
 	ImGui::GetIO().Fonts->TexID = nullptr;
 	m_atlasTextureID = 0;
 	ImGui::Shutdown();
@@ -118,6 +121,23 @@ void Elite::EImmediateUI::Initialize(EliteRawWindow pWindow)
 	SetupStyle();
 }
 
+void Elite::EImmediateUI::InitializeHeadless(int width, int height)
+{
+	m_IsHeadless = true;
+
+	ImGuiIO& io = ImGui::GetIO();
+	io.RenderDrawListsFn = nullptr; //ImGui::Render only finishes the frame
+	io.DisplaySize = ImVec2(static_cast<float>(width), static_cast<float>(height));
+	io.DisplayFramebufferScale = ImVec2(1.f, 1.f);
+	io.MousePos = ImVec2(-1, -1);
+
+	//The font atlas is built on the CPU, text still has to be measured
+	unsigned char* pixels;
+	io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+	SetupStyle();
+}
+
 void Elite::EImmediateUI::Render()
 {
 	ImGui::Render();
@@ -267,6 +287,14 @@ void Elite::EImmediateUI::NewFrame(EliteRawWindow pWindow, float deltaTime)
 {
 	ImGuiIO& io = ImGui::GetIO();
 
+	//Headless keeps the display size it was initialized with and has no input
+	if (!pWindow)
+	{
+		io.DeltaTime = deltaTime;
+		ImGui::NewFrame();
+		return;
+	}
+
 	//Setup display size (every frame because of possible window resizing, if enabled)
 	int width, height;
 	int displayWidth, displayHeight;
@@ -21,6 +21,8 @@ namespace Elite
 
 		//--- UI Functions ---
 		void Initialize(EliteRawWindow pWindow);
+		//No window and no OpenGL: frames are built so apps can call ImGui, but never drawn. Pass nullptr as window to NewFrame.
+		void InitializeHeadless(int width, int height);
 		void Render();
 		void EventProcessing();
 		static void StaticRender(ImDrawData* drawData);
@@ -29,6 +31,7 @@ namespace Elite
 
 	private:
 		//--- Datamembers ---
+		bool m_IsHeadless = false;
 		static float m_sMouseWheel;
 		static bool m_sMousePressed[3];
 		unsigned int m_atlasTextureID = 0;
@@ -53,6 +56,7 @@ namespace Elite
 	public:
 		//--- UI Functions ---
 		void Initialize(EliteRawWindow pWindow){};
+		void InitializeHeadless(int width, int height){};
 		void Render(){};
 		void EventProcessing(){};
 		static void StaticRender(ImDrawData* drawData){};
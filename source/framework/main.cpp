@@ -11,54 +11,183 @@
 //Hotfix for genetic algorithms project
 bool gRequestShutdown = false;
 
+//Simulation loop
+enum class LoopMode
+{
+	Variable,	//app and physics get the real frame time, physics accumulates on its own
+	Fixed,		//app and physics tick together at a fixed rate, rendering is interpolated
+	Headless	//fixed ticks as fast as possible without drawing, for reproducible load tests
+};
+const float FixedStepTime = 1.f / 60.f;
+const int MaxStepsPerFrame = 5;
+const float HeadlessFrameBudget = 0.1f; //seconds of ticking before the window gets a turn again
+
 //Main
 #undef main //Undefine SDL_main as main
 int main(int argc, char* argv[])
 {
+	//Arguments: [x y] [--fixed] [--headless nrOfSteps] [--record log | --replay log] [--physics-thread] [--job-benchmark] [--batch-benchmark] [--debug-draw-benchmark] [--fmatrix-benchmark] [--genetic-benchmark]
 	int x{}, y{};
-	bool runExeWithCoordinates{ argc == 3 };
+	LoopMode loopMode{ LoopMode::Variable };
+	bool isPhysicsOnThread{ false };
+	bool isJobBenchmark{ false };
+	bool isBatchBenchmark{ false };
+	bool isDebugDrawBenchmark{ false };
+	bool isFMatrixBenchmark{ false };
+	bool isGeneticBenchmark{ false };
+	unsigned long long nrOfHeadlessSteps{ 0 };
+	std::string recordPath{}, replayPath{};
+	std::vector<std::string> positionalArguments{};
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string argument{ argv[i] };
+		if (argument == "--fixed")
+			loopMode = LoopMode::Fixed;
+		else if (argument == "--headless" && i + 1 < argc)
+		{
+			loopMode = LoopMode::Headless;
+			try
+			{
+				nrOfHeadlessSteps = std::stoull(std::string(argv[++i]));
+			}
+			catch (const std::logic_error&)
+			{
+				std::cout << "--headless expects a number of steps, got " << argv[i] << std::endl;
+				return 1;
+			}
+		}
+		else if (argument == "--record" && i + 1 < argc)
+			recordPath = argv[++i];
+		else if (argument == "--replay" && i + 1 < argc)
+			replayPath = argv[++i];
+		else if (argument == "--physics-thread")
+			isPhysicsOnThread = true;
+		else if (argument == "--job-benchmark")
+			isJobBenchmark = true;
+		else if (argument == "--batch-benchmark")
+			isBatchBenchmark = true;
+		else if (argument == "--debug-draw-benchmark")
+			isDebugDrawBenchmark = true;
+		else if (argument == "--fmatrix-benchmark")
+			isFMatrixBenchmark = true;
+		else if (argument == "--genetic-benchmark")
+			isGeneticBenchmark = true;
+		else
+			positionalArguments.push_back(argument);
+	}
 
+	//Stress test and timings of the job system, no window needed
+	if (isJobBenchmark)
+	{
+		const bool hasPassed{ Elite::RunJobSystemBenchmark(std::cout) };
+		JOBSYSTEM->Destroy();
+		return hasPassed ? 0 : 1;
+	}
+
+	//Vector2 batch functions against the Vector2 functions
+	if (isBatchBenchmark)
+		return Elite::RunVector2BatchBenchmark(std::cout) ? 0 : 1;
+
+	//Culling and vertex generation of the debug renderer, without a window or OpenGL
+	if (isDebugDrawBenchmark)
+		return Elite::RunDebugGeometryBenchmark(std::cout) ? 0 : 1;
+
+	//Blocked and batched FMatrix kernels against the Get/Set loops, the batch runs on the job system
+	if (isFMatrixBenchmark)
+	{
+		const bool hasPassed{ Elite::RunFMatrixBenchmark(std::cout) };
+		JOBSYSTEM->Destroy();
+		return hasPassed ? 0 : 1;
+	}
+
+	//Headless training of a population in parallel worlds, checkpointing and scaling over threads
+	if (isGeneticBenchmark)
+	{
+		const bool hasPassed{ Elite::RunGeneticAlgorithmBenchmark(std::cout) };
+		JOBSYSTEM->Destroy();
+		return hasPassed ? 0 : 1;
+	}
+
+	//A replay runs the loop mode it was recorded with, without drawing
+	bool isReplaying{ false };
+	if (!replayPath.empty())
+	{
+		isReplaying = Elite::Replay::StartReplay(replayPath);
+		if (!isReplaying)
+		{
+			std::cout << "Could not load replay log " << replayPath << std::endl;
+			return 1;
+		}
+		loopMode = static_cast<LoopMode>(Elite::Replay::GetLoopMode());
+	}
+	else if (!recordPath.empty())
+		Elite::Replay::StartRecording(recordPath, static_cast<int>(loopMode));
+	srand(Elite::Replay::GetSeed());
+
+	bool runExeWithCoordinates{ positionalArguments.size() == 2 };
 	if (runExeWithCoordinates)
 	{
-		x = std::stoi(std::string(argv[1]));
-		y = std::stoi(std::string(argv[2]));
+		try
+		{
+			x = std::stoi(positionalArguments[0]);
+			y = std::stoi(positionalArguments[1]);
+		}
+		catch (const std::logic_error&)
+		{
+			std::cout << "Window position expects two numbers, got " << positionalArguments[0] << " " << positionalArguments[1] << std::endl;
+			return 1;
+		}
 	}
 
+	//Nothing is drawn in a headless run or a replay, so they don't get a window or an OpenGL context
+	const bool isDrawing{ loopMode != LoopMode::Headless && !isReplaying };
+
 	try
 	{
 		//Window Creation
 		Elite::WindowParams params;
-		EliteWindow* pWindow = new EliteWindow();
-		ELITE_ASSERT(pWindow, "Window has not been created.");
+		EliteWindow* pWindow = nullptr;
+		EliteFrame* pFrame = nullptr;
+		if (isDrawing)
+		{
+			pWindow = new EliteWindow();
+			ELITE_ASSERT(pWindow, "Window has not been created.");
 #ifdef _DEBUG
-		//Added to see the exam build config
-		params.windowTitle += " [DEBUG]";
+			//Added to see the exam build config
+			params.windowTitle += " [DEBUG]";
 #else
-		params.windowTitle += " [RELEASE]";
+			params.windowTitle += " [RELEASE]";
 #endif
 
-		pWindow->CreateEWindow(params);
+			pWindow->CreateEWindow(params);
 
-		if (runExeWithCoordinates)
-			pWindow->SetWindowPosition(x, y);
+			if (runExeWithCoordinates)
+				pWindow->SetWindowPosition(x, y);
 
-		//Create Frame (can later be extended by creating FrameManager for MultiThreaded Rendering)
-		EliteFrame* pFrame = new EliteFrame();
-		ELITE_ASSERT(pFrame, "Frame has not been created.");
-		pFrame->CreateFrame(pWindow);
+			//Create Frame (can later be extended by creating FrameManager for MultiThreaded Rendering)
+			pFrame = new EliteFrame();
+			ELITE_ASSERT(pFrame, "Frame has not been created.");
+			pFrame->CreateFrame(pWindow);
+		}
 
-		//Create a 2D Camera for debug rendering in this case
+		//Create a 2D Camera for debug rendering in this case. Apps still set it up when nothing is drawn.
 		Camera2D* pCamera = new Camera2D(params.width, params.height);
 		ELITE_ASSERT(pCamera, "Camera has not been created.");
-		DEBUGRENDERER2D->Initialize(pCamera);
+		DEBUGRENDERER2D->Initialize(pCamera, !isDrawing);
 
-		//Create Immediate UI 
+		//Create Immediate UI, apps build their UI in Update so it needs a context without a window too
 		Elite::EImmediateUI* pImmediateUI = new Elite::EImmediateUI();
 		ELITE_ASSERT(pImmediateUI, "ImmediateUI has not been created.");
-		pImmediateUI->Initialize(pWindow->GetRawWindowHandle());
+		if (isDrawing)
+			pImmediateUI->Initialize(pWindow->GetRawWindowHandle());
+		else
+			pImmediateUI->InitializeHeadless(params.width, params.height);
 
 		//Create Physics
-		PHYSICSWORLD; //Boot
+		Elite::PhysicsSettings physicsSettings{ PHYSICSWORLD->GetSettings() }; //Boot
+		physicsSettings.stepOnThread = isPhysicsOnThread;
+		physicsSettings.interpolateRendering = isDrawing;
+		PHYSICSWORLD->SetSettings(physicsSettings);
 
 		//Start Timer
 		TIMER->Start();
@@ -71,31 +200,137 @@ int main(int argc, char* argv[])
 		//Boot application
 		myApp->Start();
 
+		Elite::FixedTimestep fixedTimestep{ FixedStepTime, MaxStepsPerFrame };
+		const auto headlessStart = std::chrono::steady_clock::now();
+
 		//Application Loop
-		while (!pWindow->ShutdownRequested())
+		while (!(pWindow && pWindow->ShutdownRequested()) && !gRequestShutdown)
 		{
+			ELITE_PROFILE_BEGIN_FRAME();
+
 			//Timer
 			TIMER->Update();
-			auto const elapsed = TIMER->GetElapsed();
+			auto elapsed = TIMER->GetElapsed();
 
 			//Window procedure first, to capture all events and input received by the window
-			if (!pImmediateUI->FocussedOnUI())
-				pWindow->ProcedureEWindow();
-			else
-				pImmediateUI->EventProcessing();
+			if (pWindow)
+			{
+				if (!pImmediateUI->FocussedOnUI())
+					pWindow->ProcedureEWindow();
+				else
+					pImmediateUI->EventProcessing();
+			}
+
+			//Recorded runs get their input and timestep from the log
+			if (!Elite::Replay::BeginFrame(elapsed))
+				break;
 
 			//New frame Immediate UI (Flush)
-			pImmediateUI->NewFrame(pWindow->GetRawWindowHandle(), elapsed);
+			pImmediateUI->NewFrame(pWindow ? pWindow->GetRawWindowHandle() : nullptr, elapsed);
 
 			//Update (Physics, App)
-			PHYSICSWORLD->Simulate(elapsed);
-			pCamera->Update();
-			myApp->Update(elapsed);
+			if (loopMode == LoopMode::Variable)
+			{
+				ELITE_PROFILE_SCOPE("Update");
+				//On the physics thread, the step of last frame ran during its rendering and is finished here,
+				//before the app reads positions. This frame's step then runs while this frame renders.
+				if (PHYSICSWORLD->GetSettings().stepOnThread)
+				{
+					PHYSICSWORLD->Sync();
+					pCamera->Update();
+					myApp->Update(elapsed);
+					//The world can't be read while it steps, so it is drawn before
+					if (isDrawing)
+						PHYSICSWORLD->RenderDebug();
+					PHYSICSWORLD->SimulateAsync(elapsed);
+				}
+				else
+				{
+					PHYSICSWORLD->Simulate(elapsed);
+					pCamera->Update();
+					myApp->Update(elapsed);
+				}
+			}
+			else
+			{
+				ELITE_PROFILE_SCOPE("Update");
+				pCamera->Update();
+
+				//The app goes first, so teleports it does are already in the state physics interpolates from
+				const auto tick = [&]()
+				{
+					myApp->Update(fixedTimestep.GetStepTime());
+					PHYSICSWORLD->Step(fixedTimestep.GetStepTime());
+				};
+
+				if (loopMode == LoopMode::Fixed)
+				{
+					const int nrOfSteps{ fixedTimestep.Advance(elapsed) };
+					for (int i = 0; i < nrOfSteps; ++i)
+						tick();
+					PHYSICSWORLD->SetInterpolationAlpha(fixedTimestep.GetAlpha());
+					Elite::Replay::SetNrOfTicks(nrOfSteps);
+				}
+				else
+				{
+					//Not bound to real time, tick until the budget of this frame is used up.
+					//A replay ticks exactly as often as the recorded frame did instead.
+					const auto frameStart = std::chrono::steady_clock::now();
+					const int nrOfReplayTicks{ Elite::Replay::GetNrOfTicks() };
+					int nrOfTicks{ 0 };
+					const auto keepTicking = [&]()
+					{
+						if (isReplaying)
+							return nrOfTicks < nrOfReplayTicks;
+						return fixedTimestep.GetNrOfSteps() < nrOfHeadlessSteps
+							&& std::chrono::duration<float>(std::chrono::steady_clock::now() - frameStart).count() < HeadlessFrameBudget;
+					};
+
+					while (keepTicking())
+					{
+						fixedTimestep.Advance(fixedTimestep.GetStepTime());
+						tick();
+						++nrOfTicks;
+					}
+					Elite::Replay::SetNrOfTicks(nrOfTicks);
+
+					if (!isReplaying && fixedTimestep.GetNrOfSteps() >= nrOfHeadlessSteps)
+						gRequestShutdown = true;
+				}
+			}
+			Elite::Replay::EndFrame();
 
 			//Render and Present Frame
-			PHYSICSWORLD->RenderDebug();
-			myApp->Render(elapsed);
-			pFrame->SubmitAndFlipFrame(pImmediateUI);
+			if (isDrawing)
+			{
+				ELITE_PROFILE_SCOPE("Render");
+				if (!PHYSICSWORLD->IsStepping())
+					PHYSICSWORLD->RenderDebug();
+				myApp->Render(elapsed);
+			}
+			ELITE_PROFILE_RENDER_UI();
+			if (pFrame)
+				pFrame->SubmitAndFlipFrame(pImmediateUI);
+			else
+			{
+				//Drops what Update drew and ends the UI frame
+				DEBUGRENDERER2D->Render();
+				pImmediateUI->Render();
+			}
+			ELITE_PROFILE_END_FRAME();
+
+			//Everything allocated for this frame is gone from here on
+			Elite::FrameArena::EndFrame();
+		}
+
+		PHYSICSWORLD->Sync();
+		Elite::Replay::Finish();
+
+		if (loopMode == LoopMode::Headless && !isReplaying)
+		{
+			const float wallTime{ std::chrono::duration<float>(std::chrono::steady_clock::now() - headlessStart).count() };
+			std::cout << "Headless run: " << fixedTimestep.GetNrOfSteps() << " steps, " << fixedTimestep.GetSimulatedTime() << "s simulated in "
+				<< wallTime << "s (" << fixedTimestep.GetSimulatedTime() / wallTime << "x real time)" << std::endl;
 		}
 
 		//Reversed Deletion
@@ -107,9 +342,13 @@ int main(int argc, char* argv[])
 
 		//Shutdown All Singletons
 		PHYSICSWORLD->Destroy();
+		JOBSYSTEM->Destroy();
 		DEBUGRENDERER2D->Destroy();
 		INPUTMANAGER->Destroy();
 		TIMER->Destroy();
+#ifdef USE_PROFILER
+		Elite::Profiler::Destroy();
+#endif
 	}
 	catch (const Elite_Exception& e)
 	{
@@ -5,12 +5,13 @@
 #include "projects/Shared/Agario/AgarioFood.h"
 #include "projects/Shared/Agario/AgarioAgent.h"
 #include "projects/Shared/Agario/AgarioContactListener.h"
+#include "projects/Shared/Agario/AgarioAgentUpdate.h"
 #include "projects/Shared/NavigationColliderElement.h"
 
 using namespace Elite;
 App_AgarioGame_BT::App_AgarioGame_BT()
 {
-	srand(time(NULL));
+	srand(Elite::Replay::GetSeed());
 }
 
 App_AgarioGame_BT::~App_AgarioGame_BT()
@@ -20,12 +21,15 @@ App_AgarioGame_BT::~App_AgarioGame_BT()
 		SAFE_DELETE(f);
 	}
 	m_pFoodVec.clear();
+	m_FoodPool.Clear();
 
 	for (auto& a : m_pAgentVec)
 	{
 		SAFE_DELETE(a);
 	}
 	m_pAgentVec.clear();
+	m_AgentPool.Clear();
+	SAFE_DELETE(m_pAgentUpdate);
 
 	SAFE_DELETE(m_pContactListener);
 	SAFE_DELETE(m_pSmartAgent);
@@ -51,13 +55,14 @@ void App_AgarioGame_BT::Start()
 
 	//Creating the world contact listener that informs us of collisions
 	m_pContactListener = new AgarioContactListener();
+	m_pAgentUpdate = new AgarioAgentUpdate();
 
 	//Create food items
 	m_pFoodVec.reserve(m_AmountOfFood);
 	for (int i = 0; i < m_AmountOfFood; i++)
 	{
 		Elite::Vector2 randomPos = randomVector2(0.f, m_TrimWorldSize);
-		m_pFoodVec.push_back(new AgarioFood(randomPos));
+		m_pFoodVec.push_back(m_FoodPool.Spawn(randomPos));
 	}
 
 	//Create agents
@@ -65,7 +70,7 @@ void App_AgarioGame_BT::Start()
 	for (int i = 0; i < m_AmountOfAgents; i++)
 	{
 		Vector2 randomPos = randomVector2(0.f, m_TrimWorldSize);
-		AgarioAgent* newAgent = new AgarioAgent(randomPos);
+		AgarioAgent* newAgent = m_AgentPool.Spawn(randomPos);
 
 		//1. Create Blackboard
 		Blackboard* pBlackboard = CreateBlackboard(newAgent);
@@ -104,6 +109,7 @@ void App_AgarioGame_BT::Start()
 	//Create and add the necessary blackboard data
 	//1. Create Blackboard
 	Blackboard* pBlackboard = CreateBlackboard(m_pSmartAgent);
+	m_pSmartBlackboard = pBlackboard;
 
 	//2. Create BehaviorTree (make more conditions/actions and create a more advanced tree than the simple agents
 	BehaviorTree* pBehaviorTree
@@ -156,6 +162,9 @@ void App_AgarioGame_BT::Update(float deltaTime)
 {
 	UpdateImGui();
 
+	//Outcome of the contacts of the last physics step
+	m_pContactListener->ApplyContacts();
+
 	//Check if agent is still alive
 	if (m_pSmartAgent->CanBeDestroyed())
 	{
@@ -166,8 +175,8 @@ void App_AgarioGame_BT::Update(float deltaTime)
 	m_pSmartAgent->Update(deltaTime);
 	
 	//Update the other agents and food
-	UpdateAgarioEntities(m_pFoodVec, deltaTime);
-	UpdateAgarioEntities(m_pAgentVec, deltaTime);
+	UpdateAgarioEntities(m_pFoodVec, m_FoodPool, deltaTime);
+	UpdateAgarioEntities(m_pAgentVec, m_AgentPool, deltaTime);
 
 	
 	//Check if we need to spawn new food
@@ -175,7 +184,7 @@ void App_AgarioGame_BT::Update(float deltaTime)
 	if (m_TimeSinceLastFoodSpawn > m_FoodSpawnDelay)
 	{
 		m_TimeSinceLastFoodSpawn = 0.f;
-		m_pFoodVec.push_back(new AgarioFood(randomVector2(0.f, m_TrimWorldSize)));
+		m_pFoodVec.push_back(m_FoodPool.Spawn(randomVector2(0.f, m_TrimWorldSize)));
 	}
 }
 
@@ -230,6 +239,9 @@ void App_AgarioGame_BT::UpdateImGui()
 		//Elements
 		ImGui::Text("CONTROLS");
 		ImGui::Indent();
+		bool isParallel{ m_pAgentUpdate->IsParallel() };
+		if (ImGui::Checkbox("Parallel agents", &isParallel))
+			m_pAgentUpdate->SetParallel(isParallel);
 		ImGui::Unindent();
 
 		ImGui::Spacing();
@@ -241,6 +253,16 @@ void App_AgarioGame_BT::UpdateImGui()
 		ImGui::Indent();
 		ImGui::Text("%.3f ms/frame", 1000.0f / ImGui::GetIO().Framerate);
 		ImGui::Text("%.1f FPS", ImGui::GetIO().Framerate);
+#ifdef USE_HEAP_COUNTER
+		ImGui::Text("%llu heap allocs/frame", Elite::FrameArena::GetNrOfHeapAllocationsLastFrame());
+#endif
+		ImGui::Text("%.1f KB frame arena", Elite::FrameArena::GetBytesUsedLastFrame() / 1024.f);
+		const Elite::PhysicsStepStats& physicsStats{ PHYSICSWORLD->GetStepStats() };
+		ImGui::Text("%d bodies, %d awake", physicsStats.nrOfBodies, physicsStats.nrOfAwakeBodies);
+		ImGui::Text("%d contacts, %d touching", physicsStats.nrOfContacts, physicsStats.nrOfTouchingContacts);
+		ImGui::Text("%d new pairs/step", physicsStats.nrOfNewPairs);
+		ImGui::Text("%.2f ms/step (broadphase %.2f)", physicsStats.stepMs, physicsStats.broadphaseMs);
+		ImGui::Text("%.2f ms agents (%u threads)", m_pAgentUpdate->GetLastUpdateMs(), m_pAgentUpdate->IsParallel() ? m_pAgentUpdate->GetNrOfThreads() : 1u);
 		ImGui::Unindent();
 
 		ImGui::Spacing();
@@ -251,6 +273,15 @@ void App_AgarioGame_BT::UpdateImGui()
 		ImGui::Text("Agent Info");
 		ImGui::Text("Radius: %.1f",m_pSmartAgent->GetRadius());
 		ImGui::Text("Survive Time: %.1f", TIMER->GetTotal());
+
+		ImGui::Spacing();
+		ImGui::Separator();
+		ImGui::Spacing();
+		ImGui::Spacing();
+
+		ImGui::Text("Query Cache");
+		ImGui::Text("Hits: %u", m_pSmartBlackboard->GetQueryCacheHits());
+		ImGui::Text("Misses: %u", m_pSmartBlackboard->GetQueryCacheMisses());
 		
 		//End
 		ImGui::PopAllowKeyboardFocus();
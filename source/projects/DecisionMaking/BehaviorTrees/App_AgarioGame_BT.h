@@ -4,10 +4,12 @@
 // Includes & Forward Declarations
 //-----------------------------------------------------------------
 #include "framework/EliteInterfaces/EIApp.h"
+#include "projects/Shared/Agario/AgarioPool.h"
 
 class AgarioFood;
 class AgarioAgent;
 class AgarioContactListener;
+class AgarioAgentUpdate;
 class NavigationColliderElement;
 
 class App_AgarioGame_BT final : public IApp
@@ -23,13 +25,17 @@ private:
 	float m_TrimWorldSize = 300.0f;
 	const int m_AmountOfAgents{ 200 };
 	std::vector<AgarioAgent*> m_pAgentVec{};
+	AgarioPool<AgarioAgent> m_AgentPool{};
+	AgarioAgentUpdate* m_pAgentUpdate = nullptr;
 
 	AgarioAgent* m_pSmartAgent = nullptr;
+	Elite::Blackboard* m_pSmartBlackboard = nullptr; //Owned by the behavior tree of the smart agent
 
 	const int m_AmountOfFood{ 500 };
 	const float m_FoodSpawnDelay{ 2.f };
 	float m_TimeSinceLastFoodSpawn{ 0.f };
 	std::vector<AgarioFood*> m_pFoodVec{};
+	AgarioPool<AgarioFood> m_FoodPool{};
 
 	AgarioContactListener* m_pContactListener = nullptr;
 	bool m_GameOver = false;
@@ -38,7 +44,7 @@ private:
 	std::vector<NavigationColliderElement*> m_vNavigationColliders = {};
 private:	
 	template<class T_AgarioType>
-	void UpdateAgarioEntities(std::vector<T_AgarioType*>& entities, float deltaTime);
+	void UpdateAgarioEntities(std::vector<T_AgarioType*>& entities, AgarioPool<T_AgarioType>& pool, float deltaTime);
 
 	Elite::Blackboard* CreateBlackboard(AgarioAgent* a);
 	void UpdateImGui();
@@ -49,21 +55,27 @@ private:
 };
 
 template<class T_AgarioType>
-inline void App_AgarioGame_BT::UpdateAgarioEntities(std::vector<T_AgarioType*>& entities, float deltaTime)
+inline void App_AgarioGame_BT::UpdateAgarioEntities(std::vector<T_AgarioType*>& entities, AgarioPool<T_AgarioType>& pool, float deltaTime)
 {
-	for (auto& e : entities)
+	//Agents are updated all at once, their decision making and steering run in parallel
+	if constexpr (std::is_same_v<T_AgarioType, AgarioAgent>)
+		m_pAgentUpdate->Update(entities, deltaTime);
+
+	for (size_t i = 0; i < entities.size();)
 	{
-		e->Update(deltaTime);
+		T_AgarioType* e{ entities[i] };
+		if constexpr (!std::is_same_v<T_AgarioType, AgarioAgent>)
+			e->Update(deltaTime);
 
 		if (e->CanBeDestroyed())
-			SAFE_DELETE(e);
-	}
-
-	auto toRemoveEntityIt = std::remove_if(entities.begin(), entities.end(),
-		[](T_AgarioType* e) {return e == nullptr; });
-	if (toRemoveEntityIt != entities.end())
-	{
-		entities.erase(toRemoveEntityIt, entities.end());
+		{
+			//The order doesn't matter, the last entity takes its place and is updated next
+			pool.Release(e);
+			entities[i] = entities.back();
+			entities.pop_back();
+		}
+		else
+			++i;
 	}
 }
 #endif
\ No newline at end of file
@@ -62,76 +62,124 @@ namespace BT_Actions
 	}
 }
 
-namespace BT_Conditions
+namespace BT_Sensors
 {
-	bool IsFoodNearby(Elite::Blackboard* pBlackboard)
+	//World scans shared by the conditions, computed at most once per tick through Blackboard::Query
+
+	//Closest food within the food search radius
+	struct NearestFood
 	{
-		AgarioAgent* pAgent;
-		if (!pBlackboard->GetData("Agent", pAgent) || !pAgent)
-			return false;
+		using ValueType = AgarioFood*;
+		static constexpr Elite::BlackboardQueryId Id{ CompileTimeLiteralStringHash("BT_NearestFood") };
 
-		std::vector<AgarioFood*>* pFoodVec;
-		if (!pBlackboard->GetData("FoodVec", pFoodVec))
-			return false;
+		static ValueType Compute(Elite::Blackboard* pBlackboard)
+		{
+			AgarioAgent* pAgent;
+			if (!pBlackboard->GetData("Agent", pAgent) || !pAgent)
+				return nullptr;
 
-		const float searchRadius{ pAgent->GetRadius() + 40.0f };
+			std::vector<AgarioFood*>* pFoodVec;
+			if (!pBlackboard->GetData("FoodVec", pFoodVec))
+				return nullptr;
 
-		AgarioFood* pClosestFood{};
-		float closestDistanceSqr{ searchRadius * searchRadius };
-		Elite::Vector2 agentPos{ pAgent->GetPosition() };
+			const float searchRadius{ pAgent->GetRadius() + 40.0f };
 
-		DEBUGRENDERER2D->DrawCircle(agentPos, searchRadius, { 0.0f, 1.0f, 0.0f }, DEBUGRENDERER2D->NextDepthSlice());
+			AgarioFood* pClosestFood{};
+			float closestDistanceSqr{ searchRadius * searchRadius };
+			Elite::Vector2 agentPos{ pAgent->GetPosition() };
 
-		for (AgarioFood* pFood : *pFoodVec)
-		{
-			const float distanceSqr{ pFood->GetPosition().DistanceSquared(agentPos) };
+			DEBUGRENDERER2D->DrawCircle(agentPos, searchRadius, { 0.0f, 1.0f, 0.0f }, DEBUGRENDERER2D->NextDepthSlice());
 
-			if (distanceSqr < closestDistanceSqr)
+			for (AgarioFood* pFood : *pFoodVec)
 			{
-				closestDistanceSqr = distanceSqr;
-				pClosestFood = pFood;
-			}
-		}
+				const float distanceSqr{ pFood->GetPosition().DistanceSquared(agentPos) };
 
-		if (!pClosestFood) return false;
+				if (distanceSqr < closestDistanceSqr)
+				{
+					closestDistanceSqr = distanceSqr;
+					pClosestFood = pFood;
+				}
+			}
 
-		pBlackboard->ChangeData("Target", pClosestFood->GetPosition());
-		return true;
-	}
+			return pClosestFood;
+		}
+	};
 
-	bool IsBiggerEnemyNearby(Elite::Blackboard* pBlackboard)
+	//Closest bigger and smaller agents, found in a single pass over the agents
+	struct NearbyEnemies
 	{
-		AgarioAgent* pAgent;
-		if (!pBlackboard->GetData("Agent", pAgent) || !pAgent) return false;
+		struct Result
+		{
+			AgarioAgent* pBigger;
+			AgarioAgent* pSmaller;
+		};
+		using ValueType = Result;
+		static constexpr Elite::BlackboardQueryId Id{ CompileTimeLiteralStringHash("BT_NearbyEnemies") };
+
+		static ValueType Compute(Elite::Blackboard* pBlackboard)
+		{
+			Result result{ nullptr, nullptr };
 
-		std::vector<AgarioAgent*>* pAgentVector;
-		if (!pBlackboard->GetData("AgentsVec", pAgentVector) || !pAgentVector) return false;
+			AgarioAgent* pAgent;
+			if (!pBlackboard->GetData("Agent", pAgent) || !pAgent) return result;
 
-		const float radius{ pAgent->GetRadius() + 20.0f };
-		const Elite::Vector2 agentPos{ pAgent->GetPosition() };
+			std::vector<AgarioAgent*>* pAgentVector;
+			if (!pBlackboard->GetData("AgentsVec", pAgentVector) || !pAgentVector) return result;
 
-		DEBUGRENDERER2D->DrawCircle(agentPos, radius, { 1.0f, 0.0f, 0.0f, 1.0f }, DEBUGRENDERER2D->NextDepthSlice());
+			const float agentRadius{ pAgent->GetRadius() };
+			const float biggerRadius{ agentRadius + 20.0f };
+			const float smallerRadius{ agentRadius + 30.0f };
+			const Elite::Vector2 agentPos{ pAgent->GetPosition() };
 
-		AgarioAgent* closestBiggerEnemy{};
-		float closestEnemyDistance{ FLT_MAX };
+			DEBUGRENDERER2D->DrawCircle(agentPos, biggerRadius, { 1.0f, 0.0f, 0.0f, 1.0f }, DEBUGRENDERER2D->NextDepthSlice());
+			DEBUGRENDERER2D->DrawCircle(agentPos, smallerRadius, { 0.0f, 1.0f, 0.0f, 1.0f }, DEBUGRENDERER2D->NextDepthSlice());
 
-		for (AgarioAgent* pOtherAgent : *pAgentVector)
-		{
-			if (!pOtherAgent || pOtherAgent == pAgent) continue;
+			float closestBiggerDistance{ FLT_MAX };
+			float closestSmallerDistance{ FLT_MAX };
 
-			const float distance{ pOtherAgent->GetPosition().DistanceSquared(agentPos) };
+			for (AgarioAgent* pOtherAgent : *pAgentVector)
+			{
+				if (!pOtherAgent || pOtherAgent == pAgent) continue;
+
+				const float distance{ pOtherAgent->GetPosition().DistanceSquared(agentPos) };
+				const float otherRadius{ pOtherAgent->GetRadius() };
+				const float radiusDifference{ abs(otherRadius - agentRadius) };
+
+				if (distance <= Elite::Square(biggerRadius + otherRadius) && distance <= closestBiggerDistance
+					&& otherRadius >= agentRadius && radiusDifference >= 1.0f)
+				{
+					result.pBigger = pOtherAgent;
+					closestBiggerDistance = distance;
+				}
+
+				if (distance <= Elite::Square(smallerRadius + otherRadius) && distance <= closestSmallerDistance
+					&& radiusDifference >= 2.0f && otherRadius <= agentRadius)
+				{
+					result.pSmaller = pOtherAgent;
+					closestSmallerDistance = distance;
+				}
+			}
 
-			if (distance > Elite::Square(radius + pOtherAgent->GetRadius())) continue;
+			return result;
+		}
+	};
+}
 
-			if (distance > closestEnemyDistance) continue;
+namespace BT_Conditions
+{
+	bool IsFoodNearby(Elite::Blackboard* pBlackboard)
+	{
+		AgarioFood* pClosestFood{ pBlackboard->Query<BT_Sensors::NearestFood>() };
 
-			if (pOtherAgent->GetRadius() < pAgent->GetRadius()) continue;
+		if (!pClosestFood) return false;
 
-			if (abs(pOtherAgent->GetRadius() - pAgent->GetRadius()) < 1.0f) continue;
+		pBlackboard->ChangeData("Target", pClosestFood->GetPosition());
+		return true;
+	}
 
-			closestBiggerEnemy = pOtherAgent;
-			closestEnemyDistance = distance;
-		}
+	bool IsBiggerEnemyNearby(Elite::Blackboard* pBlackboard)
+	{
+		AgarioAgent* closestBiggerEnemy{ pBlackboard->Query<BT_Sensors::NearbyEnemies>().pBigger };
 
 		if (!closestBiggerEnemy) return false;
 
@@ -141,37 +189,7 @@ namespace BT_Conditions
 
 	bool IsSmallerEnemyNearby(Elite::Blackboard* pBlackboard)
 	{
-		AgarioAgent* pAgent;
-		if (!pBlackboard->GetData("Agent", pAgent) || !pAgent) return false;
-
-		std::vector<AgarioAgent*>* pAgentVector;
-		if (!pBlackboard->GetData("AgentsVec", pAgentVector) || !pAgentVector) return false;
-
-		const float radius{ pAgent->GetRadius() + 30.0f };
-		const Elite::Vector2 agentPos{ pAgent->GetPosition() };
-
-		DEBUGRENDERER2D->DrawCircle(agentPos, radius, { 0.0f, 1.0f, 0.0f, 1.0f }, DEBUGRENDERER2D->NextDepthSlice());
-
-		AgarioAgent* closestSmallerEnemy{};
-		float closestEnemyDistance{ FLT_MAX };
-
-		for (AgarioAgent* pOtherAgent : *pAgentVector)
-		{
-			if (!pOtherAgent || pOtherAgent == pAgent) continue;
-
-			const float distance{ pOtherAgent->GetPosition().DistanceSquared(agentPos) };
-
-			if (distance > Elite::Square(radius + pOtherAgent->GetRadius())) continue;
-
-			if (distance > closestEnemyDistance) continue;
-
-			if (abs(pOtherAgent->GetRadius() - pAgent->GetRadius()) < 2.0f) continue;
-
-			if (pOtherAgent->GetRadius() > pAgent->GetRadius()) continue;
-
-			closestSmallerEnemy = pOtherAgent;
-			closestEnemyDistance = distance;
-		}
+		AgarioAgent* closestSmallerEnemy{ pBlackboard->Query<BT_Sensors::NearbyEnemies>().pSmaller };
 
 		if (!closestSmallerEnemy) return false;
 
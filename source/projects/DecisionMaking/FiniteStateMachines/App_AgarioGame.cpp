@@ -7,12 +7,89 @@
 #include "projects/Shared/Agario/AgarioFood.h"
 #include "projects/Shared/Agario/AgarioAgent.h"
 #include "projects/Shared/Agario/AgarioContactListener.h"
+#include "projects/Shared/Agario/AgarioAgentUpdate.h"
 
 
 using namespace Elite;
 using namespace FSMStates;
 using namespace FSMConditions;
 
+// Dense ids and compile-time transition tables of the agario state machines
+namespace AgarioFSM
+{
+	//-----------------------
+	//---DEFAULT AGENT FSM---
+	//-----------------------
+	enum DefaultStates : FSMStateId { DefaultWander };
+
+	//----------------------
+	//---CUSTOM AGENT FSM---
+	//----------------------
+	enum CustomStates : FSMStateId
+	{
+		Wander,
+		SeekFood,
+		FleeFromTarget,
+		SeekToTarget,
+		FleeFromBorder,
+		FleeFromBorderAndTarget,
+		CustomStateCount
+	};
+
+	enum CustomConditions : FSMConditionId
+	{
+		FoodNearBy,
+		OtherFoodNearBy,
+		NoFoodNearBy,
+		BiggerEnemyNearBy,
+		OtherBiggerEnemyNearBy,
+		NoBiggerEnemyNearBy,
+		SmallerEnemyNearBy,
+		OtherSmallerEnemyNearBy,
+		NoSmallerEnemyNearBy,
+		BorderNearBy,
+		BorderAndBiggerEnemyNearBy,
+		NoBorderNearBy,
+		CustomConditionCount
+	};
+
+	// { startState, toState, condition }
+	// startState: active state for which the transition will be checked
+	// condition: if the Evaluate function returns true => transition will fire and move to the toState
+	// toState: end state where the agent will move to if the transition fires
+	// Transitions of the same start state are checked in the order they are listed here
+	constexpr FSMTransitionDesc CustomTransitionDescs[]
+	{
+		{ Wander, FleeFromTarget, BiggerEnemyNearBy },
+		{ Wander, SeekToTarget, SmallerEnemyNearBy },
+		{ Wander, SeekFood, FoodNearBy },
+		{ Wander, FleeFromBorder, BorderNearBy },
+
+		{ SeekFood, FleeFromTarget, BiggerEnemyNearBy },
+		{ SeekFood, SeekToTarget, SmallerEnemyNearBy },
+		{ SeekFood, SeekFood, OtherFoodNearBy },
+		{ SeekFood, Wander, NoFoodNearBy },
+
+		{ FleeFromTarget, FleeFromBorderAndTarget, BorderAndBiggerEnemyNearBy },
+		{ FleeFromTarget, FleeFromTarget, OtherBiggerEnemyNearBy },
+		{ FleeFromTarget, Wander, NoBiggerEnemyNearBy },
+
+		{ SeekToTarget, FleeFromTarget, BiggerEnemyNearBy },
+		{ SeekToTarget, SeekToTarget, OtherSmallerEnemyNearBy },
+		{ SeekToTarget, Wander, NoSmallerEnemyNearBy },
+
+		{ FleeFromBorder, FleeFromBorderAndTarget, BorderAndBiggerEnemyNearBy },
+		{ FleeFromBorder, SeekToTarget, SmallerEnemyNearBy },
+		{ FleeFromBorder, SeekFood, FoodNearBy },
+		{ FleeFromBorder, Wander, NoBorderNearBy },
+
+		{ FleeFromBorderAndTarget, FleeFromTarget, OtherBiggerEnemyNearBy },
+		{ FleeFromBorderAndTarget, FleeFromTarget, NoBorderNearBy },
+		{ FleeFromBorderAndTarget, FleeFromBorder, NoBiggerEnemyNearBy }
+	};
+	constexpr auto CustomTransitions{ MakeFSMTransitionTable<CustomStateCount, CustomConditionCount>(CustomTransitionDescs) };
+}
+
 App_AgarioGame::App_AgarioGame()
 {
 }
@@ -24,57 +101,54 @@ App_AgarioGame::~App_AgarioGame()
 		SAFE_DELETE(f);
 	}
 	m_pFoodVec.clear();
+	m_FoodPool.Clear();
 
 	for (auto& a : m_pAgentVec)
 	{
 		SAFE_DELETE(a);
 	}
 	m_pAgentVec.clear();
+	m_AgentPool.Clear();
+	SAFE_DELETE(m_pAgentUpdate);
 
 	SAFE_DELETE(m_pContactListener);
 	SAFE_DELETE(m_pCustomAgent);
-	for (auto& s : m_pStates)
-	{
-		SAFE_DELETE(s);
-	}
-
-	for (auto& t : m_pConditions)
-	{
-		SAFE_DELETE(t);
-	}
 
+	// Definitions are shared by the agents, so delete them after all agents are gone
+	SAFE_DELETE(m_pWanderDefinition);
+	SAFE_DELETE(m_pCustomDefinition);
 }
 
 void App_AgarioGame::Start()
 {
 	// New seed for the random positions
-	srand(time(NULL));
+	srand(Elite::Replay::GetSeed());
 
 	// Creating the world contact listener that informs us of collisions
 	m_pContactListener = new AgarioContactListener();
+	m_pAgentUpdate = new AgarioAgentUpdate();
 
 	// Create food items
 	m_pFoodVec.reserve(m_AmountOfFood);
 	for (int i = 0; i < m_AmountOfFood; i++)
 	{
 		Elite::Vector2 randomPos = randomVector2(0, m_TrimWorldSize);
-		m_pFoodVec.push_back(new AgarioFood(randomPos));
+		m_pFoodVec.push_back(m_FoodPool.Spawn(randomPos));
 	}
 
-	// Create common states
-	WanderState* pWanderState{ new WanderState{} };
-	m_pStates.push_back(pWanderState);
+	// Create the common definition, shared by all default agents
+	m_pWanderDefinition = new FSMDefinition{ { new WanderState{} }, {}, std::vector<FSMTransitionDesc>{} };
 
 	// Create default agents
 	m_pAgentVec.reserve(m_AmountOfAgents);
 	for (int i = 0; i < m_AmountOfAgents; i++)
 	{
 		Elite::Vector2 randomPos = randomVector2(0, m_TrimWorldSize * (2.0f / 3));
-		AgarioAgent* newAgent = new AgarioAgent(randomPos);
+		AgarioAgent* newAgent = m_AgentPool.Spawn(randomPos);
 
 		Blackboard* pBlackBoard{ CreateBlackboard(newAgent) };
 
-		FiniteStateMachine* pStateMachine{ new FiniteStateMachine{ pWanderState, pBlackBoard } };
+		FlatFiniteStateMachine* pStateMachine{ new FlatFiniteStateMachine{ m_pWanderDefinition, AgarioFSM::DefaultWander, pBlackBoard } };
 
 		newAgent->SetDecisionMaking(pStateMachine);
 
@@ -90,82 +164,41 @@ void App_AgarioGame::Start()
 
 	//1. Create and add the necessary blackboard data
 	Blackboard* pBlackBoard{ CreateBlackboard(m_pCustomAgent) };
+	m_pCustomBlackboard = pBlackBoard;
 
-	//2. Create the different agent states
-	SeekFoodState* pSeekFoodState{ new SeekFoodState{} };
-	m_pStates.push_back(pSeekFoodState);
-	FleeFromTargetState* pFleeFromTargetState{ new FleeFromTargetState{} };
-	m_pStates.push_back(pFleeFromTargetState);
-	SeekToTargetState* pSeekToTargetState{ new SeekToTargetState{} };
-	m_pStates.push_back(pSeekToTargetState);
-	FleeFromBorderState* pFleeFromBorderState{ new FleeFromBorderState{} };
-	m_pStates.push_back(pFleeFromBorderState);
-	FleeFromBorderAndTargetState* pFleeFromBorderAndTargetState{ new FleeFromBorderAndTargetState{} };
-	m_pStates.push_back(pFleeFromBorderAndTargetState);
-
-	//3. Create the conditions to transition between those states
-	FoodNearByCondition* pFoodNearBy{ new FoodNearByCondition{} };
-	m_pConditions.push_back(pFoodNearBy);
-	OtherFoodNearByCondition* pOtherFoodNearBy{ new OtherFoodNearByCondition{} };
-	m_pConditions.push_back(pOtherFoodNearBy);
-	NoFoodNearByCondition* pNoFoodNearBy{ new NoFoodNearByCondition{} };
-	m_pConditions.push_back(pNoFoodNearBy);
-
-	BiggerEnemyNearByCondition* pBiggerEnemyNearBy{ new BiggerEnemyNearByCondition{} };
-	m_pConditions.push_back(pBiggerEnemyNearBy);
-	OtherBiggerEnemyNearByCondition* pOtherBiggerEnemyNearBy{ new OtherBiggerEnemyNearByCondition{} };
-	m_pConditions.push_back(pOtherBiggerEnemyNearBy);
-	NoBiggerEnemyNearByCondition* pNoBiggerEnemyNearBy{ new NoBiggerEnemyNearByCondition{} };
-	m_pConditions.push_back(pNoBiggerEnemyNearBy);
-
-	SmallerEnemyNearByCondition* pSmallerEnemyNearBy{ new SmallerEnemyNearByCondition{} };
-	m_pConditions.push_back(pSmallerEnemyNearBy);
-	OtherSmallerEnemyNearByCondition* pOtherSmallerEnemyNearBy{ new OtherSmallerEnemyNearByCondition{} };
-	m_pConditions.push_back(pOtherSmallerEnemyNearBy);
-	NoSmallerEnemyNearByCondition* pNoSmallerEnemyNearBy{ new NoSmallerEnemyNearByCondition{} };
-	m_pConditions.push_back(pNoSmallerEnemyNearBy);
-
-	BorderNearByCondition* pBorderNearBy{ new BorderNearByCondition{} };
-	m_pConditions.push_back(pBorderNearBy);
-	BorderAndBiggerEnemyNearByCondition* pBorderAndBiggerEnemyNearBy{ new BorderAndBiggerEnemyNearByCondition{} };
-	m_pConditions.push_back(pBorderAndBiggerEnemyNearBy);
-	NoBorderNearByCondition* pNoBorderNearBy{ new NoBorderNearByCondition{} };
-	m_pConditions.push_back(pNoBorderNearBy);
-
-	//4. Create the finite state machine with a starting state and the blackboard
-	FiniteStateMachine* pStateMachine{ new FiniteStateMachine{ pWanderState, pBlackBoard } };
-	
-	//5. Add the transitions for the states to the state machine
-	// stateMachine->AddTransition(startState, toState, condition)
-	// startState: active state for which the transition will be checked
-	// condition: if the Evaluate function returns true => transition will fire and move to the toState
-	// toState: end state where the agent will move to if the transition fires
-	pStateMachine->AddTransition(pWanderState, pFleeFromTargetState, pBiggerEnemyNearBy);
-	pStateMachine->AddTransition(pWanderState, pSeekToTargetState, pSmallerEnemyNearBy);
-	pStateMachine->AddTransition(pWanderState, pSeekFoodState, pFoodNearBy);
-	pStateMachine->AddTransition(pWanderState, pFleeFromBorderState, pBorderNearBy);
-
-	pStateMachine->AddTransition(pSeekFoodState, pFleeFromTargetState, pBiggerEnemyNearBy);
-	pStateMachine->AddTransition(pSeekFoodState, pSeekToTargetState, pSmallerEnemyNearBy);
-	pStateMachine->AddTransition(pSeekFoodState, pSeekFoodState, pOtherFoodNearBy);
-	pStateMachine->AddTransition(pSeekFoodState, pWanderState, pNoFoodNearBy);
-
-	pStateMachine->AddTransition(pFleeFromTargetState, pFleeFromBorderAndTargetState, pBorderAndBiggerEnemyNearBy);
-	pStateMachine->AddTransition(pFleeFromTargetState, pFleeFromTargetState, pOtherBiggerEnemyNearBy);
-	pStateMachine->AddTransition(pFleeFromTargetState, pWanderState, pNoBiggerEnemyNearBy);
-
-	pStateMachine->AddTransition(pSeekToTargetState, pFleeFromTargetState, pBiggerEnemyNearBy);
-	pStateMachine->AddTransition(pSeekToTargetState, pSeekToTargetState, pOtherSmallerEnemyNearBy);
-	pStateMachine->AddTransition(pSeekToTargetState, pWanderState, pNoSmallerEnemyNearBy);
-
-	pStateMachine->AddTransition(pFleeFromBorderState, pFleeFromBorderAndTargetState, pBorderAndBiggerEnemyNearBy);
-	pStateMachine->AddTransition(pFleeFromBorderState, pSeekToTargetState, pSmallerEnemyNearBy);
-	pStateMachine->AddTransition(pFleeFromBorderState, pSeekFoodState, pFoodNearBy);
-	pStateMachine->AddTransition(pFleeFromBorderState, pWanderState, pNoBorderNearBy);
-
-	pStateMachine->AddTransition(pFleeFromBorderAndTargetState, pFleeFromTargetState, pOtherBiggerEnemyNearBy);
-	pStateMachine->AddTransition(pFleeFromBorderAndTargetState, pFleeFromTargetState, pNoBorderNearBy);
-	pStateMachine->AddTransition(pFleeFromBorderAndTargetState, pFleeFromBorderState, pNoBiggerEnemyNearBy);
+	//2. Create the different agent states, in the order of the CustomStates ids
+	std::vector<FSMState*> pStates
+	{
+		new WanderState{},
+		new SeekFoodState{},
+		new FleeFromTargetState{},
+		new SeekToTargetState{},
+		new FleeFromBorderState{},
+		new FleeFromBorderAndTargetState{}
+	};
+
+	//3. Create the conditions to transition between those states, in the order of the CustomConditions ids
+	std::vector<FSMCondition*> pConditions
+	{
+		new FoodNearByCondition{},
+		new OtherFoodNearByCondition{},
+		new NoFoodNearByCondition{},
+		new BiggerEnemyNearByCondition{},
+		new OtherBiggerEnemyNearByCondition{},
+		new NoBiggerEnemyNearByCondition{},
+		new SmallerEnemyNearByCondition{},
+		new OtherSmallerEnemyNearByCondition{},
+		new NoSmallerEnemyNearByCondition{},
+		new BorderNearByCondition{},
+		new BorderAndBiggerEnemyNearByCondition{},
+		new NoBorderNearByCondition{}
+	};
+
+	//4. Create the definition from the compile-time transition table (see AgarioFSM at the top of this file)
+	m_pCustomDefinition = new FSMDefinition{ pStates, pConditions, AgarioFSM::CustomTransitions };
+
+	//5. Create the finite state machine with a starting state and the blackboard
+	FlatFiniteStateMachine* pStateMachine{ new FlatFiniteStateMachine{ m_pCustomDefinition, AgarioFSM::Wander, pBlackBoard } };
 
 	//6. Activate the decision making stucture on the custom agent by calling the SetDecisionMaking function
 	m_pCustomAgent->SetDecisionMaking(pStateMachine);
@@ -176,14 +209,17 @@ void App_AgarioGame::Update(float deltaTime)
 {
 	UpdateImGui();
 
+	//Outcome of the contacts of the last physics step
+	m_pContactListener->ApplyContacts();
+
 	//Check if agent is still alive
 	if (m_pCustomAgent->CanBeDestroyed())
 	{
 		m_GameOver = true;
 
 		//Update the other agents and food
-		UpdateAgarioEntities(m_pFoodVec, deltaTime);
-		UpdateAgarioEntities(m_pAgentVec, deltaTime);
+		UpdateAgarioEntities(m_pFoodVec, m_FoodPool, deltaTime);
+		UpdateAgarioEntities(m_pAgentVec, m_AgentPool, deltaTime);
 		return;
 	}
 	//Update the custom agent
@@ -191,15 +227,15 @@ void App_AgarioGame::Update(float deltaTime)
 	m_pCustomAgent->TrimToWorld(m_TrimWorldSize, false);
 
 	//Update the other agents and food
-	UpdateAgarioEntities(m_pFoodVec, deltaTime);
-	UpdateAgarioEntities(m_pAgentVec, deltaTime);
+	UpdateAgarioEntities(m_pFoodVec, m_FoodPool, deltaTime);
+	UpdateAgarioEntities(m_pAgentVec, m_AgentPool, deltaTime);
 
 	//Check if we need to spawn new food
 	m_TimeSinceLastFoodSpawn += deltaTime;
 	if (m_TimeSinceLastFoodSpawn > m_FoodSpawnDelay)
 	{
 		m_TimeSinceLastFoodSpawn = 0.f;
-		m_pFoodVec.push_back(new AgarioFood(randomVector2(0, m_TrimWorldSize)));
+		m_pFoodVec.push_back(m_FoodPool.Spawn(randomVector2(0, m_TrimWorldSize)));
 	}
 }
 
@@ -254,6 +290,9 @@ void App_AgarioGame::UpdateImGui()
 		//Elements
 		ImGui::Text("CONTROLS");
 		ImGui::Indent();
+		bool isParallel{ m_pAgentUpdate->IsParallel() };
+		if (ImGui::Checkbox("Parallel agents", &isParallel))
+			m_pAgentUpdate->SetParallel(isParallel);
 		ImGui::Unindent();
 
 		ImGui::Spacing();
@@ -265,6 +304,16 @@ void App_AgarioGame::UpdateImGui()
 		ImGui::Indent();
 		ImGui::Text("%.3f ms/frame", 1000.0f / ImGui::GetIO().Framerate);
 		ImGui::Text("%.1f FPS", ImGui::GetIO().Framerate);
+#ifdef USE_HEAP_COUNTER
+		ImGui::Text("%llu heap allocs/frame", Elite::FrameArena::GetNrOfHeapAllocationsLastFrame());
+#endif
+		ImGui::Text("%.1f KB frame arena", Elite::FrameArena::GetBytesUsedLastFrame() / 1024.f);
+		const Elite::PhysicsStepStats& physicsStats{ PHYSICSWORLD->GetStepStats() };
+		ImGui::Text("%d bodies, %d awake", physicsStats.nrOfBodies, physicsStats.nrOfAwakeBodies);
+		ImGui::Text("%d contacts, %d touching", physicsStats.nrOfContacts, physicsStats.nrOfTouchingContacts);
+		ImGui::Text("%d new pairs/step", physicsStats.nrOfNewPairs);
+		ImGui::Text("%.2f ms/step (broadphase %.2f)", physicsStats.stepMs, physicsStats.broadphaseMs);
+		ImGui::Text("%.2f ms agents (%u threads)", m_pAgentUpdate->GetLastUpdateMs(), m_pAgentUpdate->IsParallel() ? m_pAgentUpdate->GetNrOfThreads() : 1u);
 		ImGui::Unindent();
 
 		ImGui::Spacing();
@@ -275,6 +324,15 @@ void App_AgarioGame::UpdateImGui()
 		ImGui::Text("Agent Info");
 		ImGui::Text("Radius: %.1f",m_pCustomAgent->GetRadius());
 		ImGui::Text("Survive Time: %.1f", TIMER->GetTotal());
+
+		ImGui::Spacing();
+		ImGui::Separator();
+		ImGui::Spacing();
+		ImGui::Spacing();
+
+		ImGui::Text("Query Cache");
+		ImGui::Text("Hits: %u", m_pCustomBlackboard->GetQueryCacheHits());
+		ImGui::Text("Misses: %u", m_pCustomBlackboard->GetQueryCacheMisses());
 		
 		//End
 		ImGui::PopAllowKeyboardFocus();
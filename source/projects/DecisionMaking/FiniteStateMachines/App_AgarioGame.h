@@ -4,10 +4,12 @@
 // Includes & Forward Declarations
 //-----------------------------------------------------------------
 #include "framework/EliteInterfaces/EIApp.h"
+#include "projects/Shared/Agario/AgarioPool.h"
 
 class AgarioFood;
 class AgarioAgent;
 class AgarioContactListener;
+class AgarioAgentUpdate;
 
 class App_AgarioGame final : public IApp
 {
@@ -22,23 +24,27 @@ private:
 	float m_TrimWorldSize = 100.0f;
 	const int m_AmountOfAgents{ 30 };
 	std::vector<AgarioAgent*> m_pAgentVec{};
+	AgarioPool<AgarioAgent> m_AgentPool{};
+	AgarioAgentUpdate* m_pAgentUpdate = nullptr;
 
 	AgarioAgent* m_pCustomAgent = nullptr;
+	Elite::Blackboard* m_pCustomBlackboard = nullptr; //Owned by the state machine of the custom agent
 
 	const int m_AmountOfFood{ 40 };
 	const float m_FoodSpawnDelay{ 2.f };
 	float m_TimeSinceLastFoodSpawn{ 0.f };
 	std::vector<AgarioFood*> m_pFoodVec{};
+	AgarioPool<AgarioFood> m_FoodPool{};
 
 	AgarioContactListener* m_pContactListener = nullptr;
 	bool m_GameOver = false;
 
-	std::vector<Elite::FSMState*> m_pStates{};
-	std::vector<Elite::FSMCondition*> m_pConditions{};
+	Elite::FSMDefinition* m_pWanderDefinition = nullptr;
+	Elite::FSMDefinition* m_pCustomDefinition = nullptr;
 
 private:	
 	template<class T_AgarioType>
-	void UpdateAgarioEntities(std::vector<T_AgarioType*>& entities, float deltaTime);
+	void UpdateAgarioEntities(std::vector<T_AgarioType*>& entities, AgarioPool<T_AgarioType>& pool, float deltaTime);
 
 	Elite::Blackboard* CreateBlackboard(AgarioAgent* a);
 	void UpdateImGui();
@@ -49,29 +55,32 @@ private:
 };
 
 template<class T_AgarioType>
-inline void App_AgarioGame::UpdateAgarioEntities(std::vector<T_AgarioType*>&entities, float deltaTime)
+inline void App_AgarioGame::UpdateAgarioEntities(std::vector<T_AgarioType*>& entities, AgarioPool<T_AgarioType>& pool, float deltaTime)
 {
-	for (auto& e : entities)
-	{
-		e->Update(deltaTime);
+	//Agents are updated all at once, their decision making and steering run in parallel
+	if constexpr (std::is_same_v<T_AgarioType, AgarioAgent>)
+		m_pAgentUpdate->Update(entities, deltaTime);
 
-	
-		auto agent = dynamic_cast<AgarioAgent*>(e);
-		if (agent)
+	for (size_t i = 0; i < entities.size();)
+	{
+		T_AgarioType* e{ entities[i] };
+		if constexpr (std::is_same_v<T_AgarioType, AgarioAgent>)
 		{
 			//Trim agent to world bounds
-			agent->TrimToWorld(m_TrimWorldSize, false);
+			e->TrimToWorld(m_TrimWorldSize, false);
 		}
-			
-		if (e->CanBeDestroyed())
-			SAFE_DELETE(e);
-	}
+		else
+			e->Update(deltaTime);
 
-	auto toRemoveEntityIt = std::remove_if(entities.begin(), entities.end(),
-		[](T_AgarioType* e) {return e == nullptr; });
-	if (toRemoveEntityIt != entities.end())
-	{
-		entities.erase(toRemoveEntityIt, entities.end());
+		if (e->CanBeDestroyed())
+		{
+			//The order doesn't matter, the last entity takes its place and is updated next
+			pool.Release(e);
+			entities[i] = entities.back();
+			entities.pop_back();
+		}
+		else
+			++i;
 	}
 }
 
@@ -133,149 +133,154 @@ void FSMStates::FleeFromBorderAndTargetState::Update(Elite::Blackboard* pBlackbo
 	pAgent->SetToFlee(pFleePosition);
 }
 
-bool FoodNearByCondition::Evaluate(Blackboard* pBlackboard) const
+FSMSensors::NearestFood::ValueType FSMSensors::NearestFood::Compute(Elite::Blackboard* pBlackboard)
 {
+	Result result{ nullptr, FLT_MAX };
+
 	AgarioAgent* pAgent;
-	if (!pBlackboard->GetData("Agent", pAgent) || !pAgent) return false;
+	if (!pBlackboard->GetData("Agent", pAgent) || !pAgent) return result;
 
 	std::vector<AgarioFood*>* pFoodVector;
-	if (!pBlackboard->GetData("FoodVector", pFoodVector) || !pFoodVector) return false;
+	if (!pBlackboard->GetData("FoodVector", pFoodVector) || !pFoodVector) return result;
 
-	const float radius{ pAgent->GetRadius() + FOOD_SEARCH_RADIUS };
 	const Vector2 agentPos{ pAgent->GetPosition() };
 
-	DEBUGRENDERER2D->DrawCircle(agentPos, radius, Color{ 1.0f, 0.0f, 0.0f, 1.0f }, DEBUGRENDERER2D->NextDepthSlice());
-
-	auto isCloser
-	{ 
-		[agentPos](AgarioFood* pFood1, AgarioFood* pFood2) 
-		{
-			float dist1{ pFood1->GetPosition().DistanceSquared(agentPos) };
-			float dist2{ pFood2->GetPosition().DistanceSquared(agentPos) };
-
-			return dist1 < dist2;
-		}
-	};
+	DEBUGRENDERER2D->DrawCircle(agentPos, pAgent->GetRadius() + FOOD_SEARCH_RADIUS, Color{ 1.0f, 0.0f, 0.0f, 1.0f }, DEBUGRENDERER2D->NextDepthSlice());
 
-	auto closestElementIt{ std::min_element(pFoodVector->begin(), pFoodVector->end(), isCloser) };
-
-	if (closestElementIt == pFoodVector->end()) return false;
+	for (AgarioFood* pFood : *pFoodVector)
+	{
+		const float distance{ pFood->GetPosition().DistanceSquared(agentPos) };
 
-	AgarioFood* pClosestFood{ *closestElementIt };
+		if (distance >= result.distanceSquared) continue;
 
-	if (pClosestFood->GetPosition().DistanceSquared(agentPos) > Square(radius)) return false;
+		result.pFood = pFood;
+		result.distanceSquared = distance;
+	}
 
-	pBlackboard->ChangeData("NearestFood", pClosestFood);
-	return true;
+	return result;
 }
 
-bool FSMConditions::NoFoodNearByCondition::Evaluate(Elite::Blackboard* pBlackboard) const
+FSMSensors::NearbyEnemies::ValueType FSMSensors::NearbyEnemies::Compute(Elite::Blackboard* pBlackboard)
 {
+	Result result{ nullptr, nullptr, nullptr };
+
 	AgarioAgent* pAgent;
-	if (!pBlackboard->GetData("Agent", pAgent) || !pAgent) return false;
+	if (!pBlackboard->GetData("Agent", pAgent) || !pAgent) return result;
 
-	std::vector<AgarioFood*>* pFoodVector;
-	if (!pBlackboard->GetData("FoodVector", pFoodVector) || !pFoodVector) return false;
+	std::vector<AgarioAgent*>* pAgentVector;
+	if (!pBlackboard->GetData("AgentVector", pAgentVector) || !pAgentVector) return result;
 
-	const float radius{ pAgent->GetRadius() + FOOD_SEARCH_RADIUS };
+	const float agentRadius{ pAgent->GetRadius() };
+	const float enemyRadius{ agentRadius + ENEMY_SEARCH_RADIUS };
+	const float foodRadius{ agentRadius + FOOD_SEARCH_RADIUS };
 	const Vector2 agentPos{ pAgent->GetPosition() };
 
-	DEBUGRENDERER2D->DrawCircle(agentPos, radius, Color{ 1.0f, 0.0f, 0.0f, 1.0f }, DEBUGRENDERER2D->NextDepthSlice());
+	DEBUGRENDERER2D->DrawCircle(agentPos, enemyRadius, Color{ 1.0f, 0.0f, 0.0f, 1.0f }, DEBUGRENDERER2D->NextDepthSlice());
+	DEBUGRENDERER2D->DrawCircle(agentPos, foodRadius, Color{ 1.0f, 0.0f, 0.0f, 1.0f }, DEBUGRENDERER2D->NextDepthSlice());
+
+	float closestBiggerDistance{ FLT_MAX };
+	float closestBiggerOrEqualDistance{ FLT_MAX };
+	float closestSmallerDistance{ FLT_MAX };
 
-	auto isCloser
+	for (AgarioAgent* pOtherAgent : *pAgentVector)
 	{
-		[agentPos](AgarioFood* pFood1, AgarioFood* pFood2)
+		const float distance{ pOtherAgent->GetPosition().DistanceSquared(agentPos) };
+		const float otherRadius{ pOtherAgent->GetRadius() };
+		const float radiusDifference{ abs(otherRadius - agentRadius) };
+
+		if (distance <= Square(enemyRadius + otherRadius) && otherRadius >= agentRadius)
 		{
-			float dist1{ pFood1->GetPosition().DistanceSquared(agentPos) };
-			float dist2{ pFood2->GetPosition().DistanceSquared(agentPos) };
+			if (distance <= closestBiggerOrEqualDistance)
+			{
+				result.pBiggerOrEqual = pOtherAgent;
+				closestBiggerOrEqualDistance = distance;
+			}
+
+			if (distance <= closestBiggerDistance && radiusDifference >= 1.0f)
+			{
+				result.pBigger = pOtherAgent;
+				closestBiggerDistance = distance;
+			}
+		}
 
-			return dist1 < dist2;
+		if (distance <= Square(foodRadius + otherRadius) && distance <= closestSmallerDistance
+			&& radiusDifference >= 2.0f && otherRadius <= agentRadius)
+		{
+			result.pSmaller = pOtherAgent;
+			closestSmallerDistance = distance;
 		}
-	};
+	}
 
-	auto closestElementIt{ std::min_element(pFoodVector->begin(), pFoodVector->end(), isCloser) };
+	return result;
+}
 
-	if (closestElementIt == pFoodVector->end()) return true;
+FSMSensors::NearBorder::ValueType FSMSensors::NearBorder::Compute(Elite::Blackboard* pBlackboard)
+{
+	AgarioAgent* pAgent;
+	if (!pBlackboard->GetData("Agent", pAgent) || !pAgent) return false;
 
-	AgarioFood* pClosestFood{ *closestElementIt };
+	float worldSize;
+	if (!pBlackboard->GetData("WorldSize", worldSize)) return false;
 
-	if (pClosestFood->GetPosition().DistanceSquared(agentPos) < Square(radius)) return false;
+	const float agentRadius{ pAgent->GetRadius() + ENEMY_SEARCH_RADIUS };
+	const Vector2 agentPosition{ pAgent->GetPosition() };
 
-	return true;
+	return !(agentRadius <= agentPosition.x && agentPosition.x <= worldSize - agentRadius &&
+		agentRadius <= agentPosition.y && agentPosition.y <= worldSize - agentRadius);
 }
 
-bool FSMConditions::OtherFoodNearByCondition::Evaluate(Elite::Blackboard* pBlackboard) const
+bool FoodNearByCondition::Evaluate(Blackboard* pBlackboard) const
 {
 	AgarioAgent* pAgent;
 	if (!pBlackboard->GetData("Agent", pAgent) || !pAgent) return false;
 
-	std::vector<AgarioFood*>* pFoodVector;
-	if (!pBlackboard->GetData("FoodVector", pFoodVector) || !pFoodVector) return false;
+	const FSMSensors::NearestFood::Result nearestFood{ pBlackboard->Query<FSMSensors::NearestFood>() };
 
-	const float radius{ pAgent->GetRadius() + FOOD_SEARCH_RADIUS };
-	const Vector2 agentPos{ pAgent->GetPosition() };
+	if (!nearestFood.pFood) return false;
 
-	DEBUGRENDERER2D->DrawCircle(agentPos, radius, Color{ 1.0f, 0.0f, 0.0f, 1.0f }, DEBUGRENDERER2D->NextDepthSlice());
+	if (nearestFood.distanceSquared > Square(pAgent->GetRadius() + FOOD_SEARCH_RADIUS)) return false;
 
-	auto isCloser
-	{
-		[agentPos](AgarioFood* pFood1, AgarioFood* pFood2)
-		{
-			float dist1{ pFood1->GetPosition().DistanceSquared(agentPos) };
-			float dist2{ pFood2->GetPosition().DistanceSquared(agentPos) };
-
-			return dist1 < dist2;
-		}
-	};
-
-	auto closestElementIt{ std::min_element(pFoodVector->begin(), pFoodVector->end(), isCloser) };
-
-	if (closestElementIt == pFoodVector->end()) return false;
+	pBlackboard->ChangeData("NearestFood", nearestFood.pFood);
+	return true;
+}
 
-	AgarioFood* pCurClosestFood{};
-	pBlackboard->GetData("NearestFood", pCurClosestFood);
+bool FSMConditions::NoFoodNearByCondition::Evaluate(Elite::Blackboard* pBlackboard) const
+{
+	AgarioAgent* pAgent;
+	if (!pBlackboard->GetData("Agent", pAgent) || !pAgent) return false;
 
-	AgarioFood* pClosestFood{ *closestElementIt };
+	const FSMSensors::NearestFood::Result nearestFood{ pBlackboard->Query<FSMSensors::NearestFood>() };
 
-	if (pClosestFood->GetPosition().DistanceSquared(agentPos) > Square(radius)) return false;
+	if (!nearestFood.pFood) return true;
 
-	if (pClosestFood == pCurClosestFood) return false;
+	if (nearestFood.distanceSquared < Square(pAgent->GetRadius() + FOOD_SEARCH_RADIUS)) return false;
 
-	pBlackboard->ChangeData("NearestFood", pClosestFood);
 	return true;
 }
 
-bool FSMConditions::BiggerEnemyNearByCondition::Evaluate(Elite::Blackboard* pBlackboard) const
+bool FSMConditions::OtherFoodNearByCondition::Evaluate(Elite::Blackboard* pBlackboard) const
 {
 	AgarioAgent* pAgent;
 	if (!pBlackboard->GetData("Agent", pAgent) || !pAgent) return false;
 
-	std::vector<AgarioAgent*>* pAgentVector;
-	if (!pBlackboard->GetData("AgentVector", pAgentVector) || !pAgentVector) return false;
-
-	const float radius{ pAgent->GetRadius() + ENEMY_SEARCH_RADIUS };
-	const Vector2 agentPos{ pAgent->GetPosition() };
-
-	DEBUGRENDERER2D->DrawCircle(agentPos, radius, Color{ 1.0f, 0.0f, 0.0f, 1.0f }, DEBUGRENDERER2D->NextDepthSlice());
+	const FSMSensors::NearestFood::Result nearestFood{ pBlackboard->Query<FSMSensors::NearestFood>() };
 
-	AgarioAgent* closestBiggerEnemy{};
-	float closestEnemyDistance{ FLT_MAX };
+	if (!nearestFood.pFood) return false;
 
-	for (AgarioAgent* pOtherAgent : *pAgentVector)
-	{
-		const float distance{ pOtherAgent->GetPosition().DistanceSquared(agentPos) };
-
-		if (distance > Square(radius + pOtherAgent->GetRadius())) continue;
+	AgarioFood* pCurClosestFood{};
+	pBlackboard->GetData("NearestFood", pCurClosestFood);
 
-		if (distance > closestEnemyDistance) continue;
+	if (nearestFood.distanceSquared > Square(pAgent->GetRadius() + FOOD_SEARCH_RADIUS)) return false;
 
-		if (pOtherAgent->GetRadius() < pAgent->GetRadius()) continue;
+	if (nearestFood.pFood == pCurClosestFood) return false;
 
-		if (abs(pOtherAgent->GetRadius() - pAgent->GetRadius()) < 1.0f) continue;
+	pBlackboard->ChangeData("NearestFood", nearestFood.pFood);
+	return true;
+}
 
-		closestBiggerEnemy = pOtherAgent;
-		closestEnemyDistance = distance;
-	}
+bool FSMConditions::BiggerEnemyNearByCondition::Evaluate(Elite::Blackboard* pBlackboard) const
+{
+	AgarioAgent* closestBiggerEnemy{ pBlackboard->Query<FSMSensors::NearbyEnemies>().pBigger };
 
 	if (!closestBiggerEnemy) return false;
 
@@ -285,35 +290,7 @@ bool FSMConditions::BiggerEnemyNearByCondition::Evaluate(Elite::Blackboard* pBla
 
 bool FSMConditions::OtherBiggerEnemyNearByCondition::Evaluate(Elite::Blackboard* pBlackboard) const
 {
-	AgarioAgent* pAgent;
-	if (!pBlackboard->GetData("Agent", pAgent) || !pAgent) return false;
-
-	std::vector<AgarioAgent*>* pAgentVector;
-	if (!pBlackboard->GetData("AgentVector", pAgentVector) || !pAgentVector) return false;
-
-	const float radius{ pAgent->GetRadius() + ENEMY_SEARCH_RADIUS };
-	const Vector2 agentPos{ pAgent->GetPosition() };
-
-	DEBUGRENDERER2D->DrawCircle(agentPos, radius, Color{ 1.0f, 0.0f, 0.0f, 1.0f }, DEBUGRENDERER2D->NextDepthSlice());
-
-	AgarioAgent* closestBiggerEnemy{};
-	float closestEnemyDistance{ FLT_MAX };
-
-	for (AgarioAgent* pOtherAgent : *pAgentVector)
-	{
-		const float distance{ pOtherAgent->GetPosition().DistanceSquared(agentPos) };
-
-		if (distance > Square(radius + pOtherAgent->GetRadius())) continue;
-
-		if (distance > closestEnemyDistance) continue;
-
-		if (pOtherAgent->GetRadius() < pAgent->GetRadius()) continue;
-
-		if (abs(pOtherAgent->GetRadius() - pAgent->GetRadius()) < 1.0f) continue;
-
-		closestBiggerEnemy = pOtherAgent;
-		closestEnemyDistance = distance;
-	}
+	AgarioAgent* closestBiggerEnemy{ pBlackboard->Query<FSMSensors::NearbyEnemies>().pBigger };
 
 	if (!closestBiggerEnemy) return false;
 
@@ -328,35 +305,7 @@ bool FSMConditions::OtherBiggerEnemyNearByCondition::Evaluate(Elite::Blackboard*
 
 bool FSMConditions::NoBiggerEnemyNearByCondition::Evaluate(Elite::Blackboard* pBlackboard) const
 {
-	AgarioAgent* pAgent;
-	if (!pBlackboard->GetData("Agent", pAgent) || !pAgent) return false;
-
-	std::vector<AgarioAgent*>* pAgentVector;
-	if (!pBlackboard->GetData("AgentVector", pAgentVector) || !pAgentVector) return false;
-
-	const float radius{ pAgent->GetRadius() + ENEMY_SEARCH_RADIUS };
-	const Vector2 agentPos{ pAgent->GetPosition() };
-
-	DEBUGRENDERER2D->DrawCircle(agentPos, radius, Color{ 1.0f, 0.0f, 0.0f, 1.0f }, DEBUGRENDERER2D->NextDepthSlice());
-
-	AgarioAgent* closestBiggerEnemy{};
-	float closestEnemyDistance{ FLT_MAX };
-
-	for (AgarioAgent* pOtherAgent : *pAgentVector)
-	{
-		const float distance{ pOtherAgent->GetPosition().DistanceSquared(agentPos) };
-
-		if (distance > Square(radius + pOtherAgent->GetRadius())) continue;
-
-		if (distance > closestEnemyDistance) continue;
-
-		if (pOtherAgent->GetRadius() < pAgent->GetRadius()) continue;
-
-		if (abs(pOtherAgent->GetRadius() - pAgent->GetRadius()) < 1.0f) continue;
-
-		closestBiggerEnemy = pOtherAgent;
-		closestEnemyDistance = distance;
-	}
+	AgarioAgent* closestBiggerEnemy{ pBlackboard->Query<FSMSensors::NearbyEnemies>().pBigger };
 
 	if (closestBiggerEnemy) return false;
 
@@ -366,35 +315,7 @@ bool FSMConditions::NoBiggerEnemyNearByCondition::Evaluate(Elite::Blackboard* pB
 
 bool FSMConditions::SmallerEnemyNearByCondition::Evaluate(Elite::Blackboard* pBlackboard) const
 {
-	AgarioAgent* pAgent;
-	if (!pBlackboard->GetData("Agent", pAgent) || !pAgent) return false;
-
-	std::vector<AgarioAgent*>* pAgentVector;
-	if (!pBlackboard->GetData("AgentVector", pAgentVector) || !pAgentVector) return false;
-
-	const float radius{ pAgent->GetRadius() + FOOD_SEARCH_RADIUS };
-	const Vector2 agentPos{ pAgent->GetPosition() };
-
-	DEBUGRENDERER2D->DrawCircle(agentPos, radius, Color{ 1.0f, 0.0f, 0.0f, 1.0f }, DEBUGRENDERER2D->NextDepthSlice());
-
-	AgarioAgent* closestSmallerEnemy{};
-	float closestEnemyDistance{ FLT_MAX };
-
-	for (AgarioAgent* pOtherAgent : *pAgentVector)
-	{
-		const float distance{ pOtherAgent->GetPosition().DistanceSquared(agentPos) };
-
-		if (distance > Square(radius + pOtherAgent->GetRadius())) continue;
-
-		if (distance > closestEnemyDistance) continue;
-
-		if (abs(pOtherAgent->GetRadius() - pAgent->GetRadius()) < 2.0f) continue;
-
-		if (pOtherAgent->GetRadius() > pAgent->GetRadius()) continue;
-
-		closestSmallerEnemy = pOtherAgent;
-		closestEnemyDistance = distance;
-	}
+	AgarioAgent* closestSmallerEnemy{ pBlackboard->Query<FSMSensors::NearbyEnemies>().pSmaller };
 
 	if (!closestSmallerEnemy) return false;
 
@@ -404,35 +325,7 @@ bool FSMConditions::SmallerEnemyNearByCondition::Evaluate(Elite::Blackboard* pBl
 
 bool FSMConditions::OtherSmallerEnemyNearByCondition::Evaluate(Elite::Blackboard* pBlackboard) const
 {
-	AgarioAgent* pAgent;
-	if (!pBlackboard->GetData("Agent", pAgent) || !pAgent) return false;
-
-	std::vector<AgarioAgent*>* pAgentVector;
-	if (!pBlackboard->GetData("AgentVector", pAgentVector) || !pAgentVector) return false;
-
-	const float radius{ pAgent->GetRadius() + FOOD_SEARCH_RADIUS };
-	const Vector2 agentPos{ pAgent->GetPosition() };
-
-	DEBUGRENDERER2D->DrawCircle(agentPos, radius, Color{ 1.0f, 0.0f, 0.0f, 1.0f }, DEBUGRENDERER2D->NextDepthSlice());
-
-	AgarioAgent* closestSmallerEnemy{};
-	float closestEnemyDistance{ FLT_MAX };
-
-	for (AgarioAgent* pOtherAgent : *pAgentVector)
-	{
-		const float distance{ pOtherAgent->GetPosition().DistanceSquared(agentPos) };
-
-		if (distance > Square(radius + pOtherAgent->GetRadius())) continue;
-
-		if (distance > closestEnemyDistance) continue;
-
-		if (abs(pOtherAgent->GetRadius() - pAgent->GetRadius()) < 2.0f) continue;
-
-		if (pOtherAgent->GetRadius() > pAgent->GetRadius()) continue;
-
-		closestSmallerEnemy = pOtherAgent;
-		closestEnemyDistance = distance;
-	}
+	AgarioAgent* closestSmallerEnemy{ pBlackboard->Query<FSMSensors::NearbyEnemies>().pSmaller };
 
 	if (!closestSmallerEnemy) return false;
 
@@ -447,35 +340,7 @@ bool FSMConditions::OtherSmallerEnemyNearByCondition::Evaluate(Elite::Blackboard
 
 bool FSMConditions::NoSmallerEnemyNearByCondition::Evaluate(Elite::Blackboard* pBlackboard) const
 {
-	AgarioAgent* pAgent;
-	if (!pBlackboard->GetData("Agent", pAgent) || !pAgent) return false;
-
-	std::vector<AgarioAgent*>* pAgentVector;
-	if (!pBlackboard->GetData("AgentVector", pAgentVector) || !pAgentVector) return false;
-
-	const float radius{ pAgent->GetRadius() + FOOD_SEARCH_RADIUS };
-	const Vector2 agentPos{ pAgent->GetPosition() };
-
-	DEBUGRENDERER2D->DrawCircle(agentPos, radius, Color{ 1.0f, 0.0f, 0.0f, 1.0f }, DEBUGRENDERER2D->NextDepthSlice());
-
-	AgarioAgent* closestSmallerEnemy{};
-	float closestEnemyDistance{ FLT_MAX };
-
-	for (AgarioAgent* pOtherAgent : *pAgentVector)
-	{
-		const float distance{ pOtherAgent->GetPosition().DistanceSquared(agentPos) };
-
-		if (distance > Square(radius + pOtherAgent->GetRadius())) continue;
-
-		if (distance > closestEnemyDistance) continue;
-
-		if (abs(pOtherAgent->GetRadius() - pAgent->GetRadius()) < 2.0f) continue;
-
-		if (pOtherAgent->GetRadius() > pAgent->GetRadius()) continue;
-
-		closestSmallerEnemy = pOtherAgent;
-		closestEnemyDistance = distance;
-	}
+	AgarioAgent* closestSmallerEnemy{ pBlackboard->Query<FSMSensors::NearbyEnemies>().pSmaller };
 
 	if (closestSmallerEnemy) return false;
 
@@ -485,69 +350,15 @@ bool FSMConditions::NoSmallerEnemyNearByCondition::Evaluate(Elite::Blackboard* p
 
 bool FSMConditions::BorderNearByCondition::Evaluate(Elite::Blackboard* pBlackboard) const
 {
-	AgarioAgent* pAgent;
-	if (!pBlackboard->GetData("Agent", pAgent) || !pAgent) return false;
-
-	float worldSize;
-	if (!pBlackboard->GetData("WorldSize", worldSize)) return false;
-
-	const float agentRadius{ pAgent->GetRadius() + ENEMY_SEARCH_RADIUS };
-	const Vector2 agentPosition{ pAgent->GetPosition() };
-
-	return !(agentRadius <= agentPosition.x && agentPosition.x <= worldSize - agentRadius &&
-		agentRadius <= agentPosition.y && agentPosition.y <= worldSize - agentRadius);
+	return pBlackboard->Query<FSMSensors::NearBorder>();
 }
 
 bool FSMConditions::BorderAndBiggerEnemyNearByCondition::Evaluate(Elite::Blackboard* pBlackboard) const
 {
-	AgarioAgent* pAgent;
-	if (!pBlackboard->GetData("Agent", pAgent) || !pAgent) return false;
-
-	std::vector<AgarioAgent*>* pAgentVector;
-	if (!pBlackboard->GetData("AgentVector", pAgentVector) || !pAgentVector) return false;
-
-	const float radius{ pAgent->GetRadius() + ENEMY_SEARCH_RADIUS };
-	const Vector2 agentPos{ pAgent->GetPosition() };
-
-	DEBUGRENDERER2D->DrawCircle(agentPos, radius, Color{ 1.0f, 0.0f, 0.0f, 1.0f }, DEBUGRENDERER2D->NextDepthSlice());
-
-	AgarioAgent* closestBiggerEnemy{};
-	float closestEnemyDistance{ FLT_MAX };
-
-	for (AgarioAgent* pOtherAgent : *pAgentVector)
-	{
-		const float distance{ pOtherAgent->GetPosition().DistanceSquared(agentPos) };
-
-		if (distance > Square(radius + pOtherAgent->GetRadius())) continue;
-
-		if (distance > closestEnemyDistance) continue;
-
-		if (pOtherAgent->GetRadius() < pAgent->GetRadius()) continue;
-
-		closestBiggerEnemy = pOtherAgent;
-		closestEnemyDistance = distance;
-	}
-
-	float worldSize;
-	if (!pBlackboard->GetData("WorldSize", worldSize)) return false;
-
-	const Vector2 agentPosition{ pAgent->GetPosition() };
-
-	return (!(radius <= agentPosition.x && agentPosition.x <= worldSize - radius &&
-		radius <= agentPosition.y && agentPosition.y <= worldSize - radius) && closestBiggerEnemy);
+	return pBlackboard->Query<FSMSensors::NearBorder>() && pBlackboard->Query<FSMSensors::NearbyEnemies>().pBiggerOrEqual;
 }
 
 bool FSMConditions::NoBorderNearByCondition::Evaluate(Elite::Blackboard* pBlackboard) const
 {
-	AgarioAgent* pAgent;
-	if (!pBlackboard->GetData("Agent", pAgent) || !pAgent) return false;
-
-	float worldSize;
-	if (!pBlackboard->GetData("WorldSize", worldSize)) return false;
-
-	const float agentRadius{ pAgent->GetRadius() + ENEMY_SEARCH_RADIUS };
-	const Vector2 agentPosition{ pAgent->GetPosition() };
-
-	return agentRadius <= agentPosition.x && agentPosition.x <= worldSize - agentRadius &&
-		agentRadius <= agentPosition.y && agentPosition.y <= worldSize - agentRadius;
+	return !pBlackboard->Query<FSMSensors::NearBorder>();
 }
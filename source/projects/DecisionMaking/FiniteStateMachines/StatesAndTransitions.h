@@ -11,6 +11,48 @@
 #include "projects/Movement/SteeringBehaviors/Steering/SteeringBehaviors.h"
 #include "framework/EliteAI/EliteData/EBlackboard.h"
 
+//-------------
+//---SENSORS---
+//-------------
+//World scans shared by the conditions, computed at most once per tick through Blackboard::Query
+namespace FSMSensors
+{
+	//Closest food in the world, without any range limit
+	struct NearestFood
+	{
+		struct Result
+		{
+			AgarioFood* pFood;
+			float distanceSquared;
+		};
+		using ValueType = Result;
+		static constexpr Elite::BlackboardQueryId Id{ CompileTimeLiteralStringHash("FSM_NearestFood") };
+		static ValueType Compute(Elite::Blackboard* pBlackboard);
+	};
+
+	//Closest bigger and smaller agents, found in a single pass over the agents
+	struct NearbyEnemies
+	{
+		struct Result
+		{
+			AgarioAgent* pBigger;			//Bigger by at least 1 in the enemy search radius
+			AgarioAgent* pBiggerOrEqual;	//Bigger or equal in the enemy search radius
+			AgarioAgent* pSmaller;			//Smaller by at least 2 in the food search radius
+		};
+		using ValueType = Result;
+		static constexpr Elite::BlackboardQueryId Id{ CompileTimeLiteralStringHash("FSM_NearbyEnemies") };
+		static ValueType Compute(Elite::Blackboard* pBlackboard);
+	};
+
+	//Agent within the enemy search radius of the world border
+	struct NearBorder
+	{
+		using ValueType = bool;
+		static constexpr Elite::BlackboardQueryId Id{ CompileTimeLiteralStringHash("FSM_NearBorder") };
+		static ValueType Compute(Elite::Blackboard* pBlackboard);
+	};
+}
+
 //------------
 //---STATES---
 //------------
@@ -3,8 +3,10 @@
 
 //AgarioIncludes
 #include "projects/Shared/Agario/AgarioFood.h"
+#include "projects/Shared/Agario/AgarioFoodHash.h"
 #include "projects/Shared/Agario/AgarioAgent.h"
 #include "projects/Shared/Agario/AgarioContactListener.h"
+#include "projects/Shared/Agario/AgarioAgentUpdate.h"
 
 
 using namespace Elite;
@@ -20,42 +22,39 @@ App_AgarioGame_IM::~App_AgarioGame_IM()
 		SAFE_DELETE(f);
 	}
 	m_pFoodVec.clear();
+	m_FoodPool.Clear();
+	SAFE_DELETE(m_pFoodHash);
 
 	for (auto& a : m_pAgentVec)
 	{
 		SAFE_DELETE(a);
 	}
 	m_pAgentVec.clear();
+	m_AgentPool.Clear();
+	SAFE_DELETE(m_pAgentUpdate);
 
 	SAFE_DELETE(m_pContactListener);
 	SAFE_DELETE(m_pCustomAgent);
-	for (auto& s : m_pStates)
-	{
-		SAFE_DELETE(s);
-	}
 
-	for (auto& t : m_pConditions)
-	{
-		SAFE_DELETE(t);
-	}
-
-	SAFE_DELETE(m_pInfluenceGrid);
+	SAFE_DELETE(m_pInfluenceMap);
 }
 
 void App_AgarioGame_IM::Start()
 {
 	// New seed for the random positions
-	srand(time(NULL));
+	srand(Elite::Replay::GetSeed());
 
 	// Creating the world contact listener that informs us of collisions
 	m_pContactListener = new AgarioContactListener();
+	m_pAgentUpdate = new AgarioAgentUpdate();
 
 	// Create food items
+	m_pFoodHash = new AgarioFoodHash();
 	m_pFoodVec.reserve(m_AmountOfFood);
 	for (int i = 0; i < m_AmountOfFood; i++)
 	{
 		Elite::Vector2 randomPos = randomVector2(0, m_TrimWorldSize);
-		m_pFoodVec.push_back(new AgarioFood(randomPos));
+		m_pFoodVec.push_back(m_FoodPool.Spawn(randomPos, m_UseFoodHash ? m_pFoodHash : nullptr));
 	}
 
 	// Create common states
@@ -65,7 +64,7 @@ void App_AgarioGame_IM::Start()
 	for (int i = 0; i < m_AmountOfAgents; i++)
 	{
 		Elite::Vector2 randomPos = randomVector2(0, m_TrimWorldSize * (2.0f / 3));
-		AgarioAgent* newAgent = new AgarioAgent(randomPos);
+		AgarioAgent* newAgent = m_AgentPool.Spawn(randomPos);
 
 		newAgent->SetToWander();
 
@@ -82,29 +81,39 @@ void App_AgarioGame_IM::Start()
 	//6. Activate the decision making stucture on the custom agent by calling the SetDecisionMaking function
 	m_pCustomAgent->SetRenderBehavior(true);
 
-	// Create the Influence Map
-	m_pInfluenceGrid = new InfluenceMap<InfluenceGrid>(false);
-	m_pInfluenceGrid->InitializeGrid(m_GridSize, m_GridSize, static_cast<int>(m_TrimWorldSize) / m_GridSize, false, true);
-	m_pInfluenceGrid->InitializeBuffer();
+	// Create the Influence Map, every kind of influence gets its own layer
+	m_pInfluenceMap = new LayeredInfluenceMap(m_GridSize, m_GridSize, m_TrimWorldSize / m_GridSize);
+	m_ThreatLayer = m_pInfluenceMap->AddLayer("Threat", 0.25f, 0.4f);
+	m_PreyLayer = m_pInfluenceMap->AddLayer("Prey", 0.25f, 0.4f);
+	m_FoodLayer = m_pInfluenceMap->AddLayer("Food", 0.25f, 0.6f);
+	m_SeekWeights = { { m_FoodLayer, 1.f }, { m_PreyLayer, 1.f }, { m_ThreatLayer, -1.f } };
 
 	// Set the data of the Influence Map
-	m_pInfluenceGrid->SetMomentum(0.25f);
-	m_pInfluenceGrid->SetDecay(0.4f);
-	m_pInfluenceGrid->SetPropagationInterval(0.1f);
+	m_pInfluenceMap->SetPropagationInterval(0.1f);
+	m_pInfluenceMap->SetNrOfPropagationThreads(std::thread::hardware_concurrency());
 }
 
 void App_AgarioGame_IM::Update(float deltaTime)
 {
 	UpdateImGui();
 
+	//Outcome of the contacts of the last physics step
+	m_pContactListener->ApplyContacts();
+
+	//The contact listener doesn't see the food in the hash
+	if (m_UseFoodHash)
+	{
+		m_pFoodHash->EatFood(m_pAgentVec, m_pCustomAgent);
+	}
+
 	//Check if agent is still alive
 	if (m_pCustomAgent->CanBeDestroyed())
 	{
 		m_GameOver = true;
 
 		//Update the other agents and food
-		UpdateAgarioEntities(m_pFoodVec, deltaTime);
-		UpdateAgarioEntities(m_pAgentVec, deltaTime);
+		UpdateAgarioEntities(m_pFoodVec, m_FoodPool, deltaTime);
+		UpdateAgarioEntities(m_pAgentVec, m_AgentPool, deltaTime);
 		return;
 	}
 	//Update the custom agent
@@ -112,84 +121,69 @@ void App_AgarioGame_IM::Update(float deltaTime)
 	m_pCustomAgent->TrimToWorld(m_TrimWorldSize, false);
 
 	//Update the other agents and food
-	UpdateAgarioEntities(m_pFoodVec, deltaTime);
-	UpdateAgarioEntities(m_pAgentVec, deltaTime);
+	UpdateAgarioEntities(m_pFoodVec, m_FoodPool, deltaTime);
+	UpdateAgarioEntities(m_pAgentVec, m_AgentPool, deltaTime);
 
 	//Check if we need to spawn new food
 	m_TimeSinceLastFoodSpawn += deltaTime;
 	if (m_TimeSinceLastFoodSpawn > m_FoodSpawnDelay)
 	{
 		m_TimeSinceLastFoodSpawn = 0.f;
-		m_pFoodVec.push_back(new AgarioFood(randomVector2(0, m_TrimWorldSize)));
+		m_pFoodVec.push_back(m_FoodPool.Spawn(randomVector2(0, m_TrimWorldSize), m_UseFoodHash ? m_pFoodHash : nullptr));
 	}
 
 	// Update the enemy positions on the influence grid
 	const float gridTileSize{ m_TrimWorldSize / m_GridSize };
 	const float minRadiusDelta{ 1 };
+	m_ThreatSources.clear();
+	m_PreySources.clear();
 	for (AgarioAgent* pAgent : m_pAgentVec)
 	{
 		if (pAgent == m_pCustomAgent) continue;
 
-		const Vector2 curPos{ pAgent->GetPosition() };
 		const float curRadius{ pAgent->GetRadius() };
-
 		const float radiusDifference{ m_pCustomAgent->GetRadius() - curRadius };
 		if (abs(radiusDifference) <= minRadiusDelta) continue;
-		const float enemyInfluence{ radiusDifference > minRadiusDelta ? 100.0f : -100.0f };
 
-		for (int x{ static_cast<int>((curPos.x - curRadius) / gridTileSize) }; x < static_cast<int>(std::ceil((curPos.x + curRadius) / gridTileSize)); ++x)
-		{
-			for (int y{ static_cast<int>((curPos.y - curRadius) / gridTileSize) }; y < static_cast<int>(std::ceil((curPos.y + curRadius) / gridTileSize)); ++y)
-			{
-				const Vector2 testPos{ static_cast<float>(x * gridTileSize),  static_cast<float>(y * gridTileSize) };
-				if ((testPos - curPos).MagnitudeSquared() <= (curRadius + gridTileSize * 1.5f) * (curRadius + gridTileSize * 1.5f))
-				{
-					m_pInfluenceGrid->SetInfluenceAtPosition(testPos, enemyInfluence);
-				}
-			}
-		}
+		const InfluenceSource source{ pAgent->GetPosition(), curRadius + gridTileSize * 1.5f, 100.0f, InfluenceFalloff::Constant };
+		if (radiusDifference > minRadiusDelta)
+			m_PreySources.push_back(source);
+		else
+			m_ThreatSources.push_back(source);
 	}
+	m_pInfluenceMap->StampInfluence(m_ThreatLayer, m_ThreatSources);
+	m_pInfluenceMap->StampInfluence(m_PreyLayer, m_PreySources);
 
 	// Update the food positions on the influence grid
+	m_FoodSources.clear();
 	for (AgarioFood* pFood : m_pFoodVec)
 	{
-		m_pInfluenceGrid->SetInfluenceAtPosition(pFood->GetPosition(), 75);
+		m_FoodSources.push_back({ pFood->GetPosition(), 0.0f, 75.0f, InfluenceFalloff::Constant });
 	}
+	m_pInfluenceMap->StampInfluence(m_FoodLayer, m_FoodSources);
 
 	// Propagate influence on the grid
-	m_pInfluenceGrid->PropagateInfluence(deltaTime);
+	m_pInfluenceMap->PropagateInfluence(deltaTime);
 
 	// Set the target of the player
 	const Vector2 playerPos{ m_pCustomAgent->GetPosition() };
 	const float playerRadius{ m_pCustomAgent->GetRadius() };
 	const float foodTestRadius{ gridTileSize * 5 };
 	const float enemyTestRadius{ gridTileSize * 2 };
-	Vector2 seekTarget{};
+	const float fleeThreshold{ 40.0f };
+
+	// Seek the best mix of food and prey without threats, slightly preferring closer cells
+	Vector2 seekTarget{ playerPos };
+	float seekInfluence{};
+	m_pInfluenceMap->FindBestCellInRadius(playerPos, playerRadius + foodTestRadius, m_SeekWeights, seekTarget, seekInfluence, 0.5f);
+
+	// Flee from the highest threat close to the player
 	Vector2 fleeTarget{};
-	float maxInfluence{ -1000 };
-	float minInfluence{ 1000 };
-	const float fleeThreshold{ -40.0f };
-	const float worldSizeSqr{ m_TrimWorldSize * m_TrimWorldSize };
-	for (int x{ max(static_cast<int>((playerPos.x - playerRadius - foodTestRadius) / gridTileSize), 0) }; x < min(static_cast<int>(std::ceil((playerPos.x + playerRadius + foodTestRadius) / gridTileSize)), m_GridSize - 1); ++x)
-	{
-		for (int y{ max(static_cast<int>((playerPos.y - playerRadius - foodTestRadius) / gridTileSize), 0) }; y < min(static_cast<int>(std::ceil((playerPos.y + playerRadius + foodTestRadius) / gridTileSize)), m_GridSize - 1); ++y)
-		{
-			const Vector2 testPos{ static_cast<float>(x * gridTileSize) + gridTileSize / 2.0f,  static_cast<float>(y * gridTileSize) + gridTileSize / 2.0f };
-			const float distance{ testPos.DistanceSquared(playerPos) };
-			float testInfluence{ m_pInfluenceGrid->GetNodeAtWorldPos(testPos)->GetInfluence() };
-			if (testInfluence * (worldSizeSqr - distance) > maxInfluence)
-			{
-				maxInfluence = testInfluence * (worldSizeSqr - distance);
-				seekTarget = testPos;
-			}
-			if (distance < (enemyTestRadius + playerRadius) * (enemyTestRadius + playerRadius) && testInfluence < minInfluence)
-			{
-				minInfluence = testInfluence;
-				fleeTarget = testPos;
-			}
-		}
-	}
-	if (minInfluence >= fleeThreshold)
+	float threatInfluence{};
+	const bool isThreatened{ m_pInfluenceMap->FindBestCellInRadius(playerPos, playerRadius + enemyTestRadius, { { m_ThreatLayer, 1.f } }, fleeTarget, threatInfluence)
+		&& threatInfluence > fleeThreshold };
+
+	if (!isThreatened)
 	{
 		m_pCustomAgent->SetToSeek(seekTarget);
 		DEBUGRENDERER2D->DrawCircle(seekTarget, 2.0f, Color{ 1.0f, 0.0f, 0.0f }, DEBUGRENDERER2D->NextDepthSlice());
@@ -200,31 +194,16 @@ void App_AgarioGame_IM::Update(float deltaTime)
 		DEBUGRENDERER2D->DrawCircle(fleeTarget, 2.0f, Color{ 0.0f, 0.0f, 1.0f }, DEBUGRENDERER2D->NextDepthSlice());
 	}
 
-	std::vector<Vector2> foodRadius
-	{
-			Vector2{ (playerPos.x - playerRadius - foodTestRadius),(playerPos.y - playerRadius - foodTestRadius) },
-			Vector2{ (playerPos.x - playerRadius - foodTestRadius),(playerPos.y + playerRadius + foodTestRadius) },
-			Vector2{ (playerPos.x + playerRadius + foodTestRadius),(playerPos.y + playerRadius + foodTestRadius) },
-			Vector2{ (playerPos.x + playerRadius + foodTestRadius),(playerPos.y - playerRadius - foodTestRadius) }
-	};
-	DEBUGRENDERER2D->DrawPolygon(foodRadius.data(), 4, Color{0.0f, 1.0f, 0.0f}, DEBUGRENDERER2D->NextDepthSlice());
-
-	std::vector<Vector2> enemyRadius
-	{
-			Vector2{ (playerPos.x - playerRadius - enemyTestRadius),(playerPos.y - playerRadius - enemyTestRadius) },
-			Vector2{ (playerPos.x - playerRadius - enemyTestRadius),(playerPos.y + playerRadius + enemyTestRadius) },
-			Vector2{ (playerPos.x + playerRadius + enemyTestRadius),(playerPos.y + playerRadius + enemyTestRadius) },
-			Vector2{ (playerPos.x + playerRadius + enemyTestRadius),(playerPos.y - playerRadius - enemyTestRadius) }
-	};
-	DEBUGRENDERER2D->DrawPolygon(enemyRadius.data(), 4, Color{ 0.0f, 1.0f, 0.0f }, DEBUGRENDERER2D->NextDepthSlice());
+	// The queries search in circles around the player
+	DEBUGRENDERER2D->DrawCircle(playerPos, playerRadius + foodTestRadius, Color{ 0.0f, 1.0f, 0.0f }, DEBUGRENDERER2D->NextDepthSlice());
+	DEBUGRENDERER2D->DrawCircle(playerPos, playerRadius + enemyTestRadius, Color{ 0.0f, 1.0f, 0.0f }, DEBUGRENDERER2D->NextDepthSlice());
 }
 
 void App_AgarioGame_IM::Render(float deltaTime) const
 {
 	RenderWorldBounds(m_TrimWorldSize);
 
-	m_pInfluenceGrid->SetNodeColorsBasedOnInfluence();
-	m_GraphRenderer.RenderGraph(m_pInfluenceGrid, true, false, false, true);
+	m_pInfluenceMap->Render(m_SeekWeights, 100.f);
 
 	for (AgarioFood* f : m_pFoodVec)
 	{
@@ -273,6 +252,20 @@ void App_AgarioGame_IM::UpdateImGui()
 		//Elements
 		ImGui::Text("CONTROLS");
 		ImGui::Indent();
+		bool isParallel{ m_pAgentUpdate->IsParallel() };
+		if (ImGui::Checkbox("Parallel agents", &isParallel))
+			m_pAgentUpdate->SetParallel(isParallel);
+		bool useFoodHash{ m_UseFoodHash };
+		if (ImGui::Checkbox("Food in hash", &useFoodHash))
+			SetUsingFoodHash(useFoodHash);
+		if (ImGui::Button("Benchmark food"))
+			RunFoodBenchmark();
+		for (const FoodBenchmarkResult& result : m_FoodBenchmarkResults)
+		{
+			ImGui::Text("%d food:", result.nrOfFood);
+			ImGui::Text("  Box2D %.2f ms", result.box2DMsPerFrame);
+			ImGui::Text("  hash %.2f ms", result.hashMsPerFrame);
+		}
 		ImGui::Unindent();
 
 		ImGui::Spacing();
@@ -284,6 +277,17 @@ void App_AgarioGame_IM::UpdateImGui()
 		ImGui::Indent();
 		ImGui::Text("%.3f ms/frame", 1000.0f / ImGui::GetIO().Framerate);
 		ImGui::Text("%.1f FPS", ImGui::GetIO().Framerate);
+#ifdef USE_HEAP_COUNTER
+		ImGui::Text("%llu heap allocs/frame", Elite::FrameArena::GetNrOfHeapAllocationsLastFrame());
+#endif
+		ImGui::Text("%.1f KB frame arena", Elite::FrameArena::GetBytesUsedLastFrame() / 1024.f);
+		const Elite::PhysicsStepStats& physicsStats{ PHYSICSWORLD->GetStepStats() };
+		ImGui::Text("%d bodies, %d awake", physicsStats.nrOfBodies, physicsStats.nrOfAwakeBodies);
+		ImGui::Text("%d contacts, %d touching", physicsStats.nrOfContacts, physicsStats.nrOfTouchingContacts);
+		ImGui::Text("%d new pairs/step", physicsStats.nrOfNewPairs);
+		ImGui::Text("%.2f ms/step (broadphase %.2f)", physicsStats.stepMs, physicsStats.broadphaseMs);
+		ImGui::Text("%.2f ms agents (%u threads)", m_pAgentUpdate->GetLastUpdateMs(), m_pAgentUpdate->IsParallel() ? m_pAgentUpdate->GetNrOfThreads() : 1u);
+		ImGui::Text("Tiles: %d/%d", m_pInfluenceMap->GetNrOfPropagatedTiles(), m_pInfluenceMap->GetNrOfTiles());
 		ImGui::Unindent();
 
 		ImGui::Spacing();
@@ -319,3 +323,78 @@ void App_AgarioGame_IM::UpdateImGui()
 #endif
 
 }
+
+void App_AgarioGame_IM::SetUsingFoodHash(bool useFoodHash)
+{
+	//Same food objects, the blackboards keep pointing to them
+	m_UseFoodHash = useFoodHash;
+	for (AgarioFood* pFood : m_pFoodVec)
+		pFood->SetFoodHash(m_UseFoodHash ? m_pFoodHash : nullptr);
+}
+
+void App_AgarioGame_IM::RunFoodBenchmark()
+{
+	//Runs far away from the game, so the benchmark agents never touch it.
+	//The game's bodies are stepped along, they are in both measurements.
+	const Elite::Vector2 origin{ -10.f * m_TrimWorldSize, -10.f * m_TrimWorldSize };
+	const int nrOfAgents{ 30 };
+	const int nrOfFrames{ 60 };
+	const float frameTime{ 1.f / 60.f };
+	const int foodCounts[]{ 1000, 5000, 20000, 50000 };
+
+	m_FoodBenchmarkResults.clear();
+	for (const int nrOfFood : foodCounts)
+	{
+		//Same density of food as the game
+		const float worldSize{ m_TrimWorldSize * sqrtf(static_cast<float>(nrOfFood) / m_AmountOfFood) };
+
+		FoodBenchmarkResult result{ nrOfFood };
+		for (const bool useFoodHash : { false, true })
+		{
+			AgarioFoodHash foodHash{};
+			std::vector<AgarioFood*> pFoodVec{};
+			pFoodVec.reserve(nrOfFood);
+			for (int i = 0; i < nrOfFood; ++i)
+				pFoodVec.push_back(new AgarioFood(origin + randomVector2(0, worldSize), useFoodHash ? &foodHash : nullptr));
+
+			std::vector<AgarioAgent*> pAgentVec{};
+			for (int i = 0; i < nrOfAgents; ++i)
+			{
+				pAgentVec.push_back(new AgarioAgent(origin + randomVector2(0, worldSize)));
+				pAgentVec.back()->SetToWander();
+			}
+
+			const auto start = std::chrono::high_resolution_clock::now();
+			for (int frame = 0; frame < nrOfFrames; ++frame)
+			{
+				for (AgarioAgent* pAgent : pAgentVec)
+					pAgent->Update(frameTime);
+
+				if (useFoodHash)
+					foodHash.EatFood(pAgentVec);
+				PHYSICSWORLD->Step(frameTime);
+				m_pContactListener->ApplyContacts();
+
+				for (AgarioFood*& pFood : pFoodVec)
+				{
+					if (pFood->CanBeDestroyed())
+						SAFE_DELETE(pFood);
+				}
+				pFoodVec.erase(std::remove(pFoodVec.begin(), pFoodVec.end(), nullptr), pFoodVec.end());
+			}
+			const auto end = std::chrono::high_resolution_clock::now();
+
+			const float msPerFrame{ std::chrono::duration<float, std::milli>(end - start).count() / nrOfFrames };
+			if (useFoodHash)
+				result.hashMsPerFrame = msPerFrame;
+			else
+				result.box2DMsPerFrame = msPerFrame;
+
+			for (AgarioFood* pFood : pFoodVec)
+				SAFE_DELETE(pFood);
+			for (AgarioAgent* pAgent : pAgentVec)
+				SAFE_DELETE(pAgent);
+		}
+		m_FoodBenchmarkResults.push_back(result);
+	}
+}
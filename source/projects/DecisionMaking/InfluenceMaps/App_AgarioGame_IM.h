@@ -4,13 +4,14 @@
 // Includes & Forward Declarations
 //-----------------------------------------------------------------
 #include "framework/EliteInterfaces/EIApp.h"
-#include "framework\EliteAI\EliteGraphs\EInfluenceMap.h"
-#include "framework/EliteAI/EliteGraphs/EGridGraph.h"
-#include "framework\EliteAI\EliteGraphs\EliteGraphUtilities\EGraphRenderer.h"
+#include "projects/Shared/Agario/AgarioPool.h"
+#include "framework/EliteAI/EliteGraphs/ELayeredInfluenceMap.h"
 
 class AgarioFood;
+class AgarioFoodHash;
 class AgarioAgent;
 class AgarioContactListener;
+class AgarioAgentUpdate;
 
 class App_AgarioGame_IM final : public IApp
 {
@@ -21,13 +22,13 @@ public:
 	void Start() override;
 	void Update(float deltaTime) override;
 	void Render(float deltaTime) const override;
-
-	using InfluenceGrid = Elite::GridGraph<Elite::InfluenceNode, Elite::GraphConnection>;
 private:
 	float m_TrimWorldSize = 1000.0f;
 	int m_GridSize = 250;
 	const int m_AmountOfAgents{ 100 };
 	std::vector<AgarioAgent*> m_pAgentVec{};
+	AgarioPool<AgarioAgent> m_AgentPool{};
+	AgarioAgentUpdate* m_pAgentUpdate = nullptr;
 
 	AgarioAgent* m_pCustomAgent = nullptr;
 
@@ -35,52 +36,74 @@ private:
 	const float m_FoodSpawnDelay{ 2.f };
 	float m_TimeSinceLastFoodSpawn{ 0.f };
 	std::vector<AgarioFood*> m_pFoodVec{};
+	AgarioPool<AgarioFood> m_FoodPool{};
+
+	//Food outside of Box2D, agents eat it in one overlap pass per frame
+	AgarioFoodHash* m_pFoodHash = nullptr;
+	bool m_UseFoodHash = true;
+
+	//Food benchmark: ms per frame of 30 wandering agents for an increasing amount of pellets
+	struct FoodBenchmarkResult
+	{
+		int nrOfFood;
+		float box2DMsPerFrame;
+		float hashMsPerFrame;
+	};
+	std::vector<FoodBenchmarkResult> m_FoodBenchmarkResults{};
 
 	AgarioContactListener* m_pContactListener = nullptr;
 	bool m_GameOver = false;
 
-	std::vector<Elite::FSMState*> m_pStates{};
-	std::vector<Elite::FSMCondition*> m_pConditions{};
-
 private:	
 	template<class T_AgarioType>
-	void UpdateAgarioEntities(std::vector<T_AgarioType*>& entities, float deltaTime);
+	void UpdateAgarioEntities(std::vector<T_AgarioType*>& entities, AgarioPool<T_AgarioType>& pool, float deltaTime);
 
 	Elite::Blackboard* CreateBlackboard(AgarioAgent* a);
 	void UpdateImGui();
+	void SetUsingFoodHash(bool useFoodHash);
+	void RunFoodBenchmark();
 private:
 	//C++ make the class non-copyable
-	Elite::InfluenceMap<InfluenceGrid>* m_pInfluenceGrid = nullptr;
-	Elite::GraphRenderer m_GraphRenderer{};
+	Elite::LayeredInfluenceMap* m_pInfluenceMap = nullptr;
+	int m_ThreatLayer{};
+	int m_PreyLayer{};
+	int m_FoodLayer{};
+	std::vector<Elite::InfluenceLayerWeight> m_SeekWeights{};
+	std::vector<Elite::InfluenceSource> m_ThreatSources{};
+	std::vector<Elite::InfluenceSource> m_PreySources{};
+	std::vector<Elite::InfluenceSource> m_FoodSources{};
 
 	App_AgarioGame_IM(const App_AgarioGame_IM&) {};
 	App_AgarioGame_IM& operator=(const App_AgarioGame_IM&) {};
 };
 
 template<class T_AgarioType>
-inline void App_AgarioGame_IM::UpdateAgarioEntities(std::vector<T_AgarioType*>&entities, float deltaTime)
+inline void App_AgarioGame_IM::UpdateAgarioEntities(std::vector<T_AgarioType*>& entities, AgarioPool<T_AgarioType>& pool, float deltaTime)
 {
-	for (auto& e : entities)
-	{
-		e->Update(deltaTime);
+	//Agents are updated all at once, their decision making and steering run in parallel
+	if constexpr (std::is_same_v<T_AgarioType, AgarioAgent>)
+		m_pAgentUpdate->Update(entities, deltaTime);
 
-	
-		auto agent = dynamic_cast<AgarioAgent*>(e);
-		if (agent)
+	for (size_t i = 0; i < entities.size();)
+	{
+		T_AgarioType* e{ entities[i] };
+		if constexpr (std::is_same_v<T_AgarioType, AgarioAgent>)
 		{
 			//Trim agent to world bounds
-			agent->TrimToWorld(m_TrimWorldSize, false);
+			e->TrimToWorld(m_TrimWorldSize, false);
 		}
-			
-		if (e->CanBeDestroyed())
-			SAFE_DELETE(e);
-	}
+		else
+			e->Update(deltaTime);
 
-	auto toRemoveEntityIt = std::remove_if(entities.begin(), entities.end(),
-		[](T_AgarioType* e) {return e == nullptr; });
-	if (toRemoveEntityIt != entities.end())
-	{
-		entities.erase(toRemoveEntityIt, entities.end());
+		if (e->CanBeDestroyed())
+		{
+			//The order doesn't matter, the last entity takes its place and is updated next
+			pool.Release(e);
+			entities[i] = entities.back();
+			entities.pop_back();
+		}
+		else
+			++i;
 	}
 }
 
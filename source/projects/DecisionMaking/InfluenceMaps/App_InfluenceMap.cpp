@@ -110,16 +110,31 @@ void App_InfluenceMap::UpdateUI()
 	auto momentum = m_pInfluenceGrid->GetMomentum();
 	auto decay = m_pInfluenceGrid->GetDecay();
 	auto propagationInterval = m_pInfluenceGrid->GetPropagationInterval();
+	auto useGridKernel = m_pInfluenceGrid->GetUseGridKernel();
+	auto nrOfThreads = static_cast<int>(m_pInfluenceGrid->GetNrOfPropagationThreads());
 
 	ImGui::SliderFloat("Momentum", &momentum, 0.0f, 1.f, "%.2");
 	ImGui::SliderFloat("Decay", &decay, 0.f, 1.f, "%.2");
 	ImGui::SliderFloat("Propagation Interval", &propagationInterval, 0.f, 2.f, "%.2");
+	ImGui::Checkbox("Use grid kernel", &useGridKernel);
+	ImGui::SliderInt("Threads", &nrOfThreads, 1, static_cast<int>(JOBSYSTEM->GetNrOfThreads()));
+	ImGui::Spacing();
+
+	if (ImGui::Button("Benchmark propagation"))
+		RunPropagationBenchmark();
+	for (const PropagationBenchmarkResult& result : m_PropagationBenchmarkResults)
+	{
+		ImGui::Text("%u threads: %.2f ms (x%.1f)", result.nrOfThreads, result.msPerStep,
+			m_PropagationBenchmarkResults[0].msPerStep / result.msPerStep);
+	}
 	ImGui::Spacing();
 
 	//Set data
 	m_pInfluenceGrid->SetMomentum(momentum);
 	m_pInfluenceGrid->SetDecay(decay);
 	m_pInfluenceGrid->SetPropagationInterval(propagationInterval);
+	m_pInfluenceGrid->SetUseGridKernel(useGridKernel);
+	m_pInfluenceGrid->SetNrOfPropagationThreads(static_cast<unsigned int>(nrOfThreads));
 
 	m_pInfluenceGraph2D->SetMomentum(momentum);
 	m_pInfluenceGraph2D->SetDecay(decay);
@@ -160,3 +175,46 @@ void App_InfluenceMap::AddInfluenceOnMouseClick(Elite::InputMouseButton mouseBtn
 	else
 		m_pInfluenceGrid->SetInfluenceAtPosition(mousePos, inf);
 }
+
+void App_InfluenceMap::RunPropagationBenchmark()
+{
+	//Runs the grid kernel on a flat 1024x1024 grid, a graph with that many nodes would mostly measure the connection allocations
+	const int gridSize{ 1024 };
+	const int nrOfSteps{ 20 };
+
+	InfluenceGridStencil stencil{};
+	stencil.columns = gridSize;
+	stencil.rows = gridSize;
+	stencil.isConnectedDiagonally = true;
+	stencil.straightFactor = expf(-1.f * m_pInfluenceGrid->GetDecay());
+	stencil.diagonalFactor = expf(-1.5f * m_pInfluenceGrid->GetDecay());
+	stencil.momentum = m_pInfluenceGrid->GetMomentum();
+
+	std::vector<float> source(gridSize * gridSize);
+	std::vector<float> destination(gridSize * gridSize);
+
+	m_PropagationBenchmarkResults.clear();
+	const unsigned int maxNrOfThreads{ JOBSYSTEM->GetNrOfThreads() };
+	for (unsigned int nrOfThreads = 1; ; nrOfThreads = std::min(nrOfThreads * 2, maxNrOfThreads))
+	{
+		for (float& influence : source)
+			influence = randomFloat(-100.f, 100.f);
+
+		const auto start = std::chrono::high_resolution_clock::now();
+		for (int step = 0; step < nrOfSteps; ++step)
+		{
+			JOBSYSTEM->ParallelForRanges(gridSize, static_cast<int>(nrOfThreads), [&](int rowBegin, int rowEnd)
+				{
+					PropagateInfluenceGridRows(stencil, source.data(), destination.data(), rowBegin, rowEnd);
+				});
+			source.swap(destination);
+		}
+		const auto end = std::chrono::high_resolution_clock::now();
+
+		const float totalMs{ std::chrono::duration<float, std::milli>(end - start).count() };
+		m_PropagationBenchmarkResults.push_back({ nrOfThreads, totalMs / nrOfSteps });
+
+		if (nrOfThreads == maxNrOfThreads)
+			break;
+	}
+}
@@ -49,7 +49,16 @@ private:
 	bool m_EditGraphEnabled = false;
 	bool m_RenderAsGraph = false;
 
+	//Propagation benchmark: ms per step of a 1024x1024 grid for an increasing amount of threads
+	struct PropagationBenchmarkResult
+	{
+		unsigned int nrOfThreads;
+		float msPerStep;
+	};
+	std::vector<PropagationBenchmarkResult> m_PropagationBenchmarkResults{};
+
 	void AddInfluenceOnMouseClick(Elite::InputMouseButton mouseBtn, float inf);
+	void RunPropagationBenchmark();
 private:
 	//C++ make the class non-copyable
 	App_InfluenceMap(const App_InfluenceMap&) = delete;
@@ -188,6 +188,20 @@ void App_PathfindingAStar::UpdateImGui()
 		}
 		ImGui::Spacing();
 
+		/*Spacing*/ImGui::Spacing(); ImGui::Separator(); ImGui::Spacing(); ImGui::Spacing();
+		ImGui::Checkbox("Implicit connections", &m_BenchmarkImplicitGrid);
+		if (ImGui::Button("Benchmark grid graph"))
+			RunGraphBenchmark();
+		if (m_GraphBenchmarkResult.initializeMs > 0.f)
+		{
+			ImGui::Text("%dx%d, %d connections", GraphBenchmarkSize, GraphBenchmarkSize, m_GraphBenchmarkResult.nrOfConnections);
+			ImGui::Text("Initialize: %.1f ms", m_GraphBenchmarkResult.initializeMs);
+			ImGui::Text("Clone: %.1f ms", m_GraphBenchmarkResult.cloneMs);
+			ImGui::Text("Destroy: %.1f ms", m_GraphBenchmarkResult.destroyMs);
+			ImGui::Text("Memory: ~%.1f MB", m_GraphBenchmarkResult.memoryMB);
+		}
+		ImGui::Spacing();
+
 		//End
 		ImGui::PopAllowKeyboardFocus();
 		ImGui::End();
@@ -220,3 +234,38 @@ void App_PathfindingAStar::CalculatePath()
 		m_vPath.clear();
 	}
 }
+
+void App_PathfindingAStar::RunGraphBenchmark()
+{
+	using Clock = std::chrono::high_resolution_clock;
+	const auto toMs = [](Clock::duration duration) { return std::chrono::duration<float, std::milli>(duration).count(); };
+
+	const auto start = Clock::now();
+	auto pGraph = new GridGraph<GridTerrainNode, GraphConnection>(false);
+	if (m_BenchmarkImplicitGrid)
+		pGraph->InitializeImplicitGrid(GraphBenchmarkSize, GraphBenchmarkSize, m_SizeCell, true);
+	else
+		pGraph->InitializeGrid(GraphBenchmarkSize, GraphBenchmarkSize, m_SizeCell, false, true);
+	const auto initialized = Clock::now();
+
+	auto pClone = pGraph->Clone();
+	const auto cloned = Clock::now();
+
+	m_GraphBenchmarkResult.nrOfConnections = pClone->GetNrOfConnections();
+
+	//Nodes and their pointers, plus a connection list per node or a blocked bit and a cost per cell
+	const size_t nrOfNodes{ static_cast<size_t>(GraphBenchmarkSize) * GraphBenchmarkSize };
+	size_t nrOfBytes{ nrOfNodes * (sizeof(GridTerrainNode) + sizeof(GridTerrainNode*)) };
+	if (m_BenchmarkImplicitGrid)
+		nrOfBytes += nrOfNodes / 8 + nrOfNodes * sizeof(float);
+	else
+		nrOfBytes += nrOfNodes * sizeof(std::vector<GraphConnection*>) + m_GraphBenchmarkResult.nrOfConnections * (sizeof(GraphConnection) + sizeof(GraphConnection*));
+	m_GraphBenchmarkResult.memoryMB = nrOfBytes / (1024.f * 1024.f);
+	pClone.reset();
+	SAFE_DELETE(pGraph);
+	const auto destroyed = Clock::now();
+
+	m_GraphBenchmarkResult.initializeMs = toMs(initialized - start);
+	m_GraphBenchmarkResult.cloneMs = toMs(cloned - initialized);
+	m_GraphBenchmarkResult.destroyMs = toMs(destroyed - cloned);
+}
@@ -61,10 +61,24 @@ private:
 	int m_SelectedHeuristic = 4;
 	Elite::Heuristic m_pHeuristicFunction = Elite::HeuristicFunctions::Chebyshev;
 
+	//Graph benchmark: builds, clones and destroys a large diagonal grid
+	static const int GraphBenchmarkSize = 1024;
+	struct GraphBenchmarkResult
+	{
+		int nrOfConnections = 0;
+		float initializeMs = 0.f;
+		float cloneMs = 0.f;
+		float destroyMs = 0.f; // both graphs
+		float memoryMB = 0.f; // estimate for one graph
+	};
+	GraphBenchmarkResult m_GraphBenchmarkResult{};
+	bool m_BenchmarkImplicitGrid = true;
+
 	//Functions
 	void MakeGridGraph();
 	void UpdateImGui();
 	void CalculatePath();
+	void RunGraphBenchmark();
 
 	//C++ make the class non-copyable
 	App_PathfindingAStar(const App_PathfindingAStar&) = delete;
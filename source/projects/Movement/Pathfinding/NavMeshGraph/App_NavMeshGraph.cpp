@@ -13,6 +13,7 @@ using namespace Elite;
 #include "framework\EliteAI\EliteNavigation\Algorithms\ENavGraphPathfinding.h"
 
 //Statics
+static const char* NavGraphFile = "navmesh.bin";
 bool App_NavMeshGraph::sShowPolygon = true;
 bool App_NavMeshGraph::sShowGraph = false;
 bool App_NavMeshGraph::sDrawPortals = false;
@@ -50,7 +51,9 @@ void App_NavMeshGraph::Start()
 	std::list<Elite::Vector2> baseBox
 	{ { -60, 30 },{ -60, -30 },{ 60, -30 },{ 60, 30 } };
 
+	const auto buildStart = std::chrono::high_resolution_clock::now();
 	m_pNavGraph = new Elite::NavGraph(Elite::Polygon(baseBox), m_AgentRadius);
+	m_NavGraphBuildMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - buildStart).count();
 
 	//----------- AGENT ------------
 	m_pSeekBehavior = new Seek();
@@ -206,6 +209,26 @@ void App_NavMeshGraph::UpdateImGui()
 		ImGui::Spacing();
 		ImGui::Spacing();
 
+		//The file is only valid for this level, loading it skips the triangulation
+		if (ImGui::Button("Save NavMesh"))
+			m_pNavGraph->SaveToFile(NavGraphFile);
+		ImGui::SameLine();
+		if (ImGui::Button("Load NavMesh"))
+		{
+			const auto loadStart = std::chrono::high_resolution_clock::now();
+			if (Elite::NavGraph* pLoadedGraph = Elite::NavGraph::CreateFromFile(NavGraphFile))
+			{
+				SAFE_DELETE(m_pNavGraph);
+				m_pNavGraph = pLoadedGraph;
+				m_NavGraphBuildMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - loadStart).count();
+				m_IsNavGraphLoaded = true;
+				m_vPath.clear();
+			}
+		}
+		ImGui::Text("%s in %.2f ms", m_IsNavGraphLoaded ? "Loaded" : "Built", m_NavGraphBuildMs);
+		ImGui::Spacing();
+		ImGui::Spacing();
+
 		if (ImGui::SliderFloat("AgentSpeed", &m_AgentSpeed, 0.0f, 22.0f))
 		{
 			m_pAgent->SetMaxLinearSpeed(m_AgentSpeed);
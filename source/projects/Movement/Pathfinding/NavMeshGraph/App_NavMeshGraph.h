@@ -52,6 +52,8 @@ private:
 	// --Graph--
 	Elite::NavGraph* m_pNavGraph = nullptr;
 	Elite::GraphRenderer m_GraphRenderer{};
+	float m_NavGraphBuildMs = 0.f; //triangulated, or loaded from file
+	bool m_IsNavGraphLoaded = false;
 
 	// --Debug drawing information--
 	std::vector<Elite::Portal> m_Portals;
@@ -13,7 +13,8 @@ Flock::Flock(
 	int flockSize /*= 50*/, 
 	float worldSize /*= 100.f*/, 
 	SteeringAgent* pAgentToEvade /*= nullptr*/, 
-	bool trimWorld /*= false*/)
+	bool trimWorld /*= false*/,
+	bool useKinematicAgents /*= false*/)
 
 	: m_WorldSize{ worldSize }
 	, m_FlockSize{ flockSize }
@@ -52,14 +53,14 @@ Flock::Flock(
 
 	m_pCellSpace = new CellSpace(m_WorldSize, m_WorldSize, m_NrPartitionsInAxis, m_NrPartitionsInAxis);
 
+	if (useKinematicAgents)
+		m_pCrowd = new AgentCrowd{};
+
 	// Initialize each agent in the flock
 	for (int i = 0; i < m_FlockSize; ++i)
 	{
-		SteeringAgent* pNewAgent{ new SteeringAgent{} };
-
-		pNewAgent->SetSteeringBehavior(m_pPrioritySteering);
+		SteeringAgent* pNewAgent{ CreateAgent() };
 
-		pNewAgent->SetAutoOrient(true);
 		pNewAgent->SetPosition({ rand() % 1001 / 1000.0f * m_WorldSize, rand() % 1001 / 1000.0f * m_WorldSize });
 		pNewAgent->SetMaxLinearSpeed(50.0f);
 		pNewAgent->SetMass(1.0f);
@@ -98,10 +99,15 @@ Flock::~Flock()
 	}
 	m_pAgents.clear();
 	m_pNeighbors.clear();
+
+	// Kinematic agents give their slot back to the crowd, so it goes last
+	SAFE_DELETE(m_pCrowd);
 }
 
 void Flock::Update(float deltaT)
 {
+	ELITE_PROFILE_SCOPE("Flock::Update");
+
 	auto target = TargetData{};
 	target.Position = m_pAgentToEvade->GetPosition();
 	target.Orientation = m_pAgentToEvade->GetRotation();
@@ -121,7 +127,7 @@ void Flock::Update(float deltaT)
 		if (m_IsUsingPartitioning)
 		{
 			m_pCellSpace->UpdateAgentCell(pAgent, prevPosition);
-			m_NrOfNeighbors = m_pCellSpace->RegisterNeighbors(m_pNeighbors, pAgent, m_NeighborhoodRadius);
+			m_NrOfNeighbors = m_pCellSpace->RegisterNeighbors(m_pNeighbors, m_NeighborhoodStats, pAgent, m_NeighborhoodRadius);
 		}
 		else
 		{
@@ -130,6 +136,10 @@ void Flock::Update(float deltaT)
 
 		pAgent->Update(deltaT);
 	}
+
+	// Rigid bodies are moved by the physics world, kinematic agents by their crowd
+	if (m_pCrowd)
+		m_pCrowd->Step(deltaT);
 }
 
 void Flock::Render(float deltaT)
@@ -180,6 +190,10 @@ void Flock::UpdateAndRenderUI()
 	ImGui::Indent();
 	ImGui::Text("%.3f ms/frame", 1000.0f / ImGui::GetIO().Framerate);
 	ImGui::Text("%.1f FPS", ImGui::GetIO().Framerate);
+#ifdef USE_HEAP_COUNTER
+	ImGui::Text("%llu heap allocs/frame", Elite::FrameArena::GetNrOfHeapAllocationsLastFrame());
+#endif
+	ImGui::Text("%.1f KB frame arena", Elite::FrameArena::GetBytesUsedLastFrame() / 1024.f);
 	ImGui::Unindent();
 
 	ImGui::Spacing();
@@ -196,6 +210,27 @@ void Flock::UpdateAndRenderUI()
 
 	ImGui::Checkbox("Is rendering agents", &m_IsRenderingAgents);
 
+	bool useKinematicAgents{ IsUsingKinematicAgents() };
+	if (ImGui::Checkbox("Kinematic agents (no Box2D)", &useKinematicAgents))
+		SetUsingKinematicAgents(useKinematicAgents);
+	if (m_pCrowd)
+	{
+		bool isResolvingOverlaps{ m_pCrowd->IsResolvingOverlaps() };
+		if (ImGui::Checkbox("Resolve overlaps", &isResolvingOverlaps))
+			m_pCrowd->SetResolvingOverlaps(isResolvingOverlaps);
+	}
+
+	if (ImGui::Button("Benchmark 10k agents"))
+		RunKinematicBenchmark();
+	if (m_KinematicBenchmarkResult.rigidBodyMs > 0.f)
+	{
+		ImGui::Text("Box2D: %.2f ms", m_KinematicBenchmarkResult.rigidBodyMs);
+		ImGui::Text("Kinematic: %.2f ms (x%.1f)", m_KinematicBenchmarkResult.kinematicMs,
+			m_KinematicBenchmarkResult.rigidBodyMs / m_KinematicBenchmarkResult.kinematicMs);
+		ImGui::Text("+ overlaps: %.2f ms (x%.1f)", m_KinematicBenchmarkResult.kinematicOverlapMs,
+			m_KinematicBenchmarkResult.rigidBodyMs / m_KinematicBenchmarkResult.kinematicOverlapMs);
+	}
+
 	// Display debug logic
 	if (ImGui::CollapsingHeader("Debug Info"))
 	{
@@ -291,20 +326,27 @@ void Flock::UpdateAndRenderUI()
 void Flock::RegisterNeighbors(SteeringAgent* pAgent)
 {
 	m_NrOfNeighbors = 0;
+	m_NeighborhoodStats.Reset();
+
+	const Vector2 agentPos{ pAgent->GetPosition() };
 	for (SteeringAgent* pOtherAgent : m_pAgents)
 	{
 		if (pOtherAgent == pAgent) continue;
 
-		float distance{ (pAgent->GetPosition() - pOtherAgent->GetPosition()).Magnitude() };
+		const Vector2 otherPos{ pOtherAgent->GetPosition() };
+		float distance{ (agentPos - otherPos).Magnitude() };
 		if (distance < m_NeighborhoodRadius)
 		{
 			m_pNeighbors[m_NrOfNeighbors++] = pOtherAgent;
 
+			const Vector2 otherVelocity{ pOtherAgent->GetLinearVelocity() };
+			m_NeighborhoodStats.AddNeighbor(agentPos, otherPos, otherVelocity, m_NeighborhoodRadius);
+
 			if(pAgent->CanRenderBehavior())
 				DEBUGRENDERER2D->DrawSolidCircle(
-					pOtherAgent->GetPosition(), 
+					otherPos, 
 					pOtherAgent->GetRadius(), 
-					pOtherAgent->GetLinearVelocity().GetNormalized(), 
+					otherVelocity.GetNormalized(), 
 					{ 0.0f, 1.0f, 0.0f }, 
 					0.0f
 				);
@@ -312,39 +354,38 @@ void Flock::RegisterNeighbors(SteeringAgent* pAgent)
 	}
 }
 
-Elite::Vector2 Flock::GetAverageNeighborPos() const
+float Flock::GetNeighborhoodRadius() const
 {
-	// If there are no neighbors, return an empty position
-	if (m_NrOfNeighbors == 0) return Vector2{};
-	
-	// Calculate the average of all the neighor position
-	Vector2 averageNeighborPos{};
-	for (int i{}; i < m_NrOfNeighbors; ++i)
-	{
-		averageNeighborPos += m_pNeighbors[i]->GetPosition();
-	}
-	averageNeighborPos /= static_cast<float>(m_NrOfNeighbors);
-
-	return averageNeighborPos;
+	return m_NeighborhoodRadius;
 }
 
-Elite::Vector2 Flock::GetAverageNeighborVelocity() const
+void Flock::SetUsingKinematicAgents(bool useKinematicAgents)
 {
-	if (m_NrOfNeighbors == 0) return Vector2{};
+	if (useKinematicAgents == IsUsingKinematicAgents())
+		return;
+
+	AgentCrowd* pPrevCrowd{ m_pCrowd };
+	m_pCrowd = useKinematicAgents ? new AgentCrowd{} : nullptr;
 
-	Vector2 averageNeighborVel{};
-	for (int i{}; i < m_NrOfNeighbors; ++i)
+	// Replace every agent by one of the other kind in the same state
+	m_pCellSpace->EmptyCells();
+	for (SteeringAgent*& pAgent : m_pAgents)
 	{
-		averageNeighborVel += m_pNeighbors[i]->GetLinearVelocity();
-	}
-	averageNeighborVel /= static_cast<float>(m_NrOfNeighbors);
+		SteeringAgent* pNewAgent{ CreateAgent() };
+		pNewAgent->SetPosition(pAgent->GetPosition());
+		pNewAgent->SetRotation(pAgent->GetRotation());
+		pNewAgent->SetLinearVelocity(pAgent->GetLinearVelocity());
+		pNewAgent->SetMaxLinearSpeed(pAgent->GetMaxLinearSpeed());
+		pNewAgent->SetMaxAngularSpeed(pAgent->GetMaxAngularSpeed());
+		pNewAgent->SetMass(pAgent->GetMass());
+		pNewAgent->SetRenderBehavior(pAgent->CanRenderBehavior());
 
-	return averageNeighborVel;
-}
+		SAFE_DELETE(pAgent);
+		pAgent = pNewAgent;
+		m_pCellSpace->AddAgent(pAgent);
+	}
 
-float Flock::GetNeighborhoodRadius() const
-{
-	return m_NeighborhoodRadius;
+	SAFE_DELETE(pPrevCrowd);
 }
 
 void Flock::SetTarget_Seek(TargetData target)
@@ -371,3 +412,48 @@ float* Flock::GetWeight(ISteeringBehavior* pBehavior)
 
 	return nullptr;
 }
+
+SteeringAgent* Flock::CreateAgent() const
+{
+	SteeringAgent* pNewAgent{ m_pCrowd ? new SteeringAgent{ m_pCrowd } : new SteeringAgent{} };
+
+	pNewAgent->SetSteeringBehavior(m_pPrioritySteering);
+	pNewAgent->SetAutoOrient(true);
+
+	return pNewAgent;
+}
+
+void Flock::RunKinematicBenchmark()
+{
+	const int flockSize{ 10000 };
+	const int nrOfSteps{ 60 };
+	const float stepTime{ 1.f / 60.f };
+
+	// Only the benchmark flock should be in the physics world
+	const bool wasUsingKinematicAgents{ IsUsingKinematicAgents() };
+	SetUsingKinematicAgents(true);
+
+	const auto measure = [&](bool useKinematicAgents, bool isResolvingOverlaps)
+	{
+		Flock flock{ flockSize, m_WorldSize, m_pAgentToEvade, true, useKinematicAgents };
+		if (flock.m_pCrowd)
+			flock.m_pCrowd->SetResolvingOverlaps(isResolvingOverlaps);
+
+		const auto start = std::chrono::high_resolution_clock::now();
+		for (int step = 0; step < nrOfSteps; ++step)
+		{
+			flock.Update(stepTime);
+			if (!useKinematicAgents)
+				PHYSICSWORLD->Step(stepTime);
+		}
+		const auto end = std::chrono::high_resolution_clock::now();
+
+		return std::chrono::duration<float, std::milli>(end - start).count() / nrOfSteps;
+	};
+
+	m_KinematicBenchmarkResult.rigidBodyMs = measure(false, false);
+	m_KinematicBenchmarkResult.kinematicMs = measure(true, false);
+	m_KinematicBenchmarkResult.kinematicOverlapMs = measure(true, true);
+
+	SetUsingKinematicAgents(wasUsingKinematicAgents);
+}
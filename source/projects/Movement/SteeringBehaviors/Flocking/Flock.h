@@ -1,12 +1,13 @@
 #pragma once
 #include "../SteeringHelpers.h"
 #include "FlockingSteeringBehaviors.h"
+#include "../SpacePartitioning/SpacePartitioning.h"
 
 class ISteeringBehavior;
 class SteeringAgent;
 class BlendedSteering;
 class PrioritySteering;
-class CellSpace;
+class AgentCrowd;
 
 class Flock final
 {
@@ -15,7 +16,8 @@ public:
 		int flockSize = 50, 
 		float worldSize = 100.f, 
 		SteeringAgent* pAgentToEvade = nullptr, 
-		bool trimWorld = false);
+		bool trimWorld = false,
+		bool useKinematicAgents = false);
 
 	~Flock();
 
@@ -26,14 +28,21 @@ public:
 	void RegisterNeighbors(SteeringAgent* pAgent);
 	int GetNrOfNeighbors() const { return m_NrOfNeighbors; }
 	const std::vector<SteeringAgent*>& GetNeighbors() const { return m_pNeighbors; }
+	//Gathered together with the neighbors of the agent that is being updated
+	const NeighborhoodStats& GetNeighborhoodStats() const { return m_NeighborhoodStats; }
 
-	Elite::Vector2 GetAverageNeighborPos() const;
-	Elite::Vector2 GetAverageNeighborVelocity() const;
+	Elite::Vector2 GetAverageNeighborPos() const { return m_NeighborhoodStats.GetAveragePosition(); }
+	Elite::Vector2 GetAverageNeighborVelocity() const { return m_NeighborhoodStats.GetAverageVelocity(); }
+	Elite::Vector2 GetNeighborSeparation() const { return m_NeighborhoodStats.separation; }
 	float GetNeighborhoodRadius() const;
 
 	void SetTarget_Seek(TargetData target);
 	void SetWorldTrimSize(float size) { m_WorldSize = size; }
 
+	//Kinematic agents are moved by an AgentCrowd instead of Box2D, switching keeps their state
+	void SetUsingKinematicAgents(bool useKinematicAgents);
+	bool IsUsingKinematicAgents() const { return m_pCrowd != nullptr; }
+
 private:
 	//Datamembers
 	int m_FlockSize = 0;
@@ -51,6 +60,7 @@ private:
 
 	float m_NeighborhoodRadius = 5.0f;
 	int m_NrOfNeighbors = 0;
+	NeighborhoodStats m_NeighborhoodStats{};
 
 	const int m_NrPartitionsInAxis = 25;
 	CellSpace* m_pCellSpace = nullptr;
@@ -58,6 +68,18 @@ private:
 	bool m_DrawPartitioning = true;
 
 	SteeringAgent* m_pAgentToEvade = nullptr;
+
+	//Owns the state of the agents when they are kinematic
+	AgentCrowd* m_pCrowd = nullptr;
+
+	//Kinematic benchmark: ms per step of a flock of 10k agents, Box2D step included for the rigid bodies
+	struct KinematicBenchmarkResult
+	{
+		float rigidBodyMs;
+		float kinematicMs;
+		float kinematicOverlapMs;
+	};
+	KinematicBenchmarkResult m_KinematicBenchmarkResult{};
 	
 	//Steering Behaviors
 	Seek* m_pSeekBehavior = nullptr;
@@ -71,6 +93,8 @@ private:
 	PrioritySteering* m_pPrioritySteering = nullptr;
 
 	float* GetWeight(ISteeringBehavior* pBehaviour);
+	SteeringAgent* CreateAgent() const;
+	void RunKinematicBenchmark();
 
 private:
 	Flock(const Flock& other);
@@ -25,24 +25,8 @@ SteeringOutput Separation::CalculateSteering(float deltaT, SteeringAgent* pAgent
 	// If there are no agents, do nothing
 	if (m_pFlock->GetNrOfNeighbors() <= 0) return {};
 
-	// Get all data about the neighbors
-	const std::vector<SteeringAgent*>& pNeightbors = m_pFlock->GetNeighbors();
-	const int nrNeighbors{ m_pFlock->GetNrOfNeighbors() };
-	const float neighborhoodRadius{ m_pFlock->GetNeighborhoodRadius() };
-
-	// Calculate the seperation direction
-	Vector2 seperationDirection{};
-
-	// For each neighbor
-	for (int i{}; i < nrNeighbors; ++i)
-	{
-		// Get the direction (and distance) away from the neighbor
-		Vector2 neighborDirection{ pAgent->GetPosition() - pNeightbors[i]->GetPosition() };
-		const float neighborDistance{ neighborDirection.Normalize() };
-
-		// Calculate the seperation vector depending on the distance of the neighbor (the furthur away the neighbor, the smaller the vector)
-		seperationDirection += neighborDirection * neighborhoodRadius * (1.0f - neighborDistance / neighborhoodRadius);
-	}
+	// The seperation direction is summed up while the neighbors are registered
+	const Vector2 seperationDirection{ m_pFlock->GetNeighborSeparation() };
 
 	// Set the target to the seperation target
 	m_Target = pAgent->GetPosition() + seperationDirection;
@@ -2,6 +2,20 @@
 #include "SpacePartitioning.h"
 #include "projects\Movement\SteeringBehaviors\SteeringAgent.h"
 
+// --- Neighborhood ---
+// --------------------
+void NeighborhoodStats::AddNeighbor(const Elite::Vector2& agentPos, const Elite::Vector2& neighborPos, const Elite::Vector2& neighborVelocity, float queryRadius)
+{
+	++nrOfNeighbors;
+	positionSum += neighborPos;
+	velocitySum += neighborVelocity;
+
+	// Direction away from the neighbor, scaled by how far inside the radius the neighbor is
+	Elite::Vector2 neighborDirection{ agentPos - neighborPos };
+	const float neighborDistance{ neighborDirection.Normalize() };
+	separation += neighborDirection * (queryRadius - neighborDistance);
+}
+
 // --- Cell ---
 // ------------
 Cell::Cell(float left, float bottom, float width, float height)
@@ -11,20 +25,18 @@ Cell::Cell(float left, float bottom, float width, float height)
 	boundingBox.height = height;
 }
 
-std::vector<Elite::Vector2> Cell::GetRectPoints() const
+Elite::FrameVector<Elite::Vector2> Cell::GetRectPoints() const
 {
 	auto left = boundingBox.bottomLeft.x;
 	auto bottom = boundingBox.bottomLeft.y;
 	auto width = boundingBox.width;
 	auto height = boundingBox.height;
 
-	std::vector<Elite::Vector2> rectPoints =
-	{
-		{ left , bottom  },
-		{ left , bottom + height  },
-		{ left + width , bottom + height },
-		{ left + width , bottom  },
-	};
+	auto rectPoints = Elite::FrameArena::MakeVector<Elite::Vector2>(4);
+	rectPoints.emplace_back(left, bottom);
+	rectPoints.emplace_back(left, bottom + height);
+	rectPoints.emplace_back(left + width, bottom + height);
+	rectPoints.emplace_back(left + width, bottom);
 
 	return rectPoints;
 }
@@ -67,7 +79,16 @@ void CellSpace::UpdateAgentCell(SteeringAgent* agent, Elite::Vector2 oldPos)
 
 int CellSpace::RegisterNeighbors(std::vector<SteeringAgent*>& pNeigbors, SteeringAgent* pAgent, float queryRadius)
 {
+	NeighborhoodStats stats{};
+	return RegisterNeighbors(pNeigbors, stats, pAgent, queryRadius);
+}
+
+int CellSpace::RegisterNeighbors(std::vector<SteeringAgent*>& pNeigbors, NeighborhoodStats& stats, SteeringAgent* pAgent, float queryRadius)
+{
+	ELITE_PROFILE_SCOPE("CellSpace::RegisterNeighbors");
+
 	int nrOfNeighbors{};
+	stats.Reset();
 
 	// Find the cell that the agent is currently in
 	const Elite::Vector2 curPos{ pAgent->GetPosition() };
@@ -95,19 +116,24 @@ int CellSpace::RegisterNeighbors(std::vector<SteeringAgent*>& pNeigbors, Steerin
 				if (pOtherAgent == pAgent) continue;
 
 				// Calculate the distance between the agents
-				const float sqrDistance{ Elite::DistanceSquared(pOtherAgent->GetPosition(), pAgent->GetPosition()) };
+				const Elite::Vector2 otherPos{ pOtherAgent->GetPosition() };
+				const float sqrDistance{ Elite::DistanceSquared(otherPos, curPos) };
 
 				// If the agent is inside the queryRadius, add the agent to the neighbors
 				if (sqrDistance < queryRadius * queryRadius)
 				{
 					pNeigbors[nrOfNeighbors++] = pOtherAgent;
 
+					// Read the velocity of the neighbor only once, for the sums
+					const Elite::Vector2 otherVelocity{ pOtherAgent->GetLinearVelocity() };
+					stats.AddNeighbor(curPos, otherPos, otherVelocity, queryRadius);
+
 					// Draw a green cirlce above the neighbor to indicite that this agent is a neighbor
 					if (pAgent->CanRenderBehavior())
 						DEBUGRENDERER2D->DrawSolidCircle(
-							pOtherAgent->GetPosition(),
+							otherPos,
 							pOtherAgent->GetRadius(),
-							pOtherAgent->GetLinearVelocity().GetNormalized(),
+							otherVelocity.GetNormalized(),
 							{ 0.0f, 1.0f, 0.0f },
 							0.0f
 						);
@@ -117,7 +143,7 @@ int CellSpace::RegisterNeighbors(std::vector<SteeringAgent*>& pNeigbors, Steerin
 			// Draw all neighbouring cells
 			if (pAgent->CanRenderBehavior())
 			{
-				const std::vector<Elite::Vector2> rectPoints{ pCell.GetRectPoints() };
+				const auto rectPoints{ pCell.GetRectPoints() };
 
 				DEBUGRENDERER2D->DrawPolygon(rectPoints.data(), rectPoints.size(), Elite::Color{ 0.0f, 0.0f, 1.0f }, 0.0f);
 			}
@@ -140,7 +166,7 @@ void CellSpace::RenderCells() const
 
 	for (Cell pCell : m_Cells)
 	{
-		const std::vector<Elite::Vector2> rectPoints{ pCell.GetRectPoints() };
+		const auto rectPoints{ pCell.GetRectPoints() };
 
 		DEBUGRENDERER2D->DrawPolygon(rectPoints.data(), rectPoints.size(), color, 0.0f);
 
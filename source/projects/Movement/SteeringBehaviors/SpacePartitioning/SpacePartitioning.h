@@ -18,13 +18,32 @@
 
 class SteeringAgent;
 
+// --- Neighborhood ---
+// --------------------
+// Sums of everything the flocking behaviors need from the neighbors, gathered while the neighbors are found,
+// so the state of every neighbor is read once instead of once per behavior
+struct NeighborhoodStats
+{
+	int nrOfNeighbors = 0;
+	Elite::Vector2 positionSum{};
+	Elite::Vector2 velocitySum{};
+	Elite::Vector2 separation{};	// away from every neighbor, longer the closer the neighbor is
+
+	void Reset() { *this = NeighborhoodStats{}; }
+	void AddNeighbor(const Elite::Vector2& agentPos, const Elite::Vector2& neighborPos, const Elite::Vector2& neighborVelocity, float queryRadius);
+
+	Elite::Vector2 GetAveragePosition() const { return nrOfNeighbors > 0 ? positionSum / static_cast<float>(nrOfNeighbors) : Elite::Vector2{}; }
+	Elite::Vector2 GetAverageVelocity() const { return nrOfNeighbors > 0 ? velocitySum / static_cast<float>(nrOfNeighbors) : Elite::Vector2{}; }
+};
+
 // --- Cell ---
 // ------------
 struct Cell
 {
 	Cell(float left, float bottom, float width, float height);
 
-	std::vector<Elite::Vector2> GetRectPoints() const;
+	//Only valid this frame
+	Elite::FrameVector<Elite::Vector2> GetRectPoints() const;
 	
 	// all the agents currently in this cell
 	std::list<SteeringAgent*> agents;
@@ -42,6 +61,8 @@ public:
 	void UpdateAgentCell(SteeringAgent* agent, Elite::Vector2 oldPos);
 
 	int RegisterNeighbors(std::vector<SteeringAgent*>& pNeighbors, SteeringAgent* agent, float queryRadius);
+	//Also fills in the sums over the neighbors it finds
+	int RegisterNeighbors(std::vector<SteeringAgent*>& pNeighbors, NeighborhoodStats& stats, SteeringAgent* agent, float queryRadius);
 
 	//empties the cells of entities
 	void EmptyCells();
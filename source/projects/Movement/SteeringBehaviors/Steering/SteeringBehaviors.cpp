@@ -122,7 +122,8 @@ SteeringOutput Wander::CalculateSteering(float deltaT, SteeringAgent* pAgent)
 {
 	const Vector2 circleCenter{ pAgent->GetPosition() + pAgent->GetDirection() * m_OffsetDistance };
 
-	const float randAngle{ float(rand()) / RAND_MAX * m_MaxAngleChange * 2 - m_MaxAngleChange };
+	std::uniform_real_distribution<float> angleDistribution{ -m_MaxAngleChange, m_MaxAngleChange };
+	const float randAngle{ angleDistribution(m_Generator) };
 
 	m_WanderAngle += randAngle;
 
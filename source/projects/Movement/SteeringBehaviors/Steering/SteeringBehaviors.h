@@ -103,6 +103,8 @@ class Wander : public Seek
 {
 public:
 	Wander() = default;
+	//Agents that wander on job workers need their own seed, rand() is not safe to share between threads
+	explicit Wander(unsigned int seed) : m_Generator{ seed } {};
 	virtual ~Wander() = default;
 
 	//Wander Behaviour
@@ -116,6 +118,7 @@ protected:
 	float m_Radius{ 4.0f }; // Wander Radius
 	float m_MaxAngleChange{ Elite::ToRadians(15) }; // Max WanderAngle change per frame
 	float m_WanderAngle{ 0.0f }; // Internal
+	std::mt19937 m_Generator{ Elite::Replay::GetSeed() }; // Internal
 };
 
 ///////////////////////////////////////
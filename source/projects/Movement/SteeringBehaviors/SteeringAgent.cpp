@@ -4,34 +4,52 @@
 
 void SteeringAgent::Update(float dt)
 {
-	if(m_pSteeringBehavior)
+	Elite::Vector2 linearVelocity{};
+	float angle{};
+	if (CalculateMovement(dt, linearVelocity, angle))
+		ApplyMovement(linearVelocity, angle);
+}
+
+bool SteeringAgent::CalculateMovement(float dt, Elite::Vector2& linearVelocity, float& angle)
+{
+	if (!m_pSteeringBehavior)
+		return false;
+
+	auto output = m_pSteeringBehavior->CalculateSteering(dt, this);
+
+	//Linear Movement
+	//***************
+	auto linVel = GetLinearVelocity();
+	auto steeringForce = output.LinearVelocity - linVel;
+	auto acceleration = steeringForce / GetMass();
+
+	linearVelocity = linVel + (acceleration * dt);
+
+	//Angular Movement
+	//****************
+	if (m_AutoOrient)
 	{
-		auto output = m_pSteeringBehavior->CalculateSteering(dt, this);
-
-		//Linear Movement
-		//***************
-		auto linVel = GetLinearVelocity();
-		auto steeringForce = output.LinearVelocity - linVel;
-		auto acceleration = steeringForce / GetMass();		
-
-		SetLinearVelocity(linVel + (acceleration*dt));
-
-		//Angular Movement
-		//****************
-		if(m_AutoOrient)
-		{
-			auto desiredOrientation = Elite::VectorToOrientation(GetLinearVelocity());
-			SetRotation(desiredOrientation);
-		}
-		else
-		{
-			if (output.AngularVelocity > m_MaxAngularSpeed)
-				output.AngularVelocity = m_MaxAngularSpeed;
-			SetAngularVelocity(output.AngularVelocity);
-		}
-
-		m_PrevPosition = GetPosition();
+		angle = Elite::VectorToOrientation(linearVelocity);
 	}
+	else
+	{
+		if (output.AngularVelocity > m_MaxAngularSpeed)
+			output.AngularVelocity = m_MaxAngularSpeed;
+		angle = output.AngularVelocity;
+	}
+	return true;
+}
+
+void SteeringAgent::ApplyMovement(const Elite::Vector2& linearVelocity, float angle)
+{
+	SetLinearVelocity(linearVelocity);
+
+	if (m_AutoOrient)
+		SetRotation(angle);
+	else
+		SetAngularVelocity(angle);
+
+	m_PrevPosition = GetPosition();
 }
 
 void SteeringAgent::Render(float dt)
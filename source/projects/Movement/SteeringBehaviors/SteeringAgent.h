@@ -20,6 +20,7 @@ public:
 	//--- Constructor & Destructor ---
 	SteeringAgent() = default;
 	SteeringAgent(float radius) : BaseAgent(radius) {};
+	SteeringAgent(AgentCrowd* pCrowd, float radius = 1.f) : BaseAgent(pCrowd, radius) {};
 	virtual ~SteeringAgent() = default;
 
 	//--- Agent Functions ---
@@ -45,6 +46,11 @@ public:
 
 	Elite::Vector2 GetPreviousPosition() const { return m_PrevPosition; };
 
+	//Update in two halves, for updates that steer many agents in parallel. CalculateMovement only reads the world
+	//and returns false without a steering behavior, angle is the rotation or the angular velocity when not auto orienting.
+	bool CalculateMovement(float dt, Elite::Vector2& linearVelocity, float& angle);
+	void ApplyMovement(const Elite::Vector2& linearVelocity, float angle);
+
 protected:
 	//--- Datamembers ---
 	ISteeringBehavior* m_pSteeringBehavior = nullptr;
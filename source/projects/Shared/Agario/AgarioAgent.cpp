@@ -2,10 +2,14 @@
 #include "projects/Movement/SteeringBehaviors/Steering/SteeringBehaviors.h"
 #include "AgarioAgent.h"
 #include "AgarioData.h"
+#include "AgarioCommands.h"
 
+const float AgarioAgent::m_StartRadius{ 2.f };
+unsigned int AgarioAgent::m_NrOfCreatedAgents{ 0 };
 using namespace Elite;
+
 AgarioAgent::AgarioAgent(Elite::Vector2 pos, Color color)
-	: SteeringAgent(2.0f)
+	: SteeringAgent(m_StartRadius)
 {
 	m_BodyColor = color;
 	SetPosition(pos);
@@ -14,11 +18,13 @@ AgarioAgent::AgarioAgent(Elite::Vector2 pos, Color color)
 	m_pRigidBody->SetUserData({ int(AgarioObjectTypes::Player), this });
 
 	//Create the possible steering behaviors for the agent
-	m_pWander = new Wander();
+	//Wander runs on the job workers, seeded from the run and the agent so replays wander the same way
+	m_pWander = new Wander(MixSeed(Replay::GetSeed(), m_NrOfCreatedAgents++));
 	m_pSeek = new Seek();
 	m_pFlee = new Flee();
 
 	this->SetAutoOrient(true);
+	m_StartMaxLinearSpeed = m_MaxLinearSpeed;
 }
 
 AgarioAgent::AgarioAgent(Elite::Vector2 pos)
@@ -35,17 +41,33 @@ AgarioAgent::~AgarioAgent()
 }
 
 void AgarioAgent::Update(float dt)
+{
+	ApplyUpgrade();
+
+	if(m_DecisionMaking)
+		m_DecisionMaking->Update(dt);
+
+	SteeringAgent::Update(dt);
+}
+
+void AgarioAgent::ApplyUpgrade()
 {
 	if (m_ToUpgrade > 0.0f)
 	{
 		OnUpgrade(m_ToUpgrade);
 		m_ToUpgrade = 0.0f;
 	}
+}
 
-	if(m_DecisionMaking)
+void AgarioAgent::UpdateDecisions(float dt, AgarioCommandBuffer& commands)
+{
+	if (m_DecisionMaking)
 		m_DecisionMaking->Update(dt);
 
-	SteeringAgent::Update(dt);
+	Elite::Vector2 linearVelocity{};
+	float angle{};
+	if (CalculateMovement(dt, linearVelocity, angle))
+		commands.Steer(this, linearVelocity, angle);
 }
 
 void AgarioAgent::Render(float dt)
@@ -90,11 +112,41 @@ void AgarioAgent::SetToFlee(Elite::Vector2 fleePos)
 	SetSteeringBehavior(m_pFlee);
 }
 
+void AgarioAgent::Deactivate()
+{
+	SetLinearVelocity(Elite::ZeroVector2);
+	SetAngularVelocity(0.f);
+	m_pRigidBody->SetActive(false);
+}
+
+void AgarioAgent::Respawn(Elite::Vector2 pos)
+{
+	m_ToUpgrade = 0.0f;
+	m_ToDestroy = false;
+	if (m_Radius != m_StartRadius)
+		SetRadius(m_StartRadius);
+	SetMaxLinearSpeed(m_StartMaxLinearSpeed);
+
+	SetPosition(pos);
+	m_pRigidBody->SetActive(true);
+}
+
+void AgarioAgent::Respawn(Elite::Vector2 pos, Elite::Color color)
+{
+	m_BodyColor = color;
+	Respawn(pos);
+}
+
 void AgarioAgent::OnUpgrade(float amountOfFood)
 {
-	float prevMass = GetMass();
-	m_Radius += amountOfFood;
-	
+	SetRadius(m_Radius + amountOfFood);
+	SetMaxLinearSpeed(m_SpeedBase / sqrt(m_Radius));
+}
+
+void AgarioAgent::SetRadius(float radius)
+{
+	m_Radius = radius;
+
 	//Remove existing shapes
 	m_pRigidBody->RemoveAllShapes();
 
@@ -103,7 +155,6 @@ void AgarioAgent::OnUpgrade(float amountOfFood)
 	shape.radius = m_Radius;
 	m_pRigidBody->AddShape(&shape);
 	m_pRigidBody->SetMass(0.f);
-	SetMaxLinearSpeed(m_SpeedBase / sqrt(m_Radius));
 }
 
 
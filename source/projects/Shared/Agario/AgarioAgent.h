@@ -11,6 +11,8 @@
 
 #include "projects/Movement/SteeringBehaviors/SteeringAgent.h"
 
+class AgarioCommandBuffer;
+
 class AgarioAgent : public SteeringAgent
 {
 public:
@@ -32,11 +34,27 @@ public:
 	void SetToWander();
 	void SetToSeek(Elite::Vector2 seekPos);
 	void SetToFlee(Elite::Vector2 seekPos);
+
+	//Update in parts for AgarioAgentUpdate. The upgrade changes the rigid body and is applied on the main thread,
+	//UpdateDecisions only reads the world and records the movement in the command buffer.
+	void ApplyUpgrade();
+	void UpdateDecisions(float dt, AgarioCommandBuffer& commands);
+
+	//Used by AgarioPool: takes the agent out of the game without destroying its rigid body,
+	//Respawn puts it back at the start radius. The decision making structure is kept.
+	void Deactivate();
+	void Respawn(Elite::Vector2 pos);
+	void Respawn(Elite::Vector2 pos, Elite::Color color);
 private:
+	static const float m_StartRadius;
+	//Agents are created on the main thread, so this numbers them the same way every run
+	static unsigned int m_NrOfCreatedAgents;
+
 	Elite::IDecisionMaking* m_DecisionMaking = nullptr;
 	float m_ToUpgrade = 0.0f;
 	bool m_ToDestroy = false;
 	float m_SpeedBase = 25.f;
+	float m_StartMaxLinearSpeed = 0.f;
 
 	ISteeringBehavior* m_pWander = nullptr;
 	ISteeringBehavior* m_pSeek = nullptr;
@@ -44,6 +62,7 @@ private:
 	
 private:
 	void OnUpgrade(float amountOfFood);
+	void SetRadius(float radius);
 
 private:
 	//C++ make the class non-copyable
@@ -0,0 +1,58 @@
+#include "stdafx.h"
+#include "AgarioAgentUpdate.h"
+#include "AgarioAgent.h"
+
+namespace
+{
+	//More chunks than threads, so a thread that gets cheap agents can pick up more work
+	const unsigned int ChunksPerThread = 4;
+}
+
+void AgarioAgentUpdate::Update(const std::vector<AgarioAgent*>& pAgents, float dt)
+{
+	ELITE_PROFILE_SCOPE("AgarioAgentUpdate::Update");
+	const auto start = std::chrono::high_resolution_clock::now();
+
+	if (!m_IsParallel)
+	{
+		for (AgarioAgent* pAgent : pAgents)
+			pAgent->Update(dt);
+	}
+	else if (!pAgents.empty())
+	{
+		//Upgrades change the shape of the rigid body
+		for (AgarioAgent* pAgent : pAgents)
+			pAgent->ApplyUpgrade();
+
+		//Every chunk has its own buffer, so the order of the commands is the order of the agents
+		const int nrOfAgents{ static_cast<int>(pAgents.size()) };
+		const int nrOfChunks{ std::min(nrOfAgents, static_cast<int>(JOBSYSTEM->GetNrOfThreads() * ChunksPerThread)) };
+		if (m_CommandBuffers.size() < static_cast<size_t>(nrOfChunks))
+			m_CommandBuffers.resize(nrOfChunks);
+		JOBSYSTEM->ParallelFor(nrOfChunks, 1, [&](int chunkBegin, int chunkEnd)
+			{
+				for (int chunk = chunkBegin; chunk < chunkEnd; ++chunk)
+				{
+					AgarioCommandBuffer& commands{ m_CommandBuffers[chunk] };
+					const int begin{ nrOfAgents * chunk / nrOfChunks };
+					const int end{ nrOfAgents * (chunk + 1) / nrOfChunks };
+					for (int i = begin; i < end; ++i)
+					{
+						if (!pAgents[i]->CanRenderBehavior())
+							pAgents[i]->UpdateDecisions(dt, commands);
+					}
+				}
+			});
+
+		for (int chunk = 0; chunk < nrOfChunks; ++chunk)
+			m_CommandBuffers[chunk].Apply();
+
+		for (AgarioAgent* pAgent : pAgents)
+		{
+			if (pAgent->CanRenderBehavior())
+				pAgent->Update(dt);
+		}
+	}
+
+	m_LastUpdateMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
@@ -0,0 +1,39 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// AgarioAgentUpdate.h: updates all Agario agents of a game in parallel.
+// Decision making and steering of the agents run on the job system while nobody writes to the world.
+// The movement they decide on goes to one command buffer per chunk of agents, and the buffers are
+// applied in chunk order afterwards: the result doesn't depend on which thread ran which chunk.
+// Agents that draw their behavior are updated on the main thread, the debug renderer isn't thread safe.
+/*=============================================================================*/
+#ifndef ELITE_AGARIO_AGENT_UPDATE
+#define ELITE_AGARIO_AGENT_UPDATE
+
+#include "AgarioCommands.h"
+
+class AgarioAgentUpdate final
+{
+public:
+	AgarioAgentUpdate() = default;
+	~AgarioAgentUpdate() = default;
+
+	void Update(const std::vector<AgarioAgent*>& pAgents, float dt);
+
+	//Serial updates call AgarioAgent::Update one by one, like before
+	void SetParallel(bool isParallel) { m_IsParallel = isParallel; }
+	bool IsParallel() const { return m_IsParallel; }
+
+	unsigned int GetNrOfThreads() const { return JOBSYSTEM->GetNrOfThreads(); }
+	float GetLastUpdateMs() const { return m_LastUpdateMs; }
+
+private:
+	std::vector<AgarioCommandBuffer> m_CommandBuffers{};
+	bool m_IsParallel = true;
+	float m_LastUpdateMs = 0.f;
+
+	//C++ make the class non-copyable
+	AgarioAgentUpdate(const AgarioAgentUpdate&) = delete;
+	AgarioAgentUpdate& operator=(const AgarioAgentUpdate&) = delete;
+};
+#endif
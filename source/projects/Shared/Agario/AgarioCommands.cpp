@@ -0,0 +1,49 @@
+#include "stdafx.h"
+#include "AgarioCommands.h"
+#include "AgarioAgent.h"
+#include "AgarioFood.h"
+
+void AgarioCommandBuffer::Steer(AgarioAgent* pAgent, const Elite::Vector2& linearVelocity, float angle)
+{
+	m_Commands.push_back({ AgarioCommand::Type::Steer, pAgent, nullptr, linearVelocity, angle });
+}
+
+void AgarioCommandBuffer::Upgrade(AgarioAgent* pAgent, float amountOfFood)
+{
+	m_Commands.push_back({ AgarioCommand::Type::Upgrade, pAgent, nullptr, Elite::ZeroVector2, amountOfFood });
+}
+
+void AgarioCommandBuffer::DestroyAgent(AgarioAgent* pAgent)
+{
+	m_Commands.push_back({ AgarioCommand::Type::DestroyAgent, pAgent, nullptr, Elite::ZeroVector2, 0.f });
+}
+
+void AgarioCommandBuffer::DestroyFood(AgarioFood* pFood)
+{
+	m_Commands.push_back({ AgarioCommand::Type::DestroyFood, nullptr, pFood, Elite::ZeroVector2, 0.f });
+}
+
+void AgarioCommandBuffer::Apply()
+{
+	for (const AgarioCommand& command : m_Commands)
+	{
+		switch (command.type)
+		{
+		case AgarioCommand::Type::Steer:
+			command.pAgent->ApplyMovement(command.vector, command.value);
+			break;
+		case AgarioCommand::Type::Upgrade:
+			command.pAgent->MarkForUpgrade(command.value);
+			break;
+		case AgarioCommand::Type::DestroyAgent:
+			command.pAgent->MarkForDestroy();
+			break;
+		case AgarioCommand::Type::DestroyFood:
+			command.pFood->MarkForDestroy();
+			break;
+		default:
+			break;
+		}
+	}
+	m_Commands.clear();
+}
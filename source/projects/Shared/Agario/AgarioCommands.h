@@ -0,0 +1,51 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// AgarioCommands.h: changes to the Agario world that are recorded now and applied later.
+// Code that runs while others read the world (agent jobs, Box2D callbacks) writes its changes
+// to a command buffer, the owner applies them on the main thread in a fixed order.
+/*=============================================================================*/
+#ifndef ELITE_AGARIO_COMMANDS
+#define ELITE_AGARIO_COMMANDS
+
+class AgarioAgent;
+class AgarioFood;
+
+struct AgarioCommand
+{
+	enum class Type
+	{
+		Steer,			//linear velocity in vector, rotation or angular velocity in value
+		Upgrade,		//amount of food in value
+		DestroyAgent,
+		DestroyFood
+	};
+
+	Type type;
+	AgarioAgent* pAgent;
+	AgarioFood* pFood;
+	Elite::Vector2 vector;
+	float value;
+};
+
+class AgarioCommandBuffer final
+{
+public:
+	AgarioCommandBuffer() = default;
+	~AgarioCommandBuffer() = default;
+
+	void Steer(AgarioAgent* pAgent, const Elite::Vector2& linearVelocity, float angle);
+	void Upgrade(AgarioAgent* pAgent, float amountOfFood);
+	void DestroyAgent(AgarioAgent* pAgent);
+	void DestroyFood(AgarioFood* pFood);
+
+	//Applies the commands in the order they were recorded and clears the buffer
+	void Apply();
+	void Clear() { m_Commands.clear(); }
+	bool IsEmpty() const { return m_Commands.empty(); }
+	size_t GetNrOfCommands() const { return m_Commands.size(); }
+
+private:
+	std::vector<AgarioCommand> m_Commands{};
+};
+#endif
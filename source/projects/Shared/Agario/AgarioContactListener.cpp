@@ -66,14 +66,14 @@ void AgarioContactListener::OnCollisionPlayerPlayer(AgarioAgent* agentA, AgarioA
 	}
 
 	//Remove Smallest Agent
-	biggestAgent->MarkForUpgrade(smallestAgent->GetRadius() * m_FoodPerRadius);
-	smallestAgent->MarkForDestroy();
+	m_Commands.Upgrade(biggestAgent, smallestAgent->GetRadius() * m_FoodPerRadius);
+	m_Commands.DestroyAgent(smallestAgent);
 }
 
 void AgarioContactListener::OnCollisionFoodPlayer(AgarioAgent* agent, AgarioFood* food)
 {
 	//Player-Food Collision
-	food->MarkForDestroy();
-	agent->MarkForUpgrade();
+	m_Commands.DestroyFood(food);
+	m_Commands.Upgrade(agent, 1.0f);
 }
 
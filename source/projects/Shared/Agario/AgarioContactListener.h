@@ -7,6 +7,8 @@
 /*=============================================================================*/
 #ifndef ELITE_AGARIO_CONTACT_LISTENER
 #define ELITE_AGARIO_CONTACT_LISTENER
+#include "AgarioCommands.h"
+
 class AgarioAgent;
 class AgarioFood;
 
@@ -15,6 +17,10 @@ class AgarioContactListener : public b2ContactListener
 public:
     AgarioContactListener();
 
+    //The outcome of a contact is recorded and only marked on the agents and food here, so a step on the
+    //physics thread never writes to them while the main thread reads. Call after PhysicsWorld::Sync.
+    void ApplyContacts() { m_Commands.Apply(); }
+
 private:
     virtual void BeginContact(b2Contact* contact) override;
     virtual void EndContact(b2Contact* contact) override;
@@ -24,6 +30,7 @@ private:
     void OnCollisionFoodPlayer(AgarioAgent* agent, AgarioFood* food);
 
 	float m_FoodPerRadius = 0.3f;
+	AgarioCommandBuffer m_Commands{};
 };
 #endif
 
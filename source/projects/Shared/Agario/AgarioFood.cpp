@@ -1,6 +1,7 @@
 #include "stdafx.h"
 #include "AgarioFood.h"
 #include "AgarioData.h"
+#include "AgarioFoodHash.h"
 
 const float AgarioFood::m_Radius{ 1.f };
 using namespace Elite;
@@ -10,10 +11,68 @@ AgarioFood::AgarioFood(Elite::Vector2 pos)
 {
 	m_Color = Color(Elite::randomFloat(), Elite::randomFloat(), Elite::randomFloat());
 
+	CreateRigidBody();
+}
+
+AgarioFood::AgarioFood(Elite::Vector2 pos, AgarioFoodHash* pFoodHash)
+	: m_Position(pos)
+{
+	m_Color = Color(Elite::randomFloat(), Elite::randomFloat(), Elite::randomFloat());
+
+	SetFoodHash(pFoodHash);
+}
+
+AgarioFood::~AgarioFood()
+{
+	if (m_pFoodHash)
+		m_pFoodHash->RemoveFood(this);
+	SAFE_DELETE(m_pRigidBody);
+}
+
+void AgarioFood::SetFoodHash(AgarioFoodHash* pFoodHash)
+{
+	if (m_pFoodHash)
+		m_pFoodHash->RemoveFood(this);
+	m_pFoodHash = pFoodHash;
+
+	if (m_pFoodHash)
+	{
+		SAFE_DELETE(m_pRigidBody);
+		m_pFoodHash->AddFood(this);
+	}
+	else if (!m_pRigidBody)
+		CreateRigidBody();
+}
 
+void AgarioFood::Deactivate()
+{
+	if (m_pFoodHash)
+		m_pFoodHash->RemoveFood(this);
+	m_pFoodHash = nullptr;
+
+	if (m_pRigidBody)
+		m_pRigidBody->SetActive(false);
+}
+
+void AgarioFood::Respawn(Elite::Vector2 pos, AgarioFoodHash* pFoodHash)
+{
+	m_Position = pos;
+	m_Color = Color(Elite::randomFloat(), Elite::randomFloat(), Elite::randomFloat());
+	m_ToDestroy = false;
+
+	if (m_pRigidBody)
+	{
+		m_pRigidBody->SetPosition(m_Position);
+		m_pRigidBody->SetActive(true);
+	}
+	SetFoodHash(pFoodHash);
+}
+
+void AgarioFood::CreateRigidBody()
+{
 	//Create Rigidbody
 	const Elite::RigidBodyDefine define = Elite::RigidBodyDefine(0.01f, 0.1f, Elite::eStatic, false);
-	const Transform transform = Transform(pos, Elite::ZeroVector2);
+	const Transform transform = Transform(m_Position, Elite::ZeroVector2);
 	m_pRigidBody = new RigidBody(define, transform);
 
 	//Add shape
@@ -24,11 +83,6 @@ AgarioFood::AgarioFood(Elite::Vector2 pos)
 	m_pRigidBody->SetUserData({ static_cast<int>(AgarioObjectTypes::Food), this });
 }
 
-AgarioFood::~AgarioFood()
-{
-	SAFE_DELETE(m_pRigidBody);
-}
-
 void AgarioFood::Update(float dt)
 {
 }
@@ -6,10 +6,14 @@
 /*=============================================================================*/
 #ifndef ELITE_AGARIO_FOOD
 #define ELITE_AGARIO_FOOD
+class AgarioFoodHash;
+
 class AgarioFood
 {
 public:
 	AgarioFood(Elite::Vector2 pos);
+	//Food without a rigid body, it is eaten by the overlap pass of the hash instead
+	AgarioFood(Elite::Vector2 pos, AgarioFoodHash* pFoodHash);
 	virtual ~AgarioFood();
 
 	virtual void Update(float dt);
@@ -18,6 +22,15 @@ public:
 	void MarkForDestroy();
 	bool CanBeDestroyed();
 	Elite::Vector2 GetPosition() { return m_Position; }
+	static float GetRadius() { return m_Radius; }
+
+	//Moves the food from Box2D into the hash, or back to Box2D with nullptr
+	void SetFoodHash(AgarioFoodHash* pFoodHash);
+
+	//Used by AgarioPool: takes the food out of the game without destroying its rigid body,
+	//Respawn puts it back as new food
+	void Deactivate();
+	void Respawn(Elite::Vector2 pos, AgarioFoodHash* pFoodHash = nullptr);
 
 private:
 	//--Datamemebers--
@@ -27,8 +40,11 @@ private:
 	Elite::Color m_Color;
 
 	RigidBody* m_pRigidBody = nullptr;
+	AgarioFoodHash* m_pFoodHash = nullptr;
 	bool m_ToDestroy = false;
 private:
+	void CreateRigidBody();
+
 	//C++ make the class non-copyable
 	AgarioFood(const AgarioFood&) {};
 	AgarioFood& operator=(const AgarioFood&) {};
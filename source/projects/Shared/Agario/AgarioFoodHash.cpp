@@ -0,0 +1,88 @@
+#include "stdafx.h"
+#include "AgarioFoodHash.h"
+#include "AgarioFood.h"
+#include "AgarioAgent.h"
+
+AgarioFoodHash::AgarioFoodHash(float cellSize, int nrOfBuckets)
+	: m_CellSize{ cellSize }
+	, m_FoodRadius{ AgarioFood::GetRadius() }
+{
+	unsigned int nrOfHashBuckets{ 1 };
+	while (nrOfHashBuckets < static_cast<unsigned int>(nrOfBuckets))
+		nrOfHashBuckets <<= 1;
+
+	m_BucketMask = nrOfHashBuckets - 1;
+	m_Buckets.resize(nrOfHashBuckets);
+}
+
+void AgarioFoodHash::AddFood(AgarioFood* pFood)
+{
+	const Elite::Vector2 pos{ pFood->GetPosition() };
+	m_Buckets[GetBucket(GetCell(pos.x), GetCell(pos.y))].push_back({ pos, pFood, 0, nullptr });
+	++m_NrOfFood;
+}
+
+void AgarioFoodHash::RemoveFood(AgarioFood* pFood)
+{
+	//Food never moves, so it is still in the bucket it was added to
+	const Elite::Vector2 pos{ pFood->GetPosition() };
+	std::vector<Pellet>& bucket{ m_Buckets[GetBucket(GetCell(pos.x), GetCell(pos.y))] };
+	for (size_t i = 0; i < bucket.size(); ++i)
+	{
+		if (bucket[i].pFood != pFood)
+			continue;
+
+		bucket[i] = bucket.back();
+		bucket.pop_back();
+		--m_NrOfFood;
+		return;
+	}
+}
+
+void AgarioFoodHash::EatFood(AgarioAgent* pAgent)
+{
+	const Elite::Vector2 agentPos{ pAgent->GetPosition() };
+	const float eatDistance{ pAgent->GetRadius() + m_FoodRadius };
+	const float eatDistanceSquared{ eatDistance * eatDistance };
+
+	//Cells that hash to the same bucket are visited more than once, the agent only eats a pellet once
+	const int minX{ GetCell(agentPos.x - eatDistance) }, maxX{ GetCell(agentPos.x + eatDistance) };
+	const int minY{ GetCell(agentPos.y - eatDistance) }, maxY{ GetCell(agentPos.y + eatDistance) };
+	for (int y = minY; y <= maxY; ++y)
+	{
+		for (int x = minX; x <= maxX; ++x)
+		{
+			for (Pellet& pellet : m_Buckets[GetBucket(x, y)])
+			{
+				const bool isEatenBefore{ pellet.eatenInPass != 0 && pellet.eatenInPass != m_Pass };
+				const bool isEatenByAgent{ pellet.eatenInPass == m_Pass && pellet.pLastEater == pAgent };
+				if (isEatenBefore || isEatenByAgent || Elite::DistanceSquared(pellet.position, agentPos) >= eatDistanceSquared)
+					continue;
+
+				//Other agents that overlap the pellet in this pass still get their upgrade
+				if (pellet.eatenInPass != m_Pass)
+					pellet.pFood->MarkForDestroy();
+				pellet.eatenInPass = m_Pass;
+				pellet.pLastEater = pAgent;
+				pAgent->MarkForUpgrade();
+			}
+		}
+	}
+}
+
+void AgarioFoodHash::EatFood(const std::vector<AgarioAgent*>& pAgents, AgarioAgent* pPlayer)
+{
+	ELITE_PROFILE_SCOPE("AgarioFoodHash::EatFood");
+
+	++m_Pass;
+	for (AgarioAgent* pAgent : pAgents)
+		EatFood(pAgent);
+	if (pPlayer)
+		EatFood(pPlayer);
+}
+
+unsigned int AgarioFoodHash::GetBucket(int cellX, int cellY) const
+{
+	const unsigned int hash{ (static_cast<unsigned int>(cellX) * 73856093u) ^ (static_cast<unsigned int>(cellY) * 19349663u) };
+	return hash & m_BucketMask;
+}
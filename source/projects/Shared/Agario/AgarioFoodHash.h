@@ -0,0 +1,54 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// AgarioFoodHash.h: food pellets that are eaten without Box2D.
+// Pellets are plain structs in a spatial hash, and one overlap pass per frame marks the food
+// and the agents the same way the contact listener does. Box2D is only left with the agents.
+/*=============================================================================*/
+#ifndef ELITE_AGARIO_FOOD_HASH
+#define ELITE_AGARIO_FOOD_HASH
+
+class AgarioFood;
+class AgarioAgent;
+
+class AgarioFoodHash final
+{
+public:
+	//nrOfBuckets is rounded up to a power of two
+	AgarioFoodHash(float cellSize = 4.f, int nrOfBuckets = 4096);
+	~AgarioFoodHash() = default;
+
+	void AddFood(AgarioFood* pFood);
+	void RemoveFood(AgarioFood* pFood);
+	int GetNrOfFood() const { return m_NrOfFood; }
+
+	//Every pellet an agent touches is marked for destroy and the agent for upgrade, like OnCollisionFoodPlayer.
+	//Box2D reports a contact for each agent that touches a pellet in the same step, so every agent that
+	//overlaps a pellet in one call gets the upgrade, not only the first. pPlayer is one more agent in the same call.
+	void EatFood(const std::vector<AgarioAgent*>& pAgents, AgarioAgent* pPlayer = nullptr);
+
+private:
+	struct Pellet
+	{
+		Elite::Vector2 position;
+		AgarioFood* pFood;
+		unsigned int eatenInPass;		//0 when not eaten, the pellet stays until its food is removed
+		const AgarioAgent* pLastEater;	//agent that got the upgrade last in that pass
+	};
+
+	float m_CellSize;
+	float m_FoodRadius;
+	unsigned int m_BucketMask;
+	std::vector<std::vector<Pellet>> m_Buckets{};
+	int m_NrOfFood = 0;
+	unsigned int m_Pass = 0;	//one per EatFood call
+
+	int GetCell(float coordinate) const { return static_cast<int>(floorf(coordinate / m_CellSize)); }
+	unsigned int GetBucket(int cellX, int cellY) const;
+	void EatFood(AgarioAgent* pAgent);
+
+	//C++ make the class non-copyable
+	AgarioFoodHash(const AgarioFoodHash&) = delete;
+	AgarioFoodHash& operator=(const AgarioFoodHash&) = delete;
+};
+#endif
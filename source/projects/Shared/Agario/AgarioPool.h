@@ -0,0 +1,53 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// AgarioPool.h: recycles AgarioFood and AgarioAgent objects instead of deleting them.
+// Released entities are deactivated, their rigid body stays in the world but is switched off.
+// Spawn hands them back out with Respawn and only allocates while nothing was released.
+/*=============================================================================*/
+#ifndef ELITE_AGARIO_POOL
+#define ELITE_AGARIO_POOL
+
+template<class T_AgarioType>
+class AgarioPool final
+{
+public:
+	AgarioPool() = default;
+	~AgarioPool() { Clear(); }
+
+	//The arguments after the position go to the constructor, or to Respawn for a recycled entity
+	template<typename... T_Args>
+	T_AgarioType* Spawn(Elite::Vector2 pos, T_Args... args)
+	{
+		if (m_pReleased.empty())
+			return new T_AgarioType(pos, args...);
+
+		T_AgarioType* pEntity{ m_pReleased.back() };
+		m_pReleased.pop_back();
+		pEntity->Respawn(pos, args...);
+		return pEntity;
+	}
+
+	void Release(T_AgarioType* pEntity)
+	{
+		pEntity->Deactivate();
+		m_pReleased.push_back(pEntity);
+	}
+
+	size_t GetNrOfReleased() const { return m_pReleased.size(); }
+
+	void Clear()
+	{
+		for (T_AgarioType* pEntity : m_pReleased)
+			SAFE_DELETE(pEntity);
+		m_pReleased.clear();
+	}
+
+private:
+	std::vector<T_AgarioType*> m_pReleased{};
+
+	//C++ make the class non-copyable
+	AgarioPool(const AgarioPool&) = delete;
+	AgarioPool& operator=(const AgarioPool&) = delete;
+};
+#endif
@@ -0,0 +1,190 @@
+#include "stdafx.h"
+#include "AgentCrowd.h"
+
+namespace
+{
+	//Same as the RigidBodyDefine of BaseAgent
+	const float LinearDamping = 0.01f;
+	const float AngularDamping = 0.1f;
+}
+
+int AgentCrowd::AddAgent(float radius)
+{
+	int idx{};
+	if (!m_FreeSlots.empty())
+	{
+		idx = m_FreeSlots.back();
+		m_FreeSlots.pop_back();
+	}
+	else
+	{
+		idx = static_cast<int>(m_Positions.size());
+		m_Positions.emplace_back();
+		m_LinearVelocities.emplace_back();
+		m_Rotations.emplace_back();
+		m_AngularVelocities.emplace_back();
+		m_Radii.emplace_back();
+		m_PrevPositions.emplace_back();
+		m_PrevRotations.emplace_back();
+		m_Masses.emplace_back();
+		m_UserData.emplace_back();
+		m_IsActive.emplace_back();
+	}
+
+	m_Positions[idx] = Elite::ZeroVector2;
+	m_LinearVelocities[idx] = Elite::ZeroVector2;
+	m_Rotations[idx] = 0.f;
+	m_AngularVelocities[idx] = 0.f;
+	m_Radii[idx] = radius;
+	m_PrevPositions[idx] = Elite::ZeroVector2;
+	m_PrevRotations[idx] = 0.f;
+	m_Masses[idx] = static_cast<float>(E_PI) * radius * radius; //circle with density 1, like a Box2D shape
+	m_UserData[idx] = {};
+	m_IsActive[idx] = true;
+
+	return idx;
+}
+
+void AgentCrowd::RemoveAgent(int idx)
+{
+	//Slots are reused, agents keep their index for as long as they live
+	m_IsActive[idx] = false;
+	m_LinearVelocities[idx] = Elite::ZeroVector2;
+	m_AngularVelocities[idx] = 0.f;
+	m_FreeSlots.push_back(idx);
+}
+
+void AgentCrowd::Step(float dt)
+{
+	ELITE_PROFILE_SCOPE("AgentCrowd::Step");
+
+	//Free slots have no velocity, so they don't need to be skipped
+	const float linearDamping{ 1.f / (1.f + dt * LinearDamping) };
+	const float angularDamping{ 1.f / (1.f + dt * AngularDamping) };
+	const size_t nrOfSlots{ m_Positions.size() };
+	for (size_t i = 0; i < nrOfSlots; ++i)
+	{
+		m_PrevPositions[i] = m_Positions[i];
+		m_PrevRotations[i] = m_Rotations[i];
+
+		m_LinearVelocities[i] *= linearDamping;
+		m_AngularVelocities[i] *= angularDamping;
+		m_Positions[i] += m_LinearVelocities[i] * dt;
+		m_Rotations[i] += m_AngularVelocities[i] * dt;
+	}
+
+	if (m_IsResolvingOverlaps)
+		ResolveOverlaps();
+}
+
+Elite::Vector2 AgentCrowd::GetRenderPosition(int idx) const
+{
+	return Elite::Lerp(m_PrevPositions[idx], m_Positions[idx], PHYSICSWORLD->GetInterpolationAlpha());
+}
+
+float AgentCrowd::GetRenderRotation(int idx) const
+{
+	//Shortest way around, in case the angle was reset in between
+	const float prevRotation{ m_PrevRotations[idx] };
+	return prevRotation + Elite::ClampedAngle(m_Rotations[idx] - prevRotation) * PHYSICSWORLD->GetInterpolationAlpha();
+}
+
+void AgentCrowd::ResolveOverlaps()
+{
+	ELITE_PROFILE_SCOPE("AgentCrowd::ResolveOverlaps");
+
+	const int nrOfSlots{ static_cast<int>(m_Positions.size()) };
+	const int nrOfAgents{ GetNrOfAgents() };
+	if (nrOfAgents < 2)
+		return;
+
+	//Cells as big as the largest agent, so overlaps are only possible with the cells around
+	Elite::Vector2 minPos{ FLT_MAX, FLT_MAX };
+	Elite::Vector2 maxPos{ -FLT_MAX, -FLT_MAX };
+	float maxRadius{};
+	for (int i = 0; i < nrOfSlots; ++i)
+	{
+		if (!m_IsActive[i])
+			continue;
+
+		minPos.x = std::min(minPos.x, m_Positions[i].x);
+		minPos.y = std::min(minPos.y, m_Positions[i].y);
+		maxPos.x = std::max(maxPos.x, m_Positions[i].x);
+		maxPos.y = std::max(maxPos.y, m_Positions[i].y);
+		maxRadius = std::max(maxRadius, m_Radii[i]);
+	}
+	if (maxRadius <= 0.f)
+		return;
+
+	//Agents spread out over a large area would need more cells than there are agents
+	float cellSize{ 2.f * maxRadius };
+	int nrOfCols{}, nrOfRows{};
+	do
+	{
+		nrOfCols = static_cast<int>((maxPos.x - minPos.x) / cellSize) + 1;
+		nrOfRows = static_cast<int>((maxPos.y - minPos.y) / cellSize) + 1;
+		cellSize *= 2.f;
+	} while (static_cast<long long>(nrOfCols) * nrOfRows > 4LL * nrOfAgents);
+	cellSize /= 2.f;
+	const int nrOfCells{ nrOfCols * nrOfRows };
+
+	//Counting sort of the agents on their cell
+	m_AgentCells.assign(nrOfSlots, -1);
+	m_CellStarts.assign(nrOfCells + 1, 0);
+	m_CellAgents.resize(nrOfAgents);
+	for (int i = 0; i < nrOfSlots; ++i)
+	{
+		if (!m_IsActive[i])
+			continue;
+
+		const int x{ std::min(static_cast<int>((m_Positions[i].x - minPos.x) / cellSize), nrOfCols - 1) };
+		const int y{ std::min(static_cast<int>((m_Positions[i].y - minPos.y) / cellSize), nrOfRows - 1) };
+		m_AgentCells[i] = y * nrOfCols + x;
+		++m_CellStarts[m_AgentCells[i]];
+	}
+	for (int c = 1; c < nrOfCells; ++c)
+		m_CellStarts[c] += m_CellStarts[c - 1];
+	m_CellStarts[nrOfCells] = nrOfAgents;
+	for (int i = nrOfSlots - 1; i >= 0; --i)
+	{
+		if (m_AgentCells[i] >= 0)
+			m_CellAgents[--m_CellStarts[m_AgentCells[i]]] = i;
+	}
+
+	//Push every overlapping pair apart, each agent half of the way
+	for (int i = 0; i < nrOfSlots; ++i)
+	{
+		if (m_AgentCells[i] < 0)
+			continue;
+
+		const int cellX{ m_AgentCells[i] % nrOfCols };
+		const int cellY{ m_AgentCells[i] / nrOfCols };
+		for (int y = std::max(cellY - 1, 0); y <= std::min(cellY + 1, nrOfRows - 1); ++y)
+		{
+			for (int x = std::max(cellX - 1, 0); x <= std::min(cellX + 1, nrOfCols - 1); ++x)
+			{
+				const int cell{ y * nrOfCols + x };
+				for (int k = m_CellStarts[cell]; k < m_CellStarts[cell + 1]; ++k)
+				{
+					const int j{ m_CellAgents[k] };
+					if (j <= i)
+						continue;
+
+					Elite::Vector2 toOther{ m_Positions[j] - m_Positions[i] };
+					const float minDistance{ m_Radii[i] + m_Radii[j] };
+					if (toOther.MagnitudeSquared() >= minDistance * minDistance)
+						continue;
+
+					//Agents on top of each other are pushed apart along x
+					float distance{ toOther.Normalize() };
+					if (distance <= 0.f)
+						toOther = { 1.f, 0.f };
+
+					const Elite::Vector2 push{ toOther * ((minDistance - distance) * 0.5f) };
+					m_Positions[i] -= push;
+					m_Positions[j] += push;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,79 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// AgentCrowd.h: kinematic agents that are moved without Box2D.
+// The crowd keeps the state of its agents in contiguous arrays and integrates them in Step,
+// for flocks and crowds that never need collision response. Overlapping agents can
+// optionally be pushed apart with a cheap circle-circle pass.
+/*=============================================================================*/
+#ifndef AGENT_CROWD_H
+#define AGENT_CROWD_H
+
+class AgentCrowd final
+{
+public:
+	AgentCrowd(bool isResolvingOverlaps = false) : m_IsResolvingOverlaps{ isResolvingOverlaps } {}
+	~AgentCrowd() = default;
+
+	//Returns the slot of the agent, which stays the same until it is removed
+	int AddAgent(float radius);
+	void RemoveAgent(int idx);
+	int GetNrOfAgents() const { return static_cast<int>(m_Positions.size() - m_FreeSlots.size()); }
+
+	//Moves every agent with its velocity, same damping as the Box2D bodies of BaseAgent
+	void Step(float dt);
+
+	void SetResolvingOverlaps(bool isResolving) { m_IsResolvingOverlaps = isResolving; }
+	bool IsResolvingOverlaps() const { return m_IsResolvingOverlaps; }
+
+	//Get - Set
+	const Elite::Vector2& GetPosition(int idx) const { return m_Positions[idx]; }
+	void SetPosition(int idx, const Elite::Vector2& pos) { m_Positions[idx] = pos; }
+	float GetRotation(int idx) const { return m_Rotations[idx]; }
+	void SetRotation(int idx, float rot) { m_Rotations[idx] = rot; }
+
+	//Interpolated between steps like the Box2D bodies, only use for drawing
+	Elite::Vector2 GetRenderPosition(int idx) const;
+	float GetRenderRotation(int idx) const;
+
+	const Elite::Vector2& GetLinearVelocity(int idx) const { return m_LinearVelocities[idx]; }
+	void SetLinearVelocity(int idx, const Elite::Vector2& linVel) { m_LinearVelocities[idx] = linVel; }
+	float GetAngularVelocity(int idx) const { return m_AngularVelocities[idx]; }
+	void SetAngularVelocity(int idx, float angVel) { m_AngularVelocities[idx] = angVel; }
+
+	float GetMass(int idx) const { return m_Masses[idx]; }
+	void SetMass(int idx, float mass) { m_Masses[idx] = mass; }
+
+	Elite::RigidBodyUserData GetUserData(int idx) const { return m_UserData[idx]; }
+	void SetUserData(int idx, Elite::RigidBodyUserData userData) { m_UserData[idx] = userData; }
+
+private:
+	//Hot data, touched every step
+	std::vector<Elite::Vector2> m_Positions{};
+	std::vector<Elite::Vector2> m_LinearVelocities{};
+	std::vector<float> m_Rotations{};
+	std::vector<float> m_AngularVelocities{};
+	std::vector<float> m_Radii{};
+
+	//Cold data
+	std::vector<Elite::Vector2> m_PrevPositions{};
+	std::vector<float> m_PrevRotations{};
+	std::vector<float> m_Masses{};
+	std::vector<Elite::RigidBodyUserData> m_UserData{};
+	std::vector<char> m_IsActive{};
+	std::vector<int> m_FreeSlots{};
+
+	bool m_IsResolvingOverlaps = false;
+
+	//Uniform grid of the overlap pass, rebuilt every step
+	std::vector<int> m_CellStarts{};
+	std::vector<int> m_CellAgents{};
+	std::vector<int> m_AgentCells{};
+
+	void ResolveOverlaps();
+
+	//C++ make the class non-copyable
+	AgentCrowd(const AgentCrowd&) = delete;
+	AgentCrowd& operator=(const AgentCrowd&) = delete;
+};
+#endif
@@ -15,8 +15,17 @@ BaseAgent::BaseAgent(float radius) : m_Radius(radius)
 }
 
 
+BaseAgent::BaseAgent(AgentCrowd* pCrowd, float radius)
+	: m_pCrowd(pCrowd)
+	, m_Radius(radius)
+{
+	m_CrowdIdx = m_pCrowd->AddAgent(m_Radius);
+}
+
 BaseAgent::~BaseAgent()
 {
+	if (m_pCrowd)
+		m_pCrowd->RemoveAgent(m_CrowdIdx);
 	SAFE_DELETE(m_pRigidBody);
 }
 
@@ -26,14 +35,14 @@ void BaseAgent::Update(float dt)
 
 void BaseAgent::Render(float dt)
 {
-	auto o = GetRotation();
-	auto p = GetPosition();
+	auto o = GetRenderRotation();
+	auto p = GetRenderPosition();
 	auto r = Elite::ToRadians(150.f);
 
 	//EliteDebugRenderer2D::GetInstance()->DrawSolidCircle(GetPosition(), m_Radius, { 0,0 }, m_BodyColor);
-	DEBUGRENDERER2D->DrawSolidCircle(GetPosition(), m_Radius, { 0,0 }, m_BodyColor);
+	DEBUGRENDERER2D->DrawSolidCircle(p, m_Radius, { 0,0 }, m_BodyColor);
 
-	std::vector<Elite::Vector2> points;
+	auto points = Elite::FrameArena::MakeVector<Elite::Vector2>(3);
 	points.push_back(Elite::Vector2(static_cast<float>(cos(o)) * m_Radius, static_cast<float>(sin(o)) * m_Radius) + p);
 	points.push_back(Elite::Vector2(static_cast<float>(cos(o + r)) * m_Radius, static_cast<float>(sin(o + r)) * m_Radius) + p);
 	points.push_back(Elite::Vector2(static_cast<float>(cos(o - r)) * m_Radius, static_cast<float>(sin(o - r)) * m_Radius) + p);
@@ -1,10 +1,14 @@
 #ifndef BASE_AGENT_H
 #define BASE_AGENT_H
 
+#include "AgentCrowd.h"
+
 class BaseAgent
 {
 public:
 	BaseAgent(float radius = 1.f);
+	//Kinematic agent: moved by the crowd instead of Box2D, it has no rigid body and doesn't collide
+	BaseAgent(AgentCrowd* pCrowd, float radius = 1.f);
 	virtual ~BaseAgent();
 
 	virtual void Update(float dt);
@@ -15,32 +19,39 @@ public:
 	void TrimToWorld(const Elite::Vector2& bottomLeft, const Elite::Vector2& topRight, bool isWorldLooping = true) const;
 
 	//Get - Set
-	Elite::Vector2 GetPosition() const { return m_pRigidBody->GetPosition(); }
-	void SetPosition(const Elite::Vector2& pos) const { m_pRigidBody->SetPosition(pos); }
+	Elite::Vector2 GetPosition() const { return m_pCrowd ? m_pCrowd->GetPosition(m_CrowdIdx) : m_pRigidBody->GetPosition(); }
+	void SetPosition(const Elite::Vector2& pos) const { if (m_pCrowd) m_pCrowd->SetPosition(m_CrowdIdx, pos); else m_pRigidBody->SetPosition(pos); }
 
 	float GetRotation() const {
-		return Elite::ClampedAngle(m_pRigidBody->GetRotation().x);}
-	void SetRotation(float rot) const { m_pRigidBody->SetRotation({ rot, 0.0f }); } 
+		return Elite::ClampedAngle(m_pCrowd ? m_pCrowd->GetRotation(m_CrowdIdx) : m_pRigidBody->GetRotation().x);}
+	void SetRotation(float rot) const { if (m_pCrowd) m_pCrowd->SetRotation(m_CrowdIdx, rot); else m_pRigidBody->SetRotation({ rot, 0.0f }); } 
+
+	//Interpolated between physics steps, only use for drawing
+	Elite::Vector2 GetRenderPosition() const { return m_pCrowd ? m_pCrowd->GetRenderPosition(m_CrowdIdx) : m_pRigidBody->GetRenderPosition(); }
+	float GetRenderRotation() const { return Elite::ClampedAngle(m_pCrowd ? m_pCrowd->GetRenderRotation(m_CrowdIdx) : m_pRigidBody->GetRenderRotation().x); }
 
-	Elite::Vector2 GetLinearVelocity() const { return m_pRigidBody->GetLinearVelocity(); }
-	void SetLinearVelocity(const Elite::Vector2& linVel) const { m_pRigidBody->SetLinearVelocity(linVel); }
+	Elite::Vector2 GetLinearVelocity() const { return m_pCrowd ? m_pCrowd->GetLinearVelocity(m_CrowdIdx) : m_pRigidBody->GetLinearVelocity(); }
+	void SetLinearVelocity(const Elite::Vector2& linVel) const { if (m_pCrowd) m_pCrowd->SetLinearVelocity(m_CrowdIdx, linVel); else m_pRigidBody->SetLinearVelocity(linVel); }
 
-	float GetAngularVelocity() const { return m_pRigidBody->GetAngularVelocity().x; }
-	void SetAngularVelocity(float angVel) const { m_pRigidBody->SetAngularVelocity({ angVel,0.f }); }
+	float GetAngularVelocity() const { return m_pCrowd ? m_pCrowd->GetAngularVelocity(m_CrowdIdx) : m_pRigidBody->GetAngularVelocity().x; }
+	void SetAngularVelocity(float angVel) const { if (m_pCrowd) m_pCrowd->SetAngularVelocity(m_CrowdIdx, angVel); else m_pRigidBody->SetAngularVelocity({ angVel,0.f }); }
 	
-	float GetMass() const { return m_pRigidBody->GetMass(); }
-	void SetMass(float mass) const { m_pRigidBody->SetMass(mass); }
+	float GetMass() const { return m_pCrowd ? m_pCrowd->GetMass(m_CrowdIdx) : m_pRigidBody->GetMass(); }
+	void SetMass(float mass) const { if (m_pCrowd) m_pCrowd->SetMass(m_CrowdIdx, mass); else m_pRigidBody->SetMass(mass); }
 
 	const Elite::Color& GetBodyColor() const { return m_BodyColor; }
 	void SetBodyColor(const Elite::Color& col) { m_BodyColor = col; }
 
-	Elite::RigidBodyUserData GetUserData() const { return m_pRigidBody->GetUserData(); }
-	void SetUserData(Elite::RigidBodyUserData userData) { m_pRigidBody->SetUserData(userData); }
+	Elite::RigidBodyUserData GetUserData() const { return m_pCrowd ? m_pCrowd->GetUserData(m_CrowdIdx) : m_pRigidBody->GetUserData(); }
+	void SetUserData(Elite::RigidBodyUserData userData) { if (m_pCrowd) m_pCrowd->SetUserData(m_CrowdIdx, userData); else m_pRigidBody->SetUserData(userData); }
 
 	float GetRadius() const { return m_Radius; }
+	bool IsKinematic() const { return m_pCrowd != nullptr; }
 
 protected:
-	RigidBody* m_pRigidBody = nullptr;
+	RigidBody* m_pRigidBody = nullptr;	//nullptr for kinematic agents
+	AgentCrowd* m_pCrowd = nullptr;
+	int m_CrowdIdx = -1;
 	float m_Radius = 1.f;
 	Elite::Color m_BodyColor = { 1,1,0,1 };
 
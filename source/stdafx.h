@@ -27,6 +27,11 @@ stdafx.h: Precompiled header for engine. Includes all standard files, as well as
 #include <functional>
 #include <unordered_map>
 #include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
 
 #pragma endregion //StandardLibraryIncludes
 
@@ -121,6 +126,17 @@ extern bool gRequestShutdown;
 /* --- DEFINES --- */
 #define USE_BOX2D
 #define USE_VLD
+//Profiling zones cost a timestamp pair per scope, Release builds only get them when USE_PROFILER is
+//added to the preprocessor definitions of the project
+#if defined(_DEBUG) && !defined(USE_PROFILER)
+#define USE_PROFILER
+#endif
+//Counts heap allocations per frame by replacing the global operator new, see FrameArena. Opt-in and
+//never in Debug: the replacement would hide the allocations from the debug heap and VLD.
+//#define USE_HEAP_COUNTER
+#if defined(_DEBUG) && defined(USE_HEAP_COUNTER)
+#undef USE_HEAP_COUNTER
+#endif
 
 /* --- PLATFORMS --- */
 #define PLATFORM_WINDOWS 0
@@ -168,16 +184,23 @@ extern bool gRequestShutdown;
 ===========================================================================*/
 #pragma region FrameworkIncludes
 #include "framework/EliteHelpers/ESingleton.h"
+#include "framework/EliteHelpers/EFrameArena.h"
+#include "framework/EliteHelpers/EBinaryFile.h"
+#include "framework/EliteHelpers/EJobSystem.h"
+#include "framework/EliteProfiler/EProfiler.h"
 #include "framework/EliteMath/EMath.h"
 #include "framework/ElitePhysics/EPhysics.h"
 #include "framework/EliteInput/EInputCodes.h"
 #include "framework/EliteInput/EInputData.h"
 #include "framework/EliteInput/EInputManager.h"
+#include "framework/EliteReplay/EReplay.h"
 #include "framework/EliteWindow/EWindow.h"
 #include "framework/EliteTimer/ETimer.h"
+#include "framework/EliteTimer/EFixedTimestep.h"
 #include "framework/EliteRendering/ERendering.h"
 #include "framework/EliteUI/EImmediateUI.h"
 #include "framework/EliteAI/EliteDecisionMaking/EDecisionMaking.h"
+#include "framework/EliteAI/EliteGenetics/EGeneticAlgorithm.h"
 #pragma endregion //FrameworkIncludes
 
 /* --- FRAMEWORK MACROS ---- */
@@ -186,6 +209,7 @@ extern bool gRequestShutdown;
 #define DEBUGRENDERER2D EliteDebugRenderer2D::GetInstance()
 #define PHYSICSWORLD PhysicsWorld::GetInstance()
 #define LEVELLOADER LevelLoader::GetInstance()
+#define JOBSYSTEM Elite::JobSystem::GetInstance()
 
 /* --- PLATFORM SPECIFIC INCLUDES --- */
 #pragma region PlatformIncludes